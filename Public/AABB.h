@@ -0,0 +1,594 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_AABB_H
+#define MATH_AABB_H 1
+
+#include "MathPrerequisites.h"
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Rect.h"
+#include <limits>
+
+namespace greaper::math
+{
+	namespace Impl
+	{
+		/* Same results as minps/maxps, when an operand is NaN the second one is returned */
+		template<class T> NODISCARD INLINE constexpr T SlabMin(T a, T b)noexcept { return a < b ? a : b; }
+		template<class T> NODISCARD INLINE constexpr T SlabMax(T a, T b)noexcept { return a > b ? a : b; }
+		template<class T> INLINE constexpr void SlabStep(T min, T max, T origin, T invDirection, T& enter, T& exit)noexcept
+		{
+			const T t0 = (min - origin) * invDirection;
+			const T t1 = (max - origin) * invDirection;
+			enter = SlabMax(SlabMin(t0, t1), enter);
+			exit = SlabMin(SlabMax(t0, t1), exit);
+		}
+	}
+
+	template<class T>
+	class AABB3Real
+	{
+		static_assert(std::is_floating_point_v<T>, "AABB3Real can only work with float, double or long double types");
+	public:
+		using value_type = Vector3Real<T>;
+
+		Vector3Real<T> Min{};
+		Vector3Real<T> Max{};
+
+		constexpr AABB3Real()noexcept = default;
+		INLINE constexpr AABB3Real(const Vector3Real<T>& min, const Vector3Real<T>& max)noexcept :Min(min), Max(max) {  }
+
+		NODISCARD static INLINE constexpr AABB3Real FromCenterExtents(const Vector3Real<T>& center, const Vector3Real<T>& extents)noexcept
+		{
+			return { center - extents, center + extents };
+		}
+
+		INLINE void Set(const Vector3Real<T>& min, const Vector3Real<T>& max)noexcept
+		{
+			Min = min;
+			Max = max;
+		}
+
+		/* EMPTY has Min above Max, merging anything into it gives that thing */
+		NODISCARD INLINE constexpr bool IsEmpty()const noexcept
+		{
+			return Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z;
+		}
+		NODISCARD INLINE constexpr Vector3Real<T> GetCenter()const noexcept
+		{
+			return (Min + Max) * T(0.5);
+		}
+		NODISCARD INLINE constexpr Vector3Real<T> GetExtents()const noexcept
+		{
+			return (Max - Min) * T(0.5);
+		}
+		NODISCARD INLINE constexpr Vector3Real<T> GetSize()const noexcept
+		{
+			return Max - Min;
+		}
+		NODISCARD INLINE constexpr T GetSurfaceArea()const noexcept
+		{
+			const Vector3Real<T> d = Max - Min;
+			return T(2) * (d.X * d.Y + d.Y * d.Z + d.Z * d.X);
+		}
+		NODISCARD INLINE constexpr T GetVolume()const noexcept
+		{
+			const Vector3Real<T> d = Max - Min;
+			return d.X * d.Y * d.Z;
+		}
+		/* 0 for X, 1 for Y and 2 for Z */
+		NODISCARD INLINE constexpr sizet GetLongestAxis()const noexcept
+		{
+			const Vector3Real<T> d = Max - Min;
+			if (d.X >= d.Y && d.X >= d.Z)
+				return 0;
+			return d.Y >= d.Z ? 1 : 2;
+		}
+
+		INLINE constexpr void Merge(const Vector3Real<T>& point)noexcept
+		{
+			Min = { Impl::SlabMin(point.X, Min.X), Impl::SlabMin(point.Y, Min.Y), Impl::SlabMin(point.Z, Min.Z) };
+			Max = { Impl::SlabMax(point.X, Max.X), Impl::SlabMax(point.Y, Max.Y), Impl::SlabMax(point.Z, Max.Z) };
+		}
+		INLINE constexpr void Merge(const AABB3Real& other)noexcept
+		{
+			Min = { Impl::SlabMin(other.Min.X, Min.X), Impl::SlabMin(other.Min.Y, Min.Y), Impl::SlabMin(other.Min.Z, Min.Z) };
+			Max = { Impl::SlabMax(other.Max.X, Max.X), Impl::SlabMax(other.Max.Y, Max.Y), Impl::SlabMax(other.Max.Z, Max.Z) };
+		}
+		NODISCARD INLINE constexpr AABB3Real GetMerged(const AABB3Real& other)const noexcept
+		{
+			AABB3Real res = *this;
+			res.Merge(other);
+			return res;
+		}
+		/* Grows every face outwards by amount, negative amounts shrink the box */
+		INLINE constexpr void Expand(T amount)noexcept
+		{
+			Expand(Vector3Real<T>(amount, amount, amount));
+		}
+		INLINE constexpr void Expand(const Vector3Real<T>& amount)noexcept
+		{
+			Min = Min - amount;
+			Max = Max + amount;
+		}
+		NODISCARD INLINE constexpr AABB3Real GetExpanded(T amount)const noexcept
+		{
+			AABB3Real res = *this;
+			res.Expand(amount);
+			return res;
+		}
+
+		NODISCARD INLINE constexpr bool Contains(const Vector3Real<T>& point)const noexcept
+		{
+			return point.X >= Min.X && point.X <= Max.X
+				&& point.Y >= Min.Y && point.Y <= Max.Y
+				&& point.Z >= Min.Z && point.Z <= Max.Z;
+		}
+		NODISCARD INLINE constexpr bool Contains(const AABB3Real& other)const noexcept
+		{
+			return other.Min.X >= Min.X && other.Max.X <= Max.X
+				&& other.Min.Y >= Min.Y && other.Max.Y <= Max.Y
+				&& other.Min.Z >= Min.Z && other.Max.Z <= Max.Z;
+		}
+		/* Touching boxes overlap */
+		NODISCARD INLINE constexpr bool Overlaps(const AABB3Real& other)const noexcept
+		{
+			return Min.X <= other.Max.X && Max.X >= other.Min.X
+				&& Min.Y <= other.Max.Y && Max.Y >= other.Min.Y
+				&& Min.Z <= other.Max.Z && Max.Z >= other.Min.Z;
+		}
+		NODISCARD INLINE constexpr bool OverlapsSphere(const Vector3Real<T>& center, T radius)const noexcept
+		{
+			return DistanceSquared(center) <= radius * radius;
+		}
+		/* The point itself when it is inside */
+		NODISCARD INLINE constexpr Vector3Real<T> ClosestPoint(const Vector3Real<T>& point)const noexcept
+		{
+			return {
+				Impl::SlabMin(Impl::SlabMax(point.X, Min.X), Max.X),
+				Impl::SlabMin(Impl::SlabMax(point.Y, Min.Y), Max.Y),
+				Impl::SlabMin(Impl::SlabMax(point.Z, Min.Z), Max.Z)
+			};
+		}
+		NODISCARD INLINE constexpr T DistanceSquared(const Vector3Real<T>& point)const noexcept
+		{
+			return (ClosestPoint(point) - point).LengthSquared();
+		}
+
+		/* Branchless slab test against a ray given with its precomputed 1 / direction, infinite components are fine.
+		 * Returns whether the ray enters the box inside [tMin, tMax], hitDistance gets the entry distance clamped to tMin. */
+		INLINE constexpr bool RayIntersects(const Vector3Real<T>& origin, const Vector3Real<T>& invDirection, T tMin, T tMax, T* hitDistance = nullptr)const noexcept;
+
+		NODISCARD INLINE constexpr bool IsNearlyEqual(const AABB3Real& other, T tolerance = MATH_TOLERANCE<T>)const noexcept
+		{
+			return Min.IsNearlyEqual(other.Min, tolerance) && Max.IsNearlyEqual(other.Max, tolerance);
+		}
+		NODISCARD INLINE constexpr bool IsEqual(const AABB3Real& other)const noexcept
+		{
+			return Min.IsEqual(other.Min) && Max.IsEqual(other.Max);
+		}
+
+		static const AABB3Real EMPTY;
+	};
+
+	template<class T> inline const AABB3Real<T> AABB3Real<T>::EMPTY = AABB3Real<T>(
+		Vector3Real<T>(std::numeric_limits<T>::max(), std::numeric_limits<T>::max(), std::numeric_limits<T>::max()),
+		Vector3Real<T>(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest())
+	);
+
+	template<class T>
+	NODISCARD INLINE constexpr bool operator==(const AABB3Real<T>& left, const AABB3Real<T>& right)noexcept { return left.IsNearlyEqual(right); }
+	template<class T>
+	NODISCARD INLINE constexpr bool operator!=(const AABB3Real<T>& left, const AABB3Real<T>& right)noexcept { return !(left == right); }
+
+	/* 2D box with Y up, it converts to and from RectT where Top is the biggest Y */
+	template<class T>
+	class AABB2Real
+	{
+		static_assert(std::is_floating_point_v<T>, "AABB2Real can only work with float, double or long double types");
+	public:
+		using value_type = Vector2Real<T>;
+
+		Vector2Real<T> Min{};
+		Vector2Real<T> Max{};
+
+		constexpr AABB2Real()noexcept = default;
+		INLINE constexpr AABB2Real(const Vector2Real<T>& min, const Vector2Real<T>& max)noexcept :Min(min), Max(max) {  }
+		INLINE constexpr explicit AABB2Real(const RectT<T>& rect)noexcept :Min(rect.Left, rect.Bottom), Max(rect.Right, rect.Top) {  }
+
+		NODISCARD INLINE constexpr RectT<T> ToRect()const noexcept
+		{
+			return RectT<T>(Min.X, Max.Y, Max.X, Min.Y);
+		}
+		INLINE void Set(const Vector2Real<T>& min, const Vector2Real<T>& max)noexcept
+		{
+			Min = min;
+			Max = max;
+		}
+
+		NODISCARD INLINE constexpr bool IsEmpty()const noexcept
+		{
+			return Min.X > Max.X || Min.Y > Max.Y;
+		}
+		NODISCARD INLINE constexpr Vector2Real<T> GetCenter()const noexcept
+		{
+			return (Min + Max) * T(0.5);
+		}
+		NODISCARD INLINE constexpr Vector2Real<T> GetExtents()const noexcept
+		{
+			return (Max - Min) * T(0.5);
+		}
+		NODISCARD INLINE constexpr Vector2Real<T> GetSize()const noexcept
+		{
+			return Max - Min;
+		}
+		NODISCARD INLINE constexpr T GetArea()const noexcept
+		{
+			const Vector2Real<T> d = Max - Min;
+			return d.X * d.Y;
+		}
+		/* The 2D counterpart of the surface area for SAH costs */
+		NODISCARD INLINE constexpr T GetPerimeter()const noexcept
+		{
+			const Vector2Real<T> d = Max - Min;
+			return T(2) * (d.X + d.Y);
+		}
+
+		INLINE constexpr void Merge(const Vector2Real<T>& point)noexcept
+		{
+			Min = { Impl::SlabMin(point.X, Min.X), Impl::SlabMin(point.Y, Min.Y) };
+			Max = { Impl::SlabMax(point.X, Max.X), Impl::SlabMax(point.Y, Max.Y) };
+		}
+		INLINE constexpr void Merge(const AABB2Real& other)noexcept
+		{
+			Min = { Impl::SlabMin(other.Min.X, Min.X), Impl::SlabMin(other.Min.Y, Min.Y) };
+			Max = { Impl::SlabMax(other.Max.X, Max.X), Impl::SlabMax(other.Max.Y, Max.Y) };
+		}
+		NODISCARD INLINE constexpr AABB2Real GetMerged(const AABB2Real& other)const noexcept
+		{
+			AABB2Real res = *this;
+			res.Merge(other);
+			return res;
+		}
+		INLINE constexpr void Expand(T amount)noexcept
+		{
+			Min = Min - Vector2Real<T>(amount, amount);
+			Max = Max + Vector2Real<T>(amount, amount);
+		}
+		NODISCARD INLINE constexpr AABB2Real GetExpanded(T amount)const noexcept
+		{
+			AABB2Real res = *this;
+			res.Expand(amount);
+			return res;
+		}
+
+		NODISCARD INLINE constexpr bool Contains(const Vector2Real<T>& point)const noexcept
+		{
+			return point.X >= Min.X && point.X <= Max.X && point.Y >= Min.Y && point.Y <= Max.Y;
+		}
+		NODISCARD INLINE constexpr bool Contains(const AABB2Real& other)const noexcept
+		{
+			return other.Min.X >= Min.X && other.Max.X <= Max.X && other.Min.Y >= Min.Y && other.Max.Y <= Max.Y;
+		}
+		NODISCARD INLINE constexpr bool Overlaps(const AABB2Real& other)const noexcept
+		{
+			return Min.X <= other.Max.X && Max.X >= other.Min.X && Min.Y <= other.Max.Y && Max.Y >= other.Min.Y;
+		}
+		NODISCARD INLINE constexpr bool OverlapsCircle(const Vector2Real<T>& center, T radius)const noexcept
+		{
+			return DistanceSquared(center) <= radius * radius;
+		}
+		NODISCARD INLINE constexpr Vector2Real<T> ClosestPoint(const Vector2Real<T>& point)const noexcept
+		{
+			return {
+				Impl::SlabMin(Impl::SlabMax(point.X, Min.X), Max.X),
+				Impl::SlabMin(Impl::SlabMax(point.Y, Min.Y), Max.Y)
+			};
+		}
+		NODISCARD INLINE constexpr T DistanceSquared(const Vector2Real<T>& point)const noexcept
+		{
+			return (ClosestPoint(point) - point).LengthSquared();
+		}
+
+		NODISCARD INLINE constexpr bool IsNearlyEqual(const AABB2Real& other, T tolerance = MATH_TOLERANCE<T>)const noexcept
+		{
+			return Min.IsNearlyEqual(other.Min, tolerance) && Max.IsNearlyEqual(other.Max, tolerance);
+		}
+		NODISCARD INLINE constexpr bool IsEqual(const AABB2Real& other)const noexcept
+		{
+			return Min.IsEqual(other.Min) && Max.IsEqual(other.Max);
+		}
+
+		static const AABB2Real EMPTY;
+	};
+
+	template<class T> inline const AABB2Real<T> AABB2Real<T>::EMPTY = AABB2Real<T>(
+		Vector2Real<T>(std::numeric_limits<T>::max(), std::numeric_limits<T>::max()),
+		Vector2Real<T>(std::numeric_limits<T>::lowest(), std::numeric_limits<T>::lowest())
+	);
+
+	template<class T>
+	NODISCARD INLINE constexpr bool operator==(const AABB2Real<T>& left, const AABB2Real<T>& right)noexcept { return left.IsNearlyEqual(right); }
+	template<class T>
+	NODISCARD INLINE constexpr bool operator!=(const AABB2Real<T>& left, const AABB2Real<T>& right)noexcept { return !(left == right); }
+
+	/* Boxes in SoA order, the one ray against N boxes tests check all of them at once.
+	 * Unused slots should be left EMPTY, rays never hit them. */
+	template<sizet N>
+	struct alignas(N * sizeof(float)) AABB3Packet
+	{
+		static constexpr sizet Count = N;
+
+		float MinX[N];
+		float MinY[N];
+		float MinZ[N];
+		float MaxX[N];
+		float MaxY[N];
+		float MaxZ[N];
+
+		INLINE constexpr AABB3Packet()noexcept
+		{
+			for (sizet i = 0; i < N; ++i)
+				Set(i, AABB3f::EMPTY);
+		}
+		INLINE constexpr void Set(sizet index, const AABB3f& box)noexcept
+		{
+			VerifyLess(index, N, "Trying to set a box of an AABB3Packet, but the index %" PRIuPTR " was out of range.", index);
+			MinX[index] = box.Min.X;
+			MinY[index] = box.Min.Y;
+			MinZ[index] = box.Min.Z;
+			MaxX[index] = box.Max.X;
+			MaxY[index] = box.Max.Y;
+			MaxZ[index] = box.Max.Z;
+		}
+		NODISCARD INLINE constexpr AABB3f Get(sizet index)const noexcept
+		{
+			VerifyLess(index, N, "Trying to get a box of an AABB3Packet, but the index %" PRIuPTR " was out of range.", index);
+			return { Vector3f(MinX[index], MinY[index], MinZ[index]), Vector3f(MaxX[index], MaxY[index], MaxZ[index]) };
+		}
+	};
+	using AABB3x4f = AABB3Packet<4>;
+	using AABB3x8f = AABB3Packet<8>;
+
+	/* Rays in SoA order, Set keeps the inverse direction used by the slab tests up to date */
+	template<sizet N>
+	struct alignas(N * sizeof(float)) RayPacket
+	{
+		static constexpr sizet Count = N;
+
+		float OriginX[N];
+		float OriginY[N];
+		float OriginZ[N];
+		float DirectionX[N];
+		float DirectionY[N];
+		float DirectionZ[N];
+		float InvDirectionX[N];
+		float InvDirectionY[N];
+		float InvDirectionZ[N];
+		float TMin[N];
+		float TMax[N];
+
+		/* Unused slots get an empty interval, nothing ever hits them */
+		INLINE constexpr RayPacket()noexcept
+		{
+			for (sizet i = 0; i < N; ++i)
+				Set(i, Vector3f(), Vector3f(1.f, 1.f, 1.f), 1.f, 0.f);
+		}
+		INLINE constexpr void Set(sizet index, const Vector3f& origin, const Vector3f& direction, float tMin, float tMax)noexcept
+		{
+			VerifyLess(index, N, "Trying to set a ray of a RayPacket, but the index %" PRIuPTR " was out of range.", index);
+			OriginX[index] = origin.X;
+			OriginY[index] = origin.Y;
+			OriginZ[index] = origin.Z;
+			DirectionX[index] = direction.X;
+			DirectionY[index] = direction.Y;
+			DirectionZ[index] = direction.Z;
+			InvDirectionX[index] = 1.f / direction.X;
+			InvDirectionY[index] = 1.f / direction.Y;
+			InvDirectionZ[index] = 1.f / direction.Z;
+			TMin[index] = tMin;
+			TMax[index] = tMax;
+		}
+		NODISCARD INLINE constexpr Vector3f GetOrigin(sizet index)const noexcept { return { OriginX[index], OriginY[index], OriginZ[index] }; }
+		NODISCARD INLINE constexpr Vector3f GetDirection(sizet index)const noexcept { return { DirectionX[index], DirectionY[index], DirectionZ[index] }; }
+		NODISCARD INLINE constexpr Vector3f GetInvDirection(sizet index)const noexcept { return { InvDirectionX[index], InvDirectionY[index], InvDirectionZ[index] }; }
+	};
+	using RayPacket4 = RayPacket<4>;
+	using RayPacket8 = RayPacket<8>;
+}
+
+namespace greaper::math::SSE
+{
+	/* Single box slab test, X/Y/Z in the first three lanes, the fourth lane is ignored */
+	INLINE bool RayIntersectsAABB(Vector4f origin, Vector4f invDirection, Vector4f boxMin, Vector4f boxMax, float tMin, float tMax, float& hitDistance)noexcept
+	{
+		const Vector4f t0 = _mm_mul_ps(_mm_sub_ps(boxMin, origin), invDirection);
+		const Vector4f t1 = _mm_mul_ps(_mm_sub_ps(boxMax, origin), invDirection);
+		const Vector4f tNear = _mm_min_ps(t0, t1);
+		const Vector4f tFar = _mm_max_ps(t0, t1);
+		Vector4f enter = _mm_max_ss(tNear, _mm_set_ss(tMin));
+		Vector4f exit = _mm_min_ss(tFar, _mm_set_ss(tMax));
+		enter = _mm_max_ss(Swizzle<1, 1, 1, 1>(tNear), enter);
+		exit = _mm_min_ss(Swizzle<1, 1, 1, 1>(tFar), exit);
+		enter = _mm_max_ss(Swizzle<2, 2, 2, 2>(tNear), enter);
+		exit = _mm_min_ss(Swizzle<2, 2, 2, 2>(tFar), exit);
+		hitDistance = _mm_cvtss_f32(enter);
+		return (_mm_movemask_ps(_mm_cmple_ss(enter, exit)) & 1) != 0;
+	}
+	/* One ray against four boxes, bit i of the result is set when box i is hit, hitDistances gets every entry distance */
+	INLINE int RayIntersectsAABB4(const float* minX, const float* minY, const float* minZ, const float* maxX, const float* maxY, const float* maxZ,
+		const Vector3f& origin, const Vector3f& invDirection, float tMin, float tMax, float* hitDistances)noexcept
+	{
+		const Vector4f ox = _mm_set1_ps(origin.X), oy = _mm_set1_ps(origin.Y), oz = _mm_set1_ps(origin.Z);
+		const Vector4f ix = _mm_set1_ps(invDirection.X), iy = _mm_set1_ps(invDirection.Y), iz = _mm_set1_ps(invDirection.Z);
+		Vector4f enter = _mm_set1_ps(tMin), exit = _mm_set1_ps(tMax);
+		Vector4f t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minX), ox), ix);
+		Vector4f t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxX), ox), ix);
+		enter = _mm_max_ps(_mm_min_ps(t0, t1), enter);
+		exit = _mm_min_ps(_mm_max_ps(t0, t1), exit);
+		t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minY), oy), iy);
+		t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxY), oy), iy);
+		enter = _mm_max_ps(_mm_min_ps(t0, t1), enter);
+		exit = _mm_min_ps(_mm_max_ps(t0, t1), exit);
+		t0 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(minZ), oz), iz);
+		t1 = _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(maxZ), oz), iz);
+		enter = _mm_max_ps(_mm_min_ps(t0, t1), enter);
+		exit = _mm_min_ps(_mm_max_ps(t0, t1), exit);
+		if (hitDistances != nullptr)
+			_mm_storeu_ps(hitDistances, enter);
+		return _mm_movemask_ps(_mm_cmple_ps(enter, exit));
+	}
+	/* Four rays of a packet, starting at first, against one box */
+	template<sizet N>
+	INLINE int RayPacketIntersectsAABB4(const AABB3f& box, const RayPacket<N>& rays, sizet first, float* hitDistances)noexcept
+	{
+		Vector4f enter = _mm_load_ps(rays.TMin + first), exit = _mm_load_ps(rays.TMax + first);
+		Vector4f t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Min.X), _mm_load_ps(rays.OriginX + first)), _mm_load_ps(rays.InvDirectionX + first));
+		Vector4f t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Max.X), _mm_load_ps(rays.OriginX + first)), _mm_load_ps(rays.InvDirectionX + first));
+		enter = _mm_max_ps(_mm_min_ps(t0, t1), enter);
+		exit = _mm_min_ps(_mm_max_ps(t0, t1), exit);
+		t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Min.Y), _mm_load_ps(rays.OriginY + first)), _mm_load_ps(rays.InvDirectionY + first));
+		t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Max.Y), _mm_load_ps(rays.OriginY + first)), _mm_load_ps(rays.InvDirectionY + first));
+		enter = _mm_max_ps(_mm_min_ps(t0, t1), enter);
+		exit = _mm_min_ps(_mm_max_ps(t0, t1), exit);
+		t0 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Min.Z), _mm_load_ps(rays.OriginZ + first)), _mm_load_ps(rays.InvDirectionZ + first));
+		t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(box.Max.Z), _mm_load_ps(rays.OriginZ + first)), _mm_load_ps(rays.InvDirectionZ + first));
+		enter = _mm_max_ps(_mm_min_ps(t0, t1), enter);
+		exit = _mm_min_ps(_mm_max_ps(t0, t1), exit);
+		if (hitDistances != nullptr)
+			_mm_storeu_ps(hitDistances, enter);
+		return _mm_movemask_ps(_mm_cmple_ps(enter, exit));
+	}
+}
+
+namespace greaper::math::AVX
+{
+	MATH_TARGET_AVX inline int RayIntersectsAABB8(const AABB3x8f& boxes, const Vector3f& origin, const Vector3f& invDirection, float tMin, float tMax, float* hitDistances)noexcept
+	{
+		const __m256 ox = _mm256_set1_ps(origin.X), oy = _mm256_set1_ps(origin.Y), oz = _mm256_set1_ps(origin.Z);
+		const __m256 ix = _mm256_set1_ps(invDirection.X), iy = _mm256_set1_ps(invDirection.Y), iz = _mm256_set1_ps(invDirection.Z);
+		__m256 enter = _mm256_set1_ps(tMin), exit = _mm256_set1_ps(tMax);
+		__m256 t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.MinX), ox), ix);
+		__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.MaxX), ox), ix);
+		enter = _mm256_max_ps(_mm256_min_ps(t0, t1), enter);
+		exit = _mm256_min_ps(_mm256_max_ps(t0, t1), exit);
+		t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.MinY), oy), iy);
+		t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.MaxY), oy), iy);
+		enter = _mm256_max_ps(_mm256_min_ps(t0, t1), enter);
+		exit = _mm256_min_ps(_mm256_max_ps(t0, t1), exit);
+		t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.MinZ), oz), iz);
+		t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(boxes.MaxZ), oz), iz);
+		enter = _mm256_max_ps(_mm256_min_ps(t0, t1), enter);
+		exit = _mm256_min_ps(_mm256_max_ps(t0, t1), exit);
+		if (hitDistances != nullptr)
+			_mm256_storeu_ps(hitDistances, enter);
+		return _mm256_movemask_ps(_mm256_cmp_ps(enter, exit, _CMP_LE_OQ));
+	}
+	MATH_TARGET_AVX inline int RayPacketIntersectsAABB8(const AABB3f& box, const RayPacket8& rays, float* hitDistances)noexcept
+	{
+		__m256 enter = _mm256_load_ps(rays.TMin), exit = _mm256_load_ps(rays.TMax);
+		__m256 t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Min.X), _mm256_load_ps(rays.OriginX)), _mm256_load_ps(rays.InvDirectionX));
+		__m256 t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Max.X), _mm256_load_ps(rays.OriginX)), _mm256_load_ps(rays.InvDirectionX));
+		enter = _mm256_max_ps(_mm256_min_ps(t0, t1), enter);
+		exit = _mm256_min_ps(_mm256_max_ps(t0, t1), exit);
+		t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Min.Y), _mm256_load_ps(rays.OriginY)), _mm256_load_ps(rays.InvDirectionY));
+		t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Max.Y), _mm256_load_ps(rays.OriginY)), _mm256_load_ps(rays.InvDirectionY));
+		enter = _mm256_max_ps(_mm256_min_ps(t0, t1), enter);
+		exit = _mm256_min_ps(_mm256_max_ps(t0, t1), exit);
+		t0 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Min.Z), _mm256_load_ps(rays.OriginZ)), _mm256_load_ps(rays.InvDirectionZ));
+		t1 = _mm256_mul_ps(_mm256_sub_ps(_mm256_set1_ps(box.Max.Z), _mm256_load_ps(rays.OriginZ)), _mm256_load_ps(rays.InvDirectionZ));
+		enter = _mm256_max_ps(_mm256_min_ps(t0, t1), enter);
+		exit = _mm256_min_ps(_mm256_max_ps(t0, t1), exit);
+		if (hitDistances != nullptr)
+			_mm256_storeu_ps(hitDistances, enter);
+		return _mm256_movemask_ps(_mm256_cmp_ps(enter, exit, _CMP_LE_OQ));
+	}
+}
+
+namespace greaper::math
+{
+	template<class T>
+	INLINE constexpr bool AABB3Real<T>::RayIntersects(const Vector3Real<T>& origin, const Vector3Real<T>& invDirection, T tMin, T tMax, T* hitDistance)const noexcept
+	{
+#if MATH_USE_OPTIMIZATIONS
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				float distance;
+				const bool hit = SSE::RayIntersectsAABB(_mm_setr_ps(origin.X, origin.Y, origin.Z, origin.X), _mm_setr_ps(invDirection.X, invDirection.Y, invDirection.Z, invDirection.X),
+					_mm_setr_ps(Min.X, Min.Y, Min.Z, Min.X), _mm_setr_ps(Max.X, Max.Y, Max.Z, Max.X), tMin, tMax, distance);
+				if (hit && hitDistance != nullptr)
+					*hitDistance = distance;
+				return hit;
+			}
+		}
+#endif
+		T enter = tMin, exit = tMax;
+		Impl::SlabStep(Min.X, Max.X, origin.X, invDirection.X, enter, exit);
+		Impl::SlabStep(Min.Y, Max.Y, origin.Y, invDirection.Y, enter, exit);
+		Impl::SlabStep(Min.Z, Max.Z, origin.Z, invDirection.Z, enter, exit);
+		if (!(enter <= exit))
+			return false;
+		if (hitDistance != nullptr)
+			*hitDistance = enter;
+		return true;
+	}
+
+	/* Bit i of the result is set when the ray enters box i inside [tMin, tMax], same results as AABB3f::RayIntersects.
+	 * hitDistances, when given, gets Count entry distances, only meaningful for the boxes that were hit. */
+	NODISCARD INLINE uint32 RayIntersects(const AABB3x4f& boxes, const Vector3f& origin, const Vector3f& invDirection, float tMin, float tMax, float* hitDistances = nullptr)noexcept
+	{
+		return static_cast<uint32>(SSE::RayIntersectsAABB4(boxes.MinX, boxes.MinY, boxes.MinZ, boxes.MaxX, boxes.MaxY, boxes.MaxZ, origin, invDirection, tMin, tMax, hitDistances));
+	}
+	NODISCARD INLINE uint32 RayIntersects(const AABB3x8f& boxes, const Vector3f& origin, const Vector3f& invDirection, float tMin, float tMax, float* hitDistances = nullptr)noexcept
+	{
+		if (GetSIMDLevel() >= SIMDLevel_t::AVX2)
+			return static_cast<uint32>(AVX::RayIntersectsAABB8(boxes, origin, invDirection, tMin, tMax, hitDistances));
+		const int lo = SSE::RayIntersectsAABB4(boxes.MinX, boxes.MinY, boxes.MinZ, boxes.MaxX, boxes.MaxY, boxes.MaxZ, origin, invDirection, tMin, tMax, hitDistances);
+		const int hi = SSE::RayIntersectsAABB4(boxes.MinX + 4, boxes.MinY + 4, boxes.MinZ + 4, boxes.MaxX + 4, boxes.MaxY + 4, boxes.MaxZ + 4, origin, invDirection, tMin, tMax,
+			hitDistances != nullptr ? hitDistances + 4 : nullptr);
+		return static_cast<uint32>(lo | (hi << 4));
+	}
+
+	/* Bit i is set when ray i enters the box inside its [TMin, TMax], each lane matches AABB3f::RayIntersects */
+	NODISCARD INLINE uint32 RayIntersects(const AABB3f& box, const RayPacket4& rays, float* hitDistances = nullptr)noexcept
+	{
+		return static_cast<uint32>(SSE::RayPacketIntersectsAABB4(box, rays, 0, hitDistances));
+	}
+	NODISCARD INLINE uint32 RayIntersects(const AABB3f& box, const RayPacket8& rays, float* hitDistances = nullptr)noexcept
+	{
+		if (GetSIMDLevel() >= SIMDLevel_t::AVX2)
+			return static_cast<uint32>(AVX::RayPacketIntersectsAABB8(box, rays, hitDistances));
+		const int lo = SSE::RayPacketIntersectsAABB4(box, rays, 0, hitDistances);
+		const int hi = SSE::RayPacketIntersectsAABB4(box, rays, 4, hitDistances != nullptr ? hitDistances + 4 : nullptr);
+		return static_cast<uint32>(lo | (hi << 4));
+	}
+}
+
+namespace std
+{
+	template<class T>
+	struct hash<greaper::math::AABB3Real<T>>
+	{
+		NODISCARD INLINE size_t operator()(const greaper::math::AABB3Real<T>& b)const noexcept
+		{
+			return ComputeHash(b.Min, b.Max);
+		}
+	};
+	template<class T>
+	struct hash<greaper::math::AABB2Real<T>>
+	{
+		NODISCARD INLINE size_t operator()(const greaper::math::AABB2Real<T>& b)const noexcept
+		{
+			return ComputeHash(b.Min, b.Max);
+		}
+	};
+}
+
+#endif /* MATH_AABB_H */
\ No newline at end of file
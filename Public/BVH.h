@@ -0,0 +1,1023 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_BVH_H
+#define MATH_BVH_H 1
+
+#include "MathPrerequisites.h"
+#include "AABB.h"
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <bit>
+
+namespace greaper::math
+{
+	/* Nodes are stored depth first, the first child of an inner node is always the next node */
+	struct alignas(32) BVHNode
+	{
+		Vector3f Min;
+		uint32 Offset = 0; // Leaf: first entry in the primitive indices, inner: index of the second child
+		Vector3f Max;
+		uint32 Count = 0; // Primitives in the leaf, 0 for inner nodes
+
+		NODISCARD INLINE constexpr bool IsLeaf()const noexcept { return Count != 0; }
+		NODISCARD INLINE constexpr AABB3f GetBounds()const noexcept { return { Min, Max }; }
+	};
+	static_assert(sizeof(BVHNode) == 32, "BVHNode must fill half a cache line");
+
+	struct BVHBuildSettings
+	{
+		uint32 MaxLeafSize = 4;
+		uint32 BinCount = 16; // Up to BVH::MAX_BIN_COUNT
+		float TraversalCost = 1.f;
+		float IntersectionCost = 1.f;
+		uint32 ThreadCount = 1; // 0 uses every hardware thread
+		uint32 MinTaskSize = 4096; // Smaller subtrees are built by the thread that split them
+	};
+
+	struct BVHHit
+	{
+		uint32 Primitive = std::numeric_limits<uint32>::max();
+		float Distance = std::numeric_limits<float>::infinity();
+
+		NODISCARD INLINE constexpr bool IsHit()const noexcept { return Primitive != std::numeric_limits<uint32>::max(); }
+	};
+
+	struct BVHClosestPoint
+	{
+		uint32 Primitive = std::numeric_limits<uint32>::max();
+		Vector3f Point;
+		float DistanceSquared = std::numeric_limits<float>::infinity();
+
+		NODISCARD INLINE constexpr bool IsFound()const noexcept { return Primitive != std::numeric_limits<uint32>::max(); }
+	};
+
+	namespace Impl
+	{
+		/* Visitors may return void or false to stop the query */
+		template<class Fn>
+		INLINE bool InvokeBVHVisitor(Fn& fn, uint32 primitive)
+		{
+			if constexpr (std::is_void_v<std::invoke_result_t<Fn&, uint32>>)
+			{
+				fn(primitive);
+				return true;
+			}
+			else
+			{
+				return static_cast<bool>(fn(primitive));
+			}
+		}
+		/* Min and Max are 16 byte aligned, the fourth lane would get the Offset/Count bits, which read as denormals
+		 * and slow every test down, so it repeats X like the origin does */
+		INLINE bool RayIntersectsBVHNode(const BVHNode& node, SSE::Vector4f origin, SSE::Vector4f invDirection, float tMin, float tMax, float& hitDistance)noexcept
+		{
+			return SSE::RayIntersectsAABB(origin, invDirection, SSE::Swizzle<0, 1, 2, 0>(_mm_load_ps(&node.Min.X)),
+				SSE::Swizzle<0, 1, 2, 0>(_mm_load_ps(&node.Max.X)), tMin, tMax, hitDistance);
+		}
+		/* Clamped as float before the conversion, the way _mm_min_ps does it, so NaN and huge centroids land in the
+		 * last bin instead of hitting an out of range conversion */
+		INLINE uint32 GetBVHBin(float centroid, float centroidMin, float scale, uint32 binCount)noexcept
+		{
+			const float bin = (centroid - centroidMin) * scale;
+			const float lastBin = static_cast<float>(binCount - 1);
+			return static_cast<uint32>(bin < lastBin ? bin : lastBin);
+		}
+		/* Half the surface area, the fourth lane is ignored */
+		INLINE float GetBVHHalfArea(SSE::Vector4f min, SSE::Vector4f max)noexcept
+		{
+			const SSE::Vector4f d = _mm_sub_ps(max, min);
+			const SSE::Vector4f p = _mm_mul_ps(d, SSE::Swizzle<1, 2, 0, 3>(d));
+			return _mm_cvtss_f32(_mm_add_ss(_mm_add_ss(p, SSE::Swizzle<1, 1, 1, 1>(p)), SSE::Swizzle<2, 2, 2, 2>(p)));
+		}
+		/* Every worker pops its own newest task and steals the oldest one of the others, in a top-down build
+		 * the oldest tasks are the biggest subtrees so a steal moves as much work as possible. */
+		template<class Task>
+		class WorkStealingPool
+		{
+			struct alignas(64) Queue
+			{
+				std::mutex Mutex;
+				std::deque<Task> Tasks;
+			};
+
+		public:
+			INLINE explicit WorkStealingPool(uint32 workerCount)
+				:m_Queues(std::make_unique<Queue[]>(workerCount)), m_WorkerCount(workerCount) {  }
+
+			/* Safe to call from inside a running task */
+			INLINE void Push(uint32 worker, const Task& task)
+			{
+				m_Pending.fetch_add(1, std::memory_order_relaxed);
+				std::lock_guard<std::mutex> lock(m_Queues[worker].Mutex);
+				m_Queues[worker].Tasks.push_back(task);
+			}
+			/* execute(uint32 worker, const Task&), returns once every task and the ones they pushed are done */
+			template<class Fn>
+			INLINE void Run(Fn&& execute)
+			{
+				std::vector<std::thread> threads;
+				threads.reserve(m_WorkerCount - 1);
+				for (uint32 worker = 1; worker < m_WorkerCount; ++worker)
+					threads.emplace_back([this, worker, &execute]() { WorkerLoop(worker, execute); });
+				WorkerLoop(0, execute);
+				for (std::thread& thread : threads)
+					thread.join();
+			}
+
+		private:
+			INLINE bool TryPop(uint32 worker, Task& task)
+			{
+				std::lock_guard<std::mutex> lock(m_Queues[worker].Mutex);
+				if (m_Queues[worker].Tasks.empty())
+					return false;
+				task = m_Queues[worker].Tasks.back();
+				m_Queues[worker].Tasks.pop_back();
+				return true;
+			}
+			INLINE bool TrySteal(uint32 worker, Task& task)
+			{
+				for (uint32 i = 1; i < m_WorkerCount; ++i)
+				{
+					Queue& victim = m_Queues[(worker + i) % m_WorkerCount];
+					std::lock_guard<std::mutex> lock(victim.Mutex);
+					if (victim.Tasks.empty())
+						continue;
+					task = victim.Tasks.front();
+					victim.Tasks.pop_front();
+					return true;
+				}
+				return false;
+			}
+			template<class Fn>
+			INLINE void WorkerLoop(uint32 worker, Fn& execute)
+			{
+				Task task;
+				while (m_Pending.load(std::memory_order_acquire) != 0)
+				{
+					if (TryPop(worker, task) || TrySteal(worker, task))
+					{
+						execute(worker, task);
+						m_Pending.fetch_sub(1, std::memory_order_acq_rel);
+					}
+					else
+					{
+						std::this_thread::yield();
+					}
+				}
+			}
+
+			std::unique_ptr<Queue[]> m_Queues;
+			uint32 m_WorkerCount;
+			std::atomic<uint32> m_Pending = 0;
+		};
+
+		/* The builder partitions these instead of indices, so every pass walks memory in order */
+		struct BVHBuildPrimitive
+		{
+			AABB3f Bounds;
+			Vector3f Centroid;
+			uint32 Index;
+		};
+		INLINE AABB3f GetTriangleBounds(std::span<const Vector3f> vertices, std::span<const uint32> indices, uint32 triangle)noexcept
+		{
+			AABB3f bounds(vertices[indices[triangle * 3]], vertices[indices[triangle * 3]]);
+			bounds.Merge(vertices[indices[triangle * 3 + 1]]);
+			bounds.Merge(vertices[indices[triangle * 3 + 2]]);
+			return bounds;
+		}
+	}
+
+	/* Binary bounding volume hierarchy built with binned SAH, it only stores the tree and the primitive order,
+	 * queries call back with primitive indices so the same tree serves boxes, triangles or anything else. */
+	class BVH
+	{
+	public:
+		static constexpr uint32 MAX_DEPTH = 64;
+		static constexpr uint32 MAX_BIN_COUNT = 32;
+
+		BVH()noexcept = default;
+
+		/* One box per primitive */
+		INLINE void Build(std::span<const AABB3f> primitiveBounds, const BVHBuildSettings& settings = {});
+		/* Three vertex indices per triangle, primitive i is the triangle starting at indices[i * 3] */
+		INLINE void Build(std::span<const Vector3f> vertices, std::span<const uint32> indices, const BVHBuildSettings& settings = {});
+
+		/* Recomputes every node bounds bottom-up after the primitives moved, the tree shape is kept so its quality degrades with large motions */
+		INLINE void Refit(std::span<const AABB3f> primitiveBounds);
+		INLINE void Refit(std::span<const Vector3f> vertices, std::span<const uint32> indices);
+		/* Same but only the leaves holding changedPrimitives and their ancestors are visited, every other subtree is skipped */
+		INLINE void Refit(std::span<const AABB3f> primitiveBounds, std::span<const uint32> changedPrimitives);
+		INLINE void Refit(std::span<const Vector3f> vertices, std::span<const uint32> indices, std::span<const uint32> changedPrimitives);
+
+		INLINE void Clear()noexcept
+		{
+			m_Nodes.clear();
+			m_PrimitiveIndices.clear();
+			m_Parents.clear();
+			m_PrimitiveLeaves.clear();
+			m_RefitMarks.clear();
+		}
+		NODISCARD INLINE bool IsEmpty()const noexcept { return m_Nodes.empty(); }
+		NODISCARD INLINE std::span<const BVHNode> GetNodes()const noexcept { return m_Nodes; }
+		NODISCARD INLINE std::span<const uint32> GetPrimitiveIndices()const noexcept { return m_PrimitiveIndices; }
+		NODISCARD INLINE AABB3f GetBounds()const noexcept { return m_Nodes.empty() ? AABB3f::EMPTY : m_Nodes[0].GetBounds(); }
+
+		/* intersect(uint32 primitive, float& distance) -> bool, on a hit closer than distance it must update it and return true.
+		 * Children are visited front to back and subtrees further than the current hit are skipped. */
+		template<class Fn>
+		NODISCARD INLINE BVHHit ClosestHit(const Vector3f& origin, const Vector3f& direction, float tMin, float tMax, Fn&& intersect)const;
+		/* intersect(uint32 primitive, float distance) -> bool, the traversal stops at the first primitive that returns true */
+		template<class Fn>
+		NODISCARD INLINE bool AnyHit(const Vector3f& origin, const Vector3f& direction, float tMin, float tMax, Fn&& intersect)const;
+
+		/* Packet traversal, a node is entered while any ray of the packet still hits it.
+		 * intersect(uint32 primitive, RayPacket<N>& rays, uint32 rayMask) -> uint32, it must lower rays.TMax of the rays in rayMask that hit
+		 * the primitive closer and return their mask. Rays with TMin > TMax are inactive, hits[i] ends with the closest hit of ray i. */
+		template<sizet N, class Fn>
+		INLINE void ClosestHit(RayPacket<N>& rays, BVHHit (&hits)[N], Fn&& intersect)const;
+		/* intersect(uint32 primitive, const RayPacket<N>& rays, uint32 rayMask) -> uint32 with the occluded rays, returns every occluded ray */
+		template<sizet N, class Fn>
+		NODISCARD INLINE uint32 AnyHit(const RayPacket<N>& rays, Fn&& intersect)const;
+
+		/* visitor(uint32 primitive) gets every primitive in a leaf whose bounds overlap, the exact test is up to the caller */
+		template<class Fn>
+		INLINE void QueryOverlaps(const AABB3f& box, Fn&& visitor)const;
+		template<class Fn>
+		INLINE void QueryOverlaps(const Vector3f& center, float radius, Fn&& visitor)const;
+
+		/* closestOnPrimitive(uint32 primitive, const Vector3f& point) -> Vector3f, only primitives nearer than maxDistance are considered */
+		template<class Fn>
+		NODISCARD INLINE BVHClosestPoint ClosestPoint(const Vector3f& point, Fn&& closestOnPrimitive, float maxDistance = std::numeric_limits<float>::infinity())const;
+
+	private:
+		struct BuildTask
+		{
+			uint32 Begin;
+			uint32 End;
+			uint32 Parent; // Only set for second children, first ones are right after their parent
+			uint32 Depth;
+		};
+		struct Split
+		{
+			uint32 Axis = 0;
+			uint32 Bin = 0;
+			float CentroidMin = 0.f;
+			float Scale = 0.f;
+			float Cost = std::numeric_limits<float>::infinity();
+		};
+		struct StackEntry
+		{
+			uint32 Node;
+			float Distance;
+		};
+
+		/* Only used while building in parallel, the second child is the root of the node fragment given by Offset */
+		static constexpr uint32 FRAGMENT_LINK = std::numeric_limits<uint32>::max();
+		struct ParallelTask
+		{
+			uint32 Begin;
+			uint32 End;
+			uint32 Depth;
+			uint32 Fragment;
+		};
+
+		INLINE void BuildRange(std::span<Impl::BVHBuildPrimitive> primitives, const BVHBuildSettings& settings);
+		INLINE void BuildRangeParallel(std::span<Impl::BVHBuildPrimitive> primitives, const BVHBuildSettings& settings, uint32 threadCount);
+		/* spawn(begin, end, depth) -> uint32 takes the second child away and returns its fragment, or FRAGMENT_LINK to keep building it here */
+		template<class Fn>
+		INLINE static void BuildSubtree(std::span<Impl::BVHBuildPrimitive> primitives, const BVHBuildSettings& settings, uint32 begin, uint32 end, uint32 depth,
+			std::vector<BVHNode>& nodes, Fn&& spawn);
+		NODISCARD INLINE static AABB3f ComputeBounds(std::span<const Impl::BVHBuildPrimitive> primitives, AABB3f& centroidBounds)noexcept;
+		NODISCARD INLINE static Split FindSplit(std::span<const Impl::BVHBuildPrimitive> primitives, const AABB3f& bounds, const AABB3f& centroidBounds,
+			const BVHBuildSettings& settings);
+
+		/* getBounds(uint32 primitive) -> AABB3f */
+		template<class Fn>
+		INLINE void RefitAll(Fn&& getBounds);
+		template<class Fn>
+		INLINE void RefitChanged(std::span<const uint32> changedPrimitives, Fn&& getBounds);
+		template<class Fn>
+		INLINE void RefitNode(uint32 nodeIndex, Fn& getBounds);
+
+		std::vector<BVHNode> m_Nodes;
+		std::vector<uint32> m_PrimitiveIndices;
+		// Filled by the first partial refit
+		std::vector<uint32> m_Parents;
+		std::vector<uint32> m_PrimitiveLeaves;
+		std::vector<uint8> m_RefitMarks;
+	};
+
+	INLINE void BVH::Build(std::span<const AABB3f> primitiveBounds, const BVHBuildSettings& settings)
+	{
+		VerifyLessEqual(settings.BinCount, MAX_BIN_COUNT, "Trying to build a BVH with %u bins, but only up to %u are supported.", settings.BinCount, MAX_BIN_COUNT);
+		std::vector<Impl::BVHBuildPrimitive> primitives(primitiveBounds.size());
+		for (sizet i = 0; i < primitiveBounds.size(); ++i)
+			primitives[i] = { primitiveBounds[i], primitiveBounds[i].GetCenter(), static_cast<uint32>(i) };
+		BuildRange(primitives, settings);
+	}
+
+	INLINE void BVH::Build(std::span<const Vector3f> vertices, std::span<const uint32> indices, const BVHBuildSettings& settings)
+	{
+		VerifyEqual(indices.size() % 3, 0, "Trying to build a BVH from triangles, but the index count %" PRIuPTR " is not a multiple of 3.", indices.size());
+		std::vector<AABB3f> bounds(indices.size() / 3);
+		for (sizet i = 0; i < bounds.size(); ++i)
+			bounds[i] = Impl::GetTriangleBounds(vertices, indices, static_cast<uint32>(i));
+		Build(bounds, settings);
+	}
+
+	INLINE void BVH::BuildRange(std::span<Impl::BVHBuildPrimitive> primitives, const BVHBuildSettings& settings)
+	{
+		const auto count = static_cast<uint32>(primitives.size());
+		Clear();
+		if (count == 0)
+			return;
+
+		const uint32 threadCount = settings.ThreadCount != 0 ? settings.ThreadCount : std::max(std::thread::hardware_concurrency(), 1u);
+		if (threadCount > 1 && count > settings.MinTaskSize)
+		{
+			BuildRangeParallel(primitives, settings, threadCount);
+		}
+		else
+		{
+			m_Nodes.reserve(count * 2 - 1);
+			BuildSubtree(primitives, settings, 0, count, 0, m_Nodes, [](uint32, uint32, uint32) { return FRAGMENT_LINK; });
+		}
+
+		m_PrimitiveIndices.resize(count);
+		for (uint32 i = 0; i < count; ++i)
+			m_PrimitiveIndices[i] = primitives[i].Index;
+	}
+
+	INLINE void BVH::BuildRangeParallel(std::span<Impl::BVHBuildPrimitive> primitives, const BVHBuildSettings& settings, uint32 threadCount)
+	{
+		// Subtrees are built into separate fragments, then stitched in depth first order
+		std::deque<std::vector<BVHNode>> fragments;
+		std::mutex fragmentsMutex;
+		fragments.emplace_back();
+
+		Impl::WorkStealingPool<ParallelTask> pool(threadCount);
+		pool.Push(0, { 0, static_cast<uint32>(primitives.size()), 0, 0 });
+		pool.Run([&](uint32 worker, const ParallelTask& task)
+			{
+				std::vector<BVHNode>* nodes;
+				{
+					std::lock_guard<std::mutex> lock(fragmentsMutex);
+					nodes = &fragments[task.Fragment];
+				}
+				BuildSubtree(primitives, settings, task.Begin, task.End, task.Depth, *nodes, [&](uint32 begin, uint32 end, uint32 depth)
+					{
+						if (end - begin < settings.MinTaskSize)
+							return FRAGMENT_LINK;
+						uint32 fragment;
+						{
+							std::lock_guard<std::mutex> lock(fragmentsMutex);
+							fragment = static_cast<uint32>(fragments.size());
+							fragments.emplace_back();
+						}
+						pool.Push(worker, { begin, end, depth, fragment });
+						return fragment;
+					});
+			});
+
+		sizet nodeCount = 0;
+		for (const std::vector<BVHNode>& fragment : fragments)
+			nodeCount += fragment.size();
+		m_Nodes.reserve(nodeCount);
+
+		struct StitchEntry
+		{
+			uint32 Fragment;
+			uint32 Node;
+			uint32 Parent;
+		};
+		std::vector<StitchEntry> stack;
+		stack.push_back({ 0, 0, std::numeric_limits<uint32>::max() });
+		while (!stack.empty())
+		{
+			const StitchEntry entry = stack.back();
+			stack.pop_back();
+
+			const auto nodeIndex = static_cast<uint32>(m_Nodes.size());
+			if (entry.Parent != std::numeric_limits<uint32>::max())
+				m_Nodes[entry.Parent].Offset = nodeIndex;
+			BVHNode node = fragments[entry.Fragment][entry.Node];
+			if (node.IsLeaf() && node.Count != FRAGMENT_LINK)
+			{
+				m_Nodes.push_back(node);
+				continue;
+			}
+			if (node.Count == FRAGMENT_LINK)
+			{
+				stack.push_back({ node.Offset, 0, nodeIndex });
+				node.Count = 0;
+			}
+			else
+			{
+				stack.push_back({ entry.Fragment, node.Offset, nodeIndex });
+			}
+			m_Nodes.push_back(node);
+			stack.push_back({ entry.Fragment, entry.Node + 1, std::numeric_limits<uint32>::max() });
+		}
+	}
+
+	template<class Fn>
+	INLINE void BVH::BuildSubtree(std::span<Impl::BVHBuildPrimitive> primitives, const BVHBuildSettings& settings, uint32 begin, uint32 end, uint32 depth,
+		std::vector<BVHNode>& nodes, Fn&& spawn)
+	{
+		std::vector<BuildTask> tasks;
+		tasks.push_back({ begin, end, std::numeric_limits<uint32>::max(), depth });
+		while (!tasks.empty())
+		{
+			const BuildTask task = tasks.back();
+			tasks.pop_back();
+
+			const auto nodeIndex = static_cast<uint32>(nodes.size());
+			if (task.Parent != std::numeric_limits<uint32>::max())
+				nodes[task.Parent].Offset = nodeIndex;
+
+			AABB3f centroidBounds;
+			const AABB3f bounds = ComputeBounds(primitives.subspan(task.Begin, task.End - task.Begin), centroidBounds);
+			BVHNode& node = nodes.emplace_back();
+			node.Min = bounds.Min;
+			node.Max = bounds.Max;
+
+			const uint32 primCount = task.End - task.Begin;
+			const float leafCost = settings.IntersectionCost * static_cast<float>(primCount);
+			uint32 middle = task.Begin;
+			if (primCount > 1 && task.Depth + 1 < MAX_DEPTH)
+			{
+				const Split split = FindSplit(primitives.subspan(task.Begin, primCount), bounds, centroidBounds, settings);
+				if (split.Cost < leafCost || primCount > settings.MaxLeafSize)
+				{
+					if (split.Cost < std::numeric_limits<float>::infinity())
+					{
+						const auto it = std::partition(primitives.begin() + task.Begin, primitives.begin() + task.End,
+							[&](const Impl::BVHBuildPrimitive& prim) { return Impl::GetBVHBin(prim.Centroid[split.Axis], split.CentroidMin, split.Scale, settings.BinCount) <= split.Bin; });
+						middle = static_cast<uint32>(it - primitives.begin());
+					}
+					else
+					{
+						// Every centroid is in the same spot, any halving is as good as another
+						middle = task.Begin + primCount / 2;
+					}
+				}
+			}
+			if (middle == task.Begin)
+			{
+				nodes[nodeIndex].Offset = task.Begin;
+				nodes[nodeIndex].Count = primCount;
+				continue;
+			}
+			const uint32 fragment = spawn(middle, task.End, task.Depth + 1);
+			if (fragment != FRAGMENT_LINK)
+			{
+				nodes[nodeIndex].Offset = fragment;
+				nodes[nodeIndex].Count = FRAGMENT_LINK;
+			}
+			else
+			{
+				tasks.push_back({ middle, task.End, nodeIndex, task.Depth + 1 });
+			}
+			tasks.push_back({ task.Begin, middle, std::numeric_limits<uint32>::max(), task.Depth + 1 });
+		}
+	}
+
+	INLINE AABB3f BVH::ComputeBounds(std::span<const Impl::BVHBuildPrimitive> primitives, AABB3f& centroidBounds)noexcept
+	{
+		SSE::Vector4f boundsMin = _mm_set1_ps(std::numeric_limits<float>::max()), boundsMax = _mm_set1_ps(std::numeric_limits<float>::lowest());
+		SSE::Vector4f centroidMin = boundsMin, centroidMax = boundsMax;
+		for (const Impl::BVHBuildPrimitive& prim : primitives)
+		{
+			const SSE::Vector4f centroid = _mm_loadu_ps(&prim.Centroid.X);
+			boundsMin = _mm_min_ps(boundsMin, _mm_loadu_ps(&prim.Bounds.Min.X));
+			boundsMax = _mm_max_ps(boundsMax, _mm_loadu_ps(&prim.Bounds.Max.X));
+			centroidMin = _mm_min_ps(centroidMin, centroid);
+			centroidMax = _mm_max_ps(centroidMax, centroid);
+		}
+		alignas(16) float values[4][4];
+		_mm_store_ps(values[0], boundsMin);
+		_mm_store_ps(values[1], boundsMax);
+		_mm_store_ps(values[2], centroidMin);
+		_mm_store_ps(values[3], centroidMax);
+		centroidBounds = { Vector3f(values[2][0], values[2][1], values[2][2]), Vector3f(values[3][0], values[3][1], values[3][2]) };
+		return { Vector3f(values[0][0], values[0][1], values[0][2]), Vector3f(values[1][0], values[1][1], values[1][2]) };
+	}
+
+	INLINE BVH::Split BVH::FindSplit(std::span<const Impl::BVHBuildPrimitive> primitives, const AABB3f& bounds, const AABB3f& centroidBounds,
+		const BVHBuildSettings& settings)
+	{
+		const uint32 binCount = settings.BinCount;
+		const float area = Impl::GetBVHHalfArea(_mm_setr_ps(bounds.Min.X, bounds.Min.Y, bounds.Min.Z, 0.f), _mm_setr_ps(bounds.Max.X, bounds.Max.Y, bounds.Max.Z, 0.f));
+		const float invArea = area > 0.f ? 1.f / area : 0.f;
+
+		alignas(16) float scales[4] = {};
+		for (uint32 axis = 0; axis < 3; ++axis)
+		{
+			const float extent = centroidBounds.Max[axis] - centroidBounds.Min[axis];
+			scales[axis] = extent > 0.f ? static_cast<float>(binCount) / extent : 0.f;
+		}
+
+		// A single pass bins the three axes, the bin math matches Impl::GetBVHBin lane by lane
+		SSE::Vector4f binMin[3][MAX_BIN_COUNT], binMax[3][MAX_BIN_COUNT];
+		uint32 binCounts[3][MAX_BIN_COUNT] = {};
+		const SSE::Vector4f emptyMin = _mm_set1_ps(std::numeric_limits<float>::max());
+		const SSE::Vector4f emptyMax = _mm_set1_ps(std::numeric_limits<float>::lowest());
+		for (uint32 axis = 0; axis < 3; ++axis)
+		{
+			std::fill_n(binMin[axis], binCount, emptyMin);
+			std::fill_n(binMax[axis], binCount, emptyMax);
+		}
+		const SSE::Vector4f centroidMin = _mm_setr_ps(centroidBounds.Min.X, centroidBounds.Min.Y, centroidBounds.Min.Z, 0.f);
+		const SSE::Vector4f scale = _mm_load_ps(scales);
+		const SSE::Vector4f lastBin = _mm_set1_ps(static_cast<float>(binCount - 1));
+		for (const Impl::BVHBuildPrimitive& prim : primitives)
+		{
+			// The fourth lanes read the next member, they are never used and the centroid one repeats X so the
+			// Index bits never reach the arithmetic as denormals
+			const SSE::Vector4f primMin = _mm_loadu_ps(&prim.Bounds.Min.X);
+			const SSE::Vector4f primMax = _mm_loadu_ps(&prim.Bounds.Max.X);
+			alignas(16) int32 bins[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(bins), _mm_cvttps_epi32(_mm_min_ps(_mm_mul_ps(_mm_sub_ps(SSE::Swizzle<0, 1, 2, 0>(_mm_loadu_ps(&prim.Centroid.X)), centroidMin), scale), lastBin)));
+			for (uint32 axis = 0; axis < 3; ++axis)
+			{
+				const uint32 bin = static_cast<uint32>(bins[axis]);
+				binMin[axis][bin] = _mm_min_ps(binMin[axis][bin], primMin);
+				binMax[axis][bin] = _mm_max_ps(binMax[axis][bin], primMax);
+				++binCounts[axis][bin];
+			}
+		}
+
+		Split best;
+		for (uint32 axis = 0; axis < 3; ++axis)
+		{
+			if (scales[axis] == 0.f)
+				continue;
+
+			float rightAreas[MAX_BIN_COUNT];
+			uint32 rightCounts[MAX_BIN_COUNT];
+			SSE::Vector4f rightMin = emptyMin, rightMax = emptyMax;
+			uint32 rightCount = 0;
+			for (uint32 i = binCount - 1; i > 0; --i)
+			{
+				rightMin = _mm_min_ps(rightMin, binMin[axis][i]);
+				rightMax = _mm_max_ps(rightMax, binMax[axis][i]);
+				rightCount += binCounts[axis][i];
+				rightAreas[i] = Impl::GetBVHHalfArea(rightMin, rightMax);
+				rightCounts[i] = rightCount;
+			}
+
+			SSE::Vector4f leftMin = emptyMin, leftMax = emptyMax;
+			uint32 leftCount = 0;
+			for (uint32 i = 0; i + 1 < binCount; ++i)
+			{
+				leftMin = _mm_min_ps(leftMin, binMin[axis][i]);
+				leftMax = _mm_max_ps(leftMax, binMax[axis][i]);
+				leftCount += binCounts[axis][i];
+				if (leftCount == 0 || rightCounts[i + 1] == 0)
+					continue;
+				const float cost = settings.TraversalCost + settings.IntersectionCost * invArea
+					* (Impl::GetBVHHalfArea(leftMin, leftMax) * static_cast<float>(leftCount) + rightAreas[i + 1] * static_cast<float>(rightCounts[i + 1]));
+				if (cost < best.Cost)
+				{
+					best.Axis = axis;
+					best.Bin = i;
+					best.CentroidMin = centroidBounds.Min[axis];
+					best.Scale = scales[axis];
+					best.Cost = cost;
+				}
+			}
+		}
+		return best;
+	}
+
+	INLINE void BVH::Refit(std::span<const AABB3f> primitiveBounds)
+	{
+		RefitAll([primitiveBounds](uint32 prim) { return primitiveBounds[prim]; });
+	}
+
+	INLINE void BVH::Refit(std::span<const Vector3f> vertices, std::span<const uint32> indices)
+	{
+		RefitAll([vertices, indices](uint32 prim) { return Impl::GetTriangleBounds(vertices, indices, prim); });
+	}
+
+	INLINE void BVH::Refit(std::span<const AABB3f> primitiveBounds, std::span<const uint32> changedPrimitives)
+	{
+		RefitChanged(changedPrimitives, [primitiveBounds](uint32 prim) { return primitiveBounds[prim]; });
+	}
+
+	INLINE void BVH::Refit(std::span<const Vector3f> vertices, std::span<const uint32> indices, std::span<const uint32> changedPrimitives)
+	{
+		RefitChanged(changedPrimitives, [vertices, indices](uint32 prim) { return Impl::GetTriangleBounds(vertices, indices, prim); });
+	}
+
+	template<class Fn>
+	INLINE void BVH::RefitNode(uint32 nodeIndex, Fn& getBounds)
+	{
+		BVHNode& node = m_Nodes[nodeIndex];
+		AABB3f bounds;
+		if (node.IsLeaf())
+		{
+			bounds = getBounds(m_PrimitiveIndices[node.Offset]);
+			for (uint32 i = 1; i < node.Count; ++i)
+				bounds.Merge(getBounds(m_PrimitiveIndices[node.Offset + i]));
+		}
+		else
+		{
+			bounds = m_Nodes[nodeIndex + 1].GetBounds();
+			bounds.Merge(m_Nodes[node.Offset].GetBounds());
+		}
+		node.Min = bounds.Min;
+		node.Max = bounds.Max;
+	}
+
+	template<class Fn>
+	INLINE void BVH::RefitAll(Fn&& getBounds)
+	{
+		// Children always come after their parent, walking backwards is bottom-up
+		for (auto i = static_cast<uint32>(m_Nodes.size()); i-- > 0; )
+			RefitNode(i, getBounds);
+	}
+
+	template<class Fn>
+	INLINE void BVH::RefitChanged(std::span<const uint32> changedPrimitives, Fn&& getBounds)
+	{
+		if (m_Nodes.empty())
+			return;
+		if (m_Parents.empty())
+		{
+			m_Parents.assign(m_Nodes.size(), std::numeric_limits<uint32>::max());
+			m_PrimitiveLeaves.resize(m_PrimitiveIndices.size());
+			m_RefitMarks.assign(m_Nodes.size(), 0);
+			for (uint32 i = 0; i < static_cast<uint32>(m_Nodes.size()); ++i)
+			{
+				const BVHNode& node = m_Nodes[i];
+				if (node.IsLeaf())
+				{
+					for (uint32 j = 0; j < node.Count; ++j)
+						m_PrimitiveLeaves[m_PrimitiveIndices[node.Offset + j]] = i;
+					continue;
+				}
+				m_Parents[i + 1] = i;
+				m_Parents[node.Offset] = i;
+			}
+		}
+
+		// Mark the touched leaves and their ancestors, the climb stops at the first node another primitive already marked
+		std::vector<uint32> dirty;
+		for (const uint32 prim : changedPrimitives)
+		{
+			VerifyLess(prim, m_PrimitiveLeaves.size(), "Trying to refit a BVH, but the primitive %u is not part of it.", prim);
+			for (uint32 node = m_PrimitiveLeaves[prim]; node != std::numeric_limits<uint32>::max() && m_RefitMarks[node] == 0; node = m_Parents[node])
+			{
+				m_RefitMarks[node] = 1;
+				dirty.push_back(node);
+			}
+		}
+		std::sort(dirty.begin(), dirty.end(), std::greater<uint32>());
+		for (const uint32 node : dirty)
+		{
+			RefitNode(node, getBounds);
+			m_RefitMarks[node] = 0;
+		}
+	}
+
+	template<class Fn>
+	INLINE BVHHit BVH::ClosestHit(const Vector3f& origin, const Vector3f& direction, float tMin, float tMax, Fn&& intersect)const
+	{
+		BVHHit hit;
+		hit.Distance = tMax;
+		float distance;
+		const SSE::Vector4f o = _mm_setr_ps(origin.X, origin.Y, origin.Z, origin.X);
+		const SSE::Vector4f inv = _mm_div_ps(_mm_set1_ps(1.f), _mm_setr_ps(direction.X, direction.Y, direction.Z, direction.X));
+		if (m_Nodes.empty() || !Impl::RayIntersectsBVHNode(m_Nodes[0], o, inv, tMin, hit.Distance, distance))
+			return hit;
+
+		StackEntry stack[MAX_DEPTH];
+		uint32 stackSize = 0;
+		uint32 nodeIndex = 0;
+		for (;;)
+		{
+			const BVHNode& node = m_Nodes[nodeIndex];
+			if (node.IsLeaf())
+			{
+				for (uint32 i = 0; i < node.Count; ++i)
+				{
+					const uint32 prim = m_PrimitiveIndices[node.Offset + i];
+					if (intersect(prim, hit.Distance))
+						hit.Primitive = prim;
+				}
+			}
+			else
+			{
+				uint32 first = nodeIndex + 1, second = node.Offset;
+				float firstDistance, secondDistance;
+				const bool firstHit = Impl::RayIntersectsBVHNode(m_Nodes[first], o, inv, tMin, hit.Distance, firstDistance);
+				const bool secondHit = Impl::RayIntersectsBVHNode(m_Nodes[second], o, inv, tMin, hit.Distance, secondDistance);
+				if (firstHit && secondHit)
+				{
+					if (secondDistance < firstDistance)
+					{
+						std::swap(first, second);
+						std::swap(firstDistance, secondDistance);
+					}
+					stack[stackSize++] = { second, secondDistance };
+					nodeIndex = first;
+					continue;
+				}
+				if (firstHit || secondHit)
+				{
+					nodeIndex = firstHit ? first : second;
+					continue;
+				}
+			}
+			do
+			{
+				if (stackSize == 0)
+					return hit;
+				--stackSize;
+			} while (stack[stackSize].Distance > hit.Distance);
+			nodeIndex = stack[stackSize].Node;
+		}
+	}
+
+	template<class Fn>
+	INLINE bool BVH::AnyHit(const Vector3f& origin, const Vector3f& direction, float tMin, float tMax, Fn&& intersect)const
+	{
+		float distance;
+		const SSE::Vector4f o = _mm_setr_ps(origin.X, origin.Y, origin.Z, origin.X);
+		const SSE::Vector4f inv = _mm_div_ps(_mm_set1_ps(1.f), _mm_setr_ps(direction.X, direction.Y, direction.Z, direction.X));
+		if (m_Nodes.empty() || !Impl::RayIntersectsBVHNode(m_Nodes[0], o, inv, tMin, tMax, distance))
+			return false;
+
+		uint32 stack[MAX_DEPTH];
+		uint32 stackSize = 0;
+		uint32 nodeIndex = 0;
+		for (;;)
+		{
+			const BVHNode& node = m_Nodes[nodeIndex];
+			if (node.IsLeaf())
+			{
+				for (uint32 i = 0; i < node.Count; ++i)
+				{
+					if (intersect(m_PrimitiveIndices[node.Offset + i], tMax))
+						return true;
+				}
+			}
+			else
+			{
+				const uint32 first = nodeIndex + 1, second = node.Offset;
+				const bool firstHit = Impl::RayIntersectsBVHNode(m_Nodes[first], o, inv, tMin, tMax, distance);
+				const bool secondHit = Impl::RayIntersectsBVHNode(m_Nodes[second], o, inv, tMin, tMax, distance);
+				if (firstHit)
+				{
+					if (secondHit)
+						stack[stackSize++] = second;
+					nodeIndex = first;
+					continue;
+				}
+				if (secondHit)
+				{
+					nodeIndex = second;
+					continue;
+				}
+			}
+			if (stackSize == 0)
+				return false;
+			nodeIndex = stack[--stackSize];
+		}
+	}
+
+	template<sizet N, class Fn>
+	INLINE void BVH::ClosestHit(RayPacket<N>& rays, BVHHit (&hits)[N], Fn&& intersect)const
+	{
+		for (sizet i = 0; i < N; ++i)
+			hits[i] = BVHHit{};
+		if (m_Nodes.empty() || RayIntersects(m_Nodes[0].GetBounds(), rays) == 0)
+			return;
+
+		uint32 stack[MAX_DEPTH];
+		uint32 stackSize = 0;
+		uint32 nodeIndex = 0;
+		for (;;)
+		{
+			const BVHNode& node = m_Nodes[nodeIndex];
+			if (node.IsLeaf())
+			{
+				// Earlier hits may have shortened the rays since the node was pushed
+				uint32 rayMask = RayIntersects(node.GetBounds(), rays);
+				for (uint32 i = 0; i < node.Count && rayMask != 0; ++i)
+				{
+					const uint32 prim = m_PrimitiveIndices[node.Offset + i];
+					for (uint32 hitMask = intersect(prim, rays, rayMask) & rayMask; hitMask != 0; hitMask &= hitMask - 1)
+					{
+						const auto ray = static_cast<uint32>(std::countr_zero(hitMask));
+						hits[ray].Primitive = prim;
+						hits[ray].Distance = rays.TMax[ray];
+					}
+				}
+			}
+			else
+			{
+				uint32 first = nodeIndex + 1, second = node.Offset;
+				float firstDistances[N], secondDistances[N];
+				const uint32 firstMask = RayIntersects(m_Nodes[first].GetBounds(), rays, firstDistances);
+				const uint32 secondMask = RayIntersects(m_Nodes[second].GetBounds(), rays, secondDistances);
+				if (firstMask != 0 && secondMask != 0)
+				{
+					// The order is picked for the first ray that hits both, coherent packets tend to agree on it
+					const uint32 bothMask = firstMask & secondMask;
+					if (bothMask != 0)
+					{
+						const auto ray = static_cast<uint32>(std::countr_zero(bothMask));
+						if (secondDistances[ray] < firstDistances[ray])
+							std::swap(first, second);
+					}
+					stack[stackSize++] = second;
+					nodeIndex = first;
+					continue;
+				}
+				if (firstMask != 0 || secondMask != 0)
+				{
+					nodeIndex = firstMask != 0 ? first : second;
+					continue;
+				}
+			}
+			do
+			{
+				if (stackSize == 0)
+					return;
+				--stackSize;
+			} while (!m_Nodes[stack[stackSize]].IsLeaf() && RayIntersects(m_Nodes[stack[stackSize]].GetBounds(), rays) == 0);
+			nodeIndex = stack[stackSize];
+		}
+	}
+
+	template<sizet N, class Fn>
+	INLINE uint32 BVH::AnyHit(const RayPacket<N>& rays, Fn&& intersect)const
+	{
+		constexpr uint32 allRays = (1u << N) - 1u;
+		if (m_Nodes.empty())
+			return 0;
+		uint32 activeMask = RayIntersects(m_Nodes[0].GetBounds(), rays);
+		uint32 occluded = 0;
+		if (activeMask == 0)
+			return 0;
+
+		uint32 stack[MAX_DEPTH];
+		uint32 stackSize = 0;
+		uint32 nodeIndex = 0;
+		for (;;)
+		{
+			const BVHNode& node = m_Nodes[nodeIndex];
+			const uint32 pending = allRays & ~occluded;
+			if (node.IsLeaf())
+			{
+				uint32 rayMask = RayIntersects(node.GetBounds(), rays) & pending;
+				for (uint32 i = 0; i < node.Count && rayMask != 0; ++i)
+				{
+					const uint32 hitMask = intersect(m_PrimitiveIndices[node.Offset + i], rays, rayMask) & rayMask;
+					occluded |= hitMask;
+					rayMask &= ~hitMask;
+				}
+				if ((occluded & activeMask) == activeMask)
+					return occluded;
+			}
+			else
+			{
+				const uint32 first = nodeIndex + 1, second = node.Offset;
+				const bool firstHit = (RayIntersects(m_Nodes[first].GetBounds(), rays) & pending) != 0;
+				const bool secondHit = (RayIntersects(m_Nodes[second].GetBounds(), rays) & pending) != 0;
+				if (firstHit)
+				{
+					if (secondHit)
+						stack[stackSize++] = second;
+					nodeIndex = first;
+					continue;
+				}
+				if (secondHit)
+				{
+					nodeIndex = second;
+					continue;
+				}
+			}
+			if (stackSize == 0)
+				return occluded;
+			nodeIndex = stack[--stackSize];
+		}
+	}
+
+	template<class Fn>
+	INLINE void BVH::QueryOverlaps(const AABB3f& box, Fn&& visitor)const
+	{
+		if (m_Nodes.empty())
+			return;
+		uint32 stack[MAX_DEPTH];
+		uint32 stackSize = 0;
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			const uint32 nodeIndex = stack[--stackSize];
+			const BVHNode& node = m_Nodes[nodeIndex];
+			if (!node.GetBounds().Overlaps(box))
+				continue;
+			if (node.IsLeaf())
+			{
+				for (uint32 i = 0; i < node.Count; ++i)
+				{
+					if (!Impl::InvokeBVHVisitor(visitor, m_PrimitiveIndices[node.Offset + i]))
+						return;
+				}
+				continue;
+			}
+			stack[stackSize++] = node.Offset;
+			stack[stackSize++] = nodeIndex + 1;
+		}
+	}
+
+	template<class Fn>
+	INLINE void BVH::QueryOverlaps(const Vector3f& center, float radius, Fn&& visitor)const
+	{
+		if (m_Nodes.empty())
+			return;
+		uint32 stack[MAX_DEPTH];
+		uint32 stackSize = 0;
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			const uint32 nodeIndex = stack[--stackSize];
+			const BVHNode& node = m_Nodes[nodeIndex];
+			if (!node.GetBounds().OverlapsSphere(center, radius))
+				continue;
+			if (node.IsLeaf())
+			{
+				for (uint32 i = 0; i < node.Count; ++i)
+				{
+					if (!Impl::InvokeBVHVisitor(visitor, m_PrimitiveIndices[node.Offset + i]))
+						return;
+				}
+				continue;
+			}
+			stack[stackSize++] = node.Offset;
+			stack[stackSize++] = nodeIndex + 1;
+		}
+	}
+
+	template<class Fn>
+	INLINE BVHClosestPoint BVH::ClosestPoint(const Vector3f& point, Fn&& closestOnPrimitive, float maxDistance)const
+	{
+		BVHClosestPoint result;
+		result.DistanceSquared = maxDistance * maxDistance;
+		if (m_Nodes.empty())
+			return result;
+
+		StackEntry stack[MAX_DEPTH];
+		uint32 stackSize = 0;
+		stack[stackSize++] = { 0, m_Nodes[0].GetBounds().DistanceSquared(point) };
+		while (stackSize > 0)
+		{
+			const StackEntry entry = stack[--stackSize];
+			if (entry.Distance > result.DistanceSquared)
+				continue;
+			const BVHNode& node = m_Nodes[entry.Node];
+			if (node.IsLeaf())
+			{
+				for (uint32 i = 0; i < node.Count; ++i)
+				{
+					const uint32 prim = m_PrimitiveIndices[node.Offset + i];
+					const Vector3f closest = closestOnPrimitive(prim, point);
+					const float distSq = (closest - point).LengthSquared();
+					if (distSq < result.DistanceSquared || (!result.IsFound() && distSq <= result.DistanceSquared))
+					{
+						result.Primitive = prim;
+						result.Point = closest;
+						result.DistanceSquared = distSq;
+					}
+				}
+				continue;
+			}
+			// The nearest child goes on top so it is visited first
+			StackEntry first = { entry.Node + 1, m_Nodes[entry.Node + 1].GetBounds().DistanceSquared(point) };
+			StackEntry second = { node.Offset, m_Nodes[node.Offset].GetBounds().DistanceSquared(point) };
+			if (first.Distance < second.Distance)
+				std::swap(first, second);
+			stack[stackSize++] = first;
+			stack[stackSize++] = second;
+		}
+		return result;
+	}
+}
+
+#endif /* MATH_BVH_H */
\ No newline at end of file
@@ -0,0 +1,190 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#if COMPILER_MSVC
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+/* Every function carries its target so it can be used after a runtime check, see CPUFeatures.inl */
+namespace greaper::math::AVX
+{
+	using Vector8f = __m256;
+	using Vector4d = __m256d;
+
+	/* Basic functions */
+	MATH_TARGET_AVX INLINE Vector4d CreateV4d()noexcept
+	{
+		return _mm256_setzero_pd();
+	}
+	MATH_TARGET_AVX INLINE Vector4d CreateV4d(double a)noexcept
+	{
+		return _mm256_set1_pd(a);
+	}
+	MATH_TARGET_AVX INLINE Vector4d CreateV4d(double x, double y, double z, double w)noexcept
+	{
+		return _mm256_setr_pd(x, y, z, w);
+	}
+	/* Arithmetic */
+	MATH_TARGET_AVX INLINE Vector4d Add(Vector4d left, Vector4d right)noexcept
+	{
+		return _mm256_add_pd(left, right);
+	}
+	MATH_TARGET_AVX INLINE Vector4d Sub(Vector4d left, Vector4d right)noexcept
+	{
+		return _mm256_sub_pd(left, right);
+	}
+	MATH_TARGET_AVX INLINE Vector4d Mul(Vector4d left, Vector4d right)noexcept
+	{
+		return _mm256_mul_pd(left, right);
+	}
+	MATH_TARGET_AVX INLINE Vector4d Div(Vector4d left, Vector4d right)noexcept
+	{
+		return _mm256_div_pd(left, right);
+	}
+
+	MATH_TARGET_AVX INLINE Vector8f CreateV8f()noexcept
+	{
+		return _mm256_setzero_ps();
+	}
+	MATH_TARGET_AVX INLINE Vector8f CreateV8f(float a)noexcept
+	{
+		return _mm256_set1_ps(a);
+	}
+	MATH_TARGET_AVX INLINE Vector8f Add(Vector8f left, Vector8f right)noexcept
+	{
+		return _mm256_add_ps(left, right);
+	}
+	MATH_TARGET_AVX INLINE Vector8f Sub(Vector8f left, Vector8f right)noexcept
+	{
+		return _mm256_sub_ps(left, right);
+	}
+	MATH_TARGET_AVX INLINE Vector8f Mul(Vector8f left, Vector8f right)noexcept
+	{
+		return _mm256_mul_ps(left, right);
+	}
+	MATH_TARGET_AVX INLINE Vector8f Div(Vector8f left, Vector8f right)noexcept
+	{
+		return _mm256_div_ps(left, right);
+	}
+	/* a * b + c with a single rounding */
+	MATH_TARGET_AVX2 INLINE Vector8f FusedMulAdd(Vector8f a, Vector8f b, Vector8f c)noexcept
+	{
+		return _mm256_fmadd_ps(a, b, c);
+	}
+	MATH_TARGET_AVX2 INLINE Vector4d FusedMulAdd(Vector4d a, Vector4d b, Vector4d c)noexcept
+	{
+		return _mm256_fmadd_pd(a, b, c);
+	}
+
+	/* Shuffling, AVX cannot permute across 128bit lanes so both halves are broadcasted and blended */
+	template<int x, int y, int z, int w>
+	MATH_TARGET_AVX INLINE Vector4d Swizzle(Vector4d v)noexcept
+	{
+		constexpr int select = (x & 1) | ((y & 1) << 1) | ((z & 1) << 2) | ((w & 1) << 3);
+		constexpr int blend = (x >> 1) | ((y >> 1) << 1) | ((z >> 1) << 2) | ((w >> 1) << 3);
+		auto lo = _mm256_permute2f128_pd(v, v, 0x00);
+		auto hi = _mm256_permute2f128_pd(v, v, 0x11);
+		return _mm256_blend_pd(_mm256_permute_pd(lo, select), _mm256_permute_pd(hi, select), blend);
+	}
+	/* Returns (a[x], a[y], b[z], b[w]) */
+	template<int x, int y, int z, int w>
+	MATH_TARGET_AVX INLINE Vector4d Shuffle(Vector4d a, Vector4d b)noexcept
+	{
+		return _mm256_blend_pd(Swizzle<x, y, x, y>(a), Swizzle<z, w, z, w>(b), 0b1100);
+	}
+
+	/* Matrix functions, each matrix is given as its four rows */
+	namespace Impl
+	{
+		/* 2x2 matrices packed as (m00, m01, m10, m11) */
+		MATH_TARGET_AVX INLINE Vector4d Matrix2Mul(Vector4d a, Vector4d b)noexcept
+		{
+			return Add(Mul(a, Swizzle<0, 3, 0, 3>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+		}
+		/* adj(a) * b */
+		MATH_TARGET_AVX INLINE Vector4d Matrix2AdjMul(Vector4d a, Vector4d b)noexcept
+		{
+			return Sub(Mul(Swizzle<3, 3, 0, 0>(a), b), Mul(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+		}
+		/* a * adj(b) */
+		MATH_TARGET_AVX INLINE Vector4d Matrix2MulAdj(Vector4d a, Vector4d b)noexcept
+		{
+			return Sub(Mul(a, Swizzle<3, 0, 3, 0>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+		}
+		MATH_TARGET_AVX INLINE Vector4d Trace2Product(Vector4d aAdjB, Vector4d dAdjC)noexcept
+		{
+			auto tr = Mul(aAdjB, Swizzle<0, 2, 1, 3>(dAdjC));
+			tr = Add(tr, _mm256_permute2f128_pd(tr, tr, 0x01));
+			return Add(tr, _mm256_permute_pd(tr, 0b0101));
+		}
+	}
+	/* Inverts a 4x4 matrix using 2x2 block sub-determinants, the rows are overwritten with the inverse
+	 * only when the determinant is not nearly zero. Returns the determinant. */
+	MATH_TARGET_AVX INLINE double Matrix4Inverse(Vector4d& r0, Vector4d& r1, Vector4d& r2, Vector4d& r3, double tolerance = MATH_TOLERANCE<double>)noexcept
+	{
+		auto a = _mm256_permute2f128_pd(r0, r1, 0x20);
+		auto b = _mm256_permute2f128_pd(r0, r1, 0x31);
+		auto c = _mm256_permute2f128_pd(r2, r3, 0x20);
+		auto d = _mm256_permute2f128_pd(r2, r3, 0x31);
+
+		// (|A|, |B|, |C|, |D|)
+		auto detSub = Sub(Mul(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+			Mul(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+		auto detA = Swizzle<0, 0, 0, 0>(detSub);
+		auto detB = Swizzle<1, 1, 1, 1>(detSub);
+		auto detC = Swizzle<2, 2, 2, 2>(detSub);
+		auto detD = Swizzle<3, 3, 3, 3>(detSub);
+
+		auto dAdjC = Impl::Matrix2AdjMul(d, c);
+		auto aAdjB = Impl::Matrix2AdjMul(a, b);
+
+		auto x = Sub(Mul(detD, a), Impl::Matrix2Mul(b, dAdjC));
+		auto w = Sub(Mul(detA, d), Impl::Matrix2Mul(c, aAdjB));
+		auto y = Sub(Mul(detB, c), Impl::Matrix2MulAdj(d, aAdjB));
+		auto z = Sub(Mul(detC, b), Impl::Matrix2MulAdj(a, dAdjC));
+
+		auto detM = Add(Mul(detA, detD), Mul(detB, detC));
+		detM = Sub(detM, Impl::Trace2Product(aAdjB, dAdjC));
+
+		double det = _mm256_cvtsd_f64(detM);
+		if (::IsNearlyEqual(det, 0.0, tolerance))
+			return det; // No inverse
+
+		auto invDet = Div(CreateV4d(1.0, -1.0, -1.0, 1.0), detM);
+		x = Mul(x, invDet);
+		y = Mul(y, invDet);
+		z = Mul(z, invDet);
+		w = Mul(w, invDet);
+
+		// Undo the adjugate while storing back the rows
+		r0 = Shuffle<3, 1, 3, 1>(x, y);
+		r1 = Shuffle<2, 0, 2, 0>(x, y);
+		r2 = Shuffle<3, 1, 3, 1>(z, w);
+		r3 = Shuffle<2, 0, 2, 0>(z, w);
+		return det;
+	}
+	/* Inverts the row major 4x4 matrix m into inv, which is only written when the determinant is not nearly zero.
+	 * Not inlined so it can be called from code built without AVX. */
+	MATH_TARGET_AVX inline double Matrix4Inverse(const double* m, double* inv, double tolerance = MATH_TOLERANCE<double>)noexcept
+	{
+		auto r0 = _mm256_loadu_pd(m);
+		auto r1 = _mm256_loadu_pd(m + 4);
+		auto r2 = _mm256_loadu_pd(m + 8);
+		auto r3 = _mm256_loadu_pd(m + 12);
+		double determinant = Matrix4Inverse(r0, r1, r2, r3, tolerance);
+		if (::IsNearlyEqual(determinant, 0.0, tolerance))
+			return determinant;
+
+		_mm256_storeu_pd(inv, r0);
+		_mm256_storeu_pd(inv + 4, r1);
+		_mm256_storeu_pd(inv + 8, r2);
+		_mm256_storeu_pd(inv + 12, r3);
+		return determinant;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#if COMPILER_MSVC
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+/* Every function carries its target so it can be used after a runtime check, see CPUFeatures.inl */
+namespace greaper::math::AVX512
+{
+	using Vector16f = __m512;
+	using Vector8d = __m512d;
+	using Vector16i = __m512i;
+
+	/* Basic functions */
+	MATH_TARGET_AVX512 INLINE Vector16f CreateV16f()noexcept
+	{
+		return _mm512_setzero_ps();
+	}
+	MATH_TARGET_AVX512 INLINE Vector16f CreateV16f(float a)noexcept
+	{
+		return _mm512_set1_ps(a);
+	}
+	/* Mask that selects the first count lanes of 16, used for the loop remainders */
+	MATH_TARGET_AVX512 INLINE __mmask16 TailMask16(sizet count)noexcept
+	{
+		return count >= 16 ? __mmask16(0xFFFF) : __mmask16((1u << count) - 1u);
+	}
+	MATH_TARGET_AVX512 INLINE __mmask8 TailMask8(sizet count)noexcept
+	{
+		return count >= 8 ? __mmask8(0xFF) : __mmask8((1u << count) - 1u);
+	}
+
+	/* Arithmetic */
+	MATH_TARGET_AVX512 INLINE Vector16f Add(Vector16f left, Vector16f right)noexcept
+	{
+		return _mm512_add_ps(left, right);
+	}
+	MATH_TARGET_AVX512 INLINE Vector16f Sub(Vector16f left, Vector16f right)noexcept
+	{
+		return _mm512_sub_ps(left, right);
+	}
+	MATH_TARGET_AVX512 INLINE Vector16f Mul(Vector16f left, Vector16f right)noexcept
+	{
+		return _mm512_mul_ps(left, right);
+	}
+	MATH_TARGET_AVX512 INLINE Vector16f Div(Vector16f left, Vector16f right)noexcept
+	{
+		return _mm512_div_ps(left, right);
+	}
+	/* a * b + c with a single rounding */
+	MATH_TARGET_AVX512 INLINE Vector16f FusedMulAdd(Vector16f a, Vector16f b, Vector16f c)noexcept
+	{
+		return _mm512_fmadd_ps(a, b, c);
+	}
+	MATH_TARGET_AVX512 INLINE Vector8d FusedMulAdd(Vector8d a, Vector8d b, Vector8d c)noexcept
+	{
+		return _mm512_fmadd_pd(a, b, c);
+	}
+}
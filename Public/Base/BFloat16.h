@@ -0,0 +1,82 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_BFLOAT16_H
+#define MATH_BFLOAT16_H 1
+
+#include "../MathPrerequisites.h"
+#include <bit>
+
+namespace greaper::math
+{
+	namespace Impl
+	{
+		/* Rounds to nearest even like vcvtneps2bf16, which also flushes float subnormals to a signed zero and
+		 * quiets NaNs keeping the top of the payload. Every path produces these bits. */
+		NODISCARD INLINE constexpr uint16 FloatToBFloat16Bits(float v)noexcept
+		{
+			const uint32 f = std::bit_cast<uint32>(v);
+			if ((f & 0x7FFFFFFF) > 0x7F800000) // NaN
+				return static_cast<uint16>((f >> 16) | 0x40);
+			if ((f & 0x7F800000) == 0) // Zero or subnormal
+				return static_cast<uint16>((f >> 16) & 0x8000);
+			// A carry out of the mantissa correctly rounds up to the next exponent or infinity
+			return static_cast<uint16>((f + 0x7FFF + ((f >> 16) & 1)) >> 16);
+		}
+		NODISCARD INLINE constexpr float BFloat16BitsToFloat(uint16 b)noexcept
+		{
+			return std::bit_cast<float>(static_cast<uint32>(b) << 16);
+		}
+	}
+
+	/* Brain floating point, keeps the float exponent range with 8 bits of precision */
+	class BFloat16
+	{
+		int16 m_Value = 0;
+
+	public:
+		constexpr BFloat16()noexcept = default;
+		template<class T, typename std::enable_if<std::is_convertible_v<T, float>, bool>::type = false>
+		INLINE constexpr explicit BFloat16(T v)noexcept
+		{
+			Set(v);
+		}
+		template<class T, typename std::enable_if<std::is_convertible_v<T, float>, bool>::type = false>
+		INLINE constexpr explicit operator T ()const noexcept
+		{
+			return static_cast<T>(Get());
+		}
+
+		template<class T, typename std::enable_if<std::is_convertible_v<T, float>, bool>::type = false>
+		INLINE constexpr void Set(T v)noexcept
+		{
+			m_Value = static_cast<int16>(Impl::FloatToBFloat16Bits(static_cast<float>(v)));
+		}
+		INLINE constexpr float Get()const noexcept
+		{
+			return Impl::BFloat16BitsToFloat(static_cast<uint16>(m_Value));
+		}
+		INLINE constexpr int16 GetRaw()const noexcept
+		{
+			return m_Value;
+		}
+		INLINE constexpr void SetRaw(int16 rawValue)noexcept
+		{
+			m_Value = rawValue;
+		}
+	};
+	INLINE constexpr bool operator==(const BFloat16& left, const BFloat16& right)noexcept
+	{
+		return left.GetRaw() == right.GetRaw();
+	}
+	INLINE constexpr bool operator!=(const BFloat16& left, const BFloat16& right)noexcept
+	{
+		return !(left == right);
+	}
+}
+
+#endif /* MATH_BFLOAT16_H */
\ No newline at end of file
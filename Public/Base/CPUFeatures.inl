@@ -0,0 +1,175 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#include "../../../GreaperCore/Public/Enumeration.h"
+
+#if COMPILER_MSVC
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#include <cpuid.h>
+#endif
+#include <atomic>
+
+/* Kernels for instruction sets that the binary is not compiled for must carry their target,
+ * MSVC does not need it. Those kernels are only called after checking GetSIMDLevel() or
+ * GetCPUFeatures(), and must not be force inlined into code without the same target. */
+#if COMPILER_MSVC
+#define MATH_TARGET_SSE41
+#define MATH_TARGET_AVX
+#define MATH_TARGET_F16C
+#define MATH_TARGET_AVX2
+#define MATH_TARGET_AVX512
+#define MATH_TARGET_AVX512BF16
+#else
+#define MATH_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define MATH_TARGET_AVX __attribute__((target("avx")))
+#define MATH_TARGET_F16C __attribute__((target("avx,f16c")))
+#define MATH_TARGET_AVX2 __attribute__((target("avx,avx2,fma,f16c")))
+#define MATH_TARGET_AVX512 __attribute__((target("avx,avx2,fma,f16c,avx512f,avx512dq,avx512bw,avx512vl")))
+#define MATH_TARGET_AVX512BF16 __attribute__((target("avx,avx2,fma,f16c,avx512f,avx512dq,avx512bw,avx512vl,avx512bf16")))
+#endif
+
+/* SIMD kernels must round exactly like their scalar fallback, so the compiler is not allowed to fuse
+ * separate multiplies and adds into FMA instructions between these two markers. MSVC only fuses with /fp:contract. */
+#if COMPILER_MSVC
+#define MATH_STRICT_FP_BEGIN
+#define MATH_STRICT_FP_END
+#elif defined(__clang__)
+#define MATH_STRICT_FP_BEGIN _Pragma("float_control(push)") _Pragma("STDC FP_CONTRACT OFF")
+#define MATH_STRICT_FP_END _Pragma("float_control(pop)")
+#else
+#define MATH_STRICT_FP_BEGIN _Pragma("GCC push_options") _Pragma("GCC optimize(\"fp-contract=off\")")
+#define MATH_STRICT_FP_END _Pragma("GCC pop_options")
+#endif
+
+ENUMERATION(SIMDLevel, Scalar, SSE41, AVX2, AVX512);
+
+namespace greaper::math
+{
+	struct CPUFeatures
+	{
+		bool SSE41 = false;
+		bool AVX = false;
+		bool AVX2 = false;
+		bool FMA = false;
+		bool F16C = false;
+		bool AVX512F = false;
+		bool AVX512DQ = false;
+		bool AVX512BW = false;
+		bool AVX512VL = false;
+		bool AVX512BF16 = false;
+	};
+
+	namespace Impl
+	{
+		INLINE void CPUID(uint32 regs[4], uint32 leaf, uint32 subleaf)noexcept
+		{
+#if COMPILER_MSVC
+			__cpuidex((int*)regs, (int)leaf, (int)subleaf);
+#else
+			__cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+		}
+		INLINE uint64 XGetBV(uint32 index)noexcept
+		{
+#if COMPILER_MSVC
+			return _xgetbv(index);
+#else
+			uint32 eax, edx;
+			__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+			return (uint64(edx) << 32) | eax;
+#endif
+		}
+		INLINE CPUFeatures DetectCPUFeatures()noexcept
+		{
+			CPUFeatures features;
+			uint32 regs[4];
+
+			CPUID(regs, 0, 0);
+			const uint32 maxLeaf = regs[0];
+			if (maxLeaf < 1)
+				return features;
+
+			CPUID(regs, 1, 0);
+			const bool osxsave = (regs[2] & (1u << 27)) != 0;
+			features.SSE41 = (regs[2] & (1u << 19)) != 0;
+
+			// The OS must save the YMM (and ZMM) registers on context switches
+			const uint64 xcr0 = osxsave ? XGetBV(0) : 0;
+			const bool ymmState = (xcr0 & 0x6) == 0x6;
+			const bool zmmState = (xcr0 & 0xE6) == 0xE6;
+
+			features.AVX = ymmState && (regs[2] & (1u << 28)) != 0;
+			features.FMA = features.AVX && (regs[2] & (1u << 12)) != 0;
+			features.F16C = features.AVX && (regs[2] & (1u << 29)) != 0;
+
+			if (maxLeaf < 7)
+				return features;
+
+			CPUID(regs, 7, 0);
+			features.AVX2 = features.AVX && (regs[1] & (1u << 5)) != 0;
+			features.AVX512F = zmmState && (regs[1] & (1u << 16)) != 0;
+			features.AVX512DQ = features.AVX512F && (regs[1] & (1u << 17)) != 0;
+			features.AVX512BW = features.AVX512F && (regs[1] & (1u << 30)) != 0;
+			features.AVX512VL = features.AVX512F && (regs[1] & (1u << 31)) != 0;
+
+			const uint32 maxSubleaf = regs[0];
+			if (maxSubleaf >= 1)
+			{
+				CPUID(regs, 7, 1);
+				features.AVX512BF16 = features.AVX512F && (regs[0] & (1u << 5)) != 0;
+			}
+			return features;
+		}
+		INLINE SIMDLevel_t DetectSIMDLevel(const CPUFeatures& features)noexcept
+		{
+			if (features.AVX512F && features.AVX512DQ && features.AVX512BW && features.AVX512VL && features.AVX2 && features.FMA && features.F16C)
+				return SIMDLevel_t::AVX512;
+			if (features.AVX2 && features.FMA && features.F16C)
+				return SIMDLevel_t::AVX2;
+			if (features.SSE41)
+				return SIMDLevel_t::SSE41;
+			return SIMDLevel_t::Scalar;
+		}
+		INLINE std::atomic<SIMDLevel_t>& GetMaxSIMDLevel()noexcept
+		{
+			static std::atomic<SIMDLevel_t> maxLevel{ SIMDLevel_t::AVX512 };
+			return maxLevel;
+		}
+	}
+
+	/* Features of the running CPU, detected once on first use */
+	INLINE const CPUFeatures& GetCPUFeatures()noexcept
+	{
+		static const CPUFeatures features = Impl::DetectCPUFeatures();
+		return features;
+	}
+	/* Highest instruction set supported by the running CPU */
+	INLINE SIMDLevel_t GetDetectedSIMDLevel()noexcept
+	{
+		static const SIMDLevel_t level = Impl::DetectSIMDLevel(GetCPUFeatures());
+		return level;
+	}
+	/* Instruction set used by the batch kernels, the detected one unless it was lowered with SetMaxSIMDLevel */
+	INLINE SIMDLevel_t GetSIMDLevel()noexcept
+	{
+#if MATH_USE_OPTIMIZATIONS
+		SIMDLevel_t detected = GetDetectedSIMDLevel();
+		SIMDLevel_t maxLevel = Impl::GetMaxSIMDLevel().load(std::memory_order_relaxed);
+		return maxLevel < detected ? maxLevel : detected;
+#else
+		return SIMDLevel_t::Scalar;
+#endif
+	}
+	/* Limits the instruction set used by the batch kernels, useful to test the narrower paths.
+	 * Levels above the detected one are ignored. */
+	INLINE void SetMaxSIMDLevel(SIMDLevel_t level)noexcept
+	{
+		Impl::GetMaxSIMDLevel().store(level, std::memory_order_relaxed);
+	}
+}
\ No newline at end of file
@@ -9,26 +9,90 @@
 #define MATH_HALF_H 1
 
 #include "../MathPrerequisites.h"
+#include <bit>
 
 namespace greaper::math
 {
+	namespace Impl
+	{
+		/* Software conversions for CPUs without F16C, they give the same bits as vcvtps2ph with round to nearest even
+		 * and vcvtph2ps, including subnormals, overflow to infinity and NaN quieting */
+		NODISCARD INLINE constexpr uint16 FloatToHalfBits(float v)noexcept
+		{
+			const uint32 f = std::bit_cast<uint32>(v);
+			const uint32 sign = (f >> 16) & 0x8000;
+			const uint32 a = f & 0x7FFFFFFF;
+			if (a > 0x7F800000) // NaN, keeps the top of the payload
+				return static_cast<uint16>(sign | 0x7E00 | ((a >> 13) & 0x3FF));
+			if (a >= 0x47800000) // Infinity or too big
+				return static_cast<uint16>(sign | 0x7C00);
+			if (a < 0x38800000) // Half subnormal or zero
+			{
+				const uint32 exponent = a >> 23;
+				if (exponent < 102)
+					return static_cast<uint16>(sign);
+				const uint32 mantissa = (a & 0x7FFFFF) | 0x800000;
+				const uint32 shift = 126 - exponent;
+				uint32 h = mantissa >> shift;
+				const uint32 rest = mantissa & ((1u << shift) - 1);
+				const uint32 halfway = 1u << (shift - 1);
+				if (rest > halfway || (rest == halfway && (h & 1) != 0))
+					++h;
+				return static_cast<uint16>(sign | h);
+			}
+			// Rebias the exponent, a carry out of the mantissa correctly rounds up to the next exponent or infinity
+			uint32 h = (a - 0x38000000) >> 13;
+			const uint32 rest = a & 0x1FFF;
+			if (rest > 0x1000 || (rest == 0x1000 && (h & 1) != 0))
+				++h;
+			return static_cast<uint16>(sign | h);
+		}
+		NODISCARD INLINE constexpr float HalfBitsToFloat(uint16 h)noexcept
+		{
+			const uint32 sign = static_cast<uint32>(h & 0x8000) << 16;
+			const uint32 exponent = (h >> 10) & 0x1F;
+			uint32 mantissa = h & 0x3FF;
+			if (exponent == 0x1F) // Infinity or NaN, NaNs come out quiet
+				return std::bit_cast<float>(sign | 0x7F800000 | (mantissa << 13) | (mantissa != 0 ? 0x400000 : 0));
+			if (exponent == 0)
+			{
+				if (mantissa == 0)
+					return std::bit_cast<float>(sign);
+				// Subnormal half, normal float
+				uint32 floatExponent = 113;
+				while ((mantissa & 0x400) == 0)
+				{
+					mantissa <<= 1;
+					--floatExponent;
+				}
+				return std::bit_cast<float>(sign | (floatExponent << 23) | ((mantissa & 0x3FF) << 13));
+			}
+			return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+		}
+		MATH_TARGET_F16C inline uint16 FloatToHalfBitsF16C(float v)noexcept
+		{
+			return static_cast<uint16>(_mm_extract_epi16(_mm_cvtps_ph(_mm_set_ss(v), _MM_FROUND_TO_NEAREST_INT), 0));
+		}
+		MATH_TARGET_F16C inline float HalfBitsToFloatF16C(uint16 h)noexcept
+		{
+			return _mm_cvtss_f32(_mm_cvtph_ps(_mm_cvtsi32_si128(h)));
+		}
+	}
+
 	class Half
 	{
 		int16 m_Value = 0;
 
-		union Cvt
-		{
-			int32 i;
-			decltype(m_Value) t;
-		};
-		
-		void _Set(float v)
+		INLINE void _Set(float v)noexcept
 		{
-			__m128 v1 = _mm_set_ss(v);
-			__m128i v2 = _mm_cvtps_ph(v1, 0);
-			int32 res = _mm_cvtsi128_si32(v2);
-			Cvt u{ res };
-			m_Value = u.t;
+#if MATH_USE_OPTIMIZATIONS
+			if (GetCPUFeatures().F16C)
+			{
+				m_Value = static_cast<int16>(Impl::FloatToHalfBitsF16C(v));
+				return;
+			}
+#endif
+			m_Value = static_cast<int16>(Impl::FloatToHalfBits(v));
 		}
 	public:
 		constexpr Half()noexcept = default;
@@ -46,16 +110,17 @@ namespace greaper::math
 		template<class T, typename std::enable_if<std::is_convertible_v<T, float>, bool>::type = false>
 		INLINE void Set(T v)noexcept
 		{
-			Set(static_cast<float>(v));
+			_Set(static_cast<float>(v));
 		}
 		INLINE float Get()const noexcept
 		{
-			Cvt u{ m_Value };
-			__m128i v1 = _mm_cvtsi32_si128(u.i);
-			__m128 v2 = _mm_cvtph_ps(v1);
-			return _mm_cvtss_f32(v2);
+#if MATH_USE_OPTIMIZATIONS
+			if (GetCPUFeatures().F16C)
+				return Impl::HalfBitsToFloatF16C(static_cast<uint16>(m_Value));
+#endif
+			return Impl::HalfBitsToFloat(static_cast<uint16>(m_Value));
 		}
-		INLINE int16 GetRaw()const noexcept
+		INLINE constexpr int16 GetRaw()const noexcept
 		{
 			return m_Value;
 		}
@@ -6,6 +6,7 @@
 #pragma once
 
 CREATE_TYPEINFO_CNAME(greaper::math::Half, 			greaper::refl::RTI_Half,		PlainType, "Half");
+CREATE_TYPEINFO_CNAME(greaper::math::BFloat16, 		greaper::refl::RTI_BFloat16,	PlainType, "BFloat16");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector2f,		greaper::refl::RTI_Vector2f,	ComplexType, "Vector2f");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector2d,		greaper::refl::RTI_Vector2d,	ComplexType, "Vector2d");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector2i,		greaper::refl::RTI_Vector2i,	ComplexType, "Vector2i");
@@ -17,6 +18,7 @@ CREATE_TYPEINFO_CNAME(greaper::math::Vector2u8,		greaper::refl::RTI_Vector2u8,	C
 CREATE_TYPEINFO_CNAME(greaper::math::Vector2u16,	greaper::refl::RTI_Vector2u16,	ComplexType, "Vector2u16");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector2u64,	greaper::refl::RTI_Vector2u64,	ComplexType, "Vector2u64");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector2b,		greaper::refl::RTI_Vector2b,	ComplexType, "Vector2b");
+CREATE_TYPEINFO_CNAME(greaper::math::Vector2h,		greaper::refl::RTI_Vector2h,	ComplexType, "Vector2h");
 
 CREATE_TYPEINFO_CNAME(greaper::math::Vector3f,		greaper::refl::RTI_Vector3f,	ComplexType, "Vector3f");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector3d,		greaper::refl::RTI_Vector3d,	ComplexType, "Vector3d");
@@ -29,6 +31,7 @@ CREATE_TYPEINFO_CNAME(greaper::math::Vector3u8,		greaper::refl::RTI_Vector3u8,	C
 CREATE_TYPEINFO_CNAME(greaper::math::Vector3u16,	greaper::refl::RTI_Vector3u16,	ComplexType, "Vector3u16");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector3u64,	greaper::refl::RTI_Vector3u64,	ComplexType, "Vector3u64");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector3b,		greaper::refl::RTI_Vector3b,	ComplexType, "Vector3b");
+CREATE_TYPEINFO_CNAME(greaper::math::Vector3h,		greaper::refl::RTI_Vector3h,	ComplexType, "Vector3h");
 
 CREATE_TYPEINFO_CNAME(greaper::math::Vector4f,		greaper::refl::RTI_Vector4f,	ComplexType, "Vector4f");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector4d,		greaper::refl::RTI_Vector4d,	ComplexType, "Vector4d");
@@ -41,6 +44,7 @@ CREATE_TYPEINFO_CNAME(greaper::math::Vector4u8,		greaper::refl::RTI_Vector4u8,	C
 CREATE_TYPEINFO_CNAME(greaper::math::Vector4u16,	greaper::refl::RTI_Vector4u16,	ComplexType, "Vector4u16");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector4u64,	greaper::refl::RTI_Vector4u64,	ComplexType, "Vector4u64");
 CREATE_TYPEINFO_CNAME(greaper::math::Vector4b,		greaper::refl::RTI_Vector4b,	ComplexType, "Vector4b");
+CREATE_TYPEINFO_CNAME(greaper::math::Vector4h,		greaper::refl::RTI_Vector4h,	ComplexType, "Vector4h");
 
 CREATE_TYPEINFO_CNAME(greaper::math::Matrix2f,		greaper::refl::RTI_Matrix2f,	ContainerType, "Matrix2f");
 CREATE_TYPEINFO_CNAME(greaper::math::Matrix2d,		greaper::refl::RTI_Matrix2d,	ContainerType, "Matrix2d");
@@ -53,6 +57,8 @@ CREATE_TYPEINFO_CNAME(greaper::math::Matrix4d,		greaper::refl::RTI_Matrix4d,	Con
 
 CREATE_TYPEINFO_CNAME(greaper::math::QuaternionF, 	greaper::refl::RTI_QuaternionF, ComplexType, "QuaternionF");
 CREATE_TYPEINFO_CNAME(greaper::math::QuaternionD, 	greaper::refl::RTI_QuaternionD, ComplexType, "QuaternionD");
+CREATE_TYPEINFO_CNAME(greaper::math::PackedQuaternion32,	greaper::refl::RTI_PackedQuaternion32, PlainType, "PackedQuaternion32");
+CREATE_TYPEINFO_CNAME(greaper::math::PackedQuaternion48,	greaper::refl::RTI_PackedQuaternion48, PlainType, "PackedQuaternion48");
 
 CREATE_TYPEINFO_CNAME(greaper::math::RectF, greaper::refl::RTI_RectF, ComplexType, "RectF");
 CREATE_TYPEINFO_CNAME(greaper::math::RectD, greaper::refl::RTI_RectD, ComplexType, "RectD");
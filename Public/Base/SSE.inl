@@ -313,4 +313,185 @@ namespace greaper::math::SSE
 	{
 		return _mm_and_ps(v, _mm_set_ps1(-0.f));
 	}
+
+	/* Shuffling */
+	template<int x, int y, int z, int w>
+	INLINE Vector4f Swizzle(Vector4f v)noexcept
+	{
+		return _mm_shuffle_ps(v, v, _MM_SHUFFLE(w, z, y, x));
+	}
+	template<int x, int y, int z, int w>
+	INLINE Vector4f Shuffle(Vector4f a, Vector4f b)noexcept
+	{
+		return _mm_shuffle_ps(a, b, _MM_SHUFFLE(w, z, y, x));
+	}
+	/* Converts four packed xyz triplets, loaded as three vectors, into one vector per component */
+	INLINE void Deinterleave3(Vector4f a, Vector4f b, Vector4f c, Vector4f& x, Vector4f& y, Vector4f& z)noexcept
+	{
+		x = Shuffle<0, 1, 0, 2>(Shuffle<0, 3, 0, 3>(a, a), Shuffle<2, 2, 1, 1>(b, c));
+		y = Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 0, 0>(a, b), Shuffle<3, 3, 2, 2>(b, c));
+		z = Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 1, 1>(a, b), Shuffle<0, 0, 3, 3>(c, c));
+	}
+	/* Inverse of Deinterleave3 */
+	INLINE void Interleave3(Vector4f x, Vector4f y, Vector4f z, Vector4f& a, Vector4f& b, Vector4f& c)noexcept
+	{
+		a = Shuffle<0, 2, 0, 2>(Shuffle<0, 0, 0, 0>(x, y), Shuffle<0, 0, 1, 1>(z, x));
+		b = Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 1, 1>(y, z), Shuffle<2, 2, 2, 2>(x, y));
+		c = Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 3, 3>(z, x), Shuffle<3, 3, 3, 3>(y, z));
+	}
+
+	/* Matrix functions, each matrix is given as its four rows */
+	INLINE void Transpose(Vector4f& r0, Vector4f& r1, Vector4f& r2, Vector4f& r3)noexcept
+	{
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	}
+	/* Computes row * M, the summation order matches the scalar Matrix4Real product */
+	INLINE Vector4f Matrix4MulRow(Vector4f row, Vector4f m0, Vector4f m1, Vector4f m2, Vector4f m3)noexcept
+	{
+		auto r = Mul(Swizzle<0, 0, 0, 0>(row), m0);
+		r = Add(r, Mul(Swizzle<1, 1, 1, 1>(row), m1));
+		r = Add(r, Mul(Swizzle<2, 2, 2, 2>(row), m2));
+		return Add(r, Mul(Swizzle<3, 3, 3, 3>(row), m3));
+	}
+	/* Computes M * v, returning the dot product of v with each row */
+	INLINE Vector4f Matrix4MulVector(Vector4f m0, Vector4f m1, Vector4f m2, Vector4f m3, Vector4f v)noexcept
+	{
+		auto t0 = Mul(m0, v);
+		auto t1 = Mul(m1, v);
+		auto t2 = Mul(m2, v);
+		auto t3 = Mul(m3, v);
+		_MM_TRANSPOSE4_PS(t0, t1, t2, t3);
+		return Add(Add(Add(t0, t1), t2), t3);
+	}
+	namespace Impl
+	{
+		/* 2x2 matrices packed as (m00, m01, m10, m11) */
+		INLINE Vector4f Matrix2Mul(Vector4f a, Vector4f b)noexcept
+		{
+			return Add(Mul(a, Swizzle<0, 3, 0, 3>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+		}
+		/* adj(a) * b */
+		INLINE Vector4f Matrix2AdjMul(Vector4f a, Vector4f b)noexcept
+		{
+			return Sub(Mul(Swizzle<3, 3, 0, 0>(a), b), Mul(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b)));
+		}
+		/* a * adj(b) */
+		INLINE Vector4f Matrix2MulAdj(Vector4f a, Vector4f b)noexcept
+		{
+			return Sub(Mul(a, Swizzle<3, 0, 3, 0>(b)), Mul(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b)));
+		}
+		/* Determinants of the four 2x2 blocks (|A|, |B|, |C|, |D|) of M = | A B |
+		 *                                                                 | C D | */
+		INLINE Vector4f Matrix4BlockDeterminants(Vector4f r0, Vector4f r1, Vector4f r2, Vector4f r3)noexcept
+		{
+			return Sub(Mul(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)),
+				Mul(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+		}
+		INLINE Vector4f Trace2Product(Vector4f aAdjB, Vector4f dAdjC)noexcept
+		{
+			auto tr = Mul(aAdjB, Swizzle<0, 2, 1, 3>(dAdjC));
+			tr = _mm_hadd_ps(tr, tr);
+			return _mm_hadd_ps(tr, tr);
+		}
+	}
+	/* Determinant of a 4x4 matrix, broadcasted to all lanes */
+	INLINE Vector4f Matrix4Determinant(Vector4f r0, Vector4f r1, Vector4f r2, Vector4f r3)noexcept
+	{
+		auto a = _mm_movelh_ps(r0, r1);
+		auto b = _mm_movehl_ps(r1, r0);
+		auto c = _mm_movelh_ps(r2, r3);
+		auto d = _mm_movehl_ps(r3, r2);
+
+		auto detSub = Impl::Matrix4BlockDeterminants(r0, r1, r2, r3);
+		auto detA = Swizzle<0, 0, 0, 0>(detSub);
+		auto detB = Swizzle<1, 1, 1, 1>(detSub);
+		auto detC = Swizzle<2, 2, 2, 2>(detSub);
+		auto detD = Swizzle<3, 3, 3, 3>(detSub);
+
+		auto dAdjC = Impl::Matrix2AdjMul(d, c);
+		auto aAdjB = Impl::Matrix2AdjMul(a, b);
+
+		// |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+		auto det = Add(Mul(detA, detD), Mul(detB, detC));
+		return Sub(det, Impl::Trace2Product(aAdjB, dAdjC));
+	}
+	/* Inverts a 4x4 matrix using 2x2 block sub-determinants, the rows are overwritten with the inverse
+	 * only when the determinant is not nearly zero. Returns the determinant. */
+	INLINE float Matrix4Inverse(Vector4f& r0, Vector4f& r1, Vector4f& r2, Vector4f& r3, float tolerance = MATH_TOLERANCE<float>)noexcept
+	{
+		auto a = _mm_movelh_ps(r0, r1);
+		auto b = _mm_movehl_ps(r1, r0);
+		auto c = _mm_movelh_ps(r2, r3);
+		auto d = _mm_movehl_ps(r3, r2);
+
+		auto detSub = Impl::Matrix4BlockDeterminants(r0, r1, r2, r3);
+		auto detA = Swizzle<0, 0, 0, 0>(detSub);
+		auto detB = Swizzle<1, 1, 1, 1>(detSub);
+		auto detC = Swizzle<2, 2, 2, 2>(detSub);
+		auto detD = Swizzle<3, 3, 3, 3>(detSub);
+
+		auto dAdjC = Impl::Matrix2AdjMul(d, c);
+		auto aAdjB = Impl::Matrix2AdjMul(a, b);
+
+		// Adjugates of the blocks of the inverse, iM = 1/|M| * | X Y |
+		//                                                      | Z W |
+		auto x = Sub(Mul(detD, a), Impl::Matrix2Mul(b, dAdjC));
+		auto w = Sub(Mul(detA, d), Impl::Matrix2Mul(c, aAdjB));
+		auto y = Sub(Mul(detB, c), Impl::Matrix2MulAdj(d, aAdjB));
+		auto z = Sub(Mul(detC, b), Impl::Matrix2MulAdj(a, dAdjC));
+
+		auto detM = Add(Mul(detA, detD), Mul(detB, detC));
+		detM = Sub(detM, Impl::Trace2Product(aAdjB, dAdjC));
+
+		float det = _mm_cvtss_f32(detM);
+		if (::IsNearlyEqual(det, 0.f, tolerance))
+			return det; // No inverse
+
+		auto invDet = Div(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), detM);
+		x = Mul(x, invDet);
+		y = Mul(y, invDet);
+		z = Mul(z, invDet);
+		w = Mul(w, invDet);
+
+		// Undo the adjugate while storing back the rows
+		r0 = Shuffle<3, 1, 3, 1>(x, y);
+		r1 = Shuffle<2, 0, 2, 0>(x, y);
+		r2 = Shuffle<3, 1, 3, 1>(z, w);
+		r3 = Shuffle<2, 0, 2, 0>(z, w);
+		return det;
+	}
+
+	/* Quaternion functions, the lanes hold (W, X, Y, Z) like QuaternionReal, the summation order matches the scalar code */
+	INLINE Vector4f QuaternionMul(Vector4f left, Vector4f right)noexcept
+	{
+		const auto sign = _mm_setr_ps(-0.f, 0.f, 0.f, 0.f);
+		auto t1 = Mul(Swizzle<0, 0, 0, 0>(left), right);
+		auto t2 = Mul(Swizzle<1, 1, 2, 3>(left), Swizzle<1, 0, 0, 0>(right));
+		auto t3 = Mul(Swizzle<2, 2, 3, 1>(left), Swizzle<2, 3, 1, 2>(right));
+		auto t4 = Mul(Swizzle<3, 3, 1, 2>(left), Swizzle<3, 2, 3, 1>(right));
+		auto r = Add(t1, _mm_xor_ps(t2, sign));
+		r = Add(r, _mm_xor_ps(t3, sign));
+		return Sub(r, t4);
+	}
+	INLINE Vector4f QuaternionConjugate(Vector4f q)noexcept
+	{
+		return _mm_xor_ps(q, _mm_setr_ps(0.f, -0.f, -0.f, -0.f));
+	}
+	/* Returns the squared length in the lowest lane */
+	INLINE Vector4f QuaternionLengthSquared(Vector4f q)noexcept
+	{
+		auto p = Mul(q, q);
+		auto len = _mm_add_ss(p, Swizzle<1, 1, 1, 1>(p));
+		len = _mm_add_ss(len, Swizzle<2, 2, 2, 2>(p));
+		return _mm_add_ss(len, Swizzle<3, 3, 3, 3>(p));
+	}
+	/* Quaternions whose squared length is not above the tolerance are returned unchanged */
+	INLINE Vector4f QuaternionNormalize(Vector4f q, float tolerance = MATH_TOLERANCE<float>)noexcept
+	{
+		auto len = QuaternionLengthSquared(q);
+		if (!(_mm_cvtss_f32(len) > tolerance))
+			return q;
+		auto invScale = _mm_div_ss(_mm_set_ss(1.f), _mm_sqrt_ss(len));
+		return Mul(q, Swizzle<0, 0, 0, 0>(invScale));
+	}
 }
\ No newline at end of file
@@ -0,0 +1,134 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_SOASTORAGE_H
+#define MATH_SOASTORAGE_H 1
+
+#include "../MathPrerequisites.h"
+#include <new>
+#include <algorithm>
+
+namespace greaper::math
+{
+	/* Storage shared by the structure of arrays containers. The streams share one allocation, each stream starts at
+	 * a 64 byte boundary and the capacity is padded to a whole number of 64 byte blocks. */
+	template<class T, sizet StreamCount>
+	class SoAStorage
+	{
+		static_assert(std::is_floating_point_v<T>, "SoAStorage can only work with float, double or long double types");
+		static_assert(StreamCount > 0, "SoAStorage needs at least one stream");
+
+	public:
+		static constexpr sizet Alignment = 64;
+		static constexpr sizet BlockCount = Alignment / sizeof(T);
+
+		constexpr SoAStorage()noexcept = default;
+		INLINE explicit SoAStorage(sizet size) { Resize(size); }
+		INLINE SoAStorage(const SoAStorage& other)
+		{
+			Resize(other.m_Size);
+			CopyStreams(other);
+		}
+		INLINE SoAStorage(SoAStorage&& other)noexcept
+			:m_Data(other.m_Data), m_Size(other.m_Size), m_Capacity(other.m_Capacity)
+		{
+			other.m_Data = nullptr;
+			other.m_Size = 0;
+			other.m_Capacity = 0;
+		}
+		INLINE ~SoAStorage()noexcept { Deallocate(); }
+
+		INLINE SoAStorage& operator=(const SoAStorage& other)
+		{
+			if (this != &other)
+			{
+				Resize(other.m_Size);
+				CopyStreams(other);
+			}
+			return *this;
+		}
+		INLINE SoAStorage& operator=(SoAStorage&& other)noexcept
+		{
+			if (this != &other)
+			{
+				Deallocate();
+				m_Data = other.m_Data;
+				m_Size = other.m_Size;
+				m_Capacity = other.m_Capacity;
+				other.m_Data = nullptr;
+				other.m_Size = 0;
+				other.m_Capacity = 0;
+			}
+			return *this;
+		}
+
+		NODISCARD INLINE sizet Size()const noexcept { return m_Size; }
+		NODISCARD INLINE sizet Capacity()const noexcept { return m_Capacity; }
+		NODISCARD INLINE bool IsEmpty()const noexcept { return m_Size == 0; }
+
+		NODISCARD INLINE T* GetStream(sizet stream)noexcept { return m_Data + m_Capacity * stream; }
+		NODISCARD INLINE const T* GetStream(sizet stream)const noexcept { return m_Data + m_Capacity * stream; }
+
+		INLINE void Reserve(sizet capacity)
+		{
+			if (capacity <= m_Capacity)
+				return;
+
+			capacity = ((capacity + BlockCount - 1) / BlockCount) * BlockCount;
+			T* data = static_cast<T*>(::operator new(capacity * StreamCount * sizeof(T), std::align_val_t{ Alignment }));
+			if (m_Data != nullptr)
+			{
+				for (sizet s = 0; s < StreamCount; ++s)
+					std::copy_n(m_Data + m_Capacity * s, m_Size, data + capacity * s);
+			}
+			Deallocate();
+			m_Data = data;
+			m_Capacity = capacity;
+		}
+		/* New elements are zero initialized */
+		INLINE void Resize(sizet size)
+		{
+			Reserve(size);
+			if (size > m_Size)
+			{
+				for (sizet s = 0; s < StreamCount; ++s)
+					std::fill(m_Data + m_Capacity * s + m_Size, m_Data + m_Capacity * s + size, T(0));
+			}
+			m_Size = size;
+		}
+		INLINE void Clear()noexcept { m_Size = 0; }
+
+	protected:
+		/* Adds one element at the end doubling the capacity when full, returns its index for the caller to set */
+		INLINE sizet Append()
+		{
+			if (m_Size == m_Capacity)
+				Reserve(m_Capacity > 0 ? m_Capacity * 2 : BlockCount);
+			return m_Size++;
+		}
+
+	private:
+		INLINE void CopyStreams(const SoAStorage& other)noexcept
+		{
+			for (sizet s = 0; s < StreamCount; ++s)
+				std::copy_n(other.m_Data + other.m_Capacity * s, m_Size, m_Data + m_Capacity * s);
+		}
+		INLINE void Deallocate()noexcept
+		{
+			if (m_Data != nullptr)
+				::operator delete(m_Data, std::align_val_t{ Alignment });
+			m_Data = nullptr;
+			m_Capacity = 0;
+		}
+
+		T* m_Data = nullptr;
+		sizet m_Size = 0;
+		sizet m_Capacity = 0;
+	};
+}
+
+#endif /* MATH_SOASTORAGE_H */
\ No newline at end of file
@@ -64,6 +64,11 @@ namespace greaper::math::Impl
 	template<> struct Mat3Conv<float> { static constexpr auto print = "%f, %f, %f, %f, %f, %f, %f, %f, %f"; static constexpr auto scan = "%f, %f, %f, %f, %f, %f, %f, %f, %f"; };
 	template<> struct Mat3Conv<double> { static constexpr auto print = "%lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf"; static constexpr auto scan = "%lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf"; };
 
+	template<class T>
+	struct Mat43Conv { };
+	template<> struct Mat43Conv<float> { static constexpr auto print = "%f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f"; static constexpr auto scan = "%f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f"; };
+	template<> struct Mat43Conv<double> { static constexpr auto print = "%lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf"; static constexpr auto scan = "%lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf, %lf"; };
+
 	template<class T>
 	struct Mat4Conv { };
 	template<> struct Mat4Conv<float> { static constexpr auto print = "%f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f"; static constexpr auto scan = "%f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f, %f"; };
@@ -0,0 +1,407 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+/* No include guard on purpose, Transcendental.h expands this once per instruction set inside a namespace
+ * that provides LaneOps and defines MATH_TRANSCENDENTAL_TARGET. Float kernels follow Cephes, double ones fdlibm. */
+
+namespace Impl
+{
+	/* Rounds to the nearest integer, the result also sits in the low mantissa bits of the intermediate sum */
+	MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Floats RoundWithMagic(LaneOps::Floats x, LaneOps::Floats& biased)noexcept
+	{
+		namespace L = LaneOps;
+		const L::Floats magic = L::Splat(12582912.f); // 1.5 * 2^23
+		biased = L::Add(x, magic);
+		return L::Sub(biased, magic);
+	}
+	MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Doubles RoundWithMagic(LaneOps::Doubles x, LaneOps::Doubles& biased)noexcept
+	{
+		namespace L = LaneOps;
+		const L::Doubles magic = L::Splat(6755399441055744.0); // 1.5 * 2^52
+		biased = L::Add(x, magic);
+		return L::Sub(biased, magic);
+	}
+	/* 2^n for integral n inside the normal exponent range */
+	MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Floats PowerOfTwo(LaneOps::Floats n)noexcept
+	{
+		namespace L = LaneOps;
+		L::Floats biased;
+		RoundWithMagic(n, biased);
+		return L::AsFloats(L::ShiftLeft32<23>(L::AddBits32(L::AsBits(biased), L::SplatBits32(127u - 0x4B400000u))));
+	}
+	MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Doubles PowerOfTwo(LaneOps::Doubles n)noexcept
+	{
+		namespace L = LaneOps;
+		L::Doubles biased;
+		RoundWithMagic(n, biased);
+		return L::AsDoubles(L::ShiftLeft64<52>(L::AddBits64(L::AsBits(biased), L::SplatBits64(1023ull - 0x4338000000000000ull))));
+	}
+
+	/* a - b with its rounding error, exact whatever the magnitudes */
+	template<class V>
+	MATH_TRANSCENDENTAL_TARGET INLINE V TwoDiff(V a, V b, V& error)noexcept
+	{
+		namespace L = LaneOps;
+		const V difference = L::Sub(a, b);
+		const V bVirtual = L::Sub(a, difference);
+		const V aVirtual = L::Add(difference, bVirtual);
+		error = L::Add(L::Sub(a, aVirtual), L::Sub(bVirtual, b));
+		return difference;
+	}
+
+	/* Cody-Waite reduction by pi/2, r lands in [-pi/4, pi/4] and the quadrant is kept in the low bits of quadrant */
+	MATH_TRANSCENDENTAL_TARGET INLINE void SinCosPolynomials(LaneOps::Floats x, LaneOps::Floats& sinR, LaneOps::Floats& cosR, LaneOps::FloatBits& quadrant)noexcept
+	{
+		namespace L = LaneOps;
+		L::Floats biased;
+		const L::Floats j = RoundWithMagic(L::Mul(x, L::Splat(0.636619772367581343f)), biased);
+		quadrant = L::AsBits(biased);
+		// The first three parts of pi/2 are short enough for j * part to be exact while |j| < 2^13, the rounding
+		// errors of the two subtractions that are not exact are recovered into tail along with the last part
+		const L::Floats head = L::Sub(x, L::Mul(j, L::Splat(1.5703125f)));
+		const L::Floats middle = L::Mul(j, L::Splat(4.837512969970703125e-4f));
+		const L::Floats third = L::Mul(j, L::Splat(7.549533620476723e-8f));
+		L::Floats error0, error1;
+		const L::Floats r = TwoDiff(TwoDiff(head, middle, error0), third, error1);
+		const L::Floats tail = L::Sub(L::Add(error0, error1), L::Mul(j, L::Splat(2.5633440682570896e-12f)));
+		const L::Floats z = L::Mul(r, r);
+		const L::Floats hz = L::Mul(z, L::Splat(0.5f));
+		const L::Floats w = L::Sub(L::Splat(1.f), hz);
+
+		// sin(r + tail) = sin(r) + tail * cos(r) and cos(r + tail) = cos(r) - tail * sin(r), tail is tiny next to r
+		L::Floats p = L::Add(L::Mul(L::Splat(-1.9515295891e-4f), z), L::Splat(8.3321608736e-3f));
+		p = L::Add(L::Mul(p, z), L::Splat(-1.6666654611e-1f));
+		sinR = L::Add(r, L::Add(L::Mul(tail, w), L::Mul(L::Mul(r, z), p)));
+		sinR = L::Select(L::CmpEq(x, L::Splat(0.f)), x, sinR); // Keeps the sign of sin(-0)
+
+		p = L::Add(L::Mul(L::Splat(2.443315711809948e-5f), z), L::Splat(-1.388731625493765e-3f));
+		p = L::Add(L::Mul(p, z), L::Splat(4.166664568298827e-2f));
+		cosR = L::Add(w, L::Add(L::Sub(L::Sub(L::Splat(1.f), w), hz), L::Sub(L::Mul(L::Mul(z, z), p), L::Mul(r, tail))));
+	}
+	MATH_TRANSCENDENTAL_TARGET INLINE void SinCosPolynomials(LaneOps::Doubles x, LaneOps::Doubles& sinR, LaneOps::Doubles& cosR, LaneOps::DoubleBits& quadrant)noexcept
+	{
+		namespace L = LaneOps;
+		L::Doubles biased;
+		const L::Doubles j = RoundWithMagic(L::Mul(x, L::Splat(6.36619772367581382433e-01)), biased);
+		quadrant = L::AsBits(biased);
+		// 33 bit parts of pi/2, j * part is exact while |j| < 2^20
+		const L::Doubles head = L::Sub(x, L::Mul(j, L::Splat(1.57079632673412561417e+00)));
+		const L::Doubles middle = L::Mul(j, L::Splat(6.07710050630396597660e-11));
+		L::Doubles error;
+		const L::Doubles r = TwoDiff(head, middle, error);
+		const L::Doubles tail = L::Sub(error, L::Mul(j, L::Splat(2.02226624879595063154e-21)));
+		const L::Doubles z = L::Mul(r, r);
+		const L::Doubles hz = L::Mul(z, L::Splat(0.5));
+		const L::Doubles w = L::Sub(L::Splat(1.0), hz);
+
+		L::Doubles p = L::Add(L::Mul(L::Splat(1.58969099521155010221e-10), z), L::Splat(-2.50507602534068634195e-08));
+		p = L::Add(L::Mul(p, z), L::Splat(2.75573137070700676789e-06));
+		p = L::Add(L::Mul(p, z), L::Splat(-1.98412698298579493134e-04));
+		p = L::Add(L::Mul(p, z), L::Splat(8.33333333332248946124e-03));
+		p = L::Add(L::Mul(p, z), L::Splat(-1.66666666666666324348e-01));
+		sinR = L::Add(r, L::Add(L::Mul(tail, w), L::Mul(L::Mul(r, z), p)));
+		sinR = L::Select(L::CmpEq(x, L::Splat(0.0)), x, sinR);
+
+		p = L::Add(L::Mul(L::Splat(-1.13596475577881948265e-11), z), L::Splat(2.08757232129817482790e-09));
+		p = L::Add(L::Mul(p, z), L::Splat(-2.75573143513906633035e-07));
+		p = L::Add(L::Mul(p, z), L::Splat(2.48015872894767294178e-05));
+		p = L::Add(L::Mul(p, z), L::Splat(-1.38888888888741095749e-03));
+		p = L::Add(L::Mul(p, z), L::Splat(4.16666666666666019037e-02));
+		cosR = L::Add(w, L::Add(L::Sub(L::Sub(L::Splat(1.0), w), hz), L::Sub(L::Mul(L::Mul(z, z), p), L::Mul(r, tail))));
+	}
+	/* sin(r + quadrant * pi/2) */
+	MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Floats ApplyQuadrant(LaneOps::Floats sinR, LaneOps::Floats cosR, LaneOps::FloatBits quadrant)noexcept
+	{
+		namespace L = LaneOps;
+		const L::Floats value = L::Select(L::MaskFromOne32(L::AndBits(quadrant, L::SplatBits32(1))), cosR, sinR);
+		return L::Xor(value, L::AsFloats(L::ShiftLeft32<30>(L::AndBits(quadrant, L::SplatBits32(2)))));
+	}
+	MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Doubles ApplyQuadrant(LaneOps::Doubles sinR, LaneOps::Doubles cosR, LaneOps::DoubleBits quadrant)noexcept
+	{
+		namespace L = LaneOps;
+		const L::Doubles value = L::Select(L::MaskFromOne64(L::AndBits(quadrant, L::SplatBits64(1))), cosR, sinR);
+		return L::Xor(value, L::AsDoubles(L::ShiftLeft64<62>(L::AndBits(quadrant, L::SplatBits64(2)))));
+	}
+
+	template<class T> struct SinCosLimit;
+	template<> struct SinCosLimit<float> { static constexpr float Value = 8192.f; };
+	template<> struct SinCosLimit<double> { static constexpr double Value = 262144.0; };
+
+	/* Lanes too big for the reduction go through libm, rare enough to not be worth a wider reduction */
+	template<class T, class V>
+	MATH_TRANSCENDENTAL_TARGET INLINE void SinCosLargeLanes(V x, V* sinValue, V* cosValue)noexcept
+	{
+		namespace L = LaneOps;
+		constexpr sizet count = sizeof(V) / sizeof(T);
+		const V abs = L::AndNot(L::Splat(T(-0.0)), x);
+		if (!L::Any(L::CmpGt(abs, L::Splat(SinCosLimit<T>::Value))))
+			return;
+		alignas(64) T values[count], sines[count], cosines[count];
+		L::Store(values, x);
+		if (sinValue != nullptr)
+			L::Store(sines, *sinValue);
+		if (cosValue != nullptr)
+			L::Store(cosines, *cosValue);
+		for (sizet i = 0; i < count; ++i)
+		{
+			if (!(std::abs(values[i]) > SinCosLimit<T>::Value))
+				continue;
+			sines[i] = std::sin(values[i]);
+			cosines[i] = std::cos(values[i]);
+		}
+		if (sinValue != nullptr)
+			*sinValue = L::Load(sines);
+		if (cosValue != nullptr)
+			*cosValue = L::Load(cosines);
+	}
+
+	template<class T, class V>
+	MATH_TRANSCENDENTAL_TARGET INLINE V ExpKernel(V x)noexcept
+	{
+		namespace L = LaneOps;
+		V y;
+		V n;
+		if constexpr (std::is_same_v<T, float>)
+		{
+			// Past these limits the result is already inf or 0, clamping keeps the exponent math in range
+			const V clamped = L::Min(L::Max(x, L::Splat(-104.f)), L::Splat(89.f));
+			V biased;
+			n = RoundWithMagic(L::Mul(clamped, L::Splat(1.44269504088896341f)), biased);
+			V r = L::Sub(clamped, L::Mul(n, L::Splat(0.693359375f)));
+			r = L::Sub(r, L::Mul(n, L::Splat(-2.12194440e-4f)));
+			V p = L::Add(L::Mul(L::Splat(1.9875691500e-4f), r), L::Splat(1.3981999507e-3f));
+			p = L::Add(L::Mul(p, r), L::Splat(8.3334519073e-3f));
+			p = L::Add(L::Mul(p, r), L::Splat(4.1665795894e-2f));
+			p = L::Add(L::Mul(p, r), L::Splat(1.6666665459e-1f));
+			p = L::Add(L::Mul(p, r), L::Splat(5.0000001201e-1f));
+			y = L::Add(L::Add(L::Mul(p, L::Mul(r, r)), r), L::Splat(1.f));
+		}
+		else
+		{
+			const V clamped = L::Min(L::Max(x, L::Splat(-746.0)), L::Splat(710.0));
+			V biased;
+			n = RoundWithMagic(L::Mul(clamped, L::Splat(1.44269504088896338700e+00)), biased);
+			const V hi = L::Sub(clamped, L::Mul(n, L::Splat(6.93147180369123816490e-01)));
+			const V lo = L::Mul(n, L::Splat(1.90821492927058770002e-10));
+			const V r = L::Sub(hi, lo);
+			const V t = L::Mul(r, r);
+			V p = L::Add(L::Mul(L::Splat(4.13813679705723846039e-08), t), L::Splat(-1.65339022054652515390e-06));
+			p = L::Add(L::Mul(p, t), L::Splat(6.61375632143793436117e-05));
+			p = L::Add(L::Mul(p, t), L::Splat(-2.77777777770155933842e-03));
+			p = L::Add(L::Mul(p, t), L::Splat(1.66666666666666019037e-01));
+			const V c = L::Sub(r, L::Mul(t, p));
+			y = L::Sub(L::Splat(1.0), L::Sub(L::Sub(lo, L::Div(L::Mul(r, c), L::Sub(L::Splat(2.0), c))), hi));
+		}
+		// Two steps so results in the subnormal range only round once, on the last product
+		V biased;
+		const V half = RoundWithMagic(L::Mul(n, L::Splat(T(0.5))), biased);
+		const V result = L::Mul(L::Mul(y, PowerOfTwo(half)), PowerOfTwo(L::Sub(n, half)));
+		return L::Select(L::CmpUnord(x, x), x, result);
+	}
+
+	template<class T, class V>
+	MATH_TRANSCENDENTAL_TARGET INLINE V LogKernel(V x)noexcept
+	{
+		namespace L = LaneOps;
+		constexpr bool isFloat = std::is_same_v<T, float>;
+		// Subnormals are scaled into the normal range first
+		const auto subnormal = L::CmpLt(x, L::Splat(std::numeric_limits<T>::min()));
+		const V scaled = L::Select(subnormal, L::Mul(x, L::Splat(isFloat ? T(8388608.0) : T(18014398509481984.0))), x);
+		const V bias = L::Select(subnormal, L::Splat(isFloat ? T(126 + 23) : T(1022 + 54)), L::Splat(isFloat ? T(126) : T(1022)));
+		V e, m;
+		if constexpr (isFloat)
+		{
+			const L::FloatBits bits = L::AsBits(scaled);
+			e = L::Sub(L::AsFloats(L::OrBits(L::ShiftRight32<23>(bits), L::AsBits(L::Splat(8388608.f)))), L::Splat(8388608.f));
+			m = L::AsFloats(L::OrBits(L::AndBits(bits, L::SplatBits32(0x007FFFFFu)), L::SplatBits32(0x3F000000u)));
+		}
+		else
+		{
+			const L::DoubleBits bits = L::AsBits(scaled);
+			e = L::Sub(L::AsDoubles(L::OrBits(L::ShiftRight64<52>(bits), L::AsBits(L::Splat(4503599627370496.0)))), L::Splat(4503599627370496.0));
+			m = L::AsDoubles(L::OrBits(L::AndBits(bits, L::SplatBits64(0x000FFFFFFFFFFFFFull)), L::SplatBits64(0x3FE0000000000000ull)));
+		}
+		// m is in [0.5, 1), keeping it in [sqrt(1/2), sqrt(2)) centers the polynomial on 1
+		const auto lowMantissa = L::CmpLt(m, L::Splat(T(0.707106781186547524)));
+		e = L::Sub(L::Sub(e, bias), L::Select(lowMantissa, L::Splat(T(1)), L::Splat(T(0))));
+		const V f = L::Sub(L::Select(lowMantissa, L::Add(m, m), m), L::Splat(T(1)));
+
+		V result;
+		if constexpr (isFloat)
+		{
+			const V z = L::Mul(f, f);
+			V p = L::Add(L::Mul(L::Splat(7.0376836292e-2f), f), L::Splat(-1.1514610310e-1f));
+			p = L::Add(L::Mul(p, f), L::Splat(1.1676998740e-1f));
+			p = L::Add(L::Mul(p, f), L::Splat(-1.2420140846e-1f));
+			p = L::Add(L::Mul(p, f), L::Splat(1.4249322787e-1f));
+			p = L::Add(L::Mul(p, f), L::Splat(-1.6668057665e-1f));
+			p = L::Add(L::Mul(p, f), L::Splat(2.0000714765e-1f));
+			p = L::Add(L::Mul(p, f), L::Splat(-2.4999993993e-1f));
+			p = L::Add(L::Mul(p, f), L::Splat(3.3333331174e-1f));
+			V y = L::Mul(L::Mul(p, f), z);
+			y = L::Add(y, L::Mul(e, L::Splat(-2.12194440e-4f)));
+			y = L::Sub(y, L::Mul(z, L::Splat(0.5f)));
+			result = L::Add(L::Add(f, y), L::Mul(e, L::Splat(0.693359375f)));
+		}
+		else
+		{
+			const V hfsq = L::Mul(L::Mul(f, f), L::Splat(0.5));
+			const V s = L::Div(f, L::Add(L::Splat(2.0), f));
+			const V z = L::Mul(s, s);
+			const V w = L::Mul(z, z);
+			V t1 = L::Add(L::Mul(L::Splat(1.531383769920937332e-01), w), L::Splat(2.222219843214978396e-01));
+			t1 = L::Mul(w, L::Add(L::Mul(t1, w), L::Splat(3.999999999940941908e-01)));
+			V t2 = L::Add(L::Mul(L::Splat(1.479819860511658591e-01), w), L::Splat(1.818357216161805012e-01));
+			t2 = L::Add(L::Mul(t2, w), L::Splat(2.857142874366239149e-01));
+			t2 = L::Mul(z, L::Add(L::Mul(t2, w), L::Splat(6.666666666666735130e-01)));
+			const V r = L::Add(t2, t1);
+			const V tail = L::Add(L::Mul(s, L::Add(hfsq, r)), L::Mul(e, L::Splat(1.90821492927058770002e-10)));
+			result = L::Sub(L::Mul(e, L::Splat(6.93147180369123816490e-01)), L::Sub(L::Sub(hfsq, tail), f));
+		}
+		const V infinity = L::Splat(std::numeric_limits<T>::infinity());
+		result = L::Select(L::CmpEq(x, infinity), x, result);
+		result = L::Select(L::CmpEq(x, L::Splat(T(0))), L::Sub(L::Splat(T(0)), infinity), result);
+		result = L::Select(L::CmpLt(x, L::Splat(T(0))), L::Splat(std::numeric_limits<T>::quiet_NaN()), result);
+		return L::Select(L::CmpUnord(x, x), x, result);
+	}
+
+	template<class T, class V>
+	MATH_TRANSCENDENTAL_TARGET INLINE V ATan2Kernel(V y, V x)noexcept
+	{
+		namespace L = LaneOps;
+		constexpr bool isFloat = std::is_same_v<T, float>;
+		const V signMask = L::Splat(T(-0.0));
+		const V zero = L::Splat(T(0));
+		const V one = L::Splat(T(1));
+		const V ax = L::AndNot(signMask, x);
+		const V ay = L::AndNot(signMask, y);
+		const V low = L::Min(ax, ay);
+		const V high = L::Max(ax, ay);
+		// atan(low / high) is in [0, pi/4], 0 / 0 gives 0 and inf / inf gives pi/4 like atan2
+		V ratio = L::Select(L::CmpEq(high, zero), zero, L::Div(low, high));
+		ratio = L::Select(L::CmpEq(low, L::Splat(std::numeric_limits<T>::infinity())), one, ratio);
+		const auto reduce = L::CmpGt(ratio, L::Splat(T(0.414213562373095048802)));
+		const V a = L::Select(reduce, L::Div(L::Sub(ratio, one), L::Add(ratio, one)), ratio);
+		const V offsetHi = L::Select(reduce, L::Splat(isFloat ? T(0.785398185253143310546875) : T(7.85398163397448278999e-01)), zero);
+		const V offsetLo = L::Select(reduce, L::Splat(isFloat ? T(-2.18556950283465021e-08) : T(3.06161699786838301793e-17)), zero);
+		const V z = L::Mul(a, a);
+		V poly;
+		if constexpr (isFloat)
+		{
+			V p = L::Add(L::Mul(L::Splat(8.05374449538e-2f), z), L::Splat(-1.38776856032e-1f));
+			p = L::Add(L::Mul(p, z), L::Splat(1.99777106478e-1f));
+			p = L::Add(L::Mul(p, z), L::Splat(-3.33329491539e-1f));
+			poly = L::Mul(L::Mul(p, z), a);
+		}
+		else
+		{
+			const V w = L::Mul(z, z);
+			V s1 = L::Add(L::Mul(L::Splat(1.62858201153657823623e-02), w), L::Splat(4.97687799461593236017e-02));
+			s1 = L::Add(L::Mul(s1, w), L::Splat(6.66107313738753120669e-02));
+			s1 = L::Add(L::Mul(s1, w), L::Splat(9.09088713343650656196e-02));
+			s1 = L::Add(L::Mul(s1, w), L::Splat(1.42857142725034663711e-01));
+			s1 = L::Mul(z, L::Add(L::Mul(s1, w), L::Splat(3.33333333333329318027e-01)));
+			V s2 = L::Add(L::Mul(L::Splat(-3.65315727442169155270e-02), w), L::Splat(-5.83357013379057348645e-02));
+			s2 = L::Add(L::Mul(s2, w), L::Splat(-7.69187620504482999495e-02));
+			s2 = L::Add(L::Mul(s2, w), L::Splat(-1.11111104054623557880e-01));
+			s2 = L::Mul(w, L::Add(L::Mul(s2, w), L::Splat(-1.99999999998764832476e-01)));
+			poly = L::Sub(zero, L::Mul(a, L::Add(s1, s2)));
+		}
+		// atan(a) = a + poly, the offset low part is folded in before the big terms
+		V t = L::Add(offsetHi, L::Add(a, L::Add(poly, offsetLo)));
+		t = L::Select(L::CmpGt(ay, ax), L::Add(L::Sub(L::Splat(isFloat ? T(1.57079637050628662109375) : T(1.57079632679489655800e+00)), t),
+			L::Splat(isFloat ? T(-4.37113900018624283e-08) : T(6.12323399573676603587e-17))), t);
+		// Checked on the sign bit so x = -0 also takes the pi branch
+		t = L::Select(L::CmpLt(L::Or(L::And(x, signMask), one), zero), L::Add(L::Sub(L::Splat(isFloat ? T(3.1415927410125732421875) : T(3.14159265358979311600e+00)), t),
+			L::Splat(isFloat ? T(-8.74227800037248566e-08) : T(1.22464679914735317723e-16))), t);
+		t = L::Or(t, L::And(y, signMask));
+		return L::Select(L::CmpUnord(x, y), L::Add(x, y), t);
+	}
+}
+
+/* sin(x) for every lane */
+NODISCARD MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Floats Sin(LaneOps::Floats x)noexcept
+{
+	LaneOps::Floats sinR, cosR;
+	LaneOps::FloatBits quadrant;
+	Impl::SinCosPolynomials(x, sinR, cosR, quadrant);
+	LaneOps::Floats result = Impl::ApplyQuadrant(sinR, cosR, quadrant);
+	Impl::SinCosLargeLanes<float>(x, &result, static_cast<LaneOps::Floats*>(nullptr));
+	return result;
+}
+NODISCARD MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Doubles Sin(LaneOps::Doubles x)noexcept
+{
+	LaneOps::Doubles sinR, cosR;
+	LaneOps::DoubleBits quadrant;
+	Impl::SinCosPolynomials(x, sinR, cosR, quadrant);
+	LaneOps::Doubles result = Impl::ApplyQuadrant(sinR, cosR, quadrant);
+	Impl::SinCosLargeLanes<double>(x, &result, static_cast<LaneOps::Doubles*>(nullptr));
+	return result;
+}
+/* cos(x) for every lane, evaluated as sin(x + pi/2) on the reduced argument */
+NODISCARD MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Floats Cos(LaneOps::Floats x)noexcept
+{
+	LaneOps::Floats sinR, cosR;
+	LaneOps::FloatBits quadrant;
+	Impl::SinCosPolynomials(x, sinR, cosR, quadrant);
+	LaneOps::Floats result = Impl::ApplyQuadrant(sinR, cosR, LaneOps::AddBits32(quadrant, LaneOps::SplatBits32(1)));
+	Impl::SinCosLargeLanes<float>(x, static_cast<LaneOps::Floats*>(nullptr), &result);
+	return result;
+}
+NODISCARD MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Doubles Cos(LaneOps::Doubles x)noexcept
+{
+	LaneOps::Doubles sinR, cosR;
+	LaneOps::DoubleBits quadrant;
+	Impl::SinCosPolynomials(x, sinR, cosR, quadrant);
+	LaneOps::Doubles result = Impl::ApplyQuadrant(sinR, cosR, LaneOps::AddBits64(quadrant, LaneOps::SplatBits64(1)));
+	Impl::SinCosLargeLanes<double>(x, static_cast<LaneOps::Doubles*>(nullptr), &result);
+	return result;
+}
+/* Same bits as Sin and Cos, sharing the range reduction */
+MATH_TRANSCENDENTAL_TARGET INLINE void SinCos(LaneOps::Floats x, LaneOps::Floats& sinValue, LaneOps::Floats& cosValue)noexcept
+{
+	LaneOps::Floats sinR, cosR;
+	LaneOps::FloatBits quadrant;
+	Impl::SinCosPolynomials(x, sinR, cosR, quadrant);
+	sinValue = Impl::ApplyQuadrant(sinR, cosR, quadrant);
+	cosValue = Impl::ApplyQuadrant(sinR, cosR, LaneOps::AddBits32(quadrant, LaneOps::SplatBits32(1)));
+	Impl::SinCosLargeLanes<float>(x, &sinValue, &cosValue);
+}
+MATH_TRANSCENDENTAL_TARGET INLINE void SinCos(LaneOps::Doubles x, LaneOps::Doubles& sinValue, LaneOps::Doubles& cosValue)noexcept
+{
+	LaneOps::Doubles sinR, cosR;
+	LaneOps::DoubleBits quadrant;
+	Impl::SinCosPolynomials(x, sinR, cosR, quadrant);
+	sinValue = Impl::ApplyQuadrant(sinR, cosR, quadrant);
+	cosValue = Impl::ApplyQuadrant(sinR, cosR, LaneOps::AddBits64(quadrant, LaneOps::SplatBits64(1)));
+	Impl::SinCosLargeLanes<double>(x, &sinValue, &cosValue);
+}
+/* e^x for every lane */
+NODISCARD MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Floats Exp(LaneOps::Floats x)noexcept
+{
+	return Impl::ExpKernel<float>(x);
+}
+NODISCARD MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Doubles Exp(LaneOps::Doubles x)noexcept
+{
+	return Impl::ExpKernel<double>(x);
+}
+/* ln(x) for every lane */
+NODISCARD MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Floats LogN(LaneOps::Floats x)noexcept
+{
+	return Impl::LogKernel<float>(x);
+}
+NODISCARD MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Doubles LogN(LaneOps::Doubles x)noexcept
+{
+	return Impl::LogKernel<double>(x);
+}
+/* atan2(y, x) for every lane, with the signed zero and infinity cases of std::atan2 */
+NODISCARD MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Floats ATan2(LaneOps::Floats y, LaneOps::Floats x)noexcept
+{
+	return Impl::ATan2Kernel<float>(y, x);
+}
+NODISCARD MATH_TRANSCENDENTAL_TARGET INLINE LaneOps::Doubles ATan2(LaneOps::Doubles y, LaneOps::Doubles x)noexcept
+{
+	return Impl::ATan2Kernel<double>(y, x);
+}
\ No newline at end of file
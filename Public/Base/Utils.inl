@@ -100,7 +100,22 @@ namespace greaper::math
 
 	template<class T> constexpr T Pow(T base, T power)noexcept;
 
-	/* Converts a floating point value into an integer with truncation towards zero. */
+	namespace Impl
+	{
+		/* Truncates to int32 saturating out of range values to INT32_MIN / INT32_MAX, NaN becomes 0. The float
+		 * conversions go through it so they never hit an out of range cast, Batch does the same lane wise. */
+		NODISCARD INLINE constexpr int32 SaturateToInt32(float val)noexcept
+		{
+			if (val >= 2147483648.f)
+				return std::numeric_limits<int32>::max();
+			if (val >= -2147483648.f)
+				return static_cast<int32>(val);
+			return val != val ? 0 : std::numeric_limits<int32>::min();
+		}
+	}
+
+	/* Converts a floating point value into an integer with truncation towards zero. Float values out of the int32
+	 * range saturate and NaN gives 0. */
 	template<class T>
 	NODISCARD INLINE constexpr int32 TruncInt(T val)noexcept
 	{
@@ -109,11 +124,7 @@ namespace greaper::math
 		{
 			if constexpr (std::is_same_v<T, float>)
 			{
-#if MATH_USE_OPTIMIZATIONS
-				return _mm_cvtt_ss2si(_mm_set_ss(val));
-#else
-				return static_cast<int32>(truncf(val));
-#endif
+				return Impl::SaturateToInt32(val);
 			}
 			else if constexpr (std::is_same_v<T, double>)
 			{
@@ -191,7 +202,8 @@ namespace greaper::math
 			return val;
 		}
 	}
-	/* Converts a float to the nearest less or equal integer */
+	/* Converts a float to the nearest less or equal integer. Float values out of the int32 range saturate and NaN
+	 * gives 0. */
 	template<class T>
 	NODISCARD INLINE int32 FloorInt(T val)noexcept
 	{
@@ -222,7 +234,7 @@ namespace greaper::math
 //#if MATH_USE_OPTIMIZATIONS
 //				return _mm_cvt_ss2si(_mm_set_ss(val + val - 0.5f)) >> 1;
 //#else
-				return static_cast<int32>(floorf(val));
+				return Impl::SaturateToInt32(floorf(val));
 //#endif
 			}
 			else if constexpr (std::is_same_v<T, double>)
@@ -297,7 +309,8 @@ namespace greaper::math
 			return val;
 		}
 	}
-	/* Converts a float to the nearest integer. Rounds up when the fraction is .5 */
+	/* Converts a float to the nearest integer. Rounds up when the fraction is .5, float values out of the int32
+	 * range saturate and NaN gives 0. */
 	template<class T>
 	NODISCARD INLINE constexpr int32 RoundInt(T val)noexcept
 	{
@@ -380,7 +393,8 @@ namespace greaper::math
 			return val;
 		}
 	}
-	/* Converts a float to the nearest greater or equal integer */
+	/* Converts a float to the nearest greater or equal integer. Float values out of the int32 range saturate and
+	 * NaN gives 0. */
 	template<class T>
 	NODISCARD INLINE constexpr int32 CeilInt(T val)noexcept
 	{
@@ -392,7 +406,7 @@ namespace greaper::math
 //#if MATH_USE_OPTIMIZATIONS
 //				return -(_mm_cvt_ss2si(_mm_set_ss(-0.5f - (val + val))) >> 1);
 //#else
-				return static_cast<int32>(ceilf(val));
+				return Impl::SaturateToInt32(ceilf(val));
 //#endif
 			}
 			else if constexpr (std::is_same_v<T, double>)
@@ -508,13 +522,181 @@ namespace greaper::math
 			return mod;
 		}
 	}
+	namespace Impl
+	{
+		/* Compile time versions of the C library functions, only reached through std::is_constant_evaluated() so the
+		 * runtime keeps calling the C library. They work one precision above T (long double for double, which is
+		 * plain double on MSVC) and land within an ulp of the runtime result. Sin and Cos reduce with a three part
+		 * pi / 2, accurate for |x| below 2^20 * pi / 2, and need |x| < 2^62 to be evaluated at all. */
+		template<class T>
+		using ConstexprWide_t = std::conditional_t<std::is_same_v<T, float>, double, long double>;
+
+		inline constexpr long double CONSTEXPR_LN2_HI = 6.93147180369123816490e-01L;
+		inline constexpr long double CONSTEXPR_LN2_LO = 1.90821492927058770002e-10L;
+		inline constexpr long double CONSTEXPR_PIO2_1 = 1.57079632673412561417e+00L;
+		inline constexpr long double CONSTEXPR_PIO2_2 = 6.07710050630396597660e-11L;
+		inline constexpr long double CONSTEXPR_PIO2_2T = 2.02226624879595063154e-21L;
+
+		template<class W>
+		NODISCARD INLINE constexpr int64 ConstexprRoundInt(W val)noexcept
+		{
+			return static_cast<int64>(val >= W(0) ? val + W(0.5) : val - W(0.5));
+		}
+		template<class W>
+		NODISCARD INLINE constexpr W ConstexprScaleByPowerOfTwo(W val, int64 exponent)noexcept
+		{
+			for (; exponent > 0; --exponent)
+				val *= W(2);
+			for (; exponent < 0; ++exponent)
+				val *= W(0.5);
+			return val;
+		}
+		template<class T>
+		NODISCARD INLINE constexpr T ConstexprSqrt(T val)noexcept
+		{
+			using W = ConstexprWide_t<T>;
+			if (val != val || val < T(0))
+				return std::numeric_limits<T>::quiet_NaN();
+			if (val == T(0) || val == std::numeric_limits<T>::infinity())
+				return val;
+			// Scaled by powers of 4 into [0.25, 1), where Newton-Raphson from 1 converges in a handful of steps
+			W x = W(val);
+			int64 exponent = 0;
+			for (; x >= W(1); ++exponent)
+				x *= W(0.25);
+			for (; x < W(0.25); --exponent)
+				x *= W(4);
+			W y = W(1);
+			for (int32 i = 0; i < 8; ++i)
+				y = W(0.5) * (y + x / y);
+			return T(ConstexprScaleByPowerOfTwo(y, exponent));
+		}
+		template<class T>
+		NODISCARD INLINE constexpr T ConstexprExp(T val)noexcept
+		{
+			using W = ConstexprWide_t<T>;
+			constexpr W ln2 = W(CONSTEXPR_LN2_HI) + W(CONSTEXPR_LN2_LO);
+			if (val != val)
+				return val;
+			if (W(val) > W(std::numeric_limits<T>::max_exponent) * ln2)
+				return std::numeric_limits<T>::infinity();
+			if (W(val) < W(std::numeric_limits<T>::min_exponent - std::numeric_limits<T>::digits - 1) * ln2)
+				return T(0);
+			// e^x = 2^k * e^r with |r| <= ln(2) / 2, e^r from its Taylor series
+			const int64 k = ConstexprRoundInt(W(val) / ln2);
+			const W r = (W(val) - W(k) * W(CONSTEXPR_LN2_HI)) - W(k) * W(CONSTEXPR_LN2_LO);
+			W sum = W(1), term = W(1);
+			for (int32 n = 1; n < 40; ++n)
+			{
+				term *= r / W(n);
+				const W next = sum + term;
+				if (next == sum)
+					break;
+				sum = next;
+			}
+			return T(ConstexprScaleByPowerOfTwo(sum, k));
+		}
+		template<class T>
+		NODISCARD INLINE constexpr T ConstexprLogN(T val)noexcept
+		{
+			using W = ConstexprWide_t<T>;
+			if (val != val || val < T(0))
+				return std::numeric_limits<T>::quiet_NaN();
+			if (val == T(0))
+				return -std::numeric_limits<T>::infinity();
+			if (val == std::numeric_limits<T>::infinity())
+				return val;
+			// x = m * 2^e with m in [sqrt(0.5), sqrt(2)), ln(m) = 2 * atanh((m - 1) / (m + 1)) from its series
+			constexpr W sqrtTwo = W(1.41421356237309504880168872420969808L);
+			W m = W(val);
+			int64 exponent = 0;
+			for (; m >= sqrtTwo; ++exponent)
+				m *= W(0.5);
+			for (; m * sqrtTwo < W(1); --exponent)
+				m *= W(2);
+			const W s = (m - W(1)) / (m + W(1));
+			const W s2 = s * s;
+			W sum = W(0), term = s;
+			for (int32 n = 1; n < 80; n += 2)
+			{
+				const W next = sum + term / W(n);
+				if (next == sum)
+					break;
+				sum = next;
+				term *= s2;
+			}
+			return T(W(exponent) * W(CONSTEXPR_LN2_HI) + (W(exponent) * W(CONSTEXPR_LN2_LO) + W(2) * sum));
+		}
+		/* Returns { sin(x), cos(x) } */
+		template<class T>
+		NODISCARD INLINE constexpr std::tuple<T, T> ConstexprSinCos(T val)noexcept
+		{
+			using W = ConstexprWide_t<T>;
+			if (val != val || val == std::numeric_limits<T>::infinity() || val == -std::numeric_limits<T>::infinity())
+				return { std::numeric_limits<T>::quiet_NaN(), std::numeric_limits<T>::quiet_NaN() };
+			// r = x - q * pi / 2 with |r| <= pi / 4, sin(r) and cos(r) from their Taylor series
+			const int64 q = ConstexprRoundInt(W(val) * W(0.636619772367581343075535053490057448L));
+			const W r = ((W(val) - W(q) * W(CONSTEXPR_PIO2_1)) - W(q) * W(CONSTEXPR_PIO2_2)) - W(q) * W(CONSTEXPR_PIO2_2T);
+			const W r2 = r * r;
+			W sinR = r, cosR = W(1), sinTerm = r, cosTerm = W(1);
+			for (int32 n = 1; n < 30; ++n)
+			{
+				sinTerm *= -r2 / (W(2 * n) * W(2 * n + 1));
+				cosTerm *= -r2 / (W(2 * n - 1) * W(2 * n));
+				const W nextSin = sinR + sinTerm;
+				const W nextCos = cosR + cosTerm;
+				if (nextSin == sinR && nextCos == cosR)
+					break;
+				sinR = nextSin;
+				cosR = nextCos;
+			}
+			switch (q & 3)
+			{
+			case 0: return { T(sinR), T(cosR) };
+			case 1: return { T(cosR), T(-sinR) };
+			case 2: return { T(-sinR), T(-cosR) };
+			default: return { T(-cosR), T(sinR) };
+			}
+		}
+		template<class T>
+		NODISCARD INLINE constexpr T ConstexprPow(T base, T power)noexcept
+		{
+			using W = ConstexprWide_t<T>;
+			if (power == T(0) || base == T(1))
+				return T(1);
+			if (base != base || power != power)
+				return std::numeric_limits<T>::quiet_NaN();
+			// Integral powers are exact up to rounding through repeated squaring, which also handles negative bases
+			constexpr W maxIntegral = W(4611686018427387904.0L); // 2^62
+			if (power > -maxIntegral && power < maxIntegral && W(static_cast<int64>(power)) == W(power))
+			{
+				const int64 n = static_cast<int64>(power);
+				uint64 remaining = static_cast<uint64>(n < 0 ? -n : n);
+				W result = W(1), square = W(base);
+				for (; remaining != 0; remaining >>= 1)
+				{
+					if ((remaining & 1) != 0)
+						result *= square;
+					square *= square;
+				}
+				return T(n < 0 ? W(1) / result : result);
+			}
+			if (base < T(0))
+				return std::numeric_limits<T>::quiet_NaN();
+			if (base == T(0))
+				return power > T(0) ? T(0) : std::numeric_limits<T>::infinity();
+			return T(ConstexprExp(W(power) * ConstexprLogN(W(base))));
+		}
+	}
 	/* Returns e^val */
 	template<class T>
-	NODISCARD INLINE Impl::MathRetType_t<T> Exp(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Exp(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
 		{
+			if (std::is_constant_evaluated())
+				return Impl::ConstexprExp(val);
 			if constexpr (std::is_same_v<T, float>)
 				return expf(val);
 			else if constexpr (std::is_same_v<T, double>)
@@ -529,11 +711,13 @@ namespace greaper::math
 	}
 	/* Returns 2^val */
 	template<class T>
-	NODISCARD INLINE Impl::MathRetType_t<T> Exp2(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Exp2(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
 		{
+			if (std::is_constant_evaluated())
+				return T(Impl::ConstexprExp(Impl::ConstexprWide_t<T>(val) * Impl::ConstexprWide_t<T>(0.693147180559945309417232121458176568L)));
 			if constexpr (std::is_same_v<T, float>)
 				return exp2f(val);
 			else if constexpr (std::is_same_v<T, double>)
@@ -548,11 +732,13 @@ namespace greaper::math
 	}
 	/* Returns ln(val) */
 	template<class T>
-	NODISCARD INLINE Impl::MathRetType_t<T> LogN(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> LogN(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
 		{
+			if (std::is_constant_evaluated())
+				return Impl::ConstexprLogN(val);
 			if constexpr (std::is_same_v<T, float>)
 				return logf(val);
 			else if constexpr (std::is_same_v<T, double>)
@@ -567,7 +753,7 @@ namespace greaper::math
 	}
 	/* Returns log[base](value) */
 	template<class T>
-	NODISCARD INLINE Impl::MathRetType_t<T> LogB(T base, T value)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> LogB(T base, T value)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
@@ -577,12 +763,12 @@ namespace greaper::math
 	}
 	/* Returns log2(val) */
 	template<class T>
-	NODISCARD INLINE Impl::MathRetType_t<T> Log2(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Log2(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
 		{
-			static constexpr T ONEOVERLOG2 = T(1.4426950408889634073599246810019);
+			constexpr T ONEOVERLOG2 = T(1.4426950408889634073599246810019);
 			return LogN(val) * ONEOVERLOG2;
 		}
 		else // integral
@@ -592,12 +778,12 @@ namespace greaper::math
 	}
 	/* Returns log10(val) */
 	template<class T>
-	NODISCARD INLINE Impl::MathRetType_t<T> Log10(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Log10(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
 		{
-			static constexpr T ONEOVERLOG10 = T(0.43429448190325182765112891891661);
+			constexpr T ONEOVERLOG10 = T(0.43429448190325182765112891891661);
 			return LogN(val) * ONEOVERLOG10;
 		}
 		else // integral
@@ -606,11 +792,13 @@ namespace greaper::math
 		}
 	}
 	template<class T> 
-	NODISCARD INLINE Impl::MathRetType_t<T> Sin(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Sin(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
 		{
+			if (std::is_constant_evaluated())
+				return std::get<0>(Impl::ConstexprSinCos(val));
 			if constexpr (std::is_same_v<T, float>)
 				return sinf(val);
 			else if constexpr (std::is_same_v<T, double>)
@@ -678,11 +866,13 @@ namespace greaper::math
 		}
 	}
 	template<class T> 
-	NODISCARD INLINE Impl::MathRetType_t<T> Cos(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Cos(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
 		{
+			if (std::is_constant_evaluated())
+				return std::get<1>(Impl::ConstexprSinCos(val));
 			if constexpr (std::is_same_v<T, float>)
 				return cosf(val);
 			else if constexpr (std::is_same_v<T, double>)
@@ -750,11 +940,16 @@ namespace greaper::math
 		}
 	}
 	template<class T> 
-	NODISCARD INLINE Impl::MathRetType_t<T> Tan(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Tan(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
 		{
+			if (std::is_constant_evaluated())
+			{
+				const auto [sin, cos] = Impl::ConstexprSinCos(val);
+				return sin / cos;
+			}
 			if constexpr (std::is_same_v<T, float>)
 				return tanf(val);
 			else if constexpr (std::is_same_v<T, double>)
@@ -840,11 +1035,13 @@ namespace greaper::math
 		}
 	}
 	template<class T> 
-	NODISCARD INLINE std::tuple<Impl::MathRetType_t<T>, Impl::MathRetType_t<T>> SinCos(T val)noexcept
+	NODISCARD INLINE constexpr std::tuple<Impl::MathRetType_t<T>, Impl::MathRetType_t<T>> SinCos(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
 		{
+			if (std::is_constant_evaluated())
+				return Impl::ConstexprSinCos(val);
 			T sin, cos;
 			if constexpr (std::is_same_v<T, float>)
 			{
@@ -868,7 +1065,7 @@ namespace greaper::math
 		}
 	}
 	template<class T> 
-	NODISCARD INLINE Impl::MathRetType_t<T> Cosecant(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Cosecant(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
@@ -877,7 +1074,7 @@ namespace greaper::math
 			return Cosecant(static_cast<Impl::MathRetType_t<T>>(val));
 	}
 	template<class T> 
-	NODISCARD INLINE Impl::MathRetType_t<T> Secant(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Secant(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
@@ -886,7 +1083,7 @@ namespace greaper::math
 			return Secant(static_cast<Impl::MathRetType_t<T>>(val));
 	}
 	template<class T> 
-	NODISCARD INLINE Impl::MathRetType_t<T> Cotangent(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Cotangent(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
@@ -895,7 +1092,7 @@ namespace greaper::math
 			return Cotangent(static_cast<Impl::MathRetType_t<T>>(val));
 	}
 	template<class T> 
-	NODISCARD INLINE Impl::MathRetType_t<T> Versine(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Versine(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
@@ -904,7 +1101,7 @@ namespace greaper::math
 			return Versine(static_cast<Impl::MathRetType_t<T>>(val));
 	}
 	template<class T> 
-	NODISCARD INLINE Impl::MathRetType_t<T> Coversine(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Coversine(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
@@ -913,17 +1110,19 @@ namespace greaper::math
 			return Coversine(static_cast<Impl::MathRetType_t<T>>(val));
 	}
 	template<class T>
-	NODISCARD INLINE Impl::MathRetType_t<T> SmoothCosZeroToOne(const T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> SmoothCosZeroToOne(const T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		return Cos(static_cast<Impl::MathRetType_t<T>>(val) * PI<Impl::MathRetType_t<T>>) * Impl::MathRetType_t<T>(-0.5) + Impl::MathRetType_t<T>(0.5);
 	}
 	template<class T> 
-	NODISCARD INLINE Impl::MathRetType_t<T> Sqrt(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> Sqrt(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
 		{
+			if (std::is_constant_evaluated())
+				return Impl::ConstexprSqrt(val);
 			if constexpr (std::is_same_v<T, float>)
 				return sqrtf(val);
 			else if constexpr (std::is_same_v<T, double>)
@@ -952,6 +1151,8 @@ namespace greaper::math
 		}
 		else // is floating point
 		{
+			if (std::is_constant_evaluated())
+				return Impl::ConstexprPow(base, power);
 			if constexpr (std::is_same_v<T, float>)
 				return powf(base, power);
 			else if constexpr (std::is_same_v<T, double>)
@@ -961,7 +1162,7 @@ namespace greaper::math
 		}
 	}
 	template<class T> 
-	NODISCARD INLINE Impl::MathRetType_t<T> InvSqrt(T val)noexcept
+	NODISCARD INLINE constexpr Impl::MathRetType_t<T> InvSqrt(T val)noexcept
 	{
 		static_assert(std::is_arithmetic_v<T>);
 		if constexpr (std::is_floating_point_v<T>)
@@ -0,0 +1,103 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_VECTOR2HALF_H
+#define MATH_VECTOR2HALF_H 1
+
+#include "Vector2Real.inl"
+#include "Half.h"
+#include "../Batch.h"
+
+namespace greaper::math
+{
+	/* Storage only half precision vector, widen it to Vector2f to operate. Equality compares the stored bits. */
+	class Vector2h
+	{
+	public:
+		static constexpr sizet ComponentCount = 2;
+		using value_type = Half;
+
+		Half X;
+		Half Y;
+
+		constexpr Vector2h()noexcept = default;
+		INLINE constexpr Vector2h(Half x, Half y)noexcept :X(x), Y(y) {  }
+		INLINE explicit Vector2h(const Vector2f& v)noexcept :X(v.X), Y(v.Y) {  }
+
+		NODISCARD INLINE constexpr Half& operator[](sizet index)noexcept
+		{
+			VerifyLess(index, ComponentCount, "Trying to access a Vector2h, but the index %" PRIuPTR " was out of range.", index);
+			return (&X)[index];
+		}
+		NODISCARD INLINE constexpr const Half& operator[](sizet index)const noexcept
+		{
+			VerifyLess(index, ComponentCount, "Trying to access a Vector2h, but the index %" PRIuPTR " was out of range.", index);
+			return (&X)[index];
+		}
+		NODISCARD INLINE Vector2f ToVector2f()const noexcept
+		{
+			return { X.Get(), Y.Get() };
+		}
+		NODISCARD INLINE explicit operator Vector2f()const noexcept
+		{
+			return ToVector2f();
+		}
+		INLINE void Set(const Vector2f& v)noexcept
+		{
+			X.Set(v.X);
+			Y.Set(v.Y);
+		}
+		NODISCARD INLINE constexpr bool IsEqual(const Vector2h& other)const noexcept
+		{
+			return X == other.X && Y == other.Y;
+		}
+		NODISCARD INLINE String ToString()const noexcept
+		{
+			return ToVector2f().ToString();
+		}
+		INLINE void FromString(StringView str)noexcept
+		{
+			Vector2f v;
+			v.FromString(str);
+			Set(v);
+		}
+	};
+
+	NODISCARD INLINE constexpr bool operator==(const Vector2h& left, const Vector2h& right)noexcept { return left.IsEqual(right); }
+	NODISCARD INLINE constexpr bool operator!=(const Vector2h& left, const Vector2h& right)noexcept { return !(left == right); }
+}
+
+namespace greaper::math::Batch
+{
+	/* Bulk narrowing and widening, same results as Batch::ConvertToHalf and Batch::ConvertToFloat */
+	INLINE void ConvertToHalf(std::span<const Vector2f> in, std::span<Vector2h> out)noexcept
+	{
+		static_assert(sizeof(Vector2f) == sizeof(float) * 2 && sizeof(Vector2h) == sizeof(Half) * 2, "Batch::ConvertToHalf expects tightly packed vectors.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ConvertToHalf, but the output is bigger than the input.");
+		ConvertToHalf(std::span<const float>(reinterpret_cast<const float*>(in.data()), out.size() * 2), std::span<Half>(reinterpret_cast<Half*>(out.data()), out.size() * 2));
+	}
+	INLINE void ConvertToFloat(std::span<const Vector2h> in, std::span<Vector2f> out)noexcept
+	{
+		static_assert(sizeof(Vector2f) == sizeof(float) * 2 && sizeof(Vector2h) == sizeof(Half) * 2, "Batch::ConvertToFloat expects tightly packed vectors.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ConvertToFloat, but the output is bigger than the input.");
+		ConvertToFloat(std::span<const Half>(reinterpret_cast<const Half*>(in.data()), out.size() * 2), std::span<float>(reinterpret_cast<float*>(out.data()), out.size() * 2));
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<greaper::math::Vector2h>
+	{
+		NODISCARD INLINE size_t operator()(const greaper::math::Vector2h& v)const noexcept
+		{
+			return ComputeHash(v.X.GetRaw(), v.Y.GetRaw());
+		}
+	};
+}
+
+#endif /* MATH_VECTOR2HALF_H */
\ No newline at end of file
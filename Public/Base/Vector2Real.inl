@@ -69,7 +69,7 @@ namespace greaper::math
 		{
 			return DotProduct(*this);
 		}
-		NODISCARD INLINE T Length()const noexcept
+		NODISCARD INLINE constexpr T Length()const noexcept
 		{
 			return Sqrt(LengthSquared());
 		}
@@ -77,7 +77,7 @@ namespace greaper::math
 		{
 			return Square(X - other.X) + Square(Y - other.Y);
 		}
-		NODISCARD INLINE T Distance(const Vector2Real& other)const noexcept
+		NODISCARD INLINE constexpr T Distance(const Vector2Real& other)const noexcept
 		{
 			return Sqrt(DistSquared(other));
 		}
@@ -85,7 +85,7 @@ namespace greaper::math
 		{
 			return X * other.Y - Y * other.X;
 		}
-		NODISCARD INLINE Vector2Real GetNormalized(T tolerance = MATH_TOLERANCE<T>)const noexcept
+		NODISCARD INLINE constexpr Vector2Real GetNormalized(T tolerance = MATH_TOLERANCE<T>)const noexcept
 		{
 			auto len = LengthSquared();
 			if (len > tolerance)
@@ -95,7 +95,7 @@ namespace greaper::math
 			}
 			return *this;
 		}
-		INLINE void Normalize(T tolerance = MATH_TOLERANCE<T>)noexcept
+		INLINE constexpr void Normalize(T tolerance = MATH_TOLERANCE<T>)noexcept
 		{
 			*this = GetNormalized(tolerance);
 		}
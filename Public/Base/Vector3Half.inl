@@ -0,0 +1,104 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_VECTOR3HALF_H
+#define MATH_VECTOR3HALF_H 1
+
+#include "Vector3Real.inl"
+#include "Vector2Half.inl"
+
+namespace greaper::math
+{
+	/* Storage only half precision vector, see Vector2h */
+	class Vector3h
+	{
+	public:
+		static constexpr sizet ComponentCount = 3;
+		using value_type = Half;
+
+		Half X;
+		Half Y;
+		Half Z;
+
+		constexpr Vector3h()noexcept = default;
+		INLINE constexpr Vector3h(Half x, Half y, Half z)noexcept :X(x), Y(y), Z(z) {  }
+		INLINE explicit Vector3h(const Vector3f& v)noexcept :X(v.X), Y(v.Y), Z(v.Z) {  }
+
+		NODISCARD INLINE constexpr Half& operator[](sizet index)noexcept
+		{
+			VerifyLess(index, ComponentCount, "Trying to access a Vector3h, but the index %" PRIuPTR " was out of range.", index);
+			return (&X)[index];
+		}
+		NODISCARD INLINE constexpr const Half& operator[](sizet index)const noexcept
+		{
+			VerifyLess(index, ComponentCount, "Trying to access a Vector3h, but the index %" PRIuPTR " was out of range.", index);
+			return (&X)[index];
+		}
+		NODISCARD INLINE Vector3f ToVector3f()const noexcept
+		{
+			return { X.Get(), Y.Get(), Z.Get() };
+		}
+		NODISCARD INLINE explicit operator Vector3f()const noexcept
+		{
+			return ToVector3f();
+		}
+		INLINE void Set(const Vector3f& v)noexcept
+		{
+			X.Set(v.X);
+			Y.Set(v.Y);
+			Z.Set(v.Z);
+		}
+		NODISCARD INLINE constexpr bool IsEqual(const Vector3h& other)const noexcept
+		{
+			return X == other.X && Y == other.Y && Z == other.Z;
+		}
+		NODISCARD INLINE String ToString()const noexcept
+		{
+			return ToVector3f().ToString();
+		}
+		INLINE void FromString(StringView str)noexcept
+		{
+			Vector3f v;
+			v.FromString(str);
+			Set(v);
+		}
+	};
+
+	NODISCARD INLINE constexpr bool operator==(const Vector3h& left, const Vector3h& right)noexcept { return left.IsEqual(right); }
+	NODISCARD INLINE constexpr bool operator!=(const Vector3h& left, const Vector3h& right)noexcept { return !(left == right); }
+}
+
+namespace greaper::math::Batch
+{
+	/* Bulk narrowing and widening, same results as Batch::ConvertToHalf and Batch::ConvertToFloat */
+	INLINE void ConvertToHalf(std::span<const Vector3f> in, std::span<Vector3h> out)noexcept
+	{
+		static_assert(sizeof(Vector3f) == sizeof(float) * 3 && sizeof(Vector3h) == sizeof(Half) * 3, "Batch::ConvertToHalf expects tightly packed vectors.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ConvertToHalf, but the output is bigger than the input.");
+		ConvertToHalf(std::span<const float>(reinterpret_cast<const float*>(in.data()), out.size() * 3), std::span<Half>(reinterpret_cast<Half*>(out.data()), out.size() * 3));
+	}
+	INLINE void ConvertToFloat(std::span<const Vector3h> in, std::span<Vector3f> out)noexcept
+	{
+		static_assert(sizeof(Vector3f) == sizeof(float) * 3 && sizeof(Vector3h) == sizeof(Half) * 3, "Batch::ConvertToFloat expects tightly packed vectors.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ConvertToFloat, but the output is bigger than the input.");
+		ConvertToFloat(std::span<const Half>(reinterpret_cast<const Half*>(in.data()), out.size() * 3), std::span<float>(reinterpret_cast<float*>(out.data()), out.size() * 3));
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<greaper::math::Vector3h>
+	{
+		NODISCARD INLINE size_t operator()(const greaper::math::Vector3h& v)const noexcept
+		{
+			return ComputeHash(v.X.GetRaw(), v.Y.GetRaw(), v.Z.GetRaw());
+		}
+	};
+}
+
+#endif /* MATH_VECTOR3HALF_H */
\ No newline at end of file
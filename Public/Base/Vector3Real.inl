@@ -73,7 +73,7 @@ namespace greaper::math
 		{
 			return DotProduct(*this);
 		}
-		NODISCARD INLINE T Length()const noexcept
+		NODISCARD INLINE constexpr T Length()const noexcept
 		{
 			return Sqrt(LengthSquared());
 		}
@@ -81,15 +81,15 @@ namespace greaper::math
 		{
 			return Square(X - other.X) + Square(Y - other.Y) + Square(Z - other.Z);;
 		}
-		NODISCARD INLINE T Distance(const Vector3Real& other)const noexcept
+		NODISCARD INLINE constexpr T Distance(const Vector3Real& other)const noexcept
 		{
 			return Sqrt(DistSquared(other));
 		}
 		NODISCARD INLINE constexpr Vector3Real CrossProduct(const Vector3Real& other)const noexcept
 		{
-			return { Y * other.Z - Z * other.Y, X * other.Z - Z * other.X, X * other.Y - Y * other.X };
+			return { Y * other.Z - Z * other.Y, Z * other.X - X * other.Z, X * other.Y - Y * other.X };
 		}
-		NODISCARD INLINE Vector3Real GetNormalized(T tolerance = MATH_TOLERANCE<T>)const noexcept
+		NODISCARD INLINE constexpr Vector3Real GetNormalized(T tolerance = MATH_TOLERANCE<T>)const noexcept
 		{
 			auto len = LengthSquared();
 			if (len > tolerance)
@@ -99,7 +99,7 @@ namespace greaper::math
 			}
 			return *this;
 		}
-		INLINE void Normalize(T tolerance = MATH_TOLERANCE<T>)noexcept
+		INLINE constexpr void Normalize(T tolerance = MATH_TOLERANCE<T>)noexcept
 		{
 			*this = GetNormalized(tolerance);
 		}
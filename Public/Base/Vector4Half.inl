@@ -0,0 +1,106 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_VECTOR4HALF_H
+#define MATH_VECTOR4HALF_H 1
+
+#include "Vector4Real.inl"
+#include "Vector3Half.inl"
+
+namespace greaper::math
+{
+	/* Storage only half precision vector, see Vector2h */
+	class Vector4h
+	{
+	public:
+		static constexpr sizet ComponentCount = 4;
+		using value_type = Half;
+
+		Half X;
+		Half Y;
+		Half Z;
+		Half W;
+
+		constexpr Vector4h()noexcept = default;
+		INLINE constexpr Vector4h(Half x, Half y, Half z, Half w)noexcept :X(x), Y(y), Z(z), W(w) {  }
+		INLINE explicit Vector4h(const Vector4f& v)noexcept :X(v.X), Y(v.Y), Z(v.Z), W(v.W) {  }
+
+		NODISCARD INLINE constexpr Half& operator[](sizet index)noexcept
+		{
+			VerifyLess(index, ComponentCount, "Trying to access a Vector4h, but the index %" PRIuPTR " was out of range.", index);
+			return (&X)[index];
+		}
+		NODISCARD INLINE constexpr const Half& operator[](sizet index)const noexcept
+		{
+			VerifyLess(index, ComponentCount, "Trying to access a Vector4h, but the index %" PRIuPTR " was out of range.", index);
+			return (&X)[index];
+		}
+		NODISCARD INLINE Vector4f ToVector4f()const noexcept
+		{
+			return { X.Get(), Y.Get(), Z.Get(), W.Get() };
+		}
+		NODISCARD INLINE explicit operator Vector4f()const noexcept
+		{
+			return ToVector4f();
+		}
+		INLINE void Set(const Vector4f& v)noexcept
+		{
+			X.Set(v.X);
+			Y.Set(v.Y);
+			Z.Set(v.Z);
+			W.Set(v.W);
+		}
+		NODISCARD INLINE constexpr bool IsEqual(const Vector4h& other)const noexcept
+		{
+			return X == other.X && Y == other.Y && Z == other.Z && W == other.W;
+		}
+		NODISCARD INLINE String ToString()const noexcept
+		{
+			return ToVector4f().ToString();
+		}
+		INLINE void FromString(StringView str)noexcept
+		{
+			Vector4f v;
+			v.FromString(str);
+			Set(v);
+		}
+	};
+
+	NODISCARD INLINE constexpr bool operator==(const Vector4h& left, const Vector4h& right)noexcept { return left.IsEqual(right); }
+	NODISCARD INLINE constexpr bool operator!=(const Vector4h& left, const Vector4h& right)noexcept { return !(left == right); }
+}
+
+namespace greaper::math::Batch
+{
+	/* Bulk narrowing and widening, same results as Batch::ConvertToHalf and Batch::ConvertToFloat */
+	INLINE void ConvertToHalf(std::span<const Vector4f> in, std::span<Vector4h> out)noexcept
+	{
+		static_assert(sizeof(Vector4f) == sizeof(float) * 4 && sizeof(Vector4h) == sizeof(Half) * 4, "Batch::ConvertToHalf expects tightly packed vectors.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ConvertToHalf, but the output is bigger than the input.");
+		ConvertToHalf(std::span<const float>(reinterpret_cast<const float*>(in.data()), out.size() * 4), std::span<Half>(reinterpret_cast<Half*>(out.data()), out.size() * 4));
+	}
+	INLINE void ConvertToFloat(std::span<const Vector4h> in, std::span<Vector4f> out)noexcept
+	{
+		static_assert(sizeof(Vector4f) == sizeof(float) * 4 && sizeof(Vector4h) == sizeof(Half) * 4, "Batch::ConvertToFloat expects tightly packed vectors.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ConvertToFloat, but the output is bigger than the input.");
+		ConvertToFloat(std::span<const Half>(reinterpret_cast<const Half*>(in.data()), out.size() * 4), std::span<float>(reinterpret_cast<float*>(out.data()), out.size() * 4));
+	}
+}
+
+namespace std
+{
+	template<>
+	struct hash<greaper::math::Vector4h>
+	{
+		NODISCARD INLINE size_t operator()(const greaper::math::Vector4h& v)const noexcept
+		{
+			return ComputeHash(v.X.GetRaw(), v.Y.GetRaw(), v.Z.GetRaw(), v.W.GetRaw());
+		}
+	};
+}
+
+#endif /* MATH_VECTOR4HALF_H */
\ No newline at end of file
@@ -79,7 +79,7 @@ namespace greaper::math
 		{
 			return DotProduct(*this);
 		}
-		NODISCARD INLINE T Length()const noexcept
+		NODISCARD INLINE constexpr T Length()const noexcept
 		{
 			return Sqrt(LengthSquared());
 		}
@@ -87,11 +87,11 @@ namespace greaper::math
 		{
 			return Square(X - other.X) + Square(Y - other.Y) + Square(Z - other.Z) + Square(W - other.W);
 		}
-		NODISCARD INLINE T Distance(const Vector4Real& other)const noexcept
+		NODISCARD INLINE constexpr T Distance(const Vector4Real& other)const noexcept
 		{
 			return Sqrt(DistSquared(other));
 		}
-		NODISCARD INLINE Vector4Real GetNormalized(T tolerance = MATH_TOLERANCE<T>)const noexcept
+		NODISCARD INLINE constexpr Vector4Real GetNormalized(T tolerance = MATH_TOLERANCE<T>)const noexcept
 		{
 			auto len = LengthSquared();
 			if (len > tolerance)
@@ -101,7 +101,7 @@ namespace greaper::math
 			}
 			return *this;
 		}
-		INLINE void Normalize(T tolerance = MATH_TOLERANCE<T>)noexcept
+		INLINE constexpr void Normalize(T tolerance = MATH_TOLERANCE<T>)noexcept
 		{
 			*this = GetNormalized(tolerance);
 		}
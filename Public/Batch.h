@@ -0,0 +1,589 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_BATCH_H
+#define MATH_BATCH_H 1
+
+#include "MathPrerequisites.h"
+#include "FloatEnvironment.h"
+#include "Base/Half.h"
+#include "Base/BFloat16.h"
+#include <span>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <algorithm>
+
+MATH_STRICT_FP_BEGIN
+
+/* Element wise kernels over float spans, they pick the widest instruction set available at runtime.
+ * Every level produces exactly the same bits as the scalar one, the output may alias any input.
+ * With SetFlushDenormals(true) the kernels of the calling thread run inside a ScopedFloatEnvironment. */
+namespace greaper::math::Batch
+{
+	namespace Impl
+	{
+		INLINE bool& FlushDenormals()noexcept
+		{
+			static thread_local bool flush = false;
+			return flush;
+		}
+		template<class Fn, class... Args>
+		INLINE void DispatchAtLevel(Fn scalar, Fn sse41, Fn avx2, Fn avx512, Args... args)noexcept
+		{
+			switch (GetSIMDLevel())
+			{
+			case SIMDLevel_t::AVX512:
+				avx512(args...);
+				return;
+			case SIMDLevel_t::AVX2:
+				avx2(args...);
+				return;
+			case SIMDLevel_t::SSE41:
+				sse41(args...);
+				return;
+			default:
+				scalar(args...);
+				return;
+			}
+		}
+		template<class Fn, class... Args>
+		INLINE void Dispatch(Fn scalar, Fn sse41, Fn avx2, Fn avx512, Args... args)noexcept
+		{
+			if (FlushDenormals())
+			{
+				// Only FTZ / DAZ change, the kernels keep the rounding mode of the caller
+				const ScopedFloatEnvironment environment(true, true, ScopedFloatEnvironment::GetCurrentRounding());
+				DispatchAtLevel(scalar, sse41, avx2, avx512, args...);
+				return;
+			}
+			DispatchAtLevel(scalar, sse41, avx2, avx512, args...);
+		}
+
+#define MATH_BATCH_BINARY_KERNELS(name, scalarOp, sseOp, avxOp, avx512Op)\
+		INLINE void name##Scalar(const float* a, const float* b, float* out, sizet count)noexcept\
+		{\
+			for (sizet i = 0; i < count; ++i)\
+			{\
+				float l = a[i], r = b[i];\
+				out[i] = scalarOp;\
+			}\
+		}\
+		MATH_TARGET_SSE41 inline void name##SSE41(const float* a, const float* b, float* out, sizet count)noexcept\
+		{\
+			sizet i = 0;\
+			for (; i + 4 <= count; i += 4)\
+				_mm_storeu_ps(out + i, sseOp(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));\
+			name##Scalar(a + i, b + i, out + i, count - i);\
+		}\
+		MATH_TARGET_AVX2 inline void name##AVX2(const float* a, const float* b, float* out, sizet count)noexcept\
+		{\
+			sizet i = 0;\
+			for (; i + 8 <= count; i += 8)\
+				_mm256_storeu_ps(out + i, avxOp(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));\
+			name##SSE41(a + i, b + i, out + i, count - i);\
+		}\
+		MATH_TARGET_AVX512 inline void name##AVX512(const float* a, const float* b, float* out, sizet count)noexcept\
+		{\
+			sizet i = 0;\
+			for (; i + 16 <= count; i += 16)\
+				_mm512_storeu_ps(out + i, avx512Op(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));\
+			if (i < count)\
+			{\
+				auto mask = AVX512::TailMask16(count - i);\
+				_mm512_mask_storeu_ps(out + i, mask, avx512Op(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i)));\
+			}\
+		}
+
+		MATH_BATCH_BINARY_KERNELS(Add, l + r, _mm_add_ps, _mm256_add_ps, _mm512_add_ps);
+		MATH_BATCH_BINARY_KERNELS(Sub, l - r, _mm_sub_ps, _mm256_sub_ps, _mm512_sub_ps);
+		MATH_BATCH_BINARY_KERNELS(Mul, l * r, _mm_mul_ps, _mm256_mul_ps, _mm512_mul_ps);
+		MATH_BATCH_BINARY_KERNELS(Div, l / r, _mm_div_ps, _mm256_div_ps, _mm512_div_ps);
+		// Same NaN and signed zero handling as minps/maxps, the second operand is returned when unordered
+		MATH_BATCH_BINARY_KERNELS(Min, l < r ? l : r, _mm_min_ps, _mm256_min_ps, _mm512_min_ps);
+		MATH_BATCH_BINARY_KERNELS(Max, l > r ? l : r, _mm_max_ps, _mm256_max_ps, _mm512_max_ps);
+
+#undef MATH_BATCH_BINARY_KERNELS
+
+		INLINE void ScaleScalar(const float* a, float scale, float* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = a[i] * scale;
+		}
+		MATH_TARGET_SSE41 inline void ScaleSSE41(const float* a, float scale, float* out, sizet count)noexcept
+		{
+			auto s = _mm_set1_ps(scale);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+				_mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(a + i), s));
+			ScaleScalar(a + i, scale, out + i, count - i);
+		}
+		MATH_TARGET_AVX2 inline void ScaleAVX2(const float* a, float scale, float* out, sizet count)noexcept
+		{
+			auto s = _mm256_set1_ps(scale);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+				_mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), s));
+			ScaleSSE41(a + i, scale, out + i, count - i);
+		}
+		MATH_TARGET_AVX512 inline void ScaleAVX512(const float* a, float scale, float* out, sizet count)noexcept
+		{
+			auto s = _mm512_set1_ps(scale);
+			sizet i = 0;
+			for (; i + 16 <= count; i += 16)
+				_mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), s));
+			if (i < count)
+			{
+				auto mask = AVX512::TailMask16(count - i);
+				_mm512_mask_storeu_ps(out + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a + i), s));
+			}
+		}
+
+		INLINE void SqrtScalar(const float* a, float* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = std::sqrt(a[i]);
+		}
+		MATH_TARGET_SSE41 inline void SqrtSSE41(const float* a, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+				_mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_loadu_ps(a + i)));
+			SqrtScalar(a + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX2 inline void SqrtAVX2(const float* a, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+				_mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_loadu_ps(a + i)));
+			SqrtSSE41(a + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX512 inline void SqrtAVX512(const float* a, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 16 <= count; i += 16)
+				_mm512_storeu_ps(out + i, _mm512_sqrt_ps(_mm512_loadu_ps(a + i)));
+			if (i < count)
+			{
+				auto mask = AVX512::TailMask16(count - i);
+				_mm512_mask_storeu_ps(out + i, mask, _mm512_sqrt_ps(_mm512_maskz_loadu_ps(mask, a + i)));
+			}
+		}
+
+		/* std::fma has a single rounding like the fma instructions, SSE4.1 has none so it stays scalar */
+		INLINE void FusedMulAddScalar(const float* a, const float* b, const float* c, float* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = std::fma(a[i], b[i], c[i]);
+		}
+		MATH_TARGET_AVX2 inline void FusedMulAddAVX2(const float* a, const float* b, const float* c, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+				_mm256_storeu_ps(out + i, _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), _mm256_loadu_ps(c + i)));
+			FusedMulAddScalar(a + i, b + i, c + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX512 inline void FusedMulAddAVX512(const float* a, const float* b, const float* c, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 16 <= count; i += 16)
+				_mm512_storeu_ps(out + i, _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), _mm512_loadu_ps(c + i)));
+			if (i < count)
+			{
+				auto mask = AVX512::TailMask16(count - i);
+				_mm512_mask_storeu_ps(out + i, mask, _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, a + i), _mm512_maskz_loadu_ps(mask, b + i), _mm512_maskz_loadu_ps(mask, c + i)));
+			}
+		}
+
+		/* Half conversions work on the raw 16 bit patterns, F16C covers SSE4.1 machines that have it */
+		INLINE void ConvertToHalfScalar(const float* in, uint16* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = math::Impl::FloatToHalfBits(in[i]);
+		}
+		MATH_TARGET_F16C inline void ConvertToHalfF16C(const float* in, uint16* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+			if (i < count)
+			{
+				// Tail goes through a zero padded block so it is converted by the same instruction
+				alignas(32) float src[8] = {  };
+				alignas(16) uint16 dst[8];
+				std::copy_n(in + i, count - i, src);
+				_mm_store_si128(reinterpret_cast<__m128i*>(dst), _mm256_cvtps_ph(_mm256_load_ps(src), _MM_FROUND_TO_NEAREST_INT));
+				std::copy_n(dst, count - i, out + i);
+			}
+		}
+		MATH_TARGET_AVX512 inline void ConvertToHalfAVX512(const float* in, uint16* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 16 <= count; i += 16)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm512_cvtps_ph(_mm512_loadu_ps(in + i), _MM_FROUND_TO_NEAREST_INT));
+			if (i < count)
+			{
+				auto mask = AVX512::TailMask16(count - i);
+				_mm256_mask_storeu_epi16(out + i, mask, _mm512_cvtps_ph(_mm512_maskz_loadu_ps(mask, in + i), _MM_FROUND_TO_NEAREST_INT));
+			}
+		}
+
+		INLINE void ConvertToFloatScalar(const uint16* in, float* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = math::Impl::HalfBitsToFloat(in[i]);
+		}
+		MATH_TARGET_F16C inline void ConvertToFloatF16C(const uint16* in, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+				_mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i))));
+			if (i < count)
+			{
+				alignas(16) uint16 src[8] = {  };
+				alignas(32) float dst[8];
+				std::copy_n(in + i, count - i, src);
+				_mm256_store_ps(dst, _mm256_cvtph_ps(_mm_load_si128(reinterpret_cast<const __m128i*>(src))));
+				std::copy_n(dst, count - i, out + i);
+			}
+		}
+		MATH_TARGET_AVX512 inline void ConvertToFloatAVX512(const uint16* in, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 16 <= count; i += 16)
+				_mm512_storeu_ps(out + i, _mm512_cvtph_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i))));
+			if (i < count)
+			{
+				auto mask = AVX512::TailMask16(count - i);
+				_mm512_mask_storeu_ps(out + i, mask, _mm512_cvtph_ps(_mm256_maskz_loadu_epi16(mask, in + i)));
+			}
+		}
+
+		/* BFloat16 rounding is integer math on the float bits, only AVX-512 BF16 has a conversion instruction */
+		INLINE void ConvertToBFloat16Scalar(const float* in, uint16* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = math::Impl::FloatToBFloat16Bits(in[i]);
+		}
+		MATH_TARGET_SSE41 INLINE __m128i FloatToBFloat16BitsSSE41(__m128 v)noexcept
+		{
+			const __m128i f = _mm_castps_si128(v);
+			const __m128i high = _mm_srli_epi32(f, 16);
+			const __m128i bias = _mm_add_epi32(_mm_set1_epi32(0x7FFF), _mm_and_si128(high, _mm_set1_epi32(1)));
+			__m128i res = _mm_srli_epi32(_mm_add_epi32(f, bias), 16);
+			res = _mm_blendv_epi8(res, _mm_or_si128(high, _mm_set1_epi32(0x40)), _mm_castps_si128(_mm_cmpunord_ps(v, v)));
+			const __m128i small = _mm_cmpeq_epi32(_mm_and_si128(f, _mm_set1_epi32(0x7F800000)), _mm_setzero_si128());
+			return _mm_blendv_epi8(res, _mm_and_si128(high, _mm_set1_epi32(0x8000)), small);
+		}
+		MATH_TARGET_SSE41 inline void ConvertToBFloat16SSE41(const float* in, uint16* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m128i lo = FloatToBFloat16BitsSSE41(_mm_loadu_ps(in + i));
+				const __m128i hi = FloatToBFloat16BitsSSE41(_mm_loadu_ps(in + i + 4));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi32(lo, hi));
+			}
+			ConvertToBFloat16Scalar(in + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX2 INLINE __m256i FloatToBFloat16BitsAVX2(__m256 v)noexcept
+		{
+			const __m256i f = _mm256_castps_si256(v);
+			const __m256i high = _mm256_srli_epi32(f, 16);
+			const __m256i bias = _mm256_add_epi32(_mm256_set1_epi32(0x7FFF), _mm256_and_si256(high, _mm256_set1_epi32(1)));
+			__m256i res = _mm256_srli_epi32(_mm256_add_epi32(f, bias), 16);
+			res = _mm256_blendv_epi8(res, _mm256_or_si256(high, _mm256_set1_epi32(0x40)), _mm256_castps_si256(_mm256_cmp_ps(v, v, _CMP_UNORD_Q)));
+			const __m256i small = _mm256_cmpeq_epi32(_mm256_and_si256(f, _mm256_set1_epi32(0x7F800000)), _mm256_setzero_si256());
+			return _mm256_blendv_epi8(res, _mm256_and_si256(high, _mm256_set1_epi32(0x8000)), small);
+		}
+		MATH_TARGET_AVX2 inline void ConvertToBFloat16AVX2(const float* in, uint16* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				const __m256i lo = FloatToBFloat16BitsAVX2(_mm256_loadu_ps(in + i));
+				const __m256i hi = FloatToBFloat16BitsAVX2(_mm256_loadu_ps(in + i + 8));
+				// Pack works per 128 bit lane, put the quarters back in order
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), _MM_SHUFFLE(3, 1, 2, 0)));
+			}
+			ConvertToBFloat16SSE41(in + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX512BF16 inline void ConvertToBFloat16AVX512BF16(const float* in, uint16* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				const __m256bh res = _mm512_cvtneps_pbh(_mm512_loadu_ps(in + i));
+				std::memcpy(out + i, &res, sizeof(res));
+			}
+			if (i < count)
+			{
+				alignas(32) uint16 dst[16];
+				const __m256bh res = _mm512_cvtneps_pbh(_mm512_maskz_loadu_ps(AVX512::TailMask16(count - i), in + i));
+				std::memcpy(dst, &res, sizeof(res));
+				std::copy_n(dst, count - i, out + i);
+			}
+		}
+
+		INLINE void ConvertFromBFloat16Scalar(const uint16* in, float* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = math::Impl::BFloat16BitsToFloat(in[i]);
+		}
+		MATH_TARGET_SSE41 inline void ConvertFromBFloat16SSE41(const uint16* in, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				// Interleaving with zeros puts every value in the top half of its float
+				const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				_mm_storeu_ps(out + i, _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), b)));
+				_mm_storeu_ps(out + i + 4, _mm_castsi128_ps(_mm_unpackhi_epi16(_mm_setzero_si128(), b)));
+			}
+			ConvertFromBFloat16Scalar(in + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX2 inline void ConvertFromBFloat16AVX2(const uint16* in, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256i b = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)));
+				_mm256_storeu_ps(out + i, _mm256_castsi256_ps(_mm256_slli_epi32(b, 16)));
+			}
+			ConvertFromBFloat16SSE41(in + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX512 inline void ConvertFromBFloat16AVX512(const uint16* in, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				const __m512i b = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)));
+				_mm512_storeu_ps(out + i, _mm512_castsi512_ps(_mm512_slli_epi32(b, 16)));
+			}
+			if (i < count)
+			{
+				auto mask = AVX512::TailMask16(count - i);
+				const __m512i b = _mm512_cvtepu16_epi32(_mm256_maskz_loadu_epi16(mask, in + i));
+				_mm512_mask_storeu_ps(out + i, mask, _mm512_castsi512_ps(_mm512_slli_epi32(b, 16)));
+			}
+		}
+
+		/* Lane wise math::Impl::SaturateToInt32, cvtt returns 0x80000000 for any lane it can not convert and
+		 * flipping it gives INT32_MAX */
+		MATH_TARGET_SSE41 INLINE __m128i ConvertSaturated(__m128 x)noexcept
+		{
+			const auto converted = _mm_xor_si128(_mm_cvttps_epi32(x), _mm_castps_si128(_mm_cmpge_ps(x, _mm_set1_ps(2147483648.f))));
+			return _mm_and_si128(converted, _mm_castps_si128(_mm_cmpord_ps(x, x)));
+		}
+		MATH_TARGET_AVX2 INLINE __m256i ConvertSaturated(__m256 x)noexcept
+		{
+			const auto converted = _mm256_xor_si256(_mm256_cvttps_epi32(x), _mm256_castps_si256(_mm256_cmp_ps(x, _mm256_set1_ps(2147483648.f), _CMP_GE_OQ)));
+			return _mm256_and_si256(converted, _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_ORD_Q)));
+		}
+		MATH_TARGET_AVX512 INLINE __m512i ConvertSaturated(__m512 x)noexcept
+		{
+			const auto converted = _mm512_mask_mov_epi32(_mm512_cvttps_epi32(x), _mm512_cmp_ps_mask(x, _mm512_set1_ps(2147483648.f), _CMP_GE_OQ),
+				_mm512_set1_epi32(std::numeric_limits<int32>::max()));
+			return _mm512_maskz_mov_epi32(_mm512_cmp_ps_mask(x, x, _CMP_ORD_Q), converted);
+		}
+
+		/* The SIMD ops round to an integral float and ConvertSaturated does the rest, like the scalar functions */
+#define MATH_BATCH_ROUNDING_KERNELS(name, scalarOp, sseOp, avxOp, avx512Op)\
+		INLINE void name##Scalar(const float* in, int32* out, sizet count)noexcept\
+		{\
+			for (sizet i = 0; i < count; ++i)\
+			{\
+				float x = in[i];\
+				out[i] = scalarOp;\
+			}\
+		}\
+		MATH_TARGET_SSE41 inline void name##SSE41(const float* in, int32* out, sizet count)noexcept\
+		{\
+			sizet i = 0;\
+			for (; i + 4 <= count; i += 4)\
+			{\
+				const __m128 v = _mm_loadu_ps(in + i);\
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), ConvertSaturated(sseOp));\
+			}\
+			name##Scalar(in + i, out + i, count - i);\
+		}\
+		MATH_TARGET_AVX2 inline void name##AVX2(const float* in, int32* out, sizet count)noexcept\
+		{\
+			sizet i = 0;\
+			for (; i + 8 <= count; i += 8)\
+			{\
+				const __m256 v = _mm256_loadu_ps(in + i);\
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), ConvertSaturated(avxOp));\
+			}\
+			name##SSE41(in + i, out + i, count - i);\
+		}\
+		MATH_TARGET_AVX512 inline void name##AVX512(const float* in, int32* out, sizet count)noexcept\
+		{\
+			sizet i = 0;\
+			for (; i + 16 <= count; i += 16)\
+			{\
+				const __m512 v = _mm512_loadu_ps(in + i);\
+				_mm512_storeu_si512(out + i, ConvertSaturated(avx512Op));\
+			}\
+			if (i < count)\
+			{\
+				auto mask = AVX512::TailMask16(count - i);\
+				const __m512 v = _mm512_maskz_loadu_ps(mask, in + i);\
+				_mm512_mask_storeu_epi32(out + i, mask, ConvertSaturated(avx512Op));\
+			}\
+		}
+
+		MATH_BATCH_ROUNDING_KERNELS(FloorInt, math::FloorInt<float>(x),
+			_mm_round_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC),
+			_mm256_round_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC),
+			_mm512_roundscale_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+		MATH_BATCH_ROUNDING_KERNELS(CeilInt, math::CeilInt<float>(x),
+			_mm_round_ps(v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC),
+			_mm256_round_ps(v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC),
+			_mm512_roundscale_ps(v, _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC));
+		// RoundInt is FloorInt(x + 0.5f), halves round up and the addition rounds like the scalar one
+		MATH_BATCH_ROUNDING_KERNELS(RoundInt, math::RoundInt<float>(x),
+			_mm_round_ps(_mm_add_ps(v, _mm_set1_ps(0.5f)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC),
+			_mm256_round_ps(_mm256_add_ps(v, _mm256_set1_ps(0.5f)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC),
+			_mm512_roundscale_ps(_mm512_add_ps(v, _mm512_set1_ps(0.5f)), _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+		MATH_BATCH_ROUNDING_KERNELS(TruncInt, math::TruncInt<float>(x), v, v, v);
+
+#undef MATH_BATCH_ROUNDING_KERNELS
+	}
+
+	/* Makes the batch kernels called from this thread flush denormal inputs and results to zero, the control
+	 * register is only changed for the duration of each call and the rounding mode is left as the caller set it */
+	INLINE void SetFlushDenormals(bool flush)noexcept
+	{
+		Impl::FlushDenormals() = flush;
+	}
+	NODISCARD INLINE bool GetFlushDenormals()noexcept
+	{
+		return Impl::FlushDenormals();
+	}
+	/* out[i] = a[i] + b[i] */
+	INLINE void Add(std::span<const float> a, std::span<const float> b, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.size(), "Trying to Batch::Add, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.size(), "Trying to Batch::Add, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::AddScalar, &Impl::AddSSE41, &Impl::AddAVX2, &Impl::AddAVX512, a.data(), b.data(), out.data(), out.size());
+	}
+	/* out[i] = a[i] - b[i] */
+	INLINE void Sub(std::span<const float> a, std::span<const float> b, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.size(), "Trying to Batch::Sub, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.size(), "Trying to Batch::Sub, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::SubScalar, &Impl::SubSSE41, &Impl::SubAVX2, &Impl::SubAVX512, a.data(), b.data(), out.data(), out.size());
+	}
+	/* out[i] = a[i] * b[i] */
+	INLINE void Mul(std::span<const float> a, std::span<const float> b, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.size(), "Trying to Batch::Mul, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.size(), "Trying to Batch::Mul, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::MulScalar, &Impl::MulSSE41, &Impl::MulAVX2, &Impl::MulAVX512, a.data(), b.data(), out.data(), out.size());
+	}
+	/* out[i] = a[i] / b[i] */
+	INLINE void Div(std::span<const float> a, std::span<const float> b, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.size(), "Trying to Batch::Div, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.size(), "Trying to Batch::Div, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::DivScalar, &Impl::DivSSE41, &Impl::DivAVX2, &Impl::DivAVX512, a.data(), b.data(), out.data(), out.size());
+	}
+	/* out[i] = a[i] < b[i] ? a[i] : b[i] */
+	INLINE void Min(std::span<const float> a, std::span<const float> b, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.size(), "Trying to Batch::Min, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.size(), "Trying to Batch::Min, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::MinScalar, &Impl::MinSSE41, &Impl::MinAVX2, &Impl::MinAVX512, a.data(), b.data(), out.data(), out.size());
+	}
+	/* out[i] = a[i] > b[i] ? a[i] : b[i] */
+	INLINE void Max(std::span<const float> a, std::span<const float> b, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.size(), "Trying to Batch::Max, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.size(), "Trying to Batch::Max, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::MaxScalar, &Impl::MaxSSE41, &Impl::MaxAVX2, &Impl::MaxAVX512, a.data(), b.data(), out.data(), out.size());
+	}
+	/* out[i] = a[i] * scale */
+	INLINE void Scale(std::span<const float> a, float scale, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.size(), "Trying to Batch::Scale, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::ScaleScalar, &Impl::ScaleSSE41, &Impl::ScaleAVX2, &Impl::ScaleAVX512, a.data(), scale, out.data(), out.size());
+	}
+	/* out[i] = sqrt(a[i]) */
+	INLINE void Sqrt(std::span<const float> a, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.size(), "Trying to Batch::Sqrt, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::SqrtScalar, &Impl::SqrtSSE41, &Impl::SqrtAVX2, &Impl::SqrtAVX512, a.data(), out.data(), out.size());
+	}
+	/* out[i] = a[i] * b[i] + c[i] rounded once */
+	INLINE void FusedMulAdd(std::span<const float> a, std::span<const float> b, std::span<const float> c, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.size(), "Trying to Batch::FusedMulAdd, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.size(), "Trying to Batch::FusedMulAdd, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), c.size(), "Trying to Batch::FusedMulAdd, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::FusedMulAddScalar, &Impl::FusedMulAddScalar, &Impl::FusedMulAddAVX2, &Impl::FusedMulAddAVX512, a.data(), b.data(), c.data(), out.data(), out.size());
+	}
+	/* out[i] = Half(in[i]), rounding to nearest even. The software fallback gives the same bits as F16C. */
+	INLINE void ConvertToHalf(std::span<const float> in, std::span<Half> out)noexcept
+	{
+		static_assert(sizeof(Half) == sizeof(uint16), "Batch::ConvertToHalf expects Half to be a bare 16 bit value.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ConvertToHalf, but the output is bigger than the input.");
+		auto sse41 = GetCPUFeatures().F16C ? &Impl::ConvertToHalfF16C : &Impl::ConvertToHalfScalar;
+		Impl::Dispatch(&Impl::ConvertToHalfScalar, sse41, &Impl::ConvertToHalfF16C, &Impl::ConvertToHalfAVX512, in.data(), reinterpret_cast<uint16*>(out.data()), out.size());
+	}
+	/* out[i] = float(in[i]), exact */
+	INLINE void ConvertToFloat(std::span<const Half> in, std::span<float> out)noexcept
+	{
+		static_assert(sizeof(Half) == sizeof(uint16), "Batch::ConvertToFloat expects Half to be a bare 16 bit value.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ConvertToFloat, but the output is bigger than the input.");
+		auto sse41 = GetCPUFeatures().F16C ? &Impl::ConvertToFloatF16C : &Impl::ConvertToFloatScalar;
+		Impl::Dispatch(&Impl::ConvertToFloatScalar, sse41, &Impl::ConvertToFloatF16C, &Impl::ConvertToFloatAVX512, reinterpret_cast<const uint16*>(in.data()), out.data(), out.size());
+	}
+	/* out[i] = BFloat16(in[i]), rounding to nearest even and flushing subnormals to zero on every path */
+	INLINE void ConvertToBFloat16(std::span<const float> in, std::span<BFloat16> out)noexcept
+	{
+		static_assert(sizeof(BFloat16) == sizeof(uint16), "Batch::ConvertToBFloat16 expects BFloat16 to be a bare 16 bit value.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ConvertToBFloat16, but the output is bigger than the input.");
+		auto avx512 = GetCPUFeatures().AVX512BF16 ? &Impl::ConvertToBFloat16AVX512BF16 : &Impl::ConvertToBFloat16AVX2;
+		Impl::Dispatch(&Impl::ConvertToBFloat16Scalar, &Impl::ConvertToBFloat16SSE41, &Impl::ConvertToBFloat16AVX2, avx512, in.data(), reinterpret_cast<uint16*>(out.data()), out.size());
+	}
+	/* out[i] = float(in[i]), exact */
+	INLINE void ConvertToFloat(std::span<const BFloat16> in, std::span<float> out)noexcept
+	{
+		static_assert(sizeof(BFloat16) == sizeof(uint16), "Batch::ConvertToFloat expects BFloat16 to be a bare 16 bit value.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ConvertToFloat, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::ConvertFromBFloat16Scalar, &Impl::ConvertFromBFloat16SSE41, &Impl::ConvertFromBFloat16AVX2, &Impl::ConvertFromBFloat16AVX512, reinterpret_cast<const uint16*>(in.data()), out.data(), out.size());
+	}
+	/* out[i] = FloorInt(in[i]), out of range values saturate and NaN gives 0 like the scalar function */
+	INLINE void FloorInt(std::span<const float> in, std::span<int32> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::FloorInt, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::FloorIntScalar, &Impl::FloorIntSSE41, &Impl::FloorIntAVX2, &Impl::FloorIntAVX512, in.data(), out.data(), out.size());
+	}
+	/* out[i] = CeilInt(in[i]), out of range values saturate and NaN gives 0 like the scalar function */
+	INLINE void CeilInt(std::span<const float> in, std::span<int32> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::CeilInt, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::CeilIntScalar, &Impl::CeilIntSSE41, &Impl::CeilIntAVX2, &Impl::CeilIntAVX512, in.data(), out.data(), out.size());
+	}
+	/* out[i] = RoundInt(in[i]), halves round up, out of range values saturate and NaN gives 0 like the scalar function */
+	INLINE void RoundInt(std::span<const float> in, std::span<int32> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::RoundInt, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::RoundIntScalar, &Impl::RoundIntSSE41, &Impl::RoundIntAVX2, &Impl::RoundIntAVX512, in.data(), out.data(), out.size());
+	}
+	/* out[i] = TruncInt(in[i]), out of range values saturate and NaN gives 0 like the scalar function */
+	INLINE void TruncInt(std::span<const float> in, std::span<int32> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::TruncInt, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::TruncIntScalar, &Impl::TruncIntSSE41, &Impl::TruncIntAVX2, &Impl::TruncIntAVX512, in.data(), out.data(), out.size());
+	}
+}
+
+MATH_STRICT_FP_END
+
+#endif /* MATH_BATCH_H */
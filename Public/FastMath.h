@@ -0,0 +1,337 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_FASTMATH_H
+#define MATH_FASTMATH_H 1
+
+#include "MathPrerequisites.h"
+#include <bit>
+#include <cmath>
+#include <limits>
+
+MATH_STRICT_FP_BEGIN
+
+/* Opt-in approximations that trade accuracy for speed, for code such as normalization or slerp weights that
+ * can live with around 1e-5 of error. Nothing outside this namespace uses them, the accurate functions stay in
+ * math:: and the vectorized accurate ones in Transcendental.h. The float and the 4 lane versions run the same
+ * operations in the same order and give the same bits.
+ *
+ * Maximum error, measured over every float in the stated range (ATan2 over every y with x = +-1 and 2^26
+ * random pairs):
+ *	InvSqrt		3.0e-7 relative, positive normal inputs
+ *	Rcp			1.9e-7 relative, |x| in [2^-126, 2^126)
+ *	Sin/Cos		1.3e-5 absolute, |x| <= 8192
+ *	ATan2		1.2e-5 absolute
+ *	Exp2		3.0e-6 relative, x in [-126, 128)
+ *	Log2		3.3e-5 absolute, positive normal inputs
+ *	ACos		3.8e-5 absolute, x in [-1, 1]
+ * Denormals are flushed: InvSqrt and Rcp return infinity for them, Log2 returns -inf and Exp2 returns 0 below
+ * -127. ATan2 of two infinities is NaN. Past 8192, and for infinities and NaN, Sin and Cos call the accurate
+ * math::Sin and math::Cos, which is slow but keeps the result bounded. */
+
+namespace greaper::math::fast
+{
+	namespace Impl
+	{
+		/* pi / 2 split so the first two parts times the quadrant are exact */
+		inline constexpr float TWO_OVER_PI = 0.636619772f;
+		inline constexpr float HALF_PI_HI = 1.5703125f;
+		inline constexpr float HALF_PI_MID = 4.837512969970703125e-4f;
+		inline constexpr float HALF_PI_LO = 7.54978995e-8f;
+		inline constexpr float ROUND_MAGIC = 12582912.f; // 1.5 * 2^23
+		inline constexpr float SIN_REDUCTION_LIMIT = 8192.f;
+
+		/* sin(r) = r + r^3 * (S1 + r^2 * S2), cos(r) = 1 + r^2 * (C1 + r^2 * C2) with |r| <= pi / 4 */
+		inline constexpr float SIN_S1 = -0.166628338f;
+		inline constexpr float SIN_S2 = 8.15299235e-3f;
+		inline constexpr float COS_C1 = -0.499776307f;
+		inline constexpr float COS_C2 = 4.04889358e-2f;
+
+		/* atan(r) = r * (A0 + r^2 * (A1 + ...)) with r in [0, 1] */
+		inline constexpr float ATAN_A0 = 0.999866329f;
+		inline constexpr float ATAN_A1 = -0.330304786f;
+		inline constexpr float ATAN_A2 = 0.180159295f;
+		inline constexpr float ATAN_A3 = -8.51563509e-2f;
+		inline constexpr float ATAN_A4 = 2.08451142e-2f;
+
+		/* 2^f = 1 + f * (E1 + f * (E2 + ...)) with f in [0, 1) */
+		inline constexpr float EXP2_E1 = 0.693044845f;
+		inline constexpr float EXP2_E2 = 0.241280205f;
+		inline constexpr float EXP2_E3 = 5.22424742e-2f;
+		inline constexpr float EXP2_E4 = 1.34266843e-2f;
+
+		/* log2(1 + u) = u * (L1 + u * (L2 + ...)) with 1 + u in [sqrt(0.5), sqrt(2)] */
+		inline constexpr float LOG2_L1 = 1.44226364f;
+		inline constexpr float LOG2_L2 = -0.721159488f;
+		inline constexpr float LOG2_L3 = 0.496625576f;
+		inline constexpr float LOG2_L4 = -0.381153770f;
+		inline constexpr float LOG2_L5 = 0.182369603f;
+		inline constexpr float SQRT2 = 1.41421356f;
+
+		/* acos(x) = sqrt(1 - x) * (P0 + x * (P1 + x * (P2 + x * P3))) with x in [0, 1] */
+		inline constexpr float ACOS_P0 = 1.57075834f;
+		inline constexpr float ACOS_P1 = -0.212875184f;
+		inline constexpr float ACOS_P2 = 7.68973875e-2f;
+		inline constexpr float ACOS_P3 = -2.08920372e-2f;
+
+		INLINE SSE::Vector4f AbsMask()noexcept { return _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)); }
+		INLINE SSE::Vector4f SignMask()noexcept { return _mm_castsi128_ps(_mm_set1_epi32(static_cast<int32>(0x80000000))); }
+		INLINE SSE::Vector4f Select(SSE::Vector4f mask, SSE::Vector4f ifTrue, SSE::Vector4f ifFalse)noexcept
+		{
+			return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse));
+		}
+		/* Lanes where the hardware estimate is zero or infinite, a Newton-Raphson step would turn them into NaN */
+		INLINE SSE::Vector4f EstimateIsExtreme(SSE::Vector4f estimate)noexcept
+		{
+			const auto absEstimate = _mm_and_ps(estimate, AbsMask());
+			return _mm_or_ps(_mm_cmpeq_ps(absEstimate, _mm_set1_ps(std::numeric_limits<float>::infinity())),
+				_mm_cmpeq_ps(absEstimate, _mm_setzero_ps()));
+		}
+		INLINE bool EstimateIsExtreme(float estimate)noexcept
+		{
+			return estimate == 0.f || std::fabs(estimate) == std::numeric_limits<float>::infinity();
+		}
+
+		/* Inputs the three part reduction does not cover */
+		INLINE float SinQuadrantLarge(float x, int32 quadrantOffset)noexcept
+		{
+			return quadrantOffset == 0 ? math::Sin(x) : math::Cos(x);
+		}
+		/* Sin and Cos share the reduction, Cos starts one quadrant later */
+		INLINE SSE::Vector4f SinQuadrant(SSE::Vector4f x, int32 quadrantOffset)noexcept
+		{
+			const int32 largeLanes = _mm_movemask_ps(_mm_cmpnle_ps(_mm_and_ps(x, AbsMask()), _mm_set1_ps(SIN_REDUCTION_LIMIT)));
+
+			auto quadrant = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(TWO_OVER_PI)));
+			const auto quadrantF = _mm_cvtepi32_ps(quadrant);
+			auto r = _mm_sub_ps(x, _mm_mul_ps(quadrantF, _mm_set1_ps(HALF_PI_HI)));
+			r = _mm_sub_ps(r, _mm_mul_ps(quadrantF, _mm_set1_ps(HALF_PI_MID)));
+			r = _mm_sub_ps(r, _mm_mul_ps(quadrantF, _mm_set1_ps(HALF_PI_LO)));
+			quadrant = _mm_add_epi32(quadrant, _mm_set1_epi32(quadrantOffset));
+
+			const auto z = _mm_mul_ps(r, r);
+			auto sinR = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(SIN_S2)), _mm_set1_ps(SIN_S1));
+			sinR = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, z), sinR));
+			auto cosR = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(COS_C2)), _mm_set1_ps(COS_C1));
+			cosR = _mm_add_ps(_mm_set1_ps(1.f), _mm_mul_ps(z, cosR));
+
+			const auto useCos = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+			const auto sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), 30));
+			const auto result = _mm_xor_ps(Select(useCos, cosR, sinR), sign);
+			if (largeLanes == 0)
+				return result;
+
+			alignas(16) float lanes[4], results[4];
+			_mm_store_ps(lanes, x);
+			_mm_store_ps(results, result);
+			for (int32 i = 0; i < 4; ++i)
+			{
+				if ((largeLanes & (1 << i)) != 0)
+					results[i] = SinQuadrantLarge(lanes[i], quadrantOffset);
+			}
+			return _mm_load_ps(results);
+		}
+		INLINE float SinQuadrant(float x, int32 quadrantOffset)noexcept
+		{
+			if (!(std::fabs(x) <= SIN_REDUCTION_LIMIT))
+				return SinQuadrantLarge(x, quadrantOffset);
+			// Adding and removing 1.5 * 2^23 rounds to nearest even like _mm_cvtps_epi32 for |x| <= 8192
+			const float quadrantF = (x * TWO_OVER_PI + ROUND_MAGIC) - ROUND_MAGIC;
+			float r = x - quadrantF * HALF_PI_HI;
+			r = r - quadrantF * HALF_PI_MID;
+			r = r - quadrantF * HALF_PI_LO;
+			const int32 quadrant = static_cast<int32>(quadrantF) + quadrantOffset;
+
+			const float z = r * r;
+			const float sinR = r + (r * z) * (z * SIN_S2 + SIN_S1);
+			const float cosR = 1.f + z * (z * COS_C2 + COS_C1);
+			const float result = (quadrant & 1) != 0 ? cosR : sinR;
+			return (quadrant & 2) != 0 ? -result : result;
+		}
+	}
+
+	/* 1 / sqrt(x) from the hardware estimate refined with one Newton-Raphson step */
+	NODISCARD INLINE SSE::Vector4f InvSqrt(SSE::Vector4f x)noexcept
+	{
+		const auto estimate = _mm_rsqrt_ps(x);
+		const auto halfX = _mm_mul_ps(x, _mm_set1_ps(0.5f));
+		const auto refined = _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.5f), _mm_mul_ps(_mm_mul_ps(halfX, estimate), estimate)));
+		return Impl::Select(Impl::EstimateIsExtreme(estimate), estimate, refined);
+	}
+	NODISCARD INLINE float InvSqrt(float x)noexcept
+	{
+		const float estimate = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+		if (Impl::EstimateIsExtreme(estimate))
+			return estimate;
+		return estimate * (1.5f - ((x * 0.5f) * estimate) * estimate);
+	}
+	/* 1 / x from the hardware estimate refined with one Newton-Raphson step */
+	NODISCARD INLINE SSE::Vector4f Rcp(SSE::Vector4f x)noexcept
+	{
+		const auto estimate = _mm_rcp_ps(x);
+		const auto refined = _mm_add_ps(estimate, _mm_mul_ps(estimate, _mm_sub_ps(_mm_set1_ps(1.f), _mm_mul_ps(x, estimate))));
+		return Impl::Select(Impl::EstimateIsExtreme(estimate), estimate, refined);
+	}
+	NODISCARD INLINE float Rcp(float x)noexcept
+	{
+		const float estimate = _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(x)));
+		if (Impl::EstimateIsExtreme(estimate))
+			return estimate;
+		return estimate + estimate * (1.f - x * estimate);
+	}
+
+	NODISCARD INLINE SSE::Vector4f Sin(SSE::Vector4f x)noexcept { return Impl::SinQuadrant(x, 0); }
+	NODISCARD INLINE float Sin(float x)noexcept { return Impl::SinQuadrant(x, 0); }
+	NODISCARD INLINE SSE::Vector4f Cos(SSE::Vector4f x)noexcept { return Impl::SinQuadrant(x, 1); }
+	NODISCARD INLINE float Cos(float x)noexcept { return Impl::SinQuadrant(x, 1); }
+
+	/* atan(y / x) in the quadrant of (x, y), atan2(+-0, +-0) follows the signs like std::atan2 */
+	NODISCARD INLINE SSE::Vector4f ATan2(SSE::Vector4f y, SSE::Vector4f x)noexcept
+	{
+		const auto absY = _mm_and_ps(y, Impl::AbsMask());
+		const auto absX = _mm_and_ps(x, Impl::AbsMask());
+		const auto maxAbs = _mm_max_ps(absX, absY);
+		const auto ratio = _mm_and_ps(_mm_div_ps(_mm_min_ps(absX, absY), maxAbs), _mm_cmpgt_ps(maxAbs, _mm_setzero_ps()));
+		const auto z = _mm_mul_ps(ratio, ratio);
+		auto t = _mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(Impl::ATAN_A4)), _mm_set1_ps(Impl::ATAN_A3));
+		t = _mm_add_ps(_mm_mul_ps(z, t), _mm_set1_ps(Impl::ATAN_A2));
+		t = _mm_add_ps(_mm_mul_ps(z, t), _mm_set1_ps(Impl::ATAN_A1));
+		t = _mm_add_ps(_mm_mul_ps(z, t), _mm_set1_ps(Impl::ATAN_A0));
+		t = _mm_mul_ps(ratio, t);
+
+		t = Impl::Select(_mm_cmpgt_ps(absY, absX), _mm_sub_ps(_mm_set1_ps(HALF_PI<float>), t), t);
+		const auto negativeX = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31));
+		t = Impl::Select(negativeX, _mm_sub_ps(_mm_set1_ps(PI<float>), t), t);
+		t = _mm_or_ps(_mm_and_ps(t, Impl::AbsMask()), _mm_and_ps(y, Impl::SignMask()));
+		return Impl::Select(_mm_cmpunord_ps(x, y), _mm_add_ps(x, y), t);
+	}
+	NODISCARD INLINE float ATan2(float y, float x)noexcept
+	{
+		if (std::isnan(x) || std::isnan(y))
+			return x + y;
+		const float absY = std::fabs(y);
+		const float absX = std::fabs(x);
+		const float maxAbs = absX > absY ? absX : absY;
+		const float ratio = maxAbs > 0.f ? (absX < absY ? absX : absY) / maxAbs : 0.f;
+		const float z = ratio * ratio;
+		float t = z * Impl::ATAN_A4 + Impl::ATAN_A3;
+		t = z * t + Impl::ATAN_A2;
+		t = z * t + Impl::ATAN_A1;
+		t = z * t + Impl::ATAN_A0;
+		t = ratio * t;
+
+		if (absY > absX)
+			t = HALF_PI<float> - t;
+		if (std::signbit(x))
+			t = PI<float> - t;
+		return std::copysign(t, y);
+	}
+
+	/* 2^x, 0 below -127 and infinity from 128 on */
+	NODISCARD INLINE SSE::Vector4f Exp2(SSE::Vector4f x)noexcept
+	{
+		const auto clamped = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-127.f)), _mm_set1_ps(128.f));
+		auto floorX = _mm_cvtepi32_ps(_mm_cvttps_epi32(clamped));
+		floorX = _mm_sub_ps(floorX, _mm_and_ps(_mm_cmpgt_ps(floorX, clamped), _mm_set1_ps(1.f)));
+		const auto f = _mm_sub_ps(clamped, floorX);
+		auto p = _mm_add_ps(_mm_mul_ps(f, _mm_set1_ps(Impl::EXP2_E4)), _mm_set1_ps(Impl::EXP2_E3));
+		p = _mm_add_ps(_mm_mul_ps(f, p), _mm_set1_ps(Impl::EXP2_E2));
+		p = _mm_add_ps(_mm_mul_ps(f, p), _mm_set1_ps(Impl::EXP2_E1));
+		p = _mm_add_ps(_mm_mul_ps(f, p), _mm_set1_ps(1.f));
+		// An exponent field of 0 gives 0 for -127 and of 255 gives infinity for 128
+		const auto scale = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(floorX), _mm_set1_epi32(127)), 23);
+		return Impl::Select(_mm_cmpunord_ps(x, x), x, _mm_mul_ps(p, _mm_castsi128_ps(scale)));
+	}
+	NODISCARD INLINE float Exp2(float x)noexcept
+	{
+		if (std::isnan(x))
+			return x;
+		const float clamped = x < -127.f ? -127.f : (x > 128.f ? 128.f : x);
+		float floorX = static_cast<float>(static_cast<int32>(clamped));
+		if (floorX > clamped)
+			floorX -= 1.f;
+		const float f = clamped - floorX;
+		float p = f * Impl::EXP2_E4 + Impl::EXP2_E3;
+		p = f * p + Impl::EXP2_E2;
+		p = f * p + Impl::EXP2_E1;
+		p = f * p + 1.f;
+		return p * std::bit_cast<float>(static_cast<uint32>(static_cast<int32>(floorX) + 127) << 23);
+	}
+
+	/* log2(x), -inf for zeros and denormals, NaN for negatives */
+	NODISCARD INLINE SSE::Vector4f Log2(SSE::Vector4f x)noexcept
+	{
+		const auto bits = _mm_castps_si128(x);
+		auto exponent = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+		auto mantissa = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007FFFFF)), _mm_set1_epi32(0x3F800000)));
+		// Keeps the mantissa in [sqrt(0.5), sqrt(2)] where the polynomial is fitted
+		const auto aboveSqrt2 = _mm_cmpgt_ps(mantissa, _mm_set1_ps(Impl::SQRT2));
+		mantissa = Impl::Select(aboveSqrt2, _mm_mul_ps(mantissa, _mm_set1_ps(0.5f)), mantissa);
+		exponent = _mm_sub_epi32(exponent, _mm_castps_si128(aboveSqrt2));
+
+		const auto u = _mm_sub_ps(mantissa, _mm_set1_ps(1.f));
+		auto p = _mm_add_ps(_mm_mul_ps(u, _mm_set1_ps(Impl::LOG2_L5)), _mm_set1_ps(Impl::LOG2_L4));
+		p = _mm_add_ps(_mm_mul_ps(u, p), _mm_set1_ps(Impl::LOG2_L3));
+		p = _mm_add_ps(_mm_mul_ps(u, p), _mm_set1_ps(Impl::LOG2_L2));
+		p = _mm_add_ps(_mm_mul_ps(u, p), _mm_set1_ps(Impl::LOG2_L1));
+		auto result = _mm_add_ps(_mm_cvtepi32_ps(exponent), _mm_mul_ps(u, p));
+
+		const auto infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+		result = Impl::Select(_mm_cmplt_ps(x, _mm_set1_ps(std::numeric_limits<float>::min())), _mm_sub_ps(_mm_setzero_ps(), infinity), result);
+		result = Impl::Select(_mm_cmpeq_ps(x, infinity), infinity, result);
+		return Impl::Select(_mm_or_ps(_mm_cmplt_ps(x, _mm_setzero_ps()), _mm_cmpunord_ps(x, x)), _mm_set1_ps(std::numeric_limits<float>::quiet_NaN()), result);
+	}
+	NODISCARD INLINE float Log2(float x)noexcept
+	{
+		if (std::isnan(x) || x < 0.f)
+			return std::numeric_limits<float>::quiet_NaN();
+		if (x < std::numeric_limits<float>::min())
+			return -std::numeric_limits<float>::infinity();
+		if (x == std::numeric_limits<float>::infinity())
+			return x;
+		const uint32 bits = std::bit_cast<uint32>(x);
+		int32 exponent = static_cast<int32>(bits >> 23) - 127;
+		float mantissa = std::bit_cast<float>((bits & 0x007FFFFF) | 0x3F800000);
+		if (mantissa > Impl::SQRT2)
+		{
+			mantissa *= 0.5f;
+			++exponent;
+		}
+
+		const float u = mantissa - 1.f;
+		float p = u * Impl::LOG2_L5 + Impl::LOG2_L4;
+		p = u * p + Impl::LOG2_L3;
+		p = u * p + Impl::LOG2_L2;
+		p = u * p + Impl::LOG2_L1;
+		return static_cast<float>(exponent) + u * p;
+	}
+
+	/* acos(x) as sqrt(1 - |x|) times a cubic, NaN outside [-1, 1] */
+	NODISCARD INLINE SSE::Vector4f ACos(SSE::Vector4f x)noexcept
+	{
+		const auto absX = _mm_and_ps(x, Impl::AbsMask());
+		auto p = _mm_add_ps(_mm_mul_ps(absX, _mm_set1_ps(Impl::ACOS_P3)), _mm_set1_ps(Impl::ACOS_P2));
+		p = _mm_add_ps(_mm_mul_ps(absX, p), _mm_set1_ps(Impl::ACOS_P1));
+		p = _mm_add_ps(_mm_mul_ps(absX, p), _mm_set1_ps(Impl::ACOS_P0));
+		const auto result = _mm_mul_ps(_mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.f), absX)), p);
+		const auto negativeX = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(x), 31));
+		return Impl::Select(negativeX, _mm_sub_ps(_mm_set1_ps(PI<float>), result), result);
+	}
+	NODISCARD INLINE float ACos(float x)noexcept
+	{
+		const float absX = std::fabs(x);
+		float p = absX * Impl::ACOS_P3 + Impl::ACOS_P2;
+		p = absX * p + Impl::ACOS_P1;
+		p = absX * p + Impl::ACOS_P0;
+		const float result = std::sqrt(1.f - absX) * p;
+		return std::signbit(x) ? PI<float> - result : result;
+	}
+}
+
+MATH_STRICT_FP_END
+
+#endif /* MATH_FASTMATH_H */
\ No newline at end of file
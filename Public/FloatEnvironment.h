@@ -0,0 +1,67 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_FLOATENVIRONMENT_H
+#define MATH_FLOATENVIRONMENT_H 1
+
+#include "MathPrerequisites.h"
+
+/* Same order as the rounding control field of MXCSR */
+ENUMERATION(FloatRounding, Nearest, Down, Up, TowardZero);
+
+namespace greaper::math
+{
+	/* Sets the SSE control register (MXCSR) of the calling thread while alive and restores the previous controls
+	 * when destroyed, exception flags raised inside the scope are kept. Flush to zero turns denormal results into
+	 * zeros and denormals are zero reads denormal inputs as zeros, which avoids the microcode assists that make
+	 * denormal arithmetic 50 to 100 times slower. Only SSE and AVX code follows it, long double math on the x87
+	 * unit keeps its own control word.
+	 * Compilers assume the default rounding mode and may fold or move inlined arithmetic across the scope, code
+	 * that depends on another rounding mode must be called out of line or built with -frounding-math. */
+	class ScopedFloatEnvironment
+	{
+	public:
+		INLINE explicit ScopedFloatEnvironment(bool flushToZero = true, bool denormalsAreZero = true, FloatRounding_t rounding = FloatRounding_t::Nearest)noexcept
+			:m_PreviousCSR(_mm_getcsr())
+		{
+			static_assert(static_cast<uint32>(FloatRounding_t::TowardZero) == 3, "FloatRounding must follow the MXCSR rounding control encoding.");
+
+			uint32 csr = m_PreviousCSR & ~(FlushToZeroBit | DenormalsAreZeroBit | RoundingMask);
+			if (flushToZero)
+				csr |= FlushToZeroBit;
+			if (denormalsAreZero)
+				csr |= DenormalsAreZeroBit;
+			csr |= static_cast<uint32>(rounding) << RoundingShift;
+			_mm_setcsr(csr);
+		}
+		INLINE ~ScopedFloatEnvironment()noexcept
+		{
+			_mm_setcsr((_mm_getcsr() & ExceptionFlagsMask) | (m_PreviousCSR & ~ExceptionFlagsMask));
+		}
+		ScopedFloatEnvironment(const ScopedFloatEnvironment&) = delete;
+		ScopedFloatEnvironment& operator=(const ScopedFloatEnvironment&) = delete;
+
+		/* MXCSR of the thread before this scope */
+		NODISCARD INLINE uint32 GetPreviousCSR()const noexcept { return m_PreviousCSR; }
+		/* Rounding mode the calling thread runs with now, to change only FTZ / DAZ */
+		NODISCARD INLINE static FloatRounding_t GetCurrentRounding()noexcept
+		{
+			return static_cast<FloatRounding_t>((_mm_getcsr() & RoundingMask) >> RoundingShift);
+		}
+
+		static constexpr uint32 FlushToZeroBit = 1u << 15;
+		static constexpr uint32 DenormalsAreZeroBit = 1u << 6;
+		static constexpr uint32 RoundingShift = 13;
+		static constexpr uint32 RoundingMask = 3u << RoundingShift;
+		static constexpr uint32 ExceptionFlagsMask = 0x3F;
+
+	private:
+		uint32 m_PreviousCSR;
+	};
+}
+
+#endif /* MATH_FLOATENVIRONMENT_H */
\ No newline at end of file
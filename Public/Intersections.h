@@ -15,6 +15,7 @@
 #include "Segment3.h"
 #include "Line2.h"
 #include "Line3.h"
+#include "RayTriangle.h"
 #include "../../GreaperCore/Public/Result.h"
 
 namespace greaper::math
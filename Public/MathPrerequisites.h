@@ -26,6 +26,7 @@ namespace greaper::math
 	using Vector2u = Vector2Unsigned<uint32>;
 	using Vector2u64 = Vector2Unsigned<uint64>;
 	class Vector2b;
+	class Vector2h;
 
 	template<class T> class Vector3Real;
 	using Vector3f = Vector3Real<float>;
@@ -41,6 +42,11 @@ namespace greaper::math
 	using Vector3u = Vector3Unsigned<uint32>;
 	using Vector3u64 = Vector3Unsigned<uint64>;
 	class Vector3b;
+	class Vector3h;
+	template<class T> struct Vector3SoAView;
+	template<class T> class Vector3SoA;
+	using Vector3SoAf = Vector3SoA<float>;
+	using Vector3SoAd = Vector3SoA<double>;
 
 	template<class T> class Vector4Real;
 	using Vector4f = Vector4Real<float>;
@@ -56,6 +62,7 @@ namespace greaper::math
 	using Vector4u = Vector4Unsigned<uint32>;
 	using Vector4u64 = Vector4Unsigned<uint64>;
 	class Vector4b;
+	class Vector4h;
 
 	template<class T> class Matrix2Real;
 	using Matrix2f = Matrix2Real<float>;
@@ -75,6 +82,12 @@ namespace greaper::math
 	template<class T> class QuaternionReal;
 	using QuaternionF = QuaternionReal<float>;
 	using QuaternionD = QuaternionReal<double>;
+	template<class T> struct QuaternionSoAView;
+	template<class T> class QuaternionSoA;
+	using QuaternionSoAf = QuaternionSoA<float>;
+	using QuaternionSoAd = QuaternionSoA<double>;
+	class PackedQuaternion32;
+	class PackedQuaternion48;
 
 	template<class T> class Segment2Real;
 	using Segment2f = Segment2Real<float>;
@@ -98,7 +111,21 @@ namespace greaper::math
 	using RectI = RectT<int32>;
 	using RectU = RectT<uint32>;
 
+	template<class T> class AABB2Real;
+	using AABB2f = AABB2Real<float>;
+	using AABB2d = AABB2Real<double>;
+	template<class T> class AABB3Real;
+	using AABB3f = AABB3Real<float>;
+	using AABB3d = AABB3Real<double>;
+	struct BVHNode;
+	class BVH;
+	template<sizet Width> struct WideBVHNode;
+	template<sizet Width> class WideBVH;
+	using BVH4 = WideBVH<4>;
+	using BVH8 = WideBVH<8>;
+
 	class Half;
+	class BFloat16;
 }
 
 namespace greaper
@@ -191,11 +218,23 @@ namespace greaper::refl
 		RTI_RectD,
 		RTI_RectI,
 		RTI_RectU,
+
+		RTI_Vector2h,
+		RTI_Vector3h,
+		RTI_Vector4h,
+
+		RTI_BFloat16,
+
+		RTI_PackedQuaternion32,
+		RTI_PackedQuaternion48,
 	};
 }
 
 #include "Base/Utils.inl"
+#include "Base/CPUFeatures.inl"
 #include "Base/SSE.inl"
+#include "Base/AVX.inl"
+#include "Base/AVX512.inl"
 #include "Base/ReflectedConversions.h"
 
 #endif /* MATH_PREREQUISITES_H */
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include "Vector4.h"
 #include "Matrix3.h"
+#include "../../GreaperCore/Public/Result.h"
 
 namespace greaper::math
 {
@@ -111,10 +112,22 @@ namespace greaper::math
 		}
 		NODISCARD INLINE constexpr T Determinant()const noexcept
 		{
-			return R0.X * Matrix3Real<T>{R1.Y, R1.Z, R1.W, R2.Y, R2.Z, R2.W, R3.Y, R3.Z, R3.W}.Determinant()
-				- R0.Y * Matrix3Real<T>{R1.X, R1.Z, R1.W, R2.X, R2.Z, R2.W, R3.X, R3.Z, R3.W}.Determinant()
-				+ R0.Z * Matrix3Real<T>{R1.X, R1.Y, R1.W, R2.X, R2.Y, R2.W, R3.X, R3.Y, R3.W}.Determinant()
-				- R0.W * Matrix3Real<T>{R1.X, R1.Y, R1.Z, R2.X, R2.Y, R2.Z, R3.X, R3.Y, R3.Z}.Determinant();
+			// Laplace expansion by complementary 2x2 minors of the two upper and two lower rows
+			T s0 = R0.X * R1.Y - R0.Y * R1.X;
+			T s1 = R0.X * R1.Z - R0.Z * R1.X;
+			T s2 = R0.X * R1.W - R0.W * R1.X;
+			T s3 = R0.Y * R1.Z - R0.Z * R1.Y;
+			T s4 = R0.Y * R1.W - R0.W * R1.Y;
+			T s5 = R0.Z * R1.W - R0.W * R1.Z;
+
+			T c0 = R2.X * R3.Y - R2.Y * R3.X;
+			T c1 = R2.X * R3.Z - R2.Z * R3.X;
+			T c2 = R2.X * R3.W - R2.W * R3.X;
+			T c3 = R2.Y * R3.Z - R2.Z * R3.Y;
+			T c4 = R2.Y * R3.W - R2.W * R3.Y;
+			T c5 = R2.Z * R3.W - R2.W * R3.Z;
+
+			return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
 		}
 		NODISCARD INLINE constexpr Matrix4Real GetTransposed()const noexcept
 		{
@@ -139,24 +152,100 @@ namespace greaper::math
 			};
 			
 		}
+		/* Returns the inverse of the matrix, or a failure when the determinant is nearly zero.
+		 * The 2x2 sub-determinants are shared between the cofactors, float uses SSE and double uses AVX when the CPU supports it. */
+		NODISCARD INLINE constexpr TReturn<Matrix4Real> TryGetInverted(T tolerance = MATH_TOLERANCE<T>)const noexcept
+		{
+#if MATH_USE_OPTIMIZATIONS
+			if (!std::is_constant_evaluated())
+			{
+				if constexpr (std::is_same_v<T, float>)
+				{
+					auto r0 = _mm_load_ps(&R0.X);
+					auto r1 = _mm_load_ps(&R1.X);
+					auto r2 = _mm_load_ps(&R2.X);
+					auto r3 = _mm_load_ps(&R3.X);
+					float determinant = SSE::Matrix4Inverse(r0, r1, r2, r3, tolerance);
+					if (::IsNearlyEqual(determinant, 0.f, tolerance))
+						return Return::CreateFailure<Matrix4Real>();
+
+					Matrix4Real inv;
+					_mm_store_ps(&inv.R0.X, r0);
+					_mm_store_ps(&inv.R1.X, r1);
+					_mm_store_ps(&inv.R2.X, r2);
+					_mm_store_ps(&inv.R3.X, r3);
+					return Return::CreateSuccess(inv);
+				}
+				else if constexpr (std::is_same_v<T, double>)
+				{
+					if (GetCPUFeatures().AVX)
+					{
+						Matrix4Real inv;
+						double determinant = AVX::Matrix4Inverse(&R0.X, &inv.R0.X, tolerance);
+						if (::IsNearlyEqual(determinant, 0.0, tolerance))
+							return Return::CreateFailure<Matrix4Real>();
+						return Return::CreateSuccess(inv);
+					}
+				}
+			}
+#endif
+			T s0 = R0.X * R1.Y - R0.Y * R1.X;
+			T s1 = R0.X * R1.Z - R0.Z * R1.X;
+			T s2 = R0.X * R1.W - R0.W * R1.X;
+			T s3 = R0.Y * R1.Z - R0.Z * R1.Y;
+			T s4 = R0.Y * R1.W - R0.W * R1.Y;
+			T s5 = R0.Z * R1.W - R0.W * R1.Z;
+
+			T c0 = R2.X * R3.Y - R2.Y * R3.X;
+			T c1 = R2.X * R3.Z - R2.Z * R3.X;
+			T c2 = R2.X * R3.W - R2.W * R3.X;
+			T c3 = R2.Y * R3.Z - R2.Z * R3.Y;
+			T c4 = R2.Y * R3.W - R2.W * R3.Y;
+			T c5 = R2.Z * R3.W - R2.W * R3.Z;
+
+			T determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+			if (::IsNearlyEqual(determinant, T(0), tolerance))
+				return Return::CreateFailure<Matrix4Real>();
+
+			T invDeterminant = T(1) / determinant;
+			return Return::CreateSuccess(Matrix4Real{
+				( R1.Y * c5 - R1.Z * c4 + R1.W * c3) * invDeterminant,
+				(-R0.Y * c5 + R0.Z * c4 - R0.W * c3) * invDeterminant,
+				( R3.Y * s5 - R3.Z * s4 + R3.W * s3) * invDeterminant,
+				(-R2.Y * s5 + R2.Z * s4 - R2.W * s3) * invDeterminant,
+
+				(-R1.X * c5 + R1.Z * c2 - R1.W * c1) * invDeterminant,
+				( R0.X * c5 - R0.Z * c2 + R0.W * c1) * invDeterminant,
+				(-R3.X * s5 + R3.Z * s2 - R3.W * s1) * invDeterminant,
+				( R2.X * s5 - R2.Z * s2 + R2.W * s1) * invDeterminant,
+
+				( R1.X * c4 - R1.Y * c2 + R1.W * c0) * invDeterminant,
+				(-R0.X * c4 + R0.Y * c2 - R0.W * c0) * invDeterminant,
+				( R3.X * s4 - R3.Y * s2 + R3.W * s0) * invDeterminant,
+				(-R2.X * s4 + R2.Y * s2 - R2.W * s0) * invDeterminant,
+
+				(-R1.X * c3 + R1.Y * c1 - R1.Z * c0) * invDeterminant,
+				( R0.X * c3 - R0.Y * c1 + R0.Z * c0) * invDeterminant,
+				(-R3.X * s3 + R3.Y * s1 - R3.Z * s0) * invDeterminant,
+				( R2.X * s3 - R2.Y * s1 + R2.Z * s0) * invDeterminant
+			});
+		}
+		/* Returns the inverse of the matrix, or itself when it has no inverse, use TryGetInverted to detect that case */
 		NODISCARD INLINE constexpr Matrix4Real GetInverted()const noexcept
 		{
-			T determinant = Determinant();
-			if (::IsNearlyEqual(determinant, T(0), MATH_TOLERANCE<T>))
+			TReturn<Matrix4Real> inv = TryGetInverted();
+			if (inv.HasFailed())
 				return *this; // No inverse
-
-			T invDeterminant = T(1) / determinant;
-			Matrix4Real inv = GetAdjoint().GetTransposed();
-			return {
-				inv.R0 * invDeterminant,
-				inv.R1 * invDeterminant,
-				inv.R2 * invDeterminant,
-				inv.R3 * invDeterminant
-			};
+			return inv.GetValue();
 		}
-		INLINE void Inverse()noexcept
+		/* Inverts the matrix, returns false and leaves it untouched if it has no inverse */
+		INLINE bool Inverse(T tolerance = MATH_TOLERANCE<T>)noexcept
 		{
-			*this = GetInverted();
+			TReturn<Matrix4Real> inv = TryGetInverted(tolerance);
+			if (inv.HasFailed())
+				return false;
+			*this = inv.GetValue();
+			return true;
 		}
 		NODISCARD INLINE constexpr float Trace()const noexcept
 		{
@@ -0,0 +1,262 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_MATRIX43_H
+#define MATH_MATRIX43_H 1
+
+#include "Matrix4.h"
+
+namespace greaper::math
+{
+	/* Affine transform, it behaves as a Matrix4Real whose last row is always (0, 0, 0, 1).
+	 * Each row holds the rotation/scale part in XYZ and the translation in W. */
+	template<class T>
+	class alignas(16) Matrix43Real
+	{
+		static_assert(std::is_floating_point_v<T>, "Matrix43Real can only work with float, double or long double types");
+
+	public:
+		using value_type = T;
+
+		static constexpr sizet RowCount = 3;
+		static constexpr sizet ColumnCount = 4;
+		static constexpr sizet ComponentCount = RowCount * ColumnCount;
+
+		Vector4Real<T> R0, R1, R2;
+
+		constexpr Matrix43Real()noexcept = default;
+		INLINE constexpr Matrix43Real(T r00, T r01, T r02, T r03, T r10, T r11, T r12, T r13, T r20, T r21, T r22, T r23)noexcept
+			:R0(r00, r01, r02, r03), R1(r10, r11, r12, r13), R2(r20, r21, r22, r23) {  }
+		INLINE constexpr explicit Matrix43Real(const std::array<T, ComponentCount>& arr)noexcept
+			:R0(arr[0], arr[1], arr[2], arr[3]), R1(arr[4], arr[5], arr[6], arr[7]), R2(arr[8], arr[9], arr[10], arr[11]) {  }
+		INLINE constexpr Matrix43Real(const Vector4Real<T>& r0, const Vector4Real<T>& r1, const Vector4Real<T>& r2)noexcept :R0(r0), R1(r1), R2(r2) {  }
+		INLINE constexpr Matrix43Real(const Matrix3Real<T>& m3, const Vector3Real<T>& translation)noexcept
+			:R0(m3.R0, translation.X), R1(m3.R1, translation.Y), R2(m3.R2, translation.Z) {  }
+		INLINE constexpr explicit Matrix43Real(const Matrix3Real<T>& m3)noexcept :R0(m3.R0, T(0)), R1(m3.R1, T(0)), R2(m3.R2, T(0)) {  }
+		/* Drops the last row of the matrix, only lossless if the matrix is affine */
+		INLINE constexpr explicit Matrix43Real(const Matrix4Real<T>& m4)noexcept :R0(m4.R0), R1(m4.R1), R2(m4.R2) {  }
+
+		NODISCARD INLINE T& operator[](sizet index)noexcept
+		{
+			VerifyLess(index, ComponentCount, "Trying to access a Matrix43, but the index %" PRIuPTR " was out of range.", index);
+			return (&R0.X)[index];
+		}
+		NODISCARD INLINE constexpr const T& operator[](sizet index)const noexcept
+		{
+			VerifyLess(index, ComponentCount, "Trying to access a Matrix43, but the index %" PRIuPTR " was out of range.", index);
+			return (&R0.X)[index];
+		}
+		NODISCARD INLINE constexpr std::array<T, ComponentCount> ToArray()const noexcept
+		{
+			return { R0.X, R0.Y, R0.Z, R0.W, R1.X, R1.Y, R1.Z, R1.W, R2.X, R2.Y, R2.Z, R2.W };
+		}
+		NODISCARD INLINE constexpr Matrix4Real<T> ToMatrix4()const noexcept
+		{
+			return { R0, R1, R2, Vector4Real<T>{ T(0), T(0), T(0), T(1) } };
+		}
+		NODISCARD INLINE constexpr explicit operator Matrix4Real<T>()const noexcept
+		{
+			return ToMatrix4();
+		}
+		NODISCARD INLINE constexpr Matrix3Real<T> GetRotationScale()const noexcept
+		{
+			return { R0.X, R0.Y, R0.Z, R1.X, R1.Y, R1.Z, R2.X, R2.Y, R2.Z };
+		}
+		NODISCARD INLINE constexpr Vector3Real<T> GetTranslation()const noexcept
+		{
+			return { R0.W, R1.W, R2.W };
+		}
+		INLINE void SetTranslation(const Vector3Real<T>& translation)noexcept
+		{
+			R0.W = translation.X;
+			R1.W = translation.Y;
+			R2.W = translation.Z;
+		}
+		INLINE void Set(const Matrix43Real& other)noexcept
+		{
+			R0 = other.R0;
+			R1 = other.R1;
+			R2 = other.R2;
+		}
+		INLINE void Set(T r00, T r01, T r02, T r03, T r10, T r11, T r12, T r13, T r20, T r21, T r22, T r23)noexcept
+		{
+			R0.Set(r00, r01, r02, r03);
+			R1.Set(r10, r11, r12, r13);
+			R2.Set(r20, r21, r22, r23);
+		}
+		INLINE void Set(const Vector4Real<T>& r0, const Vector4Real<T>& r1, const Vector4Real<T>& r2)noexcept
+		{
+			R0 = r0;
+			R1 = r1;
+			R2 = r2;
+		}
+		INLINE void SetZero()noexcept
+		{
+			R0.SetZero();
+			R1.SetZero();
+			R2.SetZero();
+		}
+		INLINE void SetIdentity()noexcept
+		{
+			R0.Set(T(1), T(0), T(0), T(0));
+			R1.Set(T(0), T(1), T(0), T(0));
+			R2.Set(T(0), T(0), T(1), T(0));
+		}
+		NODISCARD INLINE constexpr T Determinant()const noexcept
+		{
+			return R0.X * (R1.Y * R2.Z - R1.Z * R2.Y)
+				- R0.Y * (R1.X * R2.Z - R1.Z * R2.X)
+				+ R0.Z * (R1.X * R2.Y - R1.Y * R2.X);
+		}
+		/* Point transform, applies the rotation/scale and the translation */
+		NODISCARD INLINE constexpr Vector3Real<T> TransformPoint(const Vector3Real<T>& p)const noexcept
+		{
+			return {
+				R0.X * p.X + R0.Y * p.Y + R0.Z * p.Z + R0.W,
+				R1.X * p.X + R1.Y * p.Y + R1.Z * p.Z + R1.W,
+				R2.X * p.X + R2.Y * p.Y + R2.Z * p.Z + R2.W
+			};
+		}
+		/* Direction transform, only applies the rotation/scale */
+		NODISCARD INLINE constexpr Vector3Real<T> TransformVector(const Vector3Real<T>& v)const noexcept
+		{
+			return {
+				R0.X * v.X + R0.Y * v.Y + R0.Z * v.Z,
+				R1.X * v.X + R1.Y * v.Y + R1.Z * v.Z,
+				R2.X * v.X + R2.Y * v.Y + R2.Z * v.Z
+			};
+		}
+		/* Returns the inverse transform, or a failure when the rotation/scale part is singular.
+		 * Costs a single 3x3 inverse plus rotating the translation back. */
+		NODISCARD INLINE constexpr TReturn<Matrix43Real> TryGetInverted(T tolerance = MATH_TOLERANCE<T>)const noexcept
+		{
+			// Columns of the inverse are the cross products of the rows
+			T c00 = R1.Y * R2.Z - R1.Z * R2.Y, c01 = R1.Z * R2.X - R1.X * R2.Z, c02 = R1.X * R2.Y - R1.Y * R2.X;
+			T c10 = R2.Y * R0.Z - R2.Z * R0.Y, c11 = R2.Z * R0.X - R2.X * R0.Z, c12 = R2.X * R0.Y - R2.Y * R0.X;
+			T c20 = R0.Y * R1.Z - R0.Z * R1.Y, c21 = R0.Z * R1.X - R0.X * R1.Z, c22 = R0.X * R1.Y - R0.Y * R1.X;
+
+			T determinant = R0.X * c00 + R0.Y * c01 + R0.Z * c02;
+			if (::IsNearlyEqual(determinant, T(0), tolerance))
+				return Return::CreateFailure<Matrix43Real>();
+
+			T invDeterminant = T(1) / determinant;
+			Matrix3Real<T> inv{
+				c00 * invDeterminant, c10 * invDeterminant, c20 * invDeterminant,
+				c01 * invDeterminant, c11 * invDeterminant, c21 * invDeterminant,
+				c02 * invDeterminant, c12 * invDeterminant, c22 * invDeterminant
+			};
+			Vector3Real<T> t = inv * GetTranslation();
+			return Return::CreateSuccess(Matrix43Real{ inv, -t });
+		}
+		/* Returns the inverse transform, or itself when it has no inverse, use TryGetInverted to detect that case */
+		NODISCARD INLINE constexpr Matrix43Real GetInverted()const noexcept
+		{
+			TReturn<Matrix43Real> inv = TryGetInverted();
+			if (inv.HasFailed())
+				return *this; // No inverse
+			return inv.GetValue();
+		}
+		/* Inverts the transform, returns false and leaves it untouched if it has no inverse */
+		INLINE bool Inverse(T tolerance = MATH_TOLERANCE<T>)noexcept
+		{
+			TReturn<Matrix43Real> inv = TryGetInverted(tolerance);
+			if (inv.HasFailed())
+				return false;
+			*this = inv.GetValue();
+			return true;
+		}
+		NODISCARD INLINE constexpr bool IsNearlyEqual(const Matrix43Real& other, T tolerance = MATH_TOLERANCE<T>)const noexcept
+		{
+			return R0.IsNearlyEqual(other.R0, tolerance) && R1.IsNearlyEqual(other.R1, tolerance) && R2.IsNearlyEqual(other.R2, tolerance);
+		}
+		NODISCARD INLINE constexpr bool IsEqual(const Matrix43Real& other)const noexcept
+		{
+			return R0.IsEqual(other.R0) && R1.IsEqual(other.R1) && R2.IsEqual(other.R2);
+		}
+		NODISCARD INLINE constexpr bool IsNearlyIdentity(T tolerance = MATH_TOLERANCE<T>)const noexcept
+		{
+			return IsNearlyEqual({ T(1), T(0), T(0), T(0), T(0), T(1), T(0), T(0), T(0), T(0), T(1), T(0) }, tolerance);
+		}
+		NODISCARD INLINE constexpr bool IsIdentity()const noexcept
+		{
+			return IsEqual({ T(1), T(0), T(0), T(0), T(0), T(1), T(0), T(0), T(0), T(0), T(1), T(0) });
+		}
+		NODISCARD INLINE String ToString()const noexcept
+		{
+			return Format(Impl::Mat43Conv<T>::print, R0.X, R0.Y, R0.Z, R0.W, R1.X, R1.Y, R1.Z, R1.W, R2.X, R2.Y, R2.Z, R2.W);
+		}
+		INLINE void FromString(StringView str)noexcept
+		{
+			sscanf(str.data(), Impl::Mat43Conv<T>::scan, &R0.X, &R0.Y, &R0.Z, &R0.W, &R1.X, &R1.Y, &R1.Z, &R1.W, &R2.X, &R2.Y, &R2.Z, &R2.W);
+		}
+
+		static const Matrix43Real IDENTITY;
+		static const Matrix43Real ZERO;
+	};
+
+	template<class T> const Matrix43Real<T> Matrix43Real<T>::IDENTITY = { T(1), T(0), T(0), T(0),
+																		T(0), T(1), T(0), T(0),
+																		T(0), T(0), T(1), T(0) };
+	template<class T> const Matrix43Real<T> Matrix43Real<T>::ZERO = {  };
+
+	/* Composes two affine transforms, right is applied first */
+	template<class T> NODISCARD INLINE constexpr Matrix43Real<T> operator*(const Matrix43Real<T>& left, const Matrix43Real<T>& right)noexcept
+	{
+#if MATH_USE_OPTIMIZATIONS
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				// The implicit last row of right only contributes the translation of left
+				auto r0 = _mm_load_ps(&right.R0.X);
+				auto r1 = _mm_load_ps(&right.R1.X);
+				auto r2 = _mm_load_ps(&right.R2.X);
+				auto r3 = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+				Matrix43Real<T> m;
+				_mm_store_ps(&m.R0.X, SSE::Matrix4MulRow(_mm_load_ps(&left.R0.X), r0, r1, r2, r3));
+				_mm_store_ps(&m.R1.X, SSE::Matrix4MulRow(_mm_load_ps(&left.R1.X), r0, r1, r2, r3));
+				_mm_store_ps(&m.R2.X, SSE::Matrix4MulRow(_mm_load_ps(&left.R2.X), r0, r1, r2, r3));
+				return m;
+			}
+		}
+#endif
+		return {
+			left.R0.X * right.R0.X + left.R0.Y * right.R1.X + left.R0.Z * right.R2.X,	left.R0.X * right.R0.Y + left.R0.Y * right.R1.Y + left.R0.Z * right.R2.Y,	left.R0.X * right.R0.Z + left.R0.Y * right.R1.Z + left.R0.Z * right.R2.Z,	left.R0.X * right.R0.W + left.R0.Y * right.R1.W + left.R0.Z * right.R2.W + left.R0.W,
+			left.R1.X * right.R0.X + left.R1.Y * right.R1.X + left.R1.Z * right.R2.X,	left.R1.X * right.R0.Y + left.R1.Y * right.R1.Y + left.R1.Z * right.R2.Y,	left.R1.X * right.R0.Z + left.R1.Y * right.R1.Z + left.R1.Z * right.R2.Z,	left.R1.X * right.R0.W + left.R1.Y * right.R1.W + left.R1.Z * right.R2.W + left.R1.W,
+			left.R2.X * right.R0.X + left.R2.Y * right.R1.X + left.R2.Z * right.R2.X,	left.R2.X * right.R0.Y + left.R2.Y * right.R1.Y + left.R2.Z * right.R2.Y,	left.R2.X * right.R0.Z + left.R2.Y * right.R1.Z + left.R2.Z * right.R2.Z,	left.R2.X * right.R0.W + left.R2.Y * right.R1.W + left.R2.Z * right.R2.W + left.R2.W
+		};
+	}
+	template<class T> INLINE Matrix43Real<T>& operator*=(Matrix43Real<T>& left, const Matrix43Real<T>& right)noexcept { left = (left * right); return left; }
+	template<class T> NODISCARD INLINE constexpr Matrix4Real<T> operator*(const Matrix4Real<T>& left, const Matrix43Real<T>& right)noexcept { return left * right.ToMatrix4(); }
+	template<class T> NODISCARD INLINE constexpr Matrix4Real<T> operator*(const Matrix43Real<T>& left, const Matrix4Real<T>& right)noexcept { return left.ToMatrix4() * right; }
+	template<class T> NODISCARD INLINE constexpr Vector4Real<T> operator*(const Matrix43Real<T>& left, const Vector4Real<T>& right)noexcept
+	{
+		return {
+			left.R0.X * right.X + left.R0.Y * right.Y + left.R0.Z * right.Z + left.R0.W * right.W,
+			left.R1.X * right.X + left.R1.Y * right.Y + left.R1.Z * right.Z + left.R1.W * right.W,
+			left.R2.X * right.X + left.R2.Y * right.Y + left.R2.Z * right.Z + left.R2.W * right.W,
+			right.W
+		};
+	}
+
+	template<class T> NODISCARD INLINE constexpr bool operator==(const Matrix43Real<T>& left, const Matrix43Real<T>& right)noexcept { return left.IsNearlyEqual(right); }
+	template<class T> NODISCARD INLINE constexpr bool operator!=(const Matrix43Real<T>& left, const Matrix43Real<T>& right)noexcept { return !(left == right); }
+}
+
+namespace std
+{
+	template<class T>
+	struct hash<greaper::math::Matrix43Real<T>>
+	{
+		NODISCARD INLINE size_t operator()(const greaper::math::Matrix43Real<T>& m)const noexcept
+		{
+			return ComputeHash(m.R0, m.R1, m.R2);
+		}
+	};
+}
+
+#endif /* MATH_MATRIX43_H */
\ No newline at end of file
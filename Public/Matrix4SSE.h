@@ -0,0 +1,196 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_MATRIX4SSE_H
+#define MATH_MATRIX4SSE_H 1
+
+#include "Matrix4.h"
+#include "../../GreaperCore/Public/Result.h"
+
+namespace greaper::math
+{
+	/* Register resident version of Matrix4f, it has the same layout so conversions are just loads and stores */
+	class alignas(16) Matrix4SSE
+	{
+	public:
+		using value_type = float;
+
+		static constexpr sizet RowCount = 4;
+		static constexpr sizet ColumnCount = 4;
+		static constexpr sizet ComponentCount = RowCount * ColumnCount;
+
+		SSE::Vector4f R0, R1, R2, R3;
+
+		INLINE Matrix4SSE()noexcept :R0(SSE::CreateV4f()), R1(SSE::CreateV4f()), R2(SSE::CreateV4f()), R3(SSE::CreateV4f()) {  }
+		INLINE Matrix4SSE(float r00, float r01, float r02, float r03, float r10, float r11, float r12, float r13, float r20, float r21, float r22, float r23, float r30, float r31, float r32, float r33)noexcept
+			:R0(_mm_setr_ps(r00, r01, r02, r03)), R1(_mm_setr_ps(r10, r11, r12, r13)), R2(_mm_setr_ps(r20, r21, r22, r23)), R3(_mm_setr_ps(r30, r31, r32, r33)) {  }
+		INLINE Matrix4SSE(SSE::Vector4f r0, SSE::Vector4f r1, SSE::Vector4f r2, SSE::Vector4f r3)noexcept :R0(r0), R1(r1), R2(r2), R3(r3) {  }
+		INLINE explicit Matrix4SSE(const Matrix4f& m)noexcept
+			:R0(_mm_load_ps(&m.R0.X)), R1(_mm_load_ps(&m.R1.X)), R2(_mm_load_ps(&m.R2.X)), R3(_mm_load_ps(&m.R3.X)) {  }
+
+		NODISCARD INLINE Matrix4f ToMatrix4()const noexcept
+		{
+			Matrix4f m;
+			_mm_store_ps(&m.R0.X, R0);
+			_mm_store_ps(&m.R1.X, R1);
+			_mm_store_ps(&m.R2.X, R2);
+			_mm_store_ps(&m.R3.X, R3);
+			return m;
+		}
+		NODISCARD INLINE explicit operator Matrix4f()const noexcept
+		{
+			return ToMatrix4();
+		}
+		INLINE void Set(const Matrix4SSE& other)noexcept
+		{
+			R0 = other.R0;
+			R1 = other.R1;
+			R2 = other.R2;
+			R3 = other.R3;
+		}
+		INLINE void Set(const Matrix4f& m)noexcept
+		{
+			R0 = _mm_load_ps(&m.R0.X);
+			R1 = _mm_load_ps(&m.R1.X);
+			R2 = _mm_load_ps(&m.R2.X);
+			R3 = _mm_load_ps(&m.R3.X);
+		}
+		INLINE void SetZero()noexcept
+		{
+			R0 = SSE::CreateV4f();
+			R1 = SSE::CreateV4f();
+			R2 = SSE::CreateV4f();
+			R3 = SSE::CreateV4f();
+		}
+		INLINE void SetIdentity()noexcept
+		{
+			R0 = _mm_setr_ps(1.f, 0.f, 0.f, 0.f);
+			R1 = _mm_setr_ps(0.f, 1.f, 0.f, 0.f);
+			R2 = _mm_setr_ps(0.f, 0.f, 1.f, 0.f);
+			R3 = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+		}
+		NODISCARD INLINE float Determinant()const noexcept
+		{
+			return _mm_cvtss_f32(SSE::Matrix4Determinant(R0, R1, R2, R3));
+		}
+		NODISCARD INLINE Matrix4SSE GetTransposed()const noexcept
+		{
+			Matrix4SSE m{ *this };
+			m.Transpose();
+			return m;
+		}
+		INLINE void Transpose()noexcept
+		{
+			SSE::Transpose(R0, R1, R2, R3);
+		}
+		NODISCARD INLINE TReturn<Matrix4SSE> TryGetInverted(float tolerance = MATH_TOLERANCE<float>)const noexcept
+		{
+			Matrix4SSE inv{ *this };
+			float determinant = SSE::Matrix4Inverse(inv.R0, inv.R1, inv.R2, inv.R3, tolerance);
+			if (::IsNearlyEqual(determinant, 0.f, tolerance))
+				return Return::CreateFailure<Matrix4SSE>();
+			return Return::CreateSuccess(inv);
+		}
+		NODISCARD INLINE Matrix4SSE GetInverted()const noexcept
+		{
+			Matrix4SSE inv{ *this };
+			SSE::Matrix4Inverse(inv.R0, inv.R1, inv.R2, inv.R3); // On failure the matrix is left untouched
+			return inv;
+		}
+		INLINE bool Inverse(float tolerance = MATH_TOLERANCE<float>)noexcept
+		{
+			float determinant = SSE::Matrix4Inverse(R0, R1, R2, R3, tolerance);
+			return !::IsNearlyEqual(determinant, 0.f, tolerance);
+		}
+		NODISCARD INLINE float Trace()const noexcept
+		{
+			return _mm_cvtss_f32(R0) + _mm_cvtss_f32(SSE::Swizzle<1, 1, 1, 1>(R1)) + _mm_cvtss_f32(SSE::Swizzle<2, 2, 2, 2>(R2)) + _mm_cvtss_f32(SSE::Swizzle<3, 3, 3, 3>(R3));
+		}
+		NODISCARD INLINE bool IsNearlyEqual(const Matrix4SSE& other, float tolerance = MATH_TOLERANCE<float>)const noexcept
+		{
+			return SSE::NearlyEqual(R0, other.R0, tolerance) && SSE::NearlyEqual(R1, other.R1, tolerance) && SSE::NearlyEqual(R2, other.R2, tolerance) && SSE::NearlyEqual(R3, other.R3, tolerance);
+		}
+		NODISCARD INLINE bool IsEqual(const Matrix4SSE& other)const noexcept
+		{
+			return SSE::Equal(R0, other.R0) && SSE::Equal(R1, other.R1) && SSE::Equal(R2, other.R2) && SSE::Equal(R3, other.R3);
+		}
+		NODISCARD INLINE bool IsNearlyIdentity(float tolerance = MATH_TOLERANCE<float>)const noexcept
+		{
+			return IsNearlyEqual(IDENTITY, tolerance);
+		}
+		NODISCARD INLINE bool IsIdentity()const noexcept
+		{
+			return IsEqual(IDENTITY);
+		}
+		NODISCARD INLINE String ToString()const noexcept
+		{
+			return ToMatrix4().ToString();
+		}
+		INLINE void FromString(StringView str)noexcept
+		{
+			Matrix4f m;
+			m.FromString(str);
+			Set(m);
+		}
+
+		static const Matrix4SSE IDENTITY;
+		static const Matrix4SSE ZERO;
+	};
+
+	inline const Matrix4SSE Matrix4SSE::IDENTITY = { 1.f, 0.f, 0.f, 0.f,
+													0.f, 1.f, 0.f, 0.f,
+													0.f, 0.f, 1.f, 0.f,
+													0.f, 0.f, 0.f, 1.f };
+	inline const Matrix4SSE Matrix4SSE::ZERO = {  };
+
+	NODISCARD INLINE Matrix4SSE operator+(const Matrix4SSE& left, const Matrix4SSE& right)noexcept { return { SSE::Add(left.R0, right.R0), SSE::Add(left.R1, right.R1), SSE::Add(left.R2, right.R2), SSE::Add(left.R3, right.R3) }; }
+	NODISCARD INLINE Matrix4SSE operator-(const Matrix4SSE& left, const Matrix4SSE& right)noexcept { return { SSE::Sub(left.R0, right.R0), SSE::Sub(left.R1, right.R1), SSE::Sub(left.R2, right.R2), SSE::Sub(left.R3, right.R3) }; }
+	NODISCARD INLINE Matrix4SSE operator*(const Matrix4SSE& left, const Matrix4SSE& right)noexcept
+	{
+		return {
+			SSE::Matrix4MulRow(left.R0, right.R0, right.R1, right.R2, right.R3),
+			SSE::Matrix4MulRow(left.R1, right.R0, right.R1, right.R2, right.R3),
+			SSE::Matrix4MulRow(left.R2, right.R0, right.R1, right.R2, right.R3),
+			SSE::Matrix4MulRow(left.R3, right.R0, right.R1, right.R2, right.R3)
+		};
+	}
+	INLINE Matrix4SSE& operator+=(Matrix4SSE& left, const Matrix4SSE& right)noexcept { left = (left + right); return left; }
+	INLINE Matrix4SSE& operator-=(Matrix4SSE& left, const Matrix4SSE& right)noexcept { left = (left - right); return left; }
+	INLINE Matrix4SSE& operator*=(Matrix4SSE& left, const Matrix4SSE& right)noexcept { left = (left * right); return left; }
+
+	NODISCARD INLINE Matrix4SSE operator*(const Matrix4SSE& left, float right)noexcept { return { SSE::Mul(left.R0, right), SSE::Mul(left.R1, right), SSE::Mul(left.R2, right), SSE::Mul(left.R3, right) }; }
+	NODISCARD INLINE Matrix4SSE operator*(float left, const Matrix4SSE& right)noexcept { return right * left; }
+	INLINE Matrix4SSE& operator*=(Matrix4SSE& left, float right)noexcept { left = (left * right); return left; }
+
+	NODISCARD INLINE SSE::Vector4f operator*(const Matrix4SSE& left, SSE::Vector4f right)noexcept { return SSE::Matrix4MulVector(left.R0, left.R1, left.R2, left.R3, right); }
+	NODISCARD INLINE SSE::Vector4f operator*(SSE::Vector4f left, const Matrix4SSE& right)noexcept { return SSE::Matrix4MulVector(right.R0, right.R1, right.R2, right.R3, left); }
+	NODISCARD INLINE Vector4f operator*(const Matrix4SSE& left, const Vector4f& right)noexcept
+	{
+		Vector4f v;
+		_mm_store_ps(&v.X, left * _mm_load_ps(&right.X));
+		return v;
+	}
+	NODISCARD INLINE Vector4f operator*(const Vector4f& left, const Matrix4SSE& right)noexcept { return right * left; }
+	INLINE Vector4f& operator*=(Vector4f& left, const Matrix4SSE& right)noexcept { left = (left * right); return left; }
+
+	NODISCARD INLINE bool operator==(const Matrix4SSE& left, const Matrix4SSE& right)noexcept { return left.IsNearlyEqual(right); }
+	NODISCARD INLINE bool operator!=(const Matrix4SSE& left, const Matrix4SSE& right)noexcept { return !(left == right); }
+}
+
+namespace std
+{
+	template<>
+	struct hash<greaper::math::Matrix4SSE>
+	{
+		NODISCARD INLINE size_t operator()(const greaper::math::Matrix4SSE& m)const noexcept
+		{
+			return hash<greaper::math::Matrix4f>()(m.ToMatrix4());
+		}
+	};
+}
+
+#endif /* MATH_MATRIX4SSE_H */
\ No newline at end of file
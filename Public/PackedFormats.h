@@ -0,0 +1,712 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_PACKEDFORMATS_H
+#define MATH_PACKEDFORMATS_H 1
+
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+#include "Batch.h"
+
+MATH_STRICT_FP_BEGIN
+
+/* Normalized integer and packed formats for vertex attributes, following the D3D/Vulkan conversion rules:
+ * unorm maps [0, 1] to [0, max], snorm maps [-1, 1] to [-max, max] and decodes -max - 1 as -1.
+ * Encoding clamps (NaN becomes the lowest value) and rounds to nearest, decoding is exact at 0 and the ends. */
+namespace greaper::math
+{
+	namespace Impl
+	{
+		template<class I>
+		inline constexpr float NormMax = static_cast<float>(std::numeric_limits<I>::max());
+
+		NODISCARD INLINE constexpr uint32 FloatToUnormBits(float v, float max)noexcept
+		{
+			float c = v > 0.f ? v : 0.f;
+			c = c < 1.f ? c : 1.f;
+			return static_cast<uint32>(c * max + 0.5f);
+		}
+		NODISCARD INLINE constexpr int32 FloatToSnormBits(float v, float max)noexcept
+		{
+			float c = v > -1.f ? v : -1.f;
+			c = c < 1.f ? c : 1.f;
+			const float t = c * max;
+			return static_cast<int32>(t + (t < 0.f ? -0.5f : 0.5f));
+		}
+		NODISCARD INLINE constexpr float UnormBitsToFloat(uint32 v, float max)noexcept
+		{
+			return static_cast<float>(v) / max;
+		}
+		NODISCARD INLINE constexpr float SnormBitsToFloat(int32 v, float max)noexcept
+		{
+			const float f = static_cast<float>(v) / max;
+			return f > -1.f ? f : -1.f;
+		}
+	}
+
+	template<class I>
+	NODISCARD INLINE constexpr I FloatToUnorm(float v)noexcept
+	{
+		static_assert(std::is_same_v<I, uint8> || std::is_same_v<I, uint16>, "FloatToUnorm can only work with uint8 or uint16 types");
+		return static_cast<I>(Impl::FloatToUnormBits(v, Impl::NormMax<I>));
+	}
+	template<class I>
+	NODISCARD INLINE constexpr I FloatToSnorm(float v)noexcept
+	{
+		static_assert(std::is_same_v<I, int8> || std::is_same_v<I, int16>, "FloatToSnorm can only work with int8 or int16 types");
+		return static_cast<I>(Impl::FloatToSnormBits(v, Impl::NormMax<I>));
+	}
+	template<class I>
+	NODISCARD INLINE constexpr float UnormToFloat(I v)noexcept
+	{
+		static_assert(std::is_same_v<I, uint8> || std::is_same_v<I, uint16>, "UnormToFloat can only work with uint8 or uint16 types");
+		return Impl::UnormBitsToFloat(v, Impl::NormMax<I>);
+	}
+	template<class I>
+	NODISCARD INLINE constexpr float SnormToFloat(I v)noexcept
+	{
+		static_assert(std::is_same_v<I, int8> || std::is_same_v<I, int16>, "SnormToFloat can only work with int8 or int16 types");
+		return Impl::SnormBitsToFloat(v, Impl::NormMax<I>);
+	}
+
+	/* Component wise conversions between float vectors and the small integer vectors, ToUnorm<uint8>(color) gives a Vector4u8 */
+	template<class I>
+	NODISCARD INLINE constexpr Vector2Unsigned<I> ToUnorm(const Vector2f& v)noexcept
+	{
+		return { FloatToUnorm<I>(v.X), FloatToUnorm<I>(v.Y) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector3Unsigned<I> ToUnorm(const Vector3f& v)noexcept
+	{
+		return { FloatToUnorm<I>(v.X), FloatToUnorm<I>(v.Y), FloatToUnorm<I>(v.Z) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector4Unsigned<I> ToUnorm(const Vector4f& v)noexcept
+	{
+		return { FloatToUnorm<I>(v.X), FloatToUnorm<I>(v.Y), FloatToUnorm<I>(v.Z), FloatToUnorm<I>(v.W) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector2Signed<I> ToSnorm(const Vector2f& v)noexcept
+	{
+		return { FloatToSnorm<I>(v.X), FloatToSnorm<I>(v.Y) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector3Signed<I> ToSnorm(const Vector3f& v)noexcept
+	{
+		return { FloatToSnorm<I>(v.X), FloatToSnorm<I>(v.Y), FloatToSnorm<I>(v.Z) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector4Signed<I> ToSnorm(const Vector4f& v)noexcept
+	{
+		return { FloatToSnorm<I>(v.X), FloatToSnorm<I>(v.Y), FloatToSnorm<I>(v.Z), FloatToSnorm<I>(v.W) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector2f FromUnorm(const Vector2Unsigned<I>& v)noexcept
+	{
+		return { UnormToFloat(v.X), UnormToFloat(v.Y) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector3f FromUnorm(const Vector3Unsigned<I>& v)noexcept
+	{
+		return { UnormToFloat(v.X), UnormToFloat(v.Y), UnormToFloat(v.Z) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector4f FromUnorm(const Vector4Unsigned<I>& v)noexcept
+	{
+		return { UnormToFloat(v.X), UnormToFloat(v.Y), UnormToFloat(v.Z), UnormToFloat(v.W) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector2f FromSnorm(const Vector2Signed<I>& v)noexcept
+	{
+		return { SnormToFloat(v.X), SnormToFloat(v.Y) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector3f FromSnorm(const Vector3Signed<I>& v)noexcept
+	{
+		return { SnormToFloat(v.X), SnormToFloat(v.Y), SnormToFloat(v.Z) };
+	}
+	template<class I>
+	NODISCARD INLINE constexpr Vector4f FromSnorm(const Vector4Signed<I>& v)noexcept
+	{
+		return { SnormToFloat(v.X), SnormToFloat(v.Y), SnormToFloat(v.Z), SnormToFloat(v.W) };
+	}
+
+	/* Unorm 10:10:10:2, X in the lowest bits and W in the top two like DXGI_FORMAT_R10G10B10A2_UNORM */
+	NODISCARD INLINE constexpr uint32 PackRGB10A2(const Vector4f& v)noexcept
+	{
+		return Impl::FloatToUnormBits(v.X, 1023.f)
+			| (Impl::FloatToUnormBits(v.Y, 1023.f) << 10)
+			| (Impl::FloatToUnormBits(v.Z, 1023.f) << 20)
+			| (Impl::FloatToUnormBits(v.W, 3.f) << 30);
+	}
+	NODISCARD INLINE constexpr Vector4f UnpackRGB10A2(uint32 packed)noexcept
+	{
+		return {
+			Impl::UnormBitsToFloat(packed & 1023, 1023.f),
+			Impl::UnormBitsToFloat((packed >> 10) & 1023, 1023.f),
+			Impl::UnormBitsToFloat((packed >> 20) & 1023, 1023.f),
+			Impl::UnormBitsToFloat(packed >> 30, 3.f)
+		};
+	}
+
+	/* Octahedral encoding of a unit vector as two snorm16, X in the low half. The decoded direction is
+	 * within 0.004 degrees of the original, non unit or zero vectors are not supported. */
+	NODISCARD INLINE constexpr uint32 EncodeOctahedral(const Vector3f& n)noexcept
+	{
+		const float inv = 1.f / (Abs(n.X) + Abs(n.Y) + Abs(n.Z));
+		float x = n.X * inv;
+		float y = n.Y * inv;
+		if (n.Z < 0.f)
+		{
+			// Fold the lower hemisphere over the diagonals
+			const float fx = (1.f - Abs(y)) * (x >= 0.f ? 1.f : -1.f);
+			y = (1.f - Abs(x)) * (y >= 0.f ? 1.f : -1.f);
+			x = fx;
+		}
+		return static_cast<uint16>(FloatToSnorm<int16>(x)) | (static_cast<uint32>(static_cast<uint16>(FloatToSnorm<int16>(y))) << 16);
+	}
+	NODISCARD INLINE Vector3f DecodeOctahedral(uint32 packed)noexcept
+	{
+		float x = SnormToFloat(static_cast<int16>(packed & 0xFFFF));
+		float y = SnormToFloat(static_cast<int16>(packed >> 16));
+		const float z = 1.f - Abs(x) - Abs(y);
+		const float nz = -z;
+		const float t = nz > 0.f ? nz : 0.f;
+		x += x >= 0.f ? -t : t;
+		y += y >= 0.f ? -t : t;
+		const float inv = 1.f / std::sqrt(x * x + y * y + z * z);
+		return { x * inv, y * inv, z * inv };
+	}
+}
+
+/* Batch encoders and decoders, every level gives exactly the same values as the scalar functions above.
+ * The AVX-512 level runs the AVX2 kernels, these are bound by the narrow loads and stores. */
+namespace greaper::math::Batch
+{
+	namespace Impl
+	{
+		template<class I>
+		INLINE void ToNormScalar(const float* in, I* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+			{
+				if constexpr (std::is_signed_v<I>)
+					out[i] = FloatToSnorm<I>(in[i]);
+				else
+					out[i] = FloatToUnorm<I>(in[i]);
+			}
+		}
+		template<class I>
+		INLINE void FromNormScalar(const I* in, float* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+			{
+				if constexpr (std::is_signed_v<I>)
+					out[i] = SnormToFloat(in[i]);
+				else
+					out[i] = UnormToFloat(in[i]);
+			}
+		}
+
+		MATH_TARGET_SSE41 INLINE __m128i FloatToUnormSSE41(__m128 v, __m128 max)noexcept
+		{
+			const __m128 c = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.f));
+			return _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(c, max), _mm_set1_ps(0.5f)));
+		}
+		MATH_TARGET_SSE41 INLINE __m128i FloatToSnormSSE41(__m128 v, __m128 max)noexcept
+		{
+			const __m128 c = _mm_min_ps(_mm_max_ps(v, _mm_set1_ps(-1.f)), _mm_set1_ps(1.f));
+			const __m128 t = _mm_mul_ps(c, max);
+			const __m128 half = _mm_or_ps(_mm_and_ps(t, _mm_set1_ps(-0.f)), _mm_set1_ps(0.5f));
+			return _mm_cvttps_epi32(_mm_add_ps(t, half));
+		}
+		MATH_TARGET_SSE41 INLINE __m128 UnormToFloatSSE41(__m128i v, __m128 max)noexcept
+		{
+			return _mm_div_ps(_mm_cvtepi32_ps(v), max);
+		}
+		MATH_TARGET_SSE41 INLINE __m128 SnormToFloatSSE41(__m128i v, __m128 max)noexcept
+		{
+			return _mm_max_ps(_mm_div_ps(_mm_cvtepi32_ps(v), max), _mm_set1_ps(-1.f));
+		}
+		MATH_TARGET_AVX2 INLINE __m256i FloatToUnormAVX2(__m256 v, __m256 max)noexcept
+		{
+			const __m256 c = _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(1.f));
+			return _mm256_cvttps_epi32(_mm256_add_ps(_mm256_mul_ps(c, max), _mm256_set1_ps(0.5f)));
+		}
+		MATH_TARGET_AVX2 INLINE __m256i FloatToSnormAVX2(__m256 v, __m256 max)noexcept
+		{
+			const __m256 c = _mm256_min_ps(_mm256_max_ps(v, _mm256_set1_ps(-1.f)), _mm256_set1_ps(1.f));
+			const __m256 t = _mm256_mul_ps(c, max);
+			const __m256 half = _mm256_or_ps(_mm256_and_ps(t, _mm256_set1_ps(-0.f)), _mm256_set1_ps(0.5f));
+			return _mm256_cvttps_epi32(_mm256_add_ps(t, half));
+		}
+		MATH_TARGET_AVX2 INLINE __m256 UnormToFloatAVX2(__m256i v, __m256 max)noexcept
+		{
+			return _mm256_div_ps(_mm256_cvtepi32_ps(v), max);
+		}
+		MATH_TARGET_AVX2 INLINE __m256 SnormToFloatAVX2(__m256i v, __m256 max)noexcept
+		{
+			return _mm256_max_ps(_mm256_div_ps(_mm256_cvtepi32_ps(v), max), _mm256_set1_ps(-1.f));
+		}
+
+		/* 16 floats per iteration, packed with saturation down to the element size, which never clips after the clamp */
+		template<class I>
+		MATH_TARGET_SSE41 inline void ToNormSSE41(const float* in, I* out, sizet count)noexcept
+		{
+			const __m128 max = _mm_set1_ps(math::Impl::NormMax<I>);
+			sizet i = 0;
+			for (; i + 16 <= count; i += 16)
+			{
+				__m128i q[4];
+				for (sizet j = 0; j < 4; ++j)
+				{
+					if constexpr (std::is_signed_v<I>)
+						q[j] = FloatToSnormSSE41(_mm_loadu_ps(in + i + j * 4), max);
+					else
+						q[j] = FloatToUnormSSE41(_mm_loadu_ps(in + i + j * 4), max);
+				}
+				if constexpr (std::is_signed_v<I>)
+				{
+					const __m128i lo = _mm_packs_epi32(q[0], q[1]), hi = _mm_packs_epi32(q[2], q[3]);
+					if constexpr (sizeof(I) == 1)
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi16(lo, hi));
+					}
+					else
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lo);
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), hi);
+					}
+				}
+				else
+				{
+					const __m128i lo = _mm_packus_epi32(q[0], q[1]), hi = _mm_packus_epi32(q[2], q[3]);
+					if constexpr (sizeof(I) == 1)
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(lo, hi));
+					}
+					else
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), lo);
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), hi);
+					}
+				}
+			}
+			ToNormScalar(in + i, out + i, count - i);
+		}
+		/* Widens 4 elements starting at the low bytes of v to int32 */
+		template<class I>
+		MATH_TARGET_SSE41 INLINE __m128i WidenSSE41(__m128i v)noexcept
+		{
+			if constexpr (std::is_same_v<I, uint8>)
+				return _mm_cvtepu8_epi32(v);
+			else if constexpr (std::is_same_v<I, int8>)
+				return _mm_cvtepi8_epi32(v);
+			else if constexpr (std::is_same_v<I, uint16>)
+				return _mm_cvtepu16_epi32(v);
+			else
+				return _mm_cvtepi16_epi32(v);
+		}
+		template<class I>
+		MATH_TARGET_SSE41 inline void FromNormSSE41(const I* in, float* out, sizet count)noexcept
+		{
+			constexpr sizet width = 16 / sizeof(I);
+			const __m128 max = _mm_set1_ps(math::Impl::NormMax<I>);
+			sizet i = 0;
+			for (; i + width <= count; i += width)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				__m128i q[4];
+				q[0] = WidenSSE41<I>(v);
+				q[1] = WidenSSE41<I>(_mm_srli_si128(v, 4 * sizeof(I)));
+				if constexpr (sizeof(I) == 1)
+				{
+					q[2] = WidenSSE41<I>(_mm_srli_si128(v, 8));
+					q[3] = WidenSSE41<I>(_mm_srli_si128(v, 12));
+				}
+				for (sizet j = 0; j < width / 4; ++j)
+				{
+					if constexpr (std::is_signed_v<I>)
+						_mm_storeu_ps(out + i + j * 4, SnormToFloatSSE41(q[j], max));
+					else
+						_mm_storeu_ps(out + i + j * 4, UnormToFloatSSE41(q[j], max));
+				}
+			}
+			FromNormScalar(in + i, out + i, count - i);
+		}
+		/* 32 floats per iteration, the in lane packs are put back in order with a single permute */
+		template<class I>
+		MATH_TARGET_AVX2 inline void ToNormAVX2(const float* in, I* out, sizet count)noexcept
+		{
+			const __m256 max = _mm256_set1_ps(math::Impl::NormMax<I>);
+			sizet i = 0;
+			for (; i + 32 <= count; i += 32)
+			{
+				__m256i q[4];
+				for (sizet j = 0; j < 4; ++j)
+				{
+					if constexpr (std::is_signed_v<I>)
+						q[j] = FloatToSnormAVX2(_mm256_loadu_ps(in + i + j * 8), max);
+					else
+						q[j] = FloatToUnormAVX2(_mm256_loadu_ps(in + i + j * 8), max);
+				}
+				__m256i lo, hi;
+				if constexpr (std::is_signed_v<I>)
+				{
+					lo = _mm256_packs_epi32(q[0], q[1]);
+					hi = _mm256_packs_epi32(q[2], q[3]);
+				}
+				else
+				{
+					lo = _mm256_packus_epi32(q[0], q[1]);
+					hi = _mm256_packus_epi32(q[2], q[3]);
+				}
+				if constexpr (sizeof(I) == 1)
+				{
+					const __m256i bytes = std::is_signed_v<I> ? _mm256_packs_epi16(lo, hi) : _mm256_packus_epi16(lo, hi);
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7)));
+				}
+				else
+				{
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_permute4x64_epi64(lo, _MM_SHUFFLE(3, 1, 2, 0)));
+					_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 16), _mm256_permute4x64_epi64(hi, _MM_SHUFFLE(3, 1, 2, 0)));
+				}
+			}
+			ToNormSSE41(in + i, out + i, count - i);
+		}
+		template<class I>
+		MATH_TARGET_AVX2 INLINE __m256i WidenAVX2(__m128i v)noexcept
+		{
+			if constexpr (std::is_same_v<I, uint8>)
+				return _mm256_cvtepu8_epi32(v);
+			else if constexpr (std::is_same_v<I, int8>)
+				return _mm256_cvtepi8_epi32(v);
+			else if constexpr (std::is_same_v<I, uint16>)
+				return _mm256_cvtepu16_epi32(v);
+			else
+				return _mm256_cvtepi16_epi32(v);
+		}
+		template<class I>
+		MATH_TARGET_AVX2 inline void FromNormAVX2(const I* in, float* out, sizet count)noexcept
+		{
+			constexpr sizet width = 16 / sizeof(I);
+			const __m256 max = _mm256_set1_ps(math::Impl::NormMax<I>);
+			sizet i = 0;
+			for (; i + width <= count; i += width)
+			{
+				const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				__m256i q[2];
+				q[0] = WidenAVX2<I>(v);
+				if constexpr (sizeof(I) == 1)
+					q[1] = WidenAVX2<I>(_mm_srli_si128(v, 8));
+				for (sizet j = 0; j < width / 8; ++j)
+				{
+					if constexpr (std::is_signed_v<I>)
+						_mm256_storeu_ps(out + i + j * 8, SnormToFloatAVX2(q[j], max));
+					else
+						_mm256_storeu_ps(out + i + j * 8, UnormToFloatAVX2(q[j], max));
+				}
+			}
+			FromNormSSE41(in + i, out + i, count - i);
+		}
+
+		INLINE void PackRGB10A2Scalar(const Vector4f* in, uint32* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = math::PackRGB10A2(in[i]);
+		}
+		INLINE void UnpackRGB10A2Scalar(const uint32* in, Vector4f* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = math::UnpackRGB10A2(in[i]);
+		}
+		/* Four vectors are transposed into X/Y/Z/W registers so each channel is encoded with its own scale */
+		MATH_TARGET_SSE41 inline void PackRGB10A2SSE41(const Vector4f* in, uint32* out, sizet count)noexcept
+		{
+			const __m128 max10 = _mm_set1_ps(1023.f), max2 = _mm_set1_ps(3.f);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const float* src = &in[i].X;
+				__m128 x = _mm_loadu_ps(src), y = _mm_loadu_ps(src + 4), z = _mm_loadu_ps(src + 8), w = _mm_loadu_ps(src + 12);
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+				__m128i p = FloatToUnormSSE41(x, max10);
+				p = _mm_or_si128(p, _mm_slli_epi32(FloatToUnormSSE41(y, max10), 10));
+				p = _mm_or_si128(p, _mm_slli_epi32(FloatToUnormSSE41(z, max10), 20));
+				p = _mm_or_si128(p, _mm_slli_epi32(FloatToUnormSSE41(w, max2), 30));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), p);
+			}
+			PackRGB10A2Scalar(in + i, out + i, count - i);
+		}
+		MATH_TARGET_SSE41 inline void UnpackRGB10A2SSE41(const uint32* in, Vector4f* out, sizet count)noexcept
+		{
+			const __m128 max10 = _mm_set1_ps(1023.f), max2 = _mm_set1_ps(3.f);
+			const __m128i mask = _mm_set1_epi32(1023);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				__m128 x = UnormToFloatSSE41(_mm_and_si128(p, mask), max10);
+				__m128 y = UnormToFloatSSE41(_mm_and_si128(_mm_srli_epi32(p, 10), mask), max10);
+				__m128 z = UnormToFloatSSE41(_mm_and_si128(_mm_srli_epi32(p, 20), mask), max10);
+				__m128 w = UnormToFloatSSE41(_mm_srli_epi32(p, 30), max2);
+				_MM_TRANSPOSE4_PS(x, y, z, w);
+				float* dst = &out[i].X;
+				_mm_storeu_ps(dst, x);
+				_mm_storeu_ps(dst + 4, y);
+				_mm_storeu_ps(dst + 8, z);
+				_mm_storeu_ps(dst + 12, w);
+			}
+			UnpackRGB10A2Scalar(in + i, out + i, count - i);
+		}
+		/* Vectors i and i + 4 share a register so the in lane transpose leaves the results in order */
+		MATH_TARGET_AVX2 inline void PackRGB10A2AVX2(const Vector4f* in, uint32* out, sizet count)noexcept
+		{
+			const __m256 max10 = _mm256_set1_ps(1023.f), max2 = _mm256_set1_ps(3.f);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const float* src = &in[i].X;
+				__m256 x = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src)), _mm_loadu_ps(src + 16), 1);
+				__m256 y = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 4)), _mm_loadu_ps(src + 20), 1);
+				__m256 z = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 8)), _mm_loadu_ps(src + 24), 1);
+				__m256 w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 12)), _mm_loadu_ps(src + 28), 1);
+				const __m256 t0 = _mm256_unpacklo_ps(x, y), t1 = _mm256_unpackhi_ps(x, y);
+				const __m256 t2 = _mm256_unpacklo_ps(z, w), t3 = _mm256_unpackhi_ps(z, w);
+				x = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+				y = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+				z = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+				w = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+				__m256i p = FloatToUnormAVX2(x, max10);
+				p = _mm256_or_si256(p, _mm256_slli_epi32(FloatToUnormAVX2(y, max10), 10));
+				p = _mm256_or_si256(p, _mm256_slli_epi32(FloatToUnormAVX2(z, max10), 20));
+				p = _mm256_or_si256(p, _mm256_slli_epi32(FloatToUnormAVX2(w, max2), 30));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), p);
+			}
+			PackRGB10A2SSE41(in + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX2 inline void UnpackRGB10A2AVX2(const uint32* in, Vector4f* out, sizet count)noexcept
+		{
+			const __m256 max10 = _mm256_set1_ps(1023.f), max2 = _mm256_set1_ps(3.f);
+			const __m256i mask = _mm256_set1_epi32(1023);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+				const __m256 x = UnormToFloatAVX2(_mm256_and_si256(p, mask), max10);
+				const __m256 y = UnormToFloatAVX2(_mm256_and_si256(_mm256_srli_epi32(p, 10), mask), max10);
+				const __m256 z = UnormToFloatAVX2(_mm256_and_si256(_mm256_srli_epi32(p, 20), mask), max10);
+				const __m256 w = UnormToFloatAVX2(_mm256_srli_epi32(p, 30), max2);
+				const __m256 t0 = _mm256_unpacklo_ps(x, y), t1 = _mm256_unpackhi_ps(x, y);
+				const __m256 t2 = _mm256_unpacklo_ps(z, w), t3 = _mm256_unpackhi_ps(z, w);
+				const __m256 v0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+				const __m256 v1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+				const __m256 v2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+				const __m256 v3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+				float* dst = &out[i].X;
+				_mm256_storeu_ps(dst, _mm256_permute2f128_ps(v0, v1, 0x20));
+				_mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(v2, v3, 0x20));
+				_mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(v0, v1, 0x31));
+				_mm256_storeu_ps(dst + 24, _mm256_permute2f128_ps(v2, v3, 0x31));
+			}
+			UnpackRGB10A2SSE41(in + i, out + i, count - i);
+		}
+
+		INLINE void EncodeOctahedralScalar(const Vector3f* in, uint32* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = math::EncodeOctahedral(in[i]);
+		}
+		INLINE void DecodeOctahedralScalar(const uint32* in, Vector3f* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = math::DecodeOctahedral(in[i]);
+		}
+		MATH_TARGET_SSE41 INLINE __m128i EncodeOctahedralSSE41(__m128 x, __m128 y, __m128 z)noexcept
+		{
+			const __m128 sign = _mm_set1_ps(-0.f), one = _mm_set1_ps(1.f), zero = _mm_setzero_ps();
+			const __m128 inv = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign, x), _mm_andnot_ps(sign, y)), _mm_andnot_ps(sign, z)));
+			x = _mm_mul_ps(x, inv);
+			y = _mm_mul_ps(y, inv);
+			const __m128 signX = _mm_blendv_ps(_mm_set1_ps(-1.f), one, _mm_cmpge_ps(x, zero));
+			const __m128 signY = _mm_blendv_ps(_mm_set1_ps(-1.f), one, _mm_cmpge_ps(y, zero));
+			const __m128 fx = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign, y)), signX);
+			const __m128 fy = _mm_mul_ps(_mm_sub_ps(one, _mm_andnot_ps(sign, x)), signY);
+			const __m128 lower = _mm_cmplt_ps(z, zero);
+			x = _mm_blendv_ps(x, fx, lower);
+			y = _mm_blendv_ps(y, fy, lower);
+			const __m128 max = _mm_set1_ps(32767.f);
+			return _mm_or_si128(_mm_and_si128(FloatToSnormSSE41(x, max), _mm_set1_epi32(0xFFFF)), _mm_slli_epi32(FloatToSnormSSE41(y, max), 16));
+		}
+		MATH_TARGET_SSE41 INLINE void DecodeOctahedralSSE41(__m128i p, __m128& x, __m128& y, __m128& z)noexcept
+		{
+			const __m128 sign = _mm_set1_ps(-0.f), zero = _mm_setzero_ps(), max = _mm_set1_ps(32767.f);
+			x = SnormToFloatSSE41(_mm_srai_epi32(_mm_slli_epi32(p, 16), 16), max);
+			y = SnormToFloatSSE41(_mm_srai_epi32(p, 16), max);
+			z = _mm_sub_ps(_mm_sub_ps(_mm_set1_ps(1.f), _mm_andnot_ps(sign, x)), _mm_andnot_ps(sign, y));
+			const __m128 t = _mm_max_ps(_mm_xor_ps(z, sign), zero);
+			const __m128 negT = _mm_xor_ps(t, sign);
+			x = _mm_add_ps(x, _mm_blendv_ps(t, negT, _mm_cmpge_ps(x, zero)));
+			y = _mm_add_ps(y, _mm_blendv_ps(t, negT, _mm_cmpge_ps(y, zero)));
+			const __m128 inv = _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z))));
+			x = _mm_mul_ps(x, inv);
+			y = _mm_mul_ps(y, inv);
+			z = _mm_mul_ps(z, inv);
+		}
+		MATH_TARGET_SSE41 inline void EncodeOctahedralSSE41(const Vector3f* in, uint32* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const float* src = &in[i].X;
+				SSE::Vector4f x, y, z;
+				SSE::Deinterleave3(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), EncodeOctahedralSSE41(x, y, z));
+			}
+			EncodeOctahedralScalar(in + i, out + i, count - i);
+		}
+		MATH_TARGET_SSE41 inline void DecodeOctahedralSSE41(const uint32* in, Vector3f* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				SSE::Vector4f x, y, z, a, b, c;
+				DecodeOctahedralSSE41(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)), x, y, z);
+				SSE::Interleave3(x, y, z, a, b, c);
+				float* dst = &out[i].X;
+				_mm_storeu_ps(dst, a);
+				_mm_storeu_ps(dst + 4, b);
+				_mm_storeu_ps(dst + 8, c);
+			}
+			DecodeOctahedralScalar(in + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX2 INLINE __m256i EncodeOctahedralAVX2(__m256 x, __m256 y, __m256 z)noexcept
+		{
+			const __m256 sign = _mm256_set1_ps(-0.f), one = _mm256_set1_ps(1.f), zero = _mm256_setzero_ps();
+			const __m256 inv = _mm256_div_ps(one, _mm256_add_ps(_mm256_add_ps(_mm256_andnot_ps(sign, x), _mm256_andnot_ps(sign, y)), _mm256_andnot_ps(sign, z)));
+			x = _mm256_mul_ps(x, inv);
+			y = _mm256_mul_ps(y, inv);
+			const __m256 signX = _mm256_blendv_ps(_mm256_set1_ps(-1.f), one, _mm256_cmp_ps(x, zero, _CMP_GE_OQ));
+			const __m256 signY = _mm256_blendv_ps(_mm256_set1_ps(-1.f), one, _mm256_cmp_ps(y, zero, _CMP_GE_OQ));
+			const __m256 fx = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(sign, y)), signX);
+			const __m256 fy = _mm256_mul_ps(_mm256_sub_ps(one, _mm256_andnot_ps(sign, x)), signY);
+			const __m256 lower = _mm256_cmp_ps(z, zero, _CMP_LT_OQ);
+			x = _mm256_blendv_ps(x, fx, lower);
+			y = _mm256_blendv_ps(y, fy, lower);
+			const __m256 max = _mm256_set1_ps(32767.f);
+			return _mm256_or_si256(_mm256_and_si256(FloatToSnormAVX2(x, max), _mm256_set1_epi32(0xFFFF)), _mm256_slli_epi32(FloatToSnormAVX2(y, max), 16));
+		}
+		MATH_TARGET_AVX2 INLINE void DecodeOctahedralAVX2(__m256i p, __m256& x, __m256& y, __m256& z)noexcept
+		{
+			const __m256 sign = _mm256_set1_ps(-0.f), zero = _mm256_setzero_ps(), max = _mm256_set1_ps(32767.f);
+			x = SnormToFloatAVX2(_mm256_srai_epi32(_mm256_slli_epi32(p, 16), 16), max);
+			y = SnormToFloatAVX2(_mm256_srai_epi32(p, 16), max);
+			z = _mm256_sub_ps(_mm256_sub_ps(_mm256_set1_ps(1.f), _mm256_andnot_ps(sign, x)), _mm256_andnot_ps(sign, y));
+			const __m256 t = _mm256_max_ps(_mm256_xor_ps(z, sign), zero);
+			const __m256 negT = _mm256_xor_ps(t, sign);
+			x = _mm256_add_ps(x, _mm256_blendv_ps(t, negT, _mm256_cmp_ps(x, zero, _CMP_GE_OQ)));
+			y = _mm256_add_ps(y, _mm256_blendv_ps(t, negT, _mm256_cmp_ps(y, zero, _CMP_GE_OQ)));
+			const __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.f), _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z))));
+			x = _mm256_mul_ps(x, inv);
+			y = _mm256_mul_ps(y, inv);
+			z = _mm256_mul_ps(z, inv);
+		}
+		MATH_TARGET_AVX2 inline void EncodeOctahedralAVX2(const Vector3f* in, uint32* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const float* src = &in[i].X;
+				SSE::Vector4f x0, y0, z0, x1, y1, z1;
+				SSE::Deinterleave3(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x0, y0, z0);
+				SSE::Deinterleave3(_mm_loadu_ps(src + 12), _mm_loadu_ps(src + 16), _mm_loadu_ps(src + 20), x1, y1, z1);
+				const __m256i p = EncodeOctahedralAVX2(_mm256_set_m128(x1, x0), _mm256_set_m128(y1, y0), _mm256_set_m128(z1, z0));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), p);
+			}
+			EncodeOctahedralSSE41(in + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX2 inline void DecodeOctahedralAVX2(const uint32* in, Vector3f* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 x, y, z;
+				DecodeOctahedralAVX2(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i)), x, y, z);
+				SSE::Vector4f a0, b0, c0, a1, b1, c1;
+				SSE::Interleave3(_mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), a0, b0, c0);
+				SSE::Interleave3(_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), a1, b1, c1);
+				float* dst = &out[i].X;
+				_mm256_storeu_ps(dst, _mm256_set_m128(b0, a0));
+				_mm256_storeu_ps(dst + 8, _mm256_set_m128(a1, c0));
+				_mm256_storeu_ps(dst + 16, _mm256_set_m128(c1, b1));
+			}
+			DecodeOctahedralSSE41(in + i, out + i, count - i);
+		}
+	}
+
+	/* out[i] = FloatToUnorm<I>(in[i]), I is uint8 or uint16 */
+	template<class I>
+	INLINE void ToUnorm(std::span<const float> in, std::span<I> out)noexcept
+	{
+		static_assert(std::is_same_v<I, uint8> || std::is_same_v<I, uint16>, "Batch::ToUnorm can only work with uint8 or uint16 types");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ToUnorm, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::ToNormScalar<I>, &Impl::ToNormSSE41<I>, &Impl::ToNormAVX2<I>, &Impl::ToNormAVX2<I>, in.data(), out.data(), out.size());
+	}
+	/* out[i] = FloatToSnorm<I>(in[i]), I is int8 or int16 */
+	template<class I>
+	INLINE void ToSnorm(std::span<const float> in, std::span<I> out)noexcept
+	{
+		static_assert(std::is_same_v<I, int8> || std::is_same_v<I, int16>, "Batch::ToSnorm can only work with int8 or int16 types");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::ToSnorm, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::ToNormScalar<I>, &Impl::ToNormSSE41<I>, &Impl::ToNormAVX2<I>, &Impl::ToNormAVX2<I>, in.data(), out.data(), out.size());
+	}
+	/* out[i] = UnormToFloat(in[i]) */
+	template<class I>
+	INLINE void FromUnorm(std::span<const I> in, std::span<float> out)noexcept
+	{
+		static_assert(std::is_same_v<I, uint8> || std::is_same_v<I, uint16>, "Batch::FromUnorm can only work with uint8 or uint16 types");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::FromUnorm, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::FromNormScalar<I>, &Impl::FromNormSSE41<I>, &Impl::FromNormAVX2<I>, &Impl::FromNormAVX2<I>, in.data(), out.data(), out.size());
+	}
+	/* out[i] = SnormToFloat(in[i]) */
+	template<class I>
+	INLINE void FromSnorm(std::span<const I> in, std::span<float> out)noexcept
+	{
+		static_assert(std::is_same_v<I, int8> || std::is_same_v<I, int16>, "Batch::FromSnorm can only work with int8 or int16 types");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::FromSnorm, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::FromNormScalar<I>, &Impl::FromNormSSE41<I>, &Impl::FromNormAVX2<I>, &Impl::FromNormAVX2<I>, in.data(), out.data(), out.size());
+	}
+	/* out[i] = PackRGB10A2(in[i]) */
+	INLINE void PackRGB10A2(std::span<const Vector4f> in, std::span<uint32> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::PackRGB10A2, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::PackRGB10A2Scalar, &Impl::PackRGB10A2SSE41, &Impl::PackRGB10A2AVX2, &Impl::PackRGB10A2AVX2, in.data(), out.data(), out.size());
+	}
+	/* out[i] = UnpackRGB10A2(in[i]) */
+	INLINE void UnpackRGB10A2(std::span<const uint32> in, std::span<Vector4f> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::UnpackRGB10A2, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::UnpackRGB10A2Scalar, &Impl::UnpackRGB10A2SSE41, &Impl::UnpackRGB10A2AVX2, &Impl::UnpackRGB10A2AVX2, in.data(), out.data(), out.size());
+	}
+	/* out[i] = EncodeOctahedral(in[i]), the inputs must be unit vectors */
+	INLINE void EncodeOctahedral(std::span<const Vector3f> in, std::span<uint32> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::EncodeOctahedral, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::EncodeOctahedralScalar, &Impl::EncodeOctahedralSSE41, &Impl::EncodeOctahedralAVX2, &Impl::EncodeOctahedralAVX2, in.data(), out.data(), out.size());
+	}
+	/* out[i] = DecodeOctahedral(in[i]) */
+	INLINE void DecodeOctahedral(std::span<const uint32> in, std::span<Vector3f> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::DecodeOctahedral, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::DecodeOctahedralScalar, &Impl::DecodeOctahedralSSE41, &Impl::DecodeOctahedralAVX2, &Impl::DecodeOctahedralAVX2, in.data(), out.data(), out.size());
+	}
+}
+
+MATH_STRICT_FP_END
+
+#endif /* MATH_PACKEDFORMATS_H */
\ No newline at end of file
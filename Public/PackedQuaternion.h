@@ -0,0 +1,547 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_PACKEDQUATERNION_H
+#define MATH_PACKEDQUATERNION_H 1
+
+#include "Quaternion.h"
+#include "PackedFormats.h"
+#include <array>
+
+MATH_STRICT_FP_BEGIN
+
+/* Smallest three compression of unit rotations: the largest component is dropped after flipping the quaternion
+ * so it is positive, the other three lie in [-1/sqrt(2), 1/sqrt(2)] and are stored as unorm values.
+ * 32 bit: 2 bit index and 3x10 bits, each component within 1.9e-3 and the rotation within 0.25 degrees.
+ * 48 bit: 2 bit index and 3x15 bits, each component within 5.6e-5 and the rotation within 0.008 degrees. */
+namespace greaper::math
+{
+	namespace Impl
+	{
+		static constexpr float SMALLEST_THREE_SCALE = 0.707106781186547524f;
+		static constexpr float SMALLEST_THREE_INV_SCALE = 1.41421356237309505f;
+
+		struct SmallestThree
+		{
+			uint32 Index;
+			float A, B, C;
+		};
+		/* The first component with the biggest magnitude is dropped, the rest are kept in W, X, Y, Z order */
+		NODISCARD INLINE constexpr SmallestThree SplitSmallestThree(const QuaternionF& q)noexcept
+		{
+			uint32 index = 0;
+			float best = Abs(q.W);
+			float largest = q.W;
+			if (Abs(q.X) > best) { index = 1; best = Abs(q.X); largest = q.X; }
+			if (Abs(q.Y) > best) { index = 2; best = Abs(q.Y); largest = q.Y; }
+			if (Abs(q.Z) > best) { index = 3; largest = q.Z; }
+			float a = index == 0 ? q.X : q.W;
+			float b = index <= 1 ? q.Y : q.X;
+			float c = index <= 2 ? q.Z : q.Y;
+			if (largest < 0.f)
+			{
+				a = -a;
+				b = -b;
+				c = -c;
+			}
+			return { index, a, b, c };
+		}
+		NODISCARD INLINE QuaternionF MergeSmallestThree(uint32 index, float a, float b, float c)noexcept
+		{
+			const float d = 1.f - (a * a + b * b + c * c);
+			const float l = std::sqrt(d > 0.f ? d : 0.f);
+			return {
+				index == 0 ? l : a,
+				index == 0 ? a : (index == 1 ? l : b),
+				index <= 1 ? b : (index == 2 ? l : c),
+				index == 3 ? l : c
+			};
+		}
+		NODISCARD INLINE constexpr uint32 EncodeSmallestThreeComponent(float v, float max)noexcept
+		{
+			return FloatToUnormBits(v * SMALLEST_THREE_SCALE + 0.5f, max);
+		}
+		NODISCARD INLINE constexpr float DecodeSmallestThreeComponent(uint32 v, float max)noexcept
+		{
+			return (UnormBitsToFloat(v, max) - 0.5f) * SMALLEST_THREE_INV_SCALE;
+		}
+	}
+
+	/* Index in the top two bits, followed by the three components from the highest to the lowest bits */
+	NODISCARD INLINE constexpr uint32 EncodeSmallestThree32(const QuaternionF& q)noexcept
+	{
+		const auto s = Impl::SplitSmallestThree(q);
+		return (s.Index << 30)
+			| (Impl::EncodeSmallestThreeComponent(s.A, 1023.f) << 20)
+			| (Impl::EncodeSmallestThreeComponent(s.B, 1023.f) << 10)
+			| Impl::EncodeSmallestThreeComponent(s.C, 1023.f);
+	}
+	NODISCARD INLINE QuaternionF DecodeSmallestThree32(uint32 packed)noexcept
+	{
+		return Impl::MergeSmallestThree(packed >> 30,
+			Impl::DecodeSmallestThreeComponent((packed >> 20) & 1023, 1023.f),
+			Impl::DecodeSmallestThreeComponent((packed >> 10) & 1023, 1023.f),
+			Impl::DecodeSmallestThreeComponent(packed & 1023, 1023.f));
+	}
+	/* One component per word, the index bits are the top bits of the first two words */
+	NODISCARD INLINE constexpr std::array<uint16, 3> EncodeSmallestThree48(const QuaternionF& q)noexcept
+	{
+		const auto s = Impl::SplitSmallestThree(q);
+		return {
+			static_cast<uint16>(Impl::EncodeSmallestThreeComponent(s.A, 32767.f) | ((s.Index & 1) << 15)),
+			static_cast<uint16>(Impl::EncodeSmallestThreeComponent(s.B, 32767.f) | ((s.Index >> 1) << 15)),
+			static_cast<uint16>(Impl::EncodeSmallestThreeComponent(s.C, 32767.f))
+		};
+	}
+	NODISCARD INLINE QuaternionF DecodeSmallestThree48(const std::array<uint16, 3>& packed)noexcept
+	{
+		return Impl::MergeSmallestThree(static_cast<uint32>((packed[0] >> 15) | ((packed[1] >> 15) << 1)),
+			Impl::DecodeSmallestThreeComponent(packed[0] & 0x7FFFu, 32767.f),
+			Impl::DecodeSmallestThreeComponent(packed[1] & 0x7FFFu, 32767.f),
+			Impl::DecodeSmallestThreeComponent(packed[2] & 0x7FFFu, 32767.f));
+	}
+
+	/* Storage types for the encodings, reflecting them instead of a QuaternionF streams the compact form */
+	class PackedQuaternion32
+	{
+		uint32 m_Value = 0;
+
+	public:
+		constexpr PackedQuaternion32()noexcept = default;
+		INLINE constexpr explicit PackedQuaternion32(const QuaternionF& q)noexcept
+			:m_Value(EncodeSmallestThree32(q))
+		{
+
+		}
+		INLINE constexpr void Set(const QuaternionF& q)noexcept
+		{
+			m_Value = EncodeSmallestThree32(q);
+		}
+		NODISCARD INLINE QuaternionF Get()const noexcept
+		{
+			return DecodeSmallestThree32(m_Value);
+		}
+		NODISCARD INLINE constexpr uint32 GetRaw()const noexcept
+		{
+			return m_Value;
+		}
+		INLINE constexpr void SetRaw(uint32 rawValue)noexcept
+		{
+			m_Value = rawValue;
+		}
+	};
+	INLINE constexpr bool operator==(const PackedQuaternion32& left, const PackedQuaternion32& right)noexcept
+	{
+		return left.GetRaw() == right.GetRaw();
+	}
+	INLINE constexpr bool operator!=(const PackedQuaternion32& left, const PackedQuaternion32& right)noexcept
+	{
+		return !(left == right);
+	}
+
+	class PackedQuaternion48
+	{
+		std::array<uint16, 3> m_Value{  };
+
+	public:
+		constexpr PackedQuaternion48()noexcept = default;
+		INLINE constexpr explicit PackedQuaternion48(const QuaternionF& q)noexcept
+			:m_Value(EncodeSmallestThree48(q))
+		{
+
+		}
+		INLINE constexpr void Set(const QuaternionF& q)noexcept
+		{
+			m_Value = EncodeSmallestThree48(q);
+		}
+		NODISCARD INLINE QuaternionF Get()const noexcept
+		{
+			return DecodeSmallestThree48(m_Value);
+		}
+		NODISCARD INLINE constexpr const std::array<uint16, 3>& GetRaw()const noexcept
+		{
+			return m_Value;
+		}
+		INLINE constexpr void SetRaw(const std::array<uint16, 3>& rawValue)noexcept
+		{
+			m_Value = rawValue;
+		}
+	};
+	INLINE constexpr bool operator==(const PackedQuaternion48& left, const PackedQuaternion48& right)noexcept
+	{
+		return left.GetRaw() == right.GetRaw();
+	}
+	INLINE constexpr bool operator!=(const PackedQuaternion48& left, const PackedQuaternion48& right)noexcept
+	{
+		return !(left == right);
+	}
+}
+
+/* Batch encoders and decoders over quaternion arrays, every level gives the same bits as the scalar functions.
+ * Four quaternions are transposed into W/X/Y/Z registers, the AVX-512 level runs the AVX2 kernels. */
+namespace greaper::math::Batch
+{
+	namespace Impl
+	{
+		INLINE void PackQuaternion32Scalar(const QuaternionF* in, uint32* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = EncodeSmallestThree32(in[i]);
+		}
+		INLINE void UnpackQuaternion32Scalar(const uint32* in, QuaternionF* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = DecodeSmallestThree32(in[i]);
+		}
+		INLINE void PackQuaternion48Scalar(const QuaternionF* in, uint16* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+			{
+				const auto p = EncodeSmallestThree48(in[i]);
+				std::copy_n(p.data(), 3, out + i * 3);
+			}
+		}
+		INLINE void UnpackQuaternion48Scalar(const uint16* in, QuaternionF* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = DecodeSmallestThree48({ in[i * 3], in[i * 3 + 1], in[i * 3 + 2] });
+		}
+
+		/* Same selection as math::Impl::SplitSmallestThree, gives the index and the three encoded components */
+		MATH_TARGET_SSE41 INLINE void SplitSmallestThreeSSE41(__m128 w, __m128 x, __m128 y, __m128 z, __m128 max, __m128i& index, __m128i& a, __m128i& b, __m128i& c)noexcept
+		{
+			const __m128 sign = _mm_set1_ps(-0.f);
+			__m128 best = _mm_andnot_ps(sign, w), largest = w;
+			__m128i idx = _mm_setzero_si128();
+			__m128 m = _mm_cmpgt_ps(_mm_andnot_ps(sign, x), best);
+			best = _mm_blendv_ps(best, _mm_andnot_ps(sign, x), m);
+			largest = _mm_blendv_ps(largest, x, m);
+			idx = _mm_blendv_epi8(idx, _mm_set1_epi32(1), _mm_castps_si128(m));
+			m = _mm_cmpgt_ps(_mm_andnot_ps(sign, y), best);
+			best = _mm_blendv_ps(best, _mm_andnot_ps(sign, y), m);
+			largest = _mm_blendv_ps(largest, y, m);
+			idx = _mm_blendv_epi8(idx, _mm_set1_epi32(2), _mm_castps_si128(m));
+			m = _mm_cmpgt_ps(_mm_andnot_ps(sign, z), best);
+			largest = _mm_blendv_ps(largest, z, m);
+			idx = _mm_blendv_epi8(idx, _mm_set1_epi32(3), _mm_castps_si128(m));
+
+			const __m128 flip = _mm_and_ps(_mm_cmplt_ps(largest, _mm_setzero_ps()), sign);
+			const __m128 i0 = _mm_castsi128_ps(_mm_cmpeq_epi32(idx, _mm_setzero_si128()));
+			const __m128 i01 = _mm_castsi128_ps(_mm_cmplt_epi32(idx, _mm_set1_epi32(2)));
+			const __m128 i012 = _mm_castsi128_ps(_mm_cmplt_epi32(idx, _mm_set1_epi32(3)));
+			const __m128 scale = _mm_set1_ps(math::Impl::SMALLEST_THREE_SCALE), half = _mm_set1_ps(0.5f);
+			const __m128 fa = _mm_xor_ps(_mm_blendv_ps(w, x, i0), flip);
+			const __m128 fb = _mm_xor_ps(_mm_blendv_ps(x, y, i01), flip);
+			const __m128 fc = _mm_xor_ps(_mm_blendv_ps(y, z, i012), flip);
+			index = idx;
+			a = FloatToUnormSSE41(_mm_add_ps(_mm_mul_ps(fa, scale), half), max);
+			b = FloatToUnormSSE41(_mm_add_ps(_mm_mul_ps(fb, scale), half), max);
+			c = FloatToUnormSSE41(_mm_add_ps(_mm_mul_ps(fc, scale), half), max);
+		}
+		/* Inverse of SplitSmallestThreeSSE41, same operations as math::Impl::MergeSmallestThree */
+		MATH_TARGET_SSE41 INLINE void MergeSmallestThreeSSE41(__m128i index, __m128i a, __m128i b, __m128i c, __m128 max, __m128& w, __m128& x, __m128& y, __m128& z)noexcept
+		{
+			const __m128 half = _mm_set1_ps(0.5f), scale = _mm_set1_ps(math::Impl::SMALLEST_THREE_INV_SCALE);
+			const __m128 fa = _mm_mul_ps(_mm_sub_ps(UnormToFloatSSE41(a, max), half), scale);
+			const __m128 fb = _mm_mul_ps(_mm_sub_ps(UnormToFloatSSE41(b, max), half), scale);
+			const __m128 fc = _mm_mul_ps(_mm_sub_ps(UnormToFloatSSE41(c, max), half), scale);
+			const __m128 d = _mm_sub_ps(_mm_set1_ps(1.f), _mm_add_ps(_mm_add_ps(_mm_mul_ps(fa, fa), _mm_mul_ps(fb, fb)), _mm_mul_ps(fc, fc)));
+			const __m128 l = _mm_sqrt_ps(_mm_max_ps(d, _mm_setzero_ps()));
+			const __m128 i0 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_setzero_si128()));
+			const __m128 i1 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(1)));
+			const __m128 i2 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(2)));
+			const __m128 i3 = _mm_castsi128_ps(_mm_cmpeq_epi32(index, _mm_set1_epi32(3)));
+			w = _mm_blendv_ps(fa, l, i0);
+			x = _mm_blendv_ps(_mm_blendv_ps(fb, l, i1), fa, i0);
+			y = _mm_blendv_ps(_mm_blendv_ps(fc, l, i2), fb, _mm_or_ps(i0, i1));
+			z = _mm_blendv_ps(fc, l, i3);
+		}
+		/* Twelve words of four 48 bit encodings from the A/B/C word vectors and back */
+		MATH_TARGET_SSE41 INLINE void StoreSmallestThree48SSE41(__m128i a, __m128i b, __m128i c, uint16* out)noexcept
+		{
+			const __m128i ab = _mm_packus_epi32(a, b);
+			const __m128i cc = _mm_packus_epi32(c, c);
+			const __m128i lo = _mm_or_si128(
+				_mm_shuffle_epi8(ab, _mm_setr_epi8(0, 1, 8, 9, -1, -1, 2, 3, 10, 11, -1, -1, 4, 5, 12, 13)),
+				_mm_shuffle_epi8(cc, _mm_setr_epi8(-1, -1, -1, -1, 0, 1, -1, -1, -1, -1, 2, 3, -1, -1, -1, -1)));
+			const __m128i hi = _mm_or_si128(
+				_mm_shuffle_epi8(ab, _mm_setr_epi8(-1, -1, 6, 7, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+				_mm_shuffle_epi8(cc, _mm_setr_epi8(4, 5, -1, -1, -1, -1, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1)));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), lo);
+			_mm_storel_epi64(reinterpret_cast<__m128i*>(out + 8), hi);
+		}
+		MATH_TARGET_SSE41 INLINE void LoadSmallestThree48SSE41(const uint16* in, __m128i& a, __m128i& b, __m128i& c)noexcept
+		{
+			const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+			const __m128i hi = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(in + 8));
+			a = _mm_or_si128(_mm_shuffle_epi8(lo, _mm_setr_epi8(0, 1, -1, -1, 6, 7, -1, -1, 12, 13, -1, -1, -1, -1, -1, -1)),
+				_mm_shuffle_epi8(hi, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 3, -1, -1)));
+			b = _mm_or_si128(_mm_shuffle_epi8(lo, _mm_setr_epi8(2, 3, -1, -1, 8, 9, -1, -1, 14, 15, -1, -1, -1, -1, -1, -1)),
+				_mm_shuffle_epi8(hi, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 4, 5, -1, -1)));
+			c = _mm_or_si128(_mm_shuffle_epi8(lo, _mm_setr_epi8(4, 5, -1, -1, 10, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1)),
+				_mm_shuffle_epi8(hi, _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, 0, 1, -1, -1, 6, 7, -1, -1)));
+		}
+		MATH_TARGET_SSE41 INLINE void LoadQuaternionsSSE41(const QuaternionF* in, __m128& w, __m128& x, __m128& y, __m128& z)noexcept
+		{
+			const float* src = &in->W;
+			w = _mm_loadu_ps(src);
+			x = _mm_loadu_ps(src + 4);
+			y = _mm_loadu_ps(src + 8);
+			z = _mm_loadu_ps(src + 12);
+			_MM_TRANSPOSE4_PS(w, x, y, z);
+		}
+		MATH_TARGET_SSE41 INLINE void StoreQuaternionsSSE41(__m128 w, __m128 x, __m128 y, __m128 z, QuaternionF* out)noexcept
+		{
+			_MM_TRANSPOSE4_PS(w, x, y, z);
+			float* dst = &out->W;
+			_mm_storeu_ps(dst, w);
+			_mm_storeu_ps(dst + 4, x);
+			_mm_storeu_ps(dst + 8, y);
+			_mm_storeu_ps(dst + 12, z);
+		}
+
+		MATH_TARGET_SSE41 inline void PackQuaternion32SSE41(const QuaternionF* in, uint32* out, sizet count)noexcept
+		{
+			const __m128 max = _mm_set1_ps(1023.f);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 w, x, y, z;
+				__m128i index, a, b, c;
+				LoadQuaternionsSSE41(in + i, w, x, y, z);
+				SplitSmallestThreeSSE41(w, x, y, z, max, index, a, b, c);
+				const __m128i p = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(index, 30), _mm_slli_epi32(a, 20)), _mm_or_si128(_mm_slli_epi32(b, 10), c));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), p);
+			}
+			PackQuaternion32Scalar(in + i, out + i, count - i);
+		}
+		MATH_TARGET_SSE41 inline void UnpackQuaternion32SSE41(const uint32* in, QuaternionF* out, sizet count)noexcept
+		{
+			const __m128 max = _mm_set1_ps(1023.f);
+			const __m128i mask = _mm_set1_epi32(1023);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+				__m128 w, x, y, z;
+				MergeSmallestThreeSSE41(_mm_srli_epi32(p, 30), _mm_and_si128(_mm_srli_epi32(p, 20), mask), _mm_and_si128(_mm_srli_epi32(p, 10), mask), _mm_and_si128(p, mask), max, w, x, y, z);
+				StoreQuaternionsSSE41(w, x, y, z, out + i);
+			}
+			UnpackQuaternion32Scalar(in + i, out + i, count - i);
+		}
+		MATH_TARGET_SSE41 inline void PackQuaternion48SSE41(const QuaternionF* in, uint16* out, sizet count)noexcept
+		{
+			const __m128 max = _mm_set1_ps(32767.f);
+			const __m128i one = _mm_set1_epi32(1);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128 w, x, y, z;
+				__m128i index, a, b, c;
+				LoadQuaternionsSSE41(in + i, w, x, y, z);
+				SplitSmallestThreeSSE41(w, x, y, z, max, index, a, b, c);
+				a = _mm_or_si128(a, _mm_slli_epi32(_mm_and_si128(index, one), 15));
+				b = _mm_or_si128(b, _mm_slli_epi32(_mm_srli_epi32(index, 1), 15));
+				StoreSmallestThree48SSE41(a, b, c, out + i * 3);
+			}
+			PackQuaternion48Scalar(in + i, out + i * 3, count - i);
+		}
+		MATH_TARGET_SSE41 inline void UnpackQuaternion48SSE41(const uint16* in, QuaternionF* out, sizet count)noexcept
+		{
+			const __m128 max = _mm_set1_ps(32767.f);
+			const __m128i mask = _mm_set1_epi32(0x7FFF);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				__m128i a, b, c;
+				LoadSmallestThree48SSE41(in + i * 3, a, b, c);
+				const __m128i index = _mm_or_si128(_mm_srli_epi32(a, 15), _mm_slli_epi32(_mm_srli_epi32(b, 15), 1));
+				__m128 w, x, y, z;
+				MergeSmallestThreeSSE41(index, _mm_and_si128(a, mask), _mm_and_si128(b, mask), _mm_and_si128(c, mask), max, w, x, y, z);
+				StoreQuaternionsSSE41(w, x, y, z, out + i);
+			}
+			UnpackQuaternion48Scalar(in + i * 3, out + i, count - i);
+		}
+
+		MATH_TARGET_AVX2 INLINE void SplitSmallestThreeAVX2(__m256 w, __m256 x, __m256 y, __m256 z, __m256 max, __m256i& index, __m256i& a, __m256i& b, __m256i& c)noexcept
+		{
+			const __m256 sign = _mm256_set1_ps(-0.f);
+			__m256 best = _mm256_andnot_ps(sign, w), largest = w;
+			__m256i idx = _mm256_setzero_si256();
+			__m256 m = _mm256_cmp_ps(_mm256_andnot_ps(sign, x), best, _CMP_GT_OQ);
+			best = _mm256_blendv_ps(best, _mm256_andnot_ps(sign, x), m);
+			largest = _mm256_blendv_ps(largest, x, m);
+			idx = _mm256_blendv_epi8(idx, _mm256_set1_epi32(1), _mm256_castps_si256(m));
+			m = _mm256_cmp_ps(_mm256_andnot_ps(sign, y), best, _CMP_GT_OQ);
+			best = _mm256_blendv_ps(best, _mm256_andnot_ps(sign, y), m);
+			largest = _mm256_blendv_ps(largest, y, m);
+			idx = _mm256_blendv_epi8(idx, _mm256_set1_epi32(2), _mm256_castps_si256(m));
+			m = _mm256_cmp_ps(_mm256_andnot_ps(sign, z), best, _CMP_GT_OQ);
+			largest = _mm256_blendv_ps(largest, z, m);
+			idx = _mm256_blendv_epi8(idx, _mm256_set1_epi32(3), _mm256_castps_si256(m));
+
+			const __m256 flip = _mm256_and_ps(_mm256_cmp_ps(largest, _mm256_setzero_ps(), _CMP_LT_OQ), sign);
+			const __m256 i0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(idx, _mm256_setzero_si256()));
+			const __m256 i01 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(2), idx));
+			const __m256 i012 = _mm256_castsi256_ps(_mm256_cmpgt_epi32(_mm256_set1_epi32(3), idx));
+			const __m256 scale = _mm256_set1_ps(math::Impl::SMALLEST_THREE_SCALE), half = _mm256_set1_ps(0.5f);
+			const __m256 fa = _mm256_xor_ps(_mm256_blendv_ps(w, x, i0), flip);
+			const __m256 fb = _mm256_xor_ps(_mm256_blendv_ps(x, y, i01), flip);
+			const __m256 fc = _mm256_xor_ps(_mm256_blendv_ps(y, z, i012), flip);
+			index = idx;
+			a = FloatToUnormAVX2(_mm256_add_ps(_mm256_mul_ps(fa, scale), half), max);
+			b = FloatToUnormAVX2(_mm256_add_ps(_mm256_mul_ps(fb, scale), half), max);
+			c = FloatToUnormAVX2(_mm256_add_ps(_mm256_mul_ps(fc, scale), half), max);
+		}
+		MATH_TARGET_AVX2 INLINE void MergeSmallestThreeAVX2(__m256i index, __m256i a, __m256i b, __m256i c, __m256 max, __m256& w, __m256& x, __m256& y, __m256& z)noexcept
+		{
+			const __m256 half = _mm256_set1_ps(0.5f), scale = _mm256_set1_ps(math::Impl::SMALLEST_THREE_INV_SCALE);
+			const __m256 fa = _mm256_mul_ps(_mm256_sub_ps(UnormToFloatAVX2(a, max), half), scale);
+			const __m256 fb = _mm256_mul_ps(_mm256_sub_ps(UnormToFloatAVX2(b, max), half), scale);
+			const __m256 fc = _mm256_mul_ps(_mm256_sub_ps(UnormToFloatAVX2(c, max), half), scale);
+			const __m256 d = _mm256_sub_ps(_mm256_set1_ps(1.f), _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(fa, fa), _mm256_mul_ps(fb, fb)), _mm256_mul_ps(fc, fc)));
+			const __m256 l = _mm256_sqrt_ps(_mm256_max_ps(d, _mm256_setzero_ps()));
+			const __m256 i0 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_setzero_si256()));
+			const __m256 i1 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(1)));
+			const __m256 i2 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(2)));
+			const __m256 i3 = _mm256_castsi256_ps(_mm256_cmpeq_epi32(index, _mm256_set1_epi32(3)));
+			w = _mm256_blendv_ps(fa, l, i0);
+			x = _mm256_blendv_ps(_mm256_blendv_ps(fb, l, i1), fa, i0);
+			y = _mm256_blendv_ps(_mm256_blendv_ps(fc, l, i2), fb, _mm256_or_ps(i0, i1));
+			z = _mm256_blendv_ps(fc, l, i3);
+		}
+		/* Quaternions i and i + 4 share a register so the in lane transpose leaves them in order */
+		MATH_TARGET_AVX2 INLINE void LoadQuaternionsAVX2(const QuaternionF* in, __m256& w, __m256& x, __m256& y, __m256& z)noexcept
+		{
+			const float* src = &in->W;
+			w = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src)), _mm_loadu_ps(src + 16), 1);
+			x = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 4)), _mm_loadu_ps(src + 20), 1);
+			y = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 8)), _mm_loadu_ps(src + 24), 1);
+			z = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(src + 12)), _mm_loadu_ps(src + 28), 1);
+			const __m256 t0 = _mm256_unpacklo_ps(w, x), t1 = _mm256_unpackhi_ps(w, x);
+			const __m256 t2 = _mm256_unpacklo_ps(y, z), t3 = _mm256_unpackhi_ps(y, z);
+			w = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+			x = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+			y = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			z = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+		}
+		MATH_TARGET_AVX2 INLINE void StoreQuaternionsAVX2(__m256 w, __m256 x, __m256 y, __m256 z, QuaternionF* out)noexcept
+		{
+			const __m256 t0 = _mm256_unpacklo_ps(w, x), t1 = _mm256_unpackhi_ps(w, x);
+			const __m256 t2 = _mm256_unpacklo_ps(y, z), t3 = _mm256_unpackhi_ps(y, z);
+			const __m256 q0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+			const __m256 q1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+			const __m256 q2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+			const __m256 q3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+			float* dst = &out->W;
+			_mm256_storeu_ps(dst, _mm256_permute2f128_ps(q0, q1, 0x20));
+			_mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(q2, q3, 0x20));
+			_mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(q0, q1, 0x31));
+			_mm256_storeu_ps(dst + 24, _mm256_permute2f128_ps(q2, q3, 0x31));
+		}
+
+		MATH_TARGET_AVX2 inline void PackQuaternion32AVX2(const QuaternionF* in, uint32* out, sizet count)noexcept
+		{
+			const __m256 max = _mm256_set1_ps(1023.f);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 w, x, y, z;
+				__m256i index, a, b, c;
+				LoadQuaternionsAVX2(in + i, w, x, y, z);
+				SplitSmallestThreeAVX2(w, x, y, z, max, index, a, b, c);
+				const __m256i p = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(index, 30), _mm256_slli_epi32(a, 20)), _mm256_or_si256(_mm256_slli_epi32(b, 10), c));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), p);
+			}
+			PackQuaternion32SSE41(in + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX2 inline void UnpackQuaternion32AVX2(const uint32* in, QuaternionF* out, sizet count)noexcept
+		{
+			const __m256 max = _mm256_set1_ps(1023.f);
+			const __m256i mask = _mm256_set1_epi32(1023);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));
+				__m256 w, x, y, z;
+				MergeSmallestThreeAVX2(_mm256_srli_epi32(p, 30), _mm256_and_si256(_mm256_srli_epi32(p, 20), mask), _mm256_and_si256(_mm256_srli_epi32(p, 10), mask), _mm256_and_si256(p, mask), max, w, x, y, z);
+				StoreQuaternionsAVX2(w, x, y, z, out + i);
+			}
+			UnpackQuaternion32SSE41(in + i, out + i, count - i);
+		}
+		/* The 48 bit word shuffles stay 128 bit wide, only the arithmetic runs eight wide */
+		MATH_TARGET_AVX2 inline void PackQuaternion48AVX2(const QuaternionF* in, uint16* out, sizet count)noexcept
+		{
+			const __m256 max = _mm256_set1_ps(32767.f);
+			const __m256i one = _mm256_set1_epi32(1);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m256 w, x, y, z;
+				__m256i index, a, b, c;
+				LoadQuaternionsAVX2(in + i, w, x, y, z);
+				SplitSmallestThreeAVX2(w, x, y, z, max, index, a, b, c);
+				a = _mm256_or_si256(a, _mm256_slli_epi32(_mm256_and_si256(index, one), 15));
+				b = _mm256_or_si256(b, _mm256_slli_epi32(_mm256_srli_epi32(index, 1), 15));
+				StoreSmallestThree48SSE41(_mm256_castsi256_si128(a), _mm256_castsi256_si128(b), _mm256_castsi256_si128(c), out + i * 3);
+				StoreSmallestThree48SSE41(_mm256_extracti128_si256(a, 1), _mm256_extracti128_si256(b, 1), _mm256_extracti128_si256(c, 1), out + i * 3 + 12);
+			}
+			PackQuaternion48SSE41(in + i, out + i * 3, count - i);
+		}
+		MATH_TARGET_AVX2 inline void UnpackQuaternion48AVX2(const uint16* in, QuaternionF* out, sizet count)noexcept
+		{
+			const __m256 max = _mm256_set1_ps(32767.f);
+			const __m256i mask = _mm256_set1_epi32(0x7FFF);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				__m128i a0, b0, c0, a1, b1, c1;
+				LoadSmallestThree48SSE41(in + i * 3, a0, b0, c0);
+				LoadSmallestThree48SSE41(in + i * 3 + 12, a1, b1, c1);
+				const __m256i a = _mm256_set_m128i(a1, a0), b = _mm256_set_m128i(b1, b0), c = _mm256_set_m128i(c1, c0);
+				const __m256i index = _mm256_or_si256(_mm256_srli_epi32(a, 15), _mm256_slli_epi32(_mm256_srli_epi32(b, 15), 1));
+				__m256 w, x, y, z;
+				MergeSmallestThreeAVX2(index, _mm256_and_si256(a, mask), _mm256_and_si256(b, mask), _mm256_and_si256(c, mask), max, w, x, y, z);
+				StoreQuaternionsAVX2(w, x, y, z, out + i);
+			}
+			UnpackQuaternion48SSE41(in + i * 3, out + i, count - i);
+		}
+	}
+
+	/* out[i] = PackedQuaternion32(in[i]), the inputs must be unit quaternions */
+	INLINE void PackQuaternion(std::span<const QuaternionF> in, std::span<PackedQuaternion32> out)noexcept
+	{
+		static_assert(sizeof(PackedQuaternion32) == sizeof(uint32), "Batch::PackQuaternion expects PackedQuaternion32 to be a bare 32 bit value.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::PackQuaternion, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::PackQuaternion32Scalar, &Impl::PackQuaternion32SSE41, &Impl::PackQuaternion32AVX2, &Impl::PackQuaternion32AVX2, in.data(), reinterpret_cast<uint32*>(out.data()), out.size());
+	}
+	/* out[i] = PackedQuaternion48(in[i]), the inputs must be unit quaternions */
+	INLINE void PackQuaternion(std::span<const QuaternionF> in, std::span<PackedQuaternion48> out)noexcept
+	{
+		static_assert(sizeof(PackedQuaternion48) == sizeof(uint16) * 3, "Batch::PackQuaternion expects PackedQuaternion48 to be three packed 16 bit words.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::PackQuaternion, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::PackQuaternion48Scalar, &Impl::PackQuaternion48SSE41, &Impl::PackQuaternion48AVX2, &Impl::PackQuaternion48AVX2, in.data(), reinterpret_cast<uint16*>(out.data()), out.size());
+	}
+	/* out[i] = in[i].Get() */
+	INLINE void UnpackQuaternion(std::span<const PackedQuaternion32> in, std::span<QuaternionF> out)noexcept
+	{
+		static_assert(sizeof(PackedQuaternion32) == sizeof(uint32), "Batch::UnpackQuaternion expects PackedQuaternion32 to be a bare 32 bit value.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::UnpackQuaternion, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::UnpackQuaternion32Scalar, &Impl::UnpackQuaternion32SSE41, &Impl::UnpackQuaternion32AVX2, &Impl::UnpackQuaternion32AVX2, reinterpret_cast<const uint32*>(in.data()), out.data(), out.size());
+	}
+	/* out[i] = in[i].Get() */
+	INLINE void UnpackQuaternion(std::span<const PackedQuaternion48> in, std::span<QuaternionF> out)noexcept
+	{
+		static_assert(sizeof(PackedQuaternion48) == sizeof(uint16) * 3, "Batch::UnpackQuaternion expects PackedQuaternion48 to be three packed 16 bit words.");
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::UnpackQuaternion, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::UnpackQuaternion48Scalar, &Impl::UnpackQuaternion48SSE41, &Impl::UnpackQuaternion48AVX2, &Impl::UnpackQuaternion48AVX2, reinterpret_cast<const uint16*>(in.data()), out.data(), out.size());
+	}
+}
+
+MATH_STRICT_FP_END
+
+#endif /* MATH_PACKEDQUATERNION_H */
\ No newline at end of file
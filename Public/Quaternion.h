@@ -9,6 +9,7 @@
 #define MATH_QUATERNION_H 1
 
 #include "MathPrerequisites.h"
+#include "Matrix43.h"
 #include "Base/StringConversion.inl"
 
 namespace greaper::math
@@ -70,7 +71,7 @@ namespace greaper::math
 			Y = T(0);
 			Z = T(0);
 		}
-		NODISCARD INLINE static QuaternionReal<T> FromEuler(T x, T y, T z)noexcept
+		NODISCARD INLINE static constexpr QuaternionReal<T> FromEuler(T x, T y, T z)noexcept
 		{
 			auto hx = x * T(0.5);
 			auto hy = y * T(0.5);
@@ -90,11 +91,11 @@ namespace greaper::math
 					cosx * cosy * sinz - sinx * siny * cosz
 			};
 		}
-		NODISCARD INLINE static QuaternionReal<T> FromEuler(const Vector3Real<T>& v)noexcept
+		NODISCARD INLINE static constexpr QuaternionReal<T> FromEuler(const Vector3Real<T>& v)noexcept
 		{
 			return FromEuler(v.X, v.Y, v.Z);
 		}
-		NODISCARD INLINE static QuaternionReal<T> FromEuler(const std::array<T, 3>& a)noexcept
+		NODISCARD INLINE static constexpr QuaternionReal<T> FromEuler(const std::array<T, 3>& a)noexcept
 		{
 			return FromEuler(a[0], a[1], a[2]);
 		}
@@ -141,6 +142,17 @@ namespace greaper::math
 		}
 		NODISCARD INLINE constexpr QuaternionReal Conjugated()const noexcept
 		{
+#if MATH_USE_OPTIMIZATIONS
+			if constexpr (std::is_same_v<T, float>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					QuaternionReal q;
+					_mm_store_ps(&q.W, SSE::QuaternionConjugate(_mm_load_ps(&W)));
+					return q;
+				}
+			}
+#endif
 			return { W, -X, -Y, -Z };
 		}
 		INLINE void Conjugate()noexcept
@@ -168,12 +180,23 @@ namespace greaper::math
 		{
 			return DotProduct(*this);
 		}
-		NODISCARD INLINE T Length()const noexcept
+		NODISCARD INLINE constexpr T Length()const noexcept
 		{
 			return Sqrt(LengthSquared());
 		}
-		NODISCARD INLINE QuaternionReal GetNormalized(T tolerance = MATH_TOLERANCE<T>)const noexcept
+		NODISCARD INLINE constexpr QuaternionReal GetNormalized(T tolerance = MATH_TOLERANCE<T>)const noexcept
 		{
+#if MATH_USE_OPTIMIZATIONS
+			if constexpr (std::is_same_v<T, float>)
+			{
+				if (!std::is_constant_evaluated())
+				{
+					QuaternionReal q;
+					_mm_store_ps(&q.W, SSE::QuaternionNormalize(_mm_load_ps(&W), tolerance));
+					return q;
+				}
+			}
+#endif
 			auto len = LengthSquared();
 			if (len > tolerance)
 			{
@@ -182,10 +205,58 @@ namespace greaper::math
 			}
 			return *this;
 		}
-		INLINE void Normalize(T tolerance = MATH_TOLERANCE<T>)noexcept
+		INLINE constexpr void Normalize(T tolerance = MATH_TOLERANCE<T>)noexcept
 		{
 			*this = GetNormalized(tolerance);
 		}
+		/* Rotates v by this quaternion, which must be unit length.
+		 * Uses v' = v + W * t + cross(q.XYZ, t) with t = 2 * cross(q.XYZ, v), which is cheaper than q * v * q^-1 */
+		NODISCARD INLINE constexpr Vector3Real<T> Rotate(const Vector3Real<T>& v)const noexcept
+		{
+			T tx = T(2) * (Y * v.Z - Z * v.Y);
+			T ty = T(2) * (Z * v.X - X * v.Z);
+			T tz = T(2) * (X * v.Y - Y * v.X);
+			return {
+				v.X + W * tx + (Y * tz - Z * ty),
+				v.Y + W * ty + (Z * tx - X * tz),
+				v.Z + W * tz + (X * ty - Y * tx)
+			};
+		}
+
+		/* Rotation matrix for column vectors, ToMatrix3() * v == Rotate(v). The quaternion must be unit length. */
+		NODISCARD INLINE constexpr Matrix3Real<T> ToMatrix3()const noexcept
+		{
+			const T x2 = X + X, y2 = Y + Y, z2 = Z + Z;
+			const T xx = X * x2, yy = Y * y2, zz = Z * z2;
+			const T xy = X * y2, xz = X * z2, yz = Y * z2;
+			const T wx = W * x2, wy = W * y2, wz = W * z2;
+			return {
+				T(1) - (yy + zz), xy - wz, xz + wy,
+				xy + wz, T(1) - (xx + zz), yz - wx,
+				xz - wy, yz + wx, T(1) - (xx + yy)
+			};
+		}
+		NODISCARD INLINE constexpr Matrix43Real<T> ToMatrix43()const noexcept
+		{
+			return Matrix43Real<T>(ToMatrix3());
+		}
+		NODISCARD INLINE constexpr Matrix4Real<T> ToMatrix4()const noexcept
+		{
+			return ToMatrix43().ToMatrix4();
+		}
+		/* The matrix must be a pure rotation, scaled or sheared matrices give meaningless results */
+		NODISCARD INLINE static QuaternionReal FromMatrix(const Matrix3Real<T>& m)noexcept
+		{
+			return FromRotation(m.R0.X, m.R0.Y, m.R0.Z, m.R1.X, m.R1.Y, m.R1.Z, m.R2.X, m.R2.Y, m.R2.Z);
+		}
+		NODISCARD INLINE static QuaternionReal FromMatrix(const Matrix43Real<T>& m)noexcept
+		{
+			return FromRotation(m.R0.X, m.R0.Y, m.R0.Z, m.R1.X, m.R1.Y, m.R1.Z, m.R2.X, m.R2.Y, m.R2.Z);
+		}
+		NODISCARD INLINE static QuaternionReal FromMatrix(const Matrix4Real<T>& m)noexcept
+		{
+			return FromRotation(m.R0.X, m.R0.Y, m.R0.Z, m.R1.X, m.R1.Y, m.R1.Z, m.R2.X, m.R2.Y, m.R2.Z);
+		}
 
 		NODISCARD INLINE constexpr bool IsNearlyEqual(const QuaternionReal& other, T tolerance = MATH_TOLERANCE<T>)const noexcept
 		{
@@ -245,6 +316,35 @@ namespace greaper::math
 
 		static const QuaternionReal ZERO;
 		static const QuaternionReal IDENTITY;
+
+	private:
+		/* Shepperd's method, the largest of 4W^2, 4X^2, 4Y^2 and 4Z^2 is read from the diagonal and the other three
+		 * components are derived from it, so the only square root is always well conditioned */
+		NODISCARD INLINE static QuaternionReal FromRotation(T m00, T m01, T m02, T m10, T m11, T m12, T m20, T m21, T m22)noexcept
+		{
+			const T t0 = m00 + m11 + m22;
+			const T t1 = m00 - m11 - m22;
+			const T t2 = m11 - m00 - m22;
+			const T t3 = m22 - m00 - m11;
+			int largest = 0;
+			T best = t0;
+			if (t1 > best) { largest = 1; best = t1; }
+			if (t2 > best) { largest = 2; best = t2; }
+			if (t3 > best) { largest = 3; best = t3; }
+
+			const T r = Sqrt(best + T(1));
+			const T big = r * T(0.5);
+			const T f = T(0.5) / r;
+			const T wx = (m21 - m12) * f, wy = (m02 - m20) * f, wz = (m10 - m01) * f;
+			const T xy = (m01 + m10) * f, xz = (m02 + m20) * f, yz = (m12 + m21) * f;
+			switch (largest)
+			{
+			case 0: return { big, wx, wy, wz };
+			case 1: return { wx, big, xy, xz };
+			case 2: return { wy, xy, big, yz };
+			default: return { wz, xz, yz, big };
+			}
+		}
 	};
 
 	template<class T> const QuaternionReal<T> QuaternionReal<T>::ZERO{};
@@ -262,6 +362,17 @@ namespace greaper::math
 	template<class T> INLINE QuaternionReal<T>& operator/=(QuaternionReal<T>& left, T right)noexcept { float invRight = T(1) / right; left.W *= invRight; left.X *= invRight; left.Y *= invRight; left.Z *= invRight; return left; }
 	template<class T> NODISCARD INLINE constexpr QuaternionReal<T> operator*(const QuaternionReal<T>& left, const QuaternionReal<T>& right)noexcept
 	{
+#if MATH_USE_OPTIMIZATIONS
+		if constexpr (std::is_same_v<T, float>)
+		{
+			if (!std::is_constant_evaluated())
+			{
+				QuaternionReal<T> q;
+				_mm_store_ps(&q.W, SSE::QuaternionMul(_mm_load_ps(&left.W), _mm_load_ps(&right.W)));
+				return q;
+			}
+		}
+#endif
 		return {
 			
 			left.W * right.W - left.X * right.X - left.Y * right.Y - left.Z * right.Z,
@@ -278,9 +389,92 @@ namespace greaper::math
 		};
 	}
 	template<class T> INLINE QuaternionReal<T>& operator*=(QuaternionReal<T>& left, const QuaternionReal<T>& right)noexcept { left = (left * right); return left; }
+	template<class T> NODISCARD INLINE constexpr Vector3Real<T> operator*(const QuaternionReal<T>& left, const Vector3Real<T>& right)noexcept { return left.Rotate(right); }
 
 	template<class T> NODISCARD INLINE constexpr bool operator==(const QuaternionReal<T>& left, const QuaternionReal<T>& right)noexcept { return left.IsNearlyEqual(right); }
 	template<class T> NODISCARD INLINE constexpr bool operator!=(const QuaternionReal<T>& left, const QuaternionReal<T>& right)noexcept { return !(left == right); }
+
+	/* Composes translation * rotation * scale, the rotation must be unit length */
+	template<class T> NODISCARD INLINE constexpr Matrix43Real<T> ComposeTRS43(const Vector3Real<T>& translation, const QuaternionReal<T>& rotation, const Vector3Real<T>& scale)noexcept
+	{
+		const auto r = rotation.ToMatrix3();
+		return {
+			r.R0.X * scale.X, r.R0.Y * scale.Y, r.R0.Z * scale.Z, translation.X,
+			r.R1.X * scale.X, r.R1.Y * scale.Y, r.R1.Z * scale.Z, translation.Y,
+			r.R2.X * scale.X, r.R2.Y * scale.Y, r.R2.Z * scale.Z, translation.Z
+		};
+	}
+	template<class T> NODISCARD INLINE constexpr Matrix4Real<T> ComposeTRS(const Vector3Real<T>& translation, const QuaternionReal<T>& rotation, const Vector3Real<T>& scale)noexcept
+	{
+		return ComposeTRS43(translation, rotation, scale).ToMatrix4();
+	}
+
+	namespace Impl
+	{
+		/* Series coefficients from Eberly's "A Fast and Accurate Algorithm for Computing SLERP", u[i] = 1 / (i * (2i + 1))
+		 * and v[i] = i / (2i + 1) for i = 1..8, the last term is scaled by 1 + mu to make up for the truncated series */
+		constexpr double SLERP_FAST_ONE_PLUS_MU = 1.85298109240830;
+		template<class T> constexpr T SLERP_FAST_U[8] = {
+			T(1.0 / 3.0), T(1.0 / 10.0), T(1.0 / 21.0), T(1.0 / 36.0), T(1.0 / 55.0), T(1.0 / 78.0), T(1.0 / 105.0), T(SLERP_FAST_ONE_PLUS_MU / 136.0)
+		};
+		template<class T> constexpr T SLERP_FAST_V[8] = {
+			T(1.0 / 3.0), T(2.0 / 5.0), T(3.0 / 7.0), T(4.0 / 9.0), T(5.0 / 11.0), T(6.0 / 13.0), T(7.0 / 15.0), T(SLERP_FAST_ONE_PLUS_MU * 8.0 / 17.0)
+		};
+	}
+
+	/* Interpolates along the shortest path with a normalized lerp, cheaper than Slerp but the angular speed is not constant.
+	 * a and b must be unit length. */
+	template<class T> NODISCARD INLINE QuaternionReal<T> Nlerp(const QuaternionReal<T>& a, const QuaternionReal<T>& b, T t)noexcept
+	{
+		const T sign = a.DotProduct(b) < T(0) ? T(-1) : T(1);
+		const QuaternionReal<T> r{
+			a.W + (b.W * sign - a.W) * t,
+			a.X + (b.X * sign - a.X) * t,
+			a.Y + (b.Y * sign - a.Y) * t,
+			a.Z + (b.Z * sign - a.Z) * t
+		};
+		const T invLength = T(1) / Sqrt(r.W * r.W + r.X * r.X + r.Y * r.Y + r.Z * r.Z);
+		return { r.W * invLength, r.X * invLength, r.Y * invLength, r.Z * invLength };
+	}
+	/* Spherical linear interpolation along the shortest path, a and b must be unit length.
+	 * Falls back to Nlerp when the angle is too small to divide by its sine. */
+	template<class T> NODISCARD INLINE QuaternionReal<T> Slerp(const QuaternionReal<T>& a, const QuaternionReal<T>& b, T t)noexcept
+	{
+		T cosTheta = a.DotProduct(b);
+		const T sign = cosTheta < T(0) ? T(-1) : T(1);
+		cosTheta *= sign;
+		if (cosTheta > T(1) - MATH_TOLERANCE<T>)
+			return Nlerp(a, b, t);
+
+		const T theta = ACos(cosTheta);
+		const T invSin = T(1) / Sin(theta);
+		const T wa = Sin((T(1) - t) * theta) * invSin;
+		const T wb = Sin(t * theta) * invSin * sign;
+		return { a.W * wa + b.W * wb, a.X * wa + b.X * wb, a.Y * wa + b.Y * wb, a.Z * wa + b.Z * wb };
+	}
+	/* Slerp without acos or sin, sin(t * theta) / sin(theta) is evaluated as a degree 8 polynomial of cos(theta).
+	 * Branch free, the weights are within 1.91e-5 of the exact ones so each component is within 4e-5 of Slerp. */
+	template<class T> NODISCARD INLINE constexpr QuaternionReal<T> SlerpFast(const QuaternionReal<T>& a, const QuaternionReal<T>& b, T t)noexcept
+	{
+		T cosTheta = a.DotProduct(b);
+		const T sign = cosTheta < T(0) ? T(-1) : T(1);
+		cosTheta *= sign;
+
+		const T xm1 = cosTheta - T(1);
+		const T d = T(1) - t;
+		const T sqrT = t * t;
+		const T sqrD = d * d;
+		T fT = T(1);
+		T fD = T(1);
+		for (sizet i = 8; i-- > 0; )
+		{
+			fT = T(1) + (Impl::SLERP_FAST_U<T>[i] * sqrT - Impl::SLERP_FAST_V<T>[i]) * xm1 * fT;
+			fD = T(1) + (Impl::SLERP_FAST_U<T>[i] * sqrD - Impl::SLERP_FAST_V<T>[i]) * xm1 * fD;
+		}
+		const T wa = d * fD;
+		const T wb = t * fT * sign;
+		return { a.W * wa + b.W * wb, a.X * wa + b.X * wb, a.Y * wa + b.Y * wb, a.Z * wa + b.Z * wb };
+	}
 }
 
 namespace std
@@ -0,0 +1,655 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_QUATERNIONSOA_H
+#define MATH_QUATERNIONSOA_H 1
+
+#include "Quaternion.h"
+#include "Vector3SoA.h"
+#include "Batch.h"
+#include "Base/SoAStorage.h"
+
+namespace greaper::math
+{
+	/* Non owning view over four W/X/Y/Z streams of the same length, T can be const */
+	template<class T>
+	struct QuaternionSoAView
+	{
+		using value_type = std::remove_const_t<T>;
+		static_assert(std::is_floating_point_v<value_type>, "QuaternionSoAView can only work with float, double or long double types");
+
+		T* W = nullptr;
+		T* X = nullptr;
+		T* Y = nullptr;
+		T* Z = nullptr;
+		sizet Count = 0;
+
+		constexpr QuaternionSoAView()noexcept = default;
+		INLINE constexpr QuaternionSoAView(T* w, T* x, T* y, T* z, sizet count)noexcept :W(w), X(x), Y(y), Z(z), Count(count) {  }
+		template<class U, class = std::enable_if_t<std::is_same_v<const U, T>>>
+		INLINE constexpr QuaternionSoAView(const QuaternionSoAView<U>& other)noexcept :W(other.W), X(other.X), Y(other.Y), Z(other.Z), Count(other.Count) {  }
+
+		NODISCARD INLINE constexpr sizet Size()const noexcept { return Count; }
+		NODISCARD INLINE constexpr bool IsEmpty()const noexcept { return Count == 0; }
+		NODISCARD INLINE constexpr QuaternionReal<value_type> Get(sizet index)const noexcept
+		{
+			VerifyLess(index, Count, "Trying to access a QuaternionSoAView, but the index %" PRIuPTR " was out of range.", index);
+			return { W[index], X[index], Y[index], Z[index] };
+		}
+		INLINE constexpr void Set(sizet index, const QuaternionReal<value_type>& q)const noexcept
+		{
+			static_assert(!std::is_const_v<T>, "Trying to write through a const QuaternionSoAView.");
+			VerifyLess(index, Count, "Trying to access a QuaternionSoAView, but the index %" PRIuPTR " was out of range.", index);
+			W[index] = q.W;
+			X[index] = q.X;
+			Y[index] = q.Y;
+			Z[index] = q.Z;
+		}
+		NODISCARD INLINE constexpr QuaternionSoAView Subview(sizet offset, sizet count)const noexcept
+		{
+			VerifyLessEqual(offset + count, Count, "Trying to get a QuaternionSoAView subview, but the range was out of bounds.");
+			return { W + offset, X + offset, Y + offset, Z + offset, count };
+		}
+		/* Copies the AoS quaternions into the streams */
+		INLINE constexpr void Gather(std::span<const QuaternionReal<value_type>> src)const noexcept
+		{
+			static_assert(!std::is_const_v<T>, "Trying to write through a const QuaternionSoAView.");
+			VerifyLessEqual(src.size(), Count, "Trying to gather into a QuaternionSoAView, but the source is bigger than the view.");
+			for (sizet i = 0; i < src.size(); ++i)
+			{
+				W[i] = src[i].W;
+				X[i] = src[i].X;
+				Y[i] = src[i].Y;
+				Z[i] = src[i].Z;
+			}
+		}
+		/* Copies the streams into the AoS quaternions */
+		INLINE constexpr void Scatter(std::span<QuaternionReal<value_type>> dst)const noexcept
+		{
+			VerifyLessEqual(dst.size(), Count, "Trying to scatter from a QuaternionSoAView, but the destination is bigger than the view.");
+			for (sizet i = 0; i < dst.size(); ++i)
+			{
+				dst[i].W = W[i];
+				dst[i].X = X[i];
+				dst[i].Y = Y[i];
+				dst[i].Z = Z[i];
+			}
+		}
+	};
+
+	/* Owning structure of arrays Quaternion container over four W/X/Y/Z streams of one SoAStorage */
+	template<class T>
+	class QuaternionSoA : public SoAStorage<T, 4>
+	{
+		using Storage = SoAStorage<T, 4>;
+
+	public:
+		using value_type = T;
+
+		constexpr QuaternionSoA()noexcept = default;
+		INLINE explicit QuaternionSoA(sizet size) :Storage(size) {  }
+		INLINE explicit QuaternionSoA(std::span<const QuaternionReal<T>> quaternions)
+			:Storage(quaternions.size())
+		{
+			GetView().Gather(quaternions);
+		}
+
+		NODISCARD INLINE std::span<T> GetW()noexcept { return { this->GetStream(0), this->Size() }; }
+		NODISCARD INLINE std::span<T> GetX()noexcept { return { this->GetStream(1), this->Size() }; }
+		NODISCARD INLINE std::span<T> GetY()noexcept { return { this->GetStream(2), this->Size() }; }
+		NODISCARD INLINE std::span<T> GetZ()noexcept { return { this->GetStream(3), this->Size() }; }
+		NODISCARD INLINE std::span<const T> GetW()const noexcept { return { this->GetStream(0), this->Size() }; }
+		NODISCARD INLINE std::span<const T> GetX()const noexcept { return { this->GetStream(1), this->Size() }; }
+		NODISCARD INLINE std::span<const T> GetY()const noexcept { return { this->GetStream(2), this->Size() }; }
+		NODISCARD INLINE std::span<const T> GetZ()const noexcept { return { this->GetStream(3), this->Size() }; }
+
+		NODISCARD INLINE QuaternionSoAView<T> GetView()noexcept { return { this->GetStream(0), this->GetStream(1), this->GetStream(2), this->GetStream(3), this->Size() }; }
+		NODISCARD INLINE QuaternionSoAView<const T> GetView()const noexcept { return { this->GetStream(0), this->GetStream(1), this->GetStream(2), this->GetStream(3), this->Size() }; }
+		NODISCARD INLINE operator QuaternionSoAView<T>()noexcept { return GetView(); }
+		NODISCARD INLINE operator QuaternionSoAView<const T>()const noexcept { return GetView(); }
+
+		NODISCARD INLINE QuaternionReal<T> Get(sizet index)const noexcept { return GetView().Get(index); }
+		INLINE void Set(sizet index, const QuaternionReal<T>& q)noexcept { GetView().Set(index, q); }
+
+		INLINE void PushBack(const QuaternionReal<T>& q)
+		{
+			const sizet index = this->Append();
+			Set(index, q);
+		}
+	};
+}
+
+MATH_STRICT_FP_BEGIN
+
+/* Batched interpolation and matrix conversion, every element computes exactly what the scalar function of the same name does.
+ * Nlerp, SlerpFast and FromMatrix are branch free, the per lane choices are done with masks. */
+namespace greaper::math::Batch
+{
+	namespace Impl
+	{
+		template<class T>
+		INLINE void NlerpScalar(QuaternionSoAView<const T> a, QuaternionSoAView<const T> b, T t, QuaternionSoAView<T> out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out.Set(i, math::Nlerp(a.Get(i), b.Get(i), t));
+		}
+		MATH_TARGET_SSE41 inline void NlerpSSE41(QuaternionSoAView<const float> a, QuaternionSoAView<const float> b, float t, QuaternionSoAView<float> out, sizet count)noexcept
+		{
+			auto vt = _mm_set1_ps(t);
+			auto one = _mm_set1_ps(1.f);
+			auto zero = _mm_setzero_ps();
+			auto signBit = _mm_set1_ps(-0.f);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				auto aw = _mm_loadu_ps(a.W + i), ax = _mm_loadu_ps(a.X + i), ay = _mm_loadu_ps(a.Y + i), az = _mm_loadu_ps(a.Z + i);
+				auto bw = _mm_loadu_ps(b.W + i), bx = _mm_loadu_ps(b.X + i), by = _mm_loadu_ps(b.Y + i), bz = _mm_loadu_ps(b.Z + i);
+				auto dot = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+				auto sign = _mm_and_ps(_mm_cmplt_ps(dot, zero), signBit);
+
+				auto rw = _mm_add_ps(aw, _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(bw, sign), aw), vt));
+				auto rx = _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(bx, sign), ax), vt));
+				auto ry = _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(by, sign), ay), vt));
+				auto rz = _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(_mm_xor_ps(bz, sign), az), vt));
+				auto len = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rw, rw), _mm_mul_ps(rx, rx)), _mm_mul_ps(ry, ry)), _mm_mul_ps(rz, rz));
+				auto invLength = _mm_div_ps(one, _mm_sqrt_ps(len));
+				_mm_storeu_ps(out.W + i, _mm_mul_ps(rw, invLength));
+				_mm_storeu_ps(out.X + i, _mm_mul_ps(rx, invLength));
+				_mm_storeu_ps(out.Y + i, _mm_mul_ps(ry, invLength));
+				_mm_storeu_ps(out.Z + i, _mm_mul_ps(rz, invLength));
+			}
+			NlerpScalar<float>(a.Subview(i, count - i), b.Subview(i, count - i), t, out.Subview(i, count - i), count - i);
+		}
+		MATH_TARGET_AVX2 inline void NlerpAVX2(QuaternionSoAView<const float> a, QuaternionSoAView<const float> b, float t, QuaternionSoAView<float> out, sizet count)noexcept
+		{
+			auto vt = _mm256_set1_ps(t);
+			auto one = _mm256_set1_ps(1.f);
+			auto zero = _mm256_setzero_ps();
+			auto signBit = _mm256_set1_ps(-0.f);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				auto aw = _mm256_loadu_ps(a.W + i), ax = _mm256_loadu_ps(a.X + i), ay = _mm256_loadu_ps(a.Y + i), az = _mm256_loadu_ps(a.Z + i);
+				auto bw = _mm256_loadu_ps(b.W + i), bx = _mm256_loadu_ps(b.X + i), by = _mm256_loadu_ps(b.Y + i), bz = _mm256_loadu_ps(b.Z + i);
+				auto dot = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(aw, bw), _mm256_mul_ps(ax, bx)), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+				auto sign = _mm256_and_ps(_mm256_cmp_ps(dot, zero, _CMP_LT_OQ), signBit);
+
+				auto rw = _mm256_add_ps(aw, _mm256_mul_ps(_mm256_sub_ps(_mm256_xor_ps(bw, sign), aw), vt));
+				auto rx = _mm256_add_ps(ax, _mm256_mul_ps(_mm256_sub_ps(_mm256_xor_ps(bx, sign), ax), vt));
+				auto ry = _mm256_add_ps(ay, _mm256_mul_ps(_mm256_sub_ps(_mm256_xor_ps(by, sign), ay), vt));
+				auto rz = _mm256_add_ps(az, _mm256_mul_ps(_mm256_sub_ps(_mm256_xor_ps(bz, sign), az), vt));
+				auto len = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(rw, rw), _mm256_mul_ps(rx, rx)), _mm256_mul_ps(ry, ry)), _mm256_mul_ps(rz, rz));
+				auto invLength = _mm256_div_ps(one, _mm256_sqrt_ps(len));
+				_mm256_storeu_ps(out.W + i, _mm256_mul_ps(rw, invLength));
+				_mm256_storeu_ps(out.X + i, _mm256_mul_ps(rx, invLength));
+				_mm256_storeu_ps(out.Y + i, _mm256_mul_ps(ry, invLength));
+				_mm256_storeu_ps(out.Z + i, _mm256_mul_ps(rz, invLength));
+			}
+			NlerpSSE41(a.Subview(i, count - i), b.Subview(i, count - i), t, out.Subview(i, count - i), count - i);
+		}
+
+		template<class T>
+		INLINE void SlerpScalar(QuaternionSoAView<const T> a, QuaternionSoAView<const T> b, T t, QuaternionSoAView<T> out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out.Set(i, math::Slerp(a.Get(i), b.Get(i), t));
+		}
+
+		template<class T>
+		INLINE void SlerpFastScalar(QuaternionSoAView<const T> a, QuaternionSoAView<const T> b, T t, QuaternionSoAView<T> out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out.Set(i, math::SlerpFast(a.Get(i), b.Get(i), t));
+		}
+		/* The series coefficients only depend on t, so both sets are computed once per call */
+		MATH_TARGET_SSE41 inline void SlerpFastSSE41(QuaternionSoAView<const float> a, QuaternionSoAView<const float> b, float t, QuaternionSoAView<float> out, sizet count)noexcept
+		{
+			const float d = 1.f - t;
+			const float sqrT = t * t;
+			const float sqrD = d * d;
+			SSE::Vector4f cT[8], cD[8];
+			for (sizet k = 0; k < 8; ++k)
+			{
+				cT[k] = _mm_set1_ps(math::Impl::SLERP_FAST_U<float>[k] * sqrT - math::Impl::SLERP_FAST_V<float>[k]);
+				cD[k] = _mm_set1_ps(math::Impl::SLERP_FAST_U<float>[k] * sqrD - math::Impl::SLERP_FAST_V<float>[k]);
+			}
+			auto vt = _mm_set1_ps(t);
+			auto vd = _mm_set1_ps(d);
+			auto one = _mm_set1_ps(1.f);
+			auto zero = _mm_setzero_ps();
+			auto signBit = _mm_set1_ps(-0.f);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				auto aw = _mm_loadu_ps(a.W + i), ax = _mm_loadu_ps(a.X + i), ay = _mm_loadu_ps(a.Y + i), az = _mm_loadu_ps(a.Z + i);
+				auto bw = _mm_loadu_ps(b.W + i), bx = _mm_loadu_ps(b.X + i), by = _mm_loadu_ps(b.Y + i), bz = _mm_loadu_ps(b.Z + i);
+				auto cosTheta = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(aw, bw), _mm_mul_ps(ax, bx)), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+				auto sign = _mm_and_ps(_mm_cmplt_ps(cosTheta, zero), signBit);
+				auto xm1 = _mm_sub_ps(_mm_xor_ps(cosTheta, sign), one);
+
+				auto fT = one, fD = one;
+				for (sizet k = 8; k-- > 0; )
+				{
+					fT = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(cT[k], xm1), fT));
+					fD = _mm_add_ps(one, _mm_mul_ps(_mm_mul_ps(cD[k], xm1), fD));
+				}
+				auto wa = _mm_mul_ps(vd, fD);
+				auto wb = _mm_xor_ps(_mm_mul_ps(vt, fT), sign);
+				_mm_storeu_ps(out.W + i, _mm_add_ps(_mm_mul_ps(aw, wa), _mm_mul_ps(bw, wb)));
+				_mm_storeu_ps(out.X + i, _mm_add_ps(_mm_mul_ps(ax, wa), _mm_mul_ps(bx, wb)));
+				_mm_storeu_ps(out.Y + i, _mm_add_ps(_mm_mul_ps(ay, wa), _mm_mul_ps(by, wb)));
+				_mm_storeu_ps(out.Z + i, _mm_add_ps(_mm_mul_ps(az, wa), _mm_mul_ps(bz, wb)));
+			}
+			SlerpFastScalar<float>(a.Subview(i, count - i), b.Subview(i, count - i), t, out.Subview(i, count - i), count - i);
+		}
+		MATH_TARGET_AVX2 inline void SlerpFastAVX2(QuaternionSoAView<const float> a, QuaternionSoAView<const float> b, float t, QuaternionSoAView<float> out, sizet count)noexcept
+		{
+			const float d = 1.f - t;
+			const float sqrT = t * t;
+			const float sqrD = d * d;
+			AVX::Vector8f cT[8], cD[8];
+			for (sizet k = 0; k < 8; ++k)
+			{
+				cT[k] = _mm256_set1_ps(math::Impl::SLERP_FAST_U<float>[k] * sqrT - math::Impl::SLERP_FAST_V<float>[k]);
+				cD[k] = _mm256_set1_ps(math::Impl::SLERP_FAST_U<float>[k] * sqrD - math::Impl::SLERP_FAST_V<float>[k]);
+			}
+			auto vt = _mm256_set1_ps(t);
+			auto vd = _mm256_set1_ps(d);
+			auto one = _mm256_set1_ps(1.f);
+			auto zero = _mm256_setzero_ps();
+			auto signBit = _mm256_set1_ps(-0.f);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				auto aw = _mm256_loadu_ps(a.W + i), ax = _mm256_loadu_ps(a.X + i), ay = _mm256_loadu_ps(a.Y + i), az = _mm256_loadu_ps(a.Z + i);
+				auto bw = _mm256_loadu_ps(b.W + i), bx = _mm256_loadu_ps(b.X + i), by = _mm256_loadu_ps(b.Y + i), bz = _mm256_loadu_ps(b.Z + i);
+				auto cosTheta = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(aw, bw), _mm256_mul_ps(ax, bx)), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+				auto sign = _mm256_and_ps(_mm256_cmp_ps(cosTheta, zero, _CMP_LT_OQ), signBit);
+				auto xm1 = _mm256_sub_ps(_mm256_xor_ps(cosTheta, sign), one);
+
+				auto fT = one, fD = one;
+				for (sizet k = 8; k-- > 0; )
+				{
+					fT = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(cT[k], xm1), fT));
+					fD = _mm256_add_ps(one, _mm256_mul_ps(_mm256_mul_ps(cD[k], xm1), fD));
+				}
+				auto wa = _mm256_mul_ps(vd, fD);
+				auto wb = _mm256_xor_ps(_mm256_mul_ps(vt, fT), sign);
+				_mm256_storeu_ps(out.W + i, _mm256_add_ps(_mm256_mul_ps(aw, wa), _mm256_mul_ps(bw, wb)));
+				_mm256_storeu_ps(out.X + i, _mm256_add_ps(_mm256_mul_ps(ax, wa), _mm256_mul_ps(bx, wb)));
+				_mm256_storeu_ps(out.Y + i, _mm256_add_ps(_mm256_mul_ps(ay, wa), _mm256_mul_ps(by, wb)));
+				_mm256_storeu_ps(out.Z + i, _mm256_add_ps(_mm256_mul_ps(az, wa), _mm256_mul_ps(bz, wb)));
+			}
+			SlerpFastSSE41(a.Subview(i, count - i), b.Subview(i, count - i), t, out.Subview(i, count - i), count - i);
+		}
+
+		/* ToMatrix writes the bare rotation, ComposeTRS also applies the scale and translation streams */
+		template<class T>
+		INLINE Vector3SoAView<const T> OptionalSubview(Vector3SoAView<const T> v, sizet offset, sizet count)noexcept
+		{
+			return v.IsEmpty() ? v : v.Subview(offset, count);
+		}
+		template<bool TRS, class T, class M>
+		INLINE void ComposeScalar(Vector3SoAView<const T> translation, QuaternionSoAView<const T> rotation, Vector3SoAView<const T> scale, M* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+			{
+				if constexpr (TRS && std::is_same_v<M, Matrix43Real<T>>)
+					out[i] = ComposeTRS43(translation.Get(i), rotation.Get(i), scale.Get(i));
+				else if constexpr (TRS)
+					out[i] = ComposeTRS(translation.Get(i), rotation.Get(i), scale.Get(i));
+				else if constexpr (std::is_same_v<M, Matrix43Real<T>>)
+					out[i] = rotation.Get(i).ToMatrix43();
+				else
+					out[i] = rotation.Get(i).ToMatrix4();
+			}
+		}
+		/* Same operations as QuaternionReal::ToMatrix3, m receives the nine entries in row order */
+		MATH_TARGET_SSE41 INLINE void QuaternionToRotationSSE41(SSE::Vector4f w, SSE::Vector4f x, SSE::Vector4f y, SSE::Vector4f z, SSE::Vector4f* m)noexcept
+		{
+			auto one = _mm_set1_ps(1.f);
+			auto x2 = _mm_add_ps(x, x), y2 = _mm_add_ps(y, y), z2 = _mm_add_ps(z, z);
+			auto xx = _mm_mul_ps(x, x2), yy = _mm_mul_ps(y, y2), zz = _mm_mul_ps(z, z2);
+			auto xy = _mm_mul_ps(x, y2), xz = _mm_mul_ps(x, z2), yz = _mm_mul_ps(y, z2);
+			auto wx = _mm_mul_ps(w, x2), wy = _mm_mul_ps(w, y2), wz = _mm_mul_ps(w, z2);
+			m[0] = _mm_sub_ps(one, _mm_add_ps(yy, zz));
+			m[1] = _mm_sub_ps(xy, wz);
+			m[2] = _mm_add_ps(xz, wy);
+			m[3] = _mm_add_ps(xy, wz);
+			m[4] = _mm_sub_ps(one, _mm_add_ps(xx, zz));
+			m[5] = _mm_sub_ps(yz, wx);
+			m[6] = _mm_sub_ps(xz, wy);
+			m[7] = _mm_add_ps(yz, wx);
+			m[8] = _mm_sub_ps(one, _mm_add_ps(xx, yy));
+		}
+		template<bool TRS, class M>
+		MATH_TARGET_SSE41 inline void ComposeSSE41(Vector3SoAView<const float> translation, QuaternionSoAView<const float> rotation, Vector3SoAView<const float> scale, M* out, sizet count)noexcept
+		{
+			auto zero = _mm_setzero_ps();
+			auto lastRow = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				SSE::Vector4f m[9];
+				QuaternionToRotationSSE41(_mm_loadu_ps(rotation.W + i), _mm_loadu_ps(rotation.X + i), _mm_loadu_ps(rotation.Y + i), _mm_loadu_ps(rotation.Z + i), m);
+				SSE::Vector4f t[3] = { zero, zero, zero };
+				if constexpr (TRS)
+				{
+					auto sx = _mm_loadu_ps(scale.X + i), sy = _mm_loadu_ps(scale.Y + i), sz = _mm_loadu_ps(scale.Z + i);
+					for (sizet r = 0; r < 3; ++r)
+					{
+						m[r * 3 + 0] = _mm_mul_ps(m[r * 3 + 0], sx);
+						m[r * 3 + 1] = _mm_mul_ps(m[r * 3 + 1], sy);
+						m[r * 3 + 2] = _mm_mul_ps(m[r * 3 + 2], sz);
+					}
+					t[0] = _mm_loadu_ps(translation.X + i);
+					t[1] = _mm_loadu_ps(translation.Y + i);
+					t[2] = _mm_loadu_ps(translation.Z + i);
+				}
+				// Each transpose turns one row entry of four matrices into that row of each matrix
+				for (sizet r = 0; r < 3; ++r)
+				{
+					auto c0 = m[r * 3 + 0], c1 = m[r * 3 + 1], c2 = m[r * 3 + 2], c3 = t[r];
+					_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+					_mm_store_ps(&out[i + 0].R0.X + r * 4, c0);
+					_mm_store_ps(&out[i + 1].R0.X + r * 4, c1);
+					_mm_store_ps(&out[i + 2].R0.X + r * 4, c2);
+					_mm_store_ps(&out[i + 3].R0.X + r * 4, c3);
+				}
+				if constexpr (std::is_same_v<M, Matrix4f>)
+				{
+					for (sizet k = 0; k < 4; ++k)
+						_mm_store_ps(&out[i + k].R3.X, lastRow);
+				}
+			}
+			ComposeScalar<TRS, float>(OptionalSubview(translation, i, count - i), rotation.Subview(i, count - i), OptionalSubview(scale, i, count - i), out + i, count - i);
+		}
+		template<bool TRS, class M>
+		MATH_TARGET_AVX2 inline void ComposeAVX2(Vector3SoAView<const float> translation, QuaternionSoAView<const float> rotation, Vector3SoAView<const float> scale, M* out, sizet count)noexcept
+		{
+			auto one = _mm256_set1_ps(1.f);
+			auto zero = _mm256_setzero_ps();
+			auto lastRow = _mm_setr_ps(0.f, 0.f, 0.f, 1.f);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				auto w = _mm256_loadu_ps(rotation.W + i), x = _mm256_loadu_ps(rotation.X + i), y = _mm256_loadu_ps(rotation.Y + i), z = _mm256_loadu_ps(rotation.Z + i);
+				auto x2 = _mm256_add_ps(x, x), y2 = _mm256_add_ps(y, y), z2 = _mm256_add_ps(z, z);
+				auto xx = _mm256_mul_ps(x, x2), yy = _mm256_mul_ps(y, y2), zz = _mm256_mul_ps(z, z2);
+				auto xy = _mm256_mul_ps(x, y2), xz = _mm256_mul_ps(x, z2), yz = _mm256_mul_ps(y, z2);
+				auto wx = _mm256_mul_ps(w, x2), wy = _mm256_mul_ps(w, y2), wz = _mm256_mul_ps(w, z2);
+				AVX::Vector8f m[9] = {
+					_mm256_sub_ps(one, _mm256_add_ps(yy, zz)), _mm256_sub_ps(xy, wz), _mm256_add_ps(xz, wy),
+					_mm256_add_ps(xy, wz), _mm256_sub_ps(one, _mm256_add_ps(xx, zz)), _mm256_sub_ps(yz, wx),
+					_mm256_sub_ps(xz, wy), _mm256_add_ps(yz, wx), _mm256_sub_ps(one, _mm256_add_ps(xx, yy))
+				};
+				AVX::Vector8f t[3] = { zero, zero, zero };
+				if constexpr (TRS)
+				{
+					auto sx = _mm256_loadu_ps(scale.X + i), sy = _mm256_loadu_ps(scale.Y + i), sz = _mm256_loadu_ps(scale.Z + i);
+					for (sizet r = 0; r < 3; ++r)
+					{
+						m[r * 3 + 0] = _mm256_mul_ps(m[r * 3 + 0], sx);
+						m[r * 3 + 1] = _mm256_mul_ps(m[r * 3 + 1], sy);
+						m[r * 3 + 2] = _mm256_mul_ps(m[r * 3 + 2], sz);
+					}
+					t[0] = _mm256_loadu_ps(translation.X + i);
+					t[1] = _mm256_loadu_ps(translation.Y + i);
+					t[2] = _mm256_loadu_ps(translation.Z + i);
+				}
+				// In lane 4x4 transposes, the low half holds the rows of matrices i..i+3 and the high half those of i+4..i+7
+				for (sizet r = 0; r < 3; ++r)
+				{
+					auto t0 = _mm256_unpacklo_ps(m[r * 3 + 0], m[r * 3 + 1]);
+					auto t1 = _mm256_unpackhi_ps(m[r * 3 + 0], m[r * 3 + 1]);
+					auto t2 = _mm256_unpacklo_ps(m[r * 3 + 2], t[r]);
+					auto t3 = _mm256_unpackhi_ps(m[r * 3 + 2], t[r]);
+					AVX::Vector8f rows[4] = {
+						_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)),
+						_mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2)),
+						_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)),
+						_mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2))
+					};
+					for (sizet k = 0; k < 4; ++k)
+					{
+						_mm_store_ps(&out[i + k].R0.X + r * 4, _mm256_castps256_ps128(rows[k]));
+						_mm_store_ps(&out[i + k + 4].R0.X + r * 4, _mm256_extractf128_ps(rows[k], 1));
+					}
+				}
+				if constexpr (std::is_same_v<M, Matrix4f>)
+				{
+					for (sizet k = 0; k < 8; ++k)
+						_mm_store_ps(&out[i + k].R3.X, lastRow);
+				}
+			}
+			ComposeSSE41<TRS>(OptionalSubview(translation, i, count - i), rotation.Subview(i, count - i), OptionalSubview(scale, i, count - i), out + i, count - i);
+		}
+
+		template<class T, class M>
+		INLINE void FromMatrixScalar(const M* in, QuaternionSoAView<T> out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out.Set(i, QuaternionReal<T>::FromMatrix(in[i]));
+		}
+		/* Same selection and operations as QuaternionReal::FromMatrix, the rotation entries come in as one register each */
+		MATH_TARGET_SSE41 INLINE void RotationToQuaternionSSE41(const SSE::Vector4f* m, SSE::Vector4f& w, SSE::Vector4f& x, SSE::Vector4f& y, SSE::Vector4f& z)noexcept
+		{
+			auto t0 = _mm_add_ps(_mm_add_ps(m[0], m[4]), m[8]);
+			auto t1 = _mm_sub_ps(_mm_sub_ps(m[0], m[4]), m[8]);
+			auto t2 = _mm_sub_ps(_mm_sub_ps(m[4], m[0]), m[8]);
+			auto t3 = _mm_sub_ps(_mm_sub_ps(m[8], m[0]), m[4]);
+			auto best = t0;
+			auto c1 = _mm_cmpgt_ps(t1, best);
+			best = _mm_blendv_ps(best, t1, c1);
+			auto c2 = _mm_cmpgt_ps(t2, best);
+			best = _mm_blendv_ps(best, t2, c2);
+			auto c3 = _mm_cmpgt_ps(t3, best);
+			best = _mm_blendv_ps(best, t3, c3);
+
+			auto half = _mm_set1_ps(0.5f);
+			auto r = _mm_sqrt_ps(_mm_add_ps(best, _mm_set1_ps(1.f)));
+			auto big = _mm_mul_ps(r, half);
+			auto f = _mm_div_ps(half, r);
+			auto wx = _mm_mul_ps(_mm_sub_ps(m[7], m[5]), f), wy = _mm_mul_ps(_mm_sub_ps(m[2], m[6]), f), wz = _mm_mul_ps(_mm_sub_ps(m[3], m[1]), f);
+			auto xy = _mm_mul_ps(_mm_add_ps(m[1], m[3]), f), xz = _mm_mul_ps(_mm_add_ps(m[2], m[6]), f), yz = _mm_mul_ps(_mm_add_ps(m[5], m[7]), f);
+			w = _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(big, wx, c1), wy, c2), wz, c3);
+			x = _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(wx, big, c1), xy, c2), xz, c3);
+			y = _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(wy, xy, c1), big, c2), yz, c3);
+			z = _mm_blendv_ps(_mm_blendv_ps(_mm_blendv_ps(wz, xz, c1), yz, c2), big, c3);
+		}
+		template<class M>
+		MATH_TARGET_SSE41 inline void FromMatrixSSE41(const M* in, QuaternionSoAView<float> out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				SSE::Vector4f m[9];
+				for (sizet r = 0; r < 3; ++r)
+				{
+					auto c0 = _mm_load_ps(&in[i + 0].R0.X + r * 4), c1 = _mm_load_ps(&in[i + 1].R0.X + r * 4);
+					auto c2 = _mm_load_ps(&in[i + 2].R0.X + r * 4), c3 = _mm_load_ps(&in[i + 3].R0.X + r * 4);
+					_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+					m[r * 3 + 0] = c0;
+					m[r * 3 + 1] = c1;
+					m[r * 3 + 2] = c2;
+				}
+				SSE::Vector4f w, x, y, z;
+				RotationToQuaternionSSE41(m, w, x, y, z);
+				_mm_storeu_ps(out.W + i, w);
+				_mm_storeu_ps(out.X + i, x);
+				_mm_storeu_ps(out.Y + i, y);
+				_mm_storeu_ps(out.Z + i, z);
+			}
+			FromMatrixScalar<float>(in + i, out.Subview(i, count - i), count - i);
+		}
+		template<class M>
+		MATH_TARGET_AVX2 inline void FromMatrixAVX2(const M* in, QuaternionSoAView<float> out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				// Matrices i..i+3 go to the low half and i+4..i+7 to the high half, then an in lane transpose per row
+				AVX::Vector8f m[9];
+				for (sizet r = 0; r < 3; ++r)
+				{
+					AVX::Vector8f rows[4];
+					for (sizet k = 0; k < 4; ++k)
+						rows[k] = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(&in[i + k].R0.X + r * 4)), _mm_load_ps(&in[i + k + 4].R0.X + r * 4), 1);
+					auto t0 = _mm256_unpacklo_ps(rows[0], rows[1]);
+					auto t1 = _mm256_unpackhi_ps(rows[0], rows[1]);
+					auto t2 = _mm256_unpacklo_ps(rows[2], rows[3]);
+					auto t3 = _mm256_unpackhi_ps(rows[2], rows[3]);
+					m[r * 3 + 0] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0));
+					m[r * 3 + 1] = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+					m[r * 3 + 2] = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0));
+				}
+				auto t0 = _mm256_add_ps(_mm256_add_ps(m[0], m[4]), m[8]);
+				auto t1 = _mm256_sub_ps(_mm256_sub_ps(m[0], m[4]), m[8]);
+				auto t2 = _mm256_sub_ps(_mm256_sub_ps(m[4], m[0]), m[8]);
+				auto t3 = _mm256_sub_ps(_mm256_sub_ps(m[8], m[0]), m[4]);
+				auto best = t0;
+				auto c1 = _mm256_cmp_ps(t1, best, _CMP_GT_OQ);
+				best = _mm256_blendv_ps(best, t1, c1);
+				auto c2 = _mm256_cmp_ps(t2, best, _CMP_GT_OQ);
+				best = _mm256_blendv_ps(best, t2, c2);
+				auto c3 = _mm256_cmp_ps(t3, best, _CMP_GT_OQ);
+				best = _mm256_blendv_ps(best, t3, c3);
+
+				auto half = _mm256_set1_ps(0.5f);
+				auto r = _mm256_sqrt_ps(_mm256_add_ps(best, _mm256_set1_ps(1.f)));
+				auto big = _mm256_mul_ps(r, half);
+				auto f = _mm256_div_ps(half, r);
+				auto wx = _mm256_mul_ps(_mm256_sub_ps(m[7], m[5]), f), wy = _mm256_mul_ps(_mm256_sub_ps(m[2], m[6]), f), wz = _mm256_mul_ps(_mm256_sub_ps(m[3], m[1]), f);
+				auto xy = _mm256_mul_ps(_mm256_add_ps(m[1], m[3]), f), xz = _mm256_mul_ps(_mm256_add_ps(m[2], m[6]), f), yz = _mm256_mul_ps(_mm256_add_ps(m[5], m[7]), f);
+				_mm256_storeu_ps(out.W + i, _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(big, wx, c1), wy, c2), wz, c3));
+				_mm256_storeu_ps(out.X + i, _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(wx, big, c1), xy, c2), xz, c3));
+				_mm256_storeu_ps(out.Y + i, _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(wy, xy, c1), big, c2), yz, c3));
+				_mm256_storeu_ps(out.Z + i, _mm256_blendv_ps(_mm256_blendv_ps(_mm256_blendv_ps(wz, xz, c1), yz, c2), big, c3));
+			}
+			FromMatrixSSE41(in + i, out.Subview(i, count - i), count - i);
+		}
+	}
+
+	/* float uses 4 or 8 lanes depending on the CPU, AVX-512 machines take the AVX2 kernels. double loops are left to the compiler.
+	 * Slerp needs acos and sin per element so it always runs the scalar loop, prefer SlerpFast for large batches. */
+	INLINE void Nlerp(QuaternionSoAView<const float> a, QuaternionSoAView<const float> b, float t, QuaternionSoAView<float> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::Nlerp, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.Size(), b.Size(), "Trying to Batch::Nlerp, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::NlerpScalar<float>, &Impl::NlerpSSE41, &Impl::NlerpAVX2, &Impl::NlerpAVX2, a, b, t, out, out.Size());
+	}
+	INLINE void Nlerp(QuaternionSoAView<const double> a, QuaternionSoAView<const double> b, double t, QuaternionSoAView<double> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::Nlerp, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.Size(), b.Size(), "Trying to Batch::Nlerp, but the output is bigger than the inputs.");
+		Impl::NlerpScalar<double>(a, b, t, out, out.Size());
+	}
+	INLINE void Slerp(QuaternionSoAView<const float> a, QuaternionSoAView<const float> b, float t, QuaternionSoAView<float> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::Slerp, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.Size(), b.Size(), "Trying to Batch::Slerp, but the output is bigger than the inputs.");
+		Impl::SlerpScalar<float>(a, b, t, out, out.Size());
+	}
+	INLINE void Slerp(QuaternionSoAView<const double> a, QuaternionSoAView<const double> b, double t, QuaternionSoAView<double> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::Slerp, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.Size(), b.Size(), "Trying to Batch::Slerp, but the output is bigger than the inputs.");
+		Impl::SlerpScalar<double>(a, b, t, out, out.Size());
+	}
+	INLINE void SlerpFast(QuaternionSoAView<const float> a, QuaternionSoAView<const float> b, float t, QuaternionSoAView<float> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::SlerpFast, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.Size(), b.Size(), "Trying to Batch::SlerpFast, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::SlerpFastScalar<float>, &Impl::SlerpFastSSE41, &Impl::SlerpFastAVX2, &Impl::SlerpFastAVX2, a, b, t, out, out.Size());
+	}
+	INLINE void SlerpFast(QuaternionSoAView<const double> a, QuaternionSoAView<const double> b, double t, QuaternionSoAView<double> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::SlerpFast, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.Size(), b.Size(), "Trying to Batch::SlerpFast, but the output is bigger than the inputs.");
+		Impl::SlerpFastScalar<double>(a, b, t, out, out.Size());
+	}
+	/* Whole skeleton conversions, out[i] = rotation[i].ToMatrix4() / ToMatrix43() */
+	INLINE void ToMatrix4(QuaternionSoAView<const float> rotation, std::span<Matrix4f> out)noexcept
+	{
+		VerifyLessEqual(out.size(), rotation.Size(), "Trying to Batch::ToMatrix4, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::ComposeScalar<false, float, Matrix4f>, &Impl::ComposeSSE41<false, Matrix4f>, &Impl::ComposeAVX2<false, Matrix4f>, &Impl::ComposeAVX2<false, Matrix4f>,
+			Vector3SoAView<const float>{}, rotation, Vector3SoAView<const float>{}, out.data(), out.size());
+	}
+	INLINE void ToMatrix4(QuaternionSoAView<const double> rotation, std::span<Matrix4d> out)noexcept
+	{
+		VerifyLessEqual(out.size(), rotation.Size(), "Trying to Batch::ToMatrix4, but the output is bigger than the input.");
+		Impl::ComposeScalar<false, double>(Vector3SoAView<const double>{}, rotation, Vector3SoAView<const double>{}, out.data(), out.size());
+	}
+	INLINE void ToMatrix43(QuaternionSoAView<const float> rotation, std::span<Matrix43f> out)noexcept
+	{
+		VerifyLessEqual(out.size(), rotation.Size(), "Trying to Batch::ToMatrix43, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::ComposeScalar<false, float, Matrix43f>, &Impl::ComposeSSE41<false, Matrix43f>, &Impl::ComposeAVX2<false, Matrix43f>, &Impl::ComposeAVX2<false, Matrix43f>,
+			Vector3SoAView<const float>{}, rotation, Vector3SoAView<const float>{}, out.data(), out.size());
+	}
+	INLINE void ToMatrix43(QuaternionSoAView<const double> rotation, std::span<Matrix43d> out)noexcept
+	{
+		VerifyLessEqual(out.size(), rotation.Size(), "Trying to Batch::ToMatrix43, but the output is bigger than the input.");
+		Impl::ComposeScalar<false, double>(Vector3SoAView<const double>{}, rotation, Vector3SoAView<const double>{}, out.data(), out.size());
+	}
+	/* out[i] = ComposeTRS(translation[i], rotation[i], scale[i]) */
+	INLINE void ComposeTRS(Vector3SoAView<const float> translation, QuaternionSoAView<const float> rotation, Vector3SoAView<const float> scale, std::span<Matrix4f> out)noexcept
+	{
+		VerifyLessEqual(out.size(), translation.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), rotation.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), scale.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::ComposeScalar<true, float, Matrix4f>, &Impl::ComposeSSE41<true, Matrix4f>, &Impl::ComposeAVX2<true, Matrix4f>, &Impl::ComposeAVX2<true, Matrix4f>,
+			translation, rotation, scale, out.data(), out.size());
+	}
+	INLINE void ComposeTRS(Vector3SoAView<const double> translation, QuaternionSoAView<const double> rotation, Vector3SoAView<const double> scale, std::span<Matrix4d> out)noexcept
+	{
+		VerifyLessEqual(out.size(), translation.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), rotation.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), scale.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		Impl::ComposeScalar<true, double>(translation, rotation, scale, out.data(), out.size());
+	}
+	/* out[i] = ComposeTRS43(translation[i], rotation[i], scale[i]) */
+	INLINE void ComposeTRS(Vector3SoAView<const float> translation, QuaternionSoAView<const float> rotation, Vector3SoAView<const float> scale, std::span<Matrix43f> out)noexcept
+	{
+		VerifyLessEqual(out.size(), translation.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), rotation.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), scale.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::ComposeScalar<true, float, Matrix43f>, &Impl::ComposeSSE41<true, Matrix43f>, &Impl::ComposeAVX2<true, Matrix43f>, &Impl::ComposeAVX2<true, Matrix43f>,
+			translation, rotation, scale, out.data(), out.size());
+	}
+	INLINE void ComposeTRS(Vector3SoAView<const double> translation, QuaternionSoAView<const double> rotation, Vector3SoAView<const double> scale, std::span<Matrix43d> out)noexcept
+	{
+		VerifyLessEqual(out.size(), translation.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), rotation.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), scale.Size(), "Trying to Batch::ComposeTRS, but the output is bigger than the inputs.");
+		Impl::ComposeScalar<true, double>(translation, rotation, scale, out.data(), out.size());
+	}
+	/* out[i] = QuaternionReal::FromMatrix(in[i]), only the rotation part of each matrix is read */
+	INLINE void FromMatrix(std::span<const Matrix4f> in, QuaternionSoAView<float> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), in.size(), "Trying to Batch::FromMatrix, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::FromMatrixScalar<float, Matrix4f>, &Impl::FromMatrixSSE41<Matrix4f>, &Impl::FromMatrixAVX2<Matrix4f>, &Impl::FromMatrixAVX2<Matrix4f>, in.data(), out, out.Size());
+	}
+	INLINE void FromMatrix(std::span<const Matrix4d> in, QuaternionSoAView<double> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), in.size(), "Trying to Batch::FromMatrix, but the output is bigger than the input.");
+		Impl::FromMatrixScalar<double>(in.data(), out, out.Size());
+	}
+	INLINE void FromMatrix(std::span<const Matrix43f> in, QuaternionSoAView<float> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), in.size(), "Trying to Batch::FromMatrix, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::FromMatrixScalar<float, Matrix43f>, &Impl::FromMatrixSSE41<Matrix43f>, &Impl::FromMatrixAVX2<Matrix43f>, &Impl::FromMatrixAVX2<Matrix43f>, in.data(), out, out.Size());
+	}
+	INLINE void FromMatrix(std::span<const Matrix43d> in, QuaternionSoAView<double> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), in.size(), "Trying to Batch::FromMatrix, but the output is bigger than the input.");
+		Impl::FromMatrixScalar<double>(in.data(), out, out.Size());
+	}
+}
+
+MATH_STRICT_FP_END
+
+#endif /* MATH_QUATERNIONSOA_H */
@@ -0,0 +1,257 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_RAY_TRIANGLE_H
+#define MATH_RAY_TRIANGLE_H 1
+
+#include "MathPrerequisites.h"
+#include "Vector3.h"
+#include "AABB.h"
+
+MATH_STRICT_FP_BEGIN
+
+namespace greaper::math
+{
+	/* The hit point is origin + direction * Distance, or v0 * (1 - U - V) + v1 * U + v2 * V */
+	template<class T>
+	struct RayTriangleHit
+	{
+		T Distance = T(0);
+		T U = T(0);
+		T V = T(0);
+	};
+
+	namespace Impl
+	{
+		template<class T>
+		NODISCARD INLINE constexpr bool RayIntersectsTriangleEdges(const Vector3Real<T>& origin, const Vector3Real<T>& direction, const Vector3Real<T>& v0,
+			const Vector3Real<T>& edge1, const Vector3Real<T>& edge2, T tMin, T tMax, RayTriangleHit<T>& hit)noexcept
+		{
+			const Vector3Real<T> p = direction.CrossProduct(edge2);
+			const T det = edge1.DotProduct(p);
+			if (det == T(0))
+				return false;
+			const T invDet = T(1) / det;
+			const Vector3Real<T> s = origin - v0;
+			const T u = s.DotProduct(p) * invDet;
+			const Vector3Real<T> q = s.CrossProduct(edge1);
+			const T v = direction.DotProduct(q) * invDet;
+			const T t = edge2.DotProduct(q) * invDet;
+			if (!(u >= T(0) && v >= T(0) && u + v <= T(1) && t >= tMin && t <= tMax))
+				return false;
+			hit.Distance = t;
+			hit.U = u;
+			hit.V = v;
+			return true;
+		}
+	}
+
+	/* Moller-Trumbore, both faces are hit and rays parallel to the triangle never are.
+	 * Hits are accepted inside [tMin, tMax], hit is only written on a hit. */
+	template<class T>
+	NODISCARD INLINE constexpr bool RayIntersectsTriangle(const Vector3Real<T>& origin, const Vector3Real<T>& direction, const Vector3Real<T>& v0,
+		const Vector3Real<T>& v1, const Vector3Real<T>& v2, T tMin, T tMax, RayTriangleHit<T>& hit)noexcept
+	{
+		return Impl::RayIntersectsTriangleEdges(origin, direction, v0, v1 - v0, v2 - v0, tMin, tMax, hit);
+	}
+
+	/* Triangles in SoA order with their edges precomputed, unused slots are degenerate and never hit */
+	template<sizet N>
+	struct alignas(N * sizeof(float)) TrianglePacket
+	{
+		static constexpr sizet Count = N;
+
+		float V0X[N] = {};
+		float V0Y[N] = {};
+		float V0Z[N] = {};
+		float Edge1X[N] = {};
+		float Edge1Y[N] = {};
+		float Edge1Z[N] = {};
+		float Edge2X[N] = {};
+		float Edge2Y[N] = {};
+		float Edge2Z[N] = {};
+
+		INLINE constexpr void Set(sizet index, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2)noexcept
+		{
+			VerifyLess(index, N, "Trying to set a triangle of a TrianglePacket, but the index %" PRIuPTR " was out of range.", index);
+			const Vector3f edge1 = v1 - v0;
+			const Vector3f edge2 = v2 - v0;
+			V0X[index] = v0.X;
+			V0Y[index] = v0.Y;
+			V0Z[index] = v0.Z;
+			Edge1X[index] = edge1.X;
+			Edge1Y[index] = edge1.Y;
+			Edge1Z[index] = edge1.Z;
+			Edge2X[index] = edge2.X;
+			Edge2Y[index] = edge2.Y;
+			Edge2Z[index] = edge2.Z;
+		}
+	};
+	using TrianglePacket4 = TrianglePacket<4>;
+	using TrianglePacket8 = TrianglePacket<8>;
+
+	template<sizet N>
+	struct alignas(N * sizeof(float)) RayTriangleHitPacket
+	{
+		float Distance[N];
+		float U[N];
+		float V[N];
+
+		NODISCARD INLINE constexpr RayTriangleHit<float> Get(sizet index)const noexcept { return { Distance[index], U[index], V[index] }; }
+	};
+	using RayTriangleHitPacket4 = RayTriangleHitPacket<4>;
+	using RayTriangleHitPacket8 = RayTriangleHitPacket<8>;
+}
+
+namespace greaper::math::SSE
+{
+	/* Four lanes of RayIntersectsTriangle with the same order of operations, the callers broadcast either the ray or the triangle */
+	INLINE int RayIntersectsTriangle4(Vector4f ox, Vector4f oy, Vector4f oz, Vector4f dx, Vector4f dy, Vector4f dz,
+		Vector4f v0x, Vector4f v0y, Vector4f v0z, Vector4f e1x, Vector4f e1y, Vector4f e1z, Vector4f e2x, Vector4f e2y, Vector4f e2z,
+		Vector4f tMin, Vector4f tMax, float* distances, float* us, float* vs)noexcept
+	{
+		const Vector4f px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+		const Vector4f py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+		const Vector4f pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+		const Vector4f det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e1x, px), _mm_mul_ps(e1y, py)), _mm_mul_ps(e1z, pz));
+		const Vector4f invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+		const Vector4f sx = _mm_sub_ps(ox, v0x), sy = _mm_sub_ps(oy, v0y), sz = _mm_sub_ps(oz, v0z);
+		const Vector4f u = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(sx, px), _mm_mul_ps(sy, py)), _mm_mul_ps(sz, pz)), invDet);
+		const Vector4f qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+		const Vector4f qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+		const Vector4f qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+		const Vector4f v = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, qx), _mm_mul_ps(dy, qy)), _mm_mul_ps(dz, qz)), invDet);
+		const Vector4f t = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(e2x, qx), _mm_mul_ps(e2y, qy)), _mm_mul_ps(e2z, qz)), invDet);
+
+		const Vector4f zero = _mm_setzero_ps();
+		Vector4f mask = _mm_cmpneq_ps(det, zero);
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmpge_ps(v, zero)));
+		mask = _mm_and_ps(mask, _mm_cmple_ps(_mm_add_ps(u, v), _mm_set1_ps(1.f)));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(t, tMin), _mm_cmple_ps(t, tMax)));
+		_mm_storeu_ps(distances, t);
+		_mm_storeu_ps(us, u);
+		_mm_storeu_ps(vs, v);
+		return _mm_movemask_ps(mask);
+	}
+}
+
+namespace greaper::math::AVX
+{
+	MATH_TARGET_AVX inline int RayIntersectsTriangle8(__m256 ox, __m256 oy, __m256 oz, __m256 dx, __m256 dy, __m256 dz,
+		__m256 v0x, __m256 v0y, __m256 v0z, __m256 e1x, __m256 e1y, __m256 e1z, __m256 e2x, __m256 e2y, __m256 e2z,
+		__m256 tMin, __m256 tMax, float* distances, float* us, float* vs)noexcept
+	{
+		const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+		const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+		const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+		const __m256 det = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e1x, px), _mm256_mul_ps(e1y, py)), _mm256_mul_ps(e1z, pz));
+		const __m256 invDet = _mm256_div_ps(_mm256_set1_ps(1.f), det);
+		const __m256 sx = _mm256_sub_ps(ox, v0x), sy = _mm256_sub_ps(oy, v0y), sz = _mm256_sub_ps(oz, v0z);
+		const __m256 u = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(sx, px), _mm256_mul_ps(sy, py)), _mm256_mul_ps(sz, pz)), invDet);
+		const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+		const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+		const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+		const __m256 v = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, qx), _mm256_mul_ps(dy, qy)), _mm256_mul_ps(dz, qz)), invDet);
+		const __m256 t = _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(e2x, qx), _mm256_mul_ps(e2y, qy)), _mm256_mul_ps(e2z, qz)), invDet);
+
+		const __m256 zero = _mm256_setzero_ps();
+		__m256 mask = _mm256_cmp_ps(det, zero, _CMP_NEQ_UQ);
+		mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(v, zero, _CMP_GE_OQ)));
+		mask = _mm256_and_ps(mask, _mm256_cmp_ps(_mm256_add_ps(u, v), _mm256_set1_ps(1.f), _CMP_LE_OQ));
+		mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(t, tMin, _CMP_GE_OQ), _mm256_cmp_ps(t, tMax, _CMP_LE_OQ)));
+		_mm256_storeu_ps(distances, t);
+		_mm256_storeu_ps(us, u);
+		_mm256_storeu_ps(vs, v);
+		return _mm256_movemask_ps(mask);
+	}
+	MATH_TARGET_AVX inline int RayIntersectsTriangles8(const Vector3f& origin, const Vector3f& direction, const TrianglePacket8& triangles, float tMin, float tMax,
+		RayTriangleHitPacket8& hits)noexcept
+	{
+		return RayIntersectsTriangle8(_mm256_set1_ps(origin.X), _mm256_set1_ps(origin.Y), _mm256_set1_ps(origin.Z),
+			_mm256_set1_ps(direction.X), _mm256_set1_ps(direction.Y), _mm256_set1_ps(direction.Z),
+			_mm256_load_ps(triangles.V0X), _mm256_load_ps(triangles.V0Y), _mm256_load_ps(triangles.V0Z),
+			_mm256_load_ps(triangles.Edge1X), _mm256_load_ps(triangles.Edge1Y), _mm256_load_ps(triangles.Edge1Z),
+			_mm256_load_ps(triangles.Edge2X), _mm256_load_ps(triangles.Edge2Y), _mm256_load_ps(triangles.Edge2Z),
+			_mm256_set1_ps(tMin), _mm256_set1_ps(tMax), hits.Distance, hits.U, hits.V);
+	}
+	MATH_TARGET_AVX inline int RayPacketIntersectsTriangle8(const RayPacket8& rays, const Vector3f& v0, const Vector3f& edge1, const Vector3f& edge2,
+		RayTriangleHitPacket8& hits)noexcept
+	{
+		return RayIntersectsTriangle8(_mm256_load_ps(rays.OriginX), _mm256_load_ps(rays.OriginY), _mm256_load_ps(rays.OriginZ),
+			_mm256_load_ps(rays.DirectionX), _mm256_load_ps(rays.DirectionY), _mm256_load_ps(rays.DirectionZ),
+			_mm256_set1_ps(v0.X), _mm256_set1_ps(v0.Y), _mm256_set1_ps(v0.Z),
+			_mm256_set1_ps(edge1.X), _mm256_set1_ps(edge1.Y), _mm256_set1_ps(edge1.Z),
+			_mm256_set1_ps(edge2.X), _mm256_set1_ps(edge2.Y), _mm256_set1_ps(edge2.Z),
+			_mm256_load_ps(rays.TMin), _mm256_load_ps(rays.TMax), hits.Distance, hits.U, hits.V);
+	}
+}
+
+namespace greaper::math
+{
+	namespace Impl
+	{
+		template<sizet N>
+		INLINE int RayIntersectsTriangles4(const Vector3f& origin, const Vector3f& direction, const TrianglePacket<N>& triangles, sizet first, float tMin, float tMax,
+			RayTriangleHitPacket<N>& hits)noexcept
+		{
+			return SSE::RayIntersectsTriangle4(_mm_set1_ps(origin.X), _mm_set1_ps(origin.Y), _mm_set1_ps(origin.Z),
+				_mm_set1_ps(direction.X), _mm_set1_ps(direction.Y), _mm_set1_ps(direction.Z),
+				_mm_load_ps(triangles.V0X + first), _mm_load_ps(triangles.V0Y + first), _mm_load_ps(triangles.V0Z + first),
+				_mm_load_ps(triangles.Edge1X + first), _mm_load_ps(triangles.Edge1Y + first), _mm_load_ps(triangles.Edge1Z + first),
+				_mm_load_ps(triangles.Edge2X + first), _mm_load_ps(triangles.Edge2Y + first), _mm_load_ps(triangles.Edge2Z + first),
+				_mm_set1_ps(tMin), _mm_set1_ps(tMax), hits.Distance + first, hits.U + first, hits.V + first);
+		}
+		template<sizet N>
+		INLINE int RayPacketIntersectsTriangle4(const RayPacket<N>& rays, sizet first, const Vector3f& v0, const Vector3f& edge1, const Vector3f& edge2,
+			RayTriangleHitPacket<N>& hits)noexcept
+		{
+			return SSE::RayIntersectsTriangle4(_mm_load_ps(rays.OriginX + first), _mm_load_ps(rays.OriginY + first), _mm_load_ps(rays.OriginZ + first),
+				_mm_load_ps(rays.DirectionX + first), _mm_load_ps(rays.DirectionY + first), _mm_load_ps(rays.DirectionZ + first),
+				_mm_set1_ps(v0.X), _mm_set1_ps(v0.Y), _mm_set1_ps(v0.Z),
+				_mm_set1_ps(edge1.X), _mm_set1_ps(edge1.Y), _mm_set1_ps(edge1.Z),
+				_mm_set1_ps(edge2.X), _mm_set1_ps(edge2.Y), _mm_set1_ps(edge2.Z),
+				_mm_load_ps(rays.TMin + first), _mm_load_ps(rays.TMax + first), hits.Distance + first, hits.U + first, hits.V + first);
+		}
+	}
+
+	/* One ray against a packet of triangles, bit i of the result is set when triangle i is hit.
+	 * hits is written for every slot and matches RayIntersectsTriangle bit for bit on the hit ones. */
+	NODISCARD INLINE uint32 RayIntersectsTriangles(const Vector3f& origin, const Vector3f& direction, const TrianglePacket4& triangles, float tMin, float tMax,
+		RayTriangleHitPacket4& hits)noexcept
+	{
+		return static_cast<uint32>(Impl::RayIntersectsTriangles4(origin, direction, triangles, 0, tMin, tMax, hits));
+	}
+	NODISCARD INLINE uint32 RayIntersectsTriangles(const Vector3f& origin, const Vector3f& direction, const TrianglePacket8& triangles, float tMin, float tMax,
+		RayTriangleHitPacket8& hits)noexcept
+	{
+		if (GetSIMDLevel() >= SIMDLevel_t::AVX2)
+			return static_cast<uint32>(AVX::RayIntersectsTriangles8(origin, direction, triangles, tMin, tMax, hits));
+		const int lo = Impl::RayIntersectsTriangles4(origin, direction, triangles, 0, tMin, tMax, hits);
+		const int hi = Impl::RayIntersectsTriangles4(origin, direction, triangles, 4, tMin, tMax, hits);
+		return static_cast<uint32>(lo | (hi << 4));
+	}
+
+	/* A packet of rays against one triangle, bit i of the result is set when ray i hits it inside its [TMin, TMax] */
+	NODISCARD INLINE uint32 RayIntersectsTriangle(const RayPacket4& rays, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2, RayTriangleHitPacket4& hits)noexcept
+	{
+		return static_cast<uint32>(Impl::RayPacketIntersectsTriangle4(rays, 0, v0, v1 - v0, v2 - v0, hits));
+	}
+	NODISCARD INLINE uint32 RayIntersectsTriangle(const RayPacket8& rays, const Vector3f& v0, const Vector3f& v1, const Vector3f& v2, RayTriangleHitPacket8& hits)noexcept
+	{
+		const Vector3f edge1 = v1 - v0;
+		const Vector3f edge2 = v2 - v0;
+		if (GetSIMDLevel() >= SIMDLevel_t::AVX2)
+			return static_cast<uint32>(AVX::RayPacketIntersectsTriangle8(rays, v0, edge1, edge2, hits));
+		const int lo = Impl::RayPacketIntersectsTriangle4(rays, 0, v0, edge1, edge2, hits);
+		const int hi = Impl::RayPacketIntersectsTriangle4(rays, 4, v0, edge1, edge2, hits);
+		return static_cast<uint32>(lo | (hi << 4));
+	}
+}
+
+MATH_STRICT_FP_END
+
+#endif /* MATH_RAY_TRIANGLE_H */
\ No newline at end of file
@@ -0,0 +1,120 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_REFL_BFLOAT16_H
+#define MATH_REFL_BFLOAT16_H 1
+
+#include "../../../GreaperCore/Public/Reflection/PlainType.h"
+#include "../Base/BFloat16.h"
+
+namespace greaper::refl
+{
+	template<>
+	struct PlainType<math::BFloat16> : public BaseType<math::BFloat16>
+	{
+		static inline constexpr TypeCategory_t Category = TypeCategory_t::Plain;
+		static TResult<ssizet> ToStream(const math::BFloat16& data, IStream& stream)
+		{ 
+			ssizet size = stream.Write(&data, sizeof(data));
+			if(size == sizeof(data))
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::PlainType<BFloat16>]::ToStream Failure while writing to stream, not all data was written, expected:%" PRIuPTR " obtained:%" PRIiPTR ".", sizeof(data), size));
+		}
+		static TResult<ssizet> FromStream(math::BFloat16& data, IStream& stream)
+		{ 
+			ssizet size = stream.Read(&data, sizeof(data));
+			if(size == sizeof(data))
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::PlainType<BFloat16>]::FromStream Failure while reading from stream, not all data was read, expected:%" PRIuPTR " obtained:%" PRIiPTR ".", sizeof(data), size));
+		}
+		static TResult<std::pair<math::BFloat16, ssizet>> CreateFromStream(IStream& stream)
+		{
+			math::BFloat16 elem;
+			TResult<ssizet> res = FromStream(elem, stream);
+			if (res.HasFailed())
+				return Result::CopyFailure<std::pair<math::BFloat16, ssizet>, ssizet>(res);
+			return Result::CreateSuccess(std::make_pair(elem, res.GetValue()));
+		}
+		static SPtr<cJSON> CreateJSON(const math::BFloat16& data, StringView name)
+		{
+			cJSON* obj = cJSON_CreateObject();
+			ToJSON(data, obj, name);
+			return SPtr<cJSON>(obj, cJSON_Delete);
+		}
+		static cJSON* ToJSON(const math::BFloat16& data, cJSON* obj, StringView name)
+		{
+			return PlainType<float>::ToJSON(data.Get(), obj, name);
+		}
+		static EmptyResult FromJSON(math::BFloat16& data, cJSON* json, StringView name)
+		{
+			float temp;
+			EmptyResult res = PlainType<float>::FromJSON(temp, json, name);
+			if(res.HasFailed())
+				return res;
+			data.Set(temp);
+			return Result::CreateSuccess();
+		}
+		static TResult<math::BFloat16> CreateFromJSON(cJSON* json, StringView name)
+		{
+			math::BFloat16 elem;
+			EmptyResult res = FromJSON(elem, json, name);
+			if (res.HasFailed())
+				return Result::CopyFailure<math::BFloat16>(res);
+			return Result::CreateSuccess(elem);
+		}
+		NODISCARD static String ToString(const math::BFloat16& data)
+		{
+			return PlainType<float>::ToString(data.Get());
+		}
+		static EmptyResult FromString(const String& str, math::BFloat16& data)
+		{
+			float temp;
+			EmptyResult res = PlainType<float>::FromString(str, temp);
+			if(res.HasFailed())
+				return res;
+			data.Set(temp);
+			return Result::CreateSuccess();
+		}
+		static TResult<math::BFloat16> CreateFromString(const String& str)
+		{
+			math::BFloat16 elem;
+			EmptyResult res = FromString(str, elem);
+			if (res.HasFailed())
+				return Result::CopyFailure<math::BFloat16>(res);
+			return Result::CreateSuccess(elem);
+		}
+		NODISCARD static int64 GetDynamicSize(UNUSED const math::BFloat16& data)
+		{
+			return 0ll; 
+		}
+
+		NODISCARD static sizet GetArraySize(UNUSED const math::BFloat16& data)
+		{
+			Break("[refl::PlainType<BFloat16>]::GetArraySize Trying to use a PlainType for array operations!");
+			return 0ll;
+		}
+
+		static void SetArraySize(UNUSED math::BFloat16& data, UNUSED sizet size)
+		{
+			Break("[refl::PlainType<BFloat16>]::SetArraySize Trying to use a PlainType for array operations!");
+		}
+
+		NODISCARD static const int32& GetArrayValue(UNUSED const math::BFloat16& data, UNUSED sizet index)
+		{
+			static constexpr int32 dummy = 0;
+			Break("[refl::PlainType<BFloat16>]::GetArrayValue Trying to use a PlainType for array operations!");
+			return dummy;
+		}
+
+		static void SetArrayValue(UNUSED math::BFloat16& data, UNUSED const int32& value, UNUSED sizet index)
+		{
+			Break("[refl::PlainType<BFloat16>]::SetArrayValue Trying to use a PlainType for array operations!");
+		}
+	};
+}
+
+#endif /* MATH_REFL_BFLOAT16_H */
\ No newline at end of file
@@ -0,0 +1,237 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_REFL_PACKEDQUATERNION_H
+#define MATH_REFL_PACKEDQUATERNION_H 1
+
+#include "../../../GreaperCore/Public/Reflection/PlainType.h"
+#include "../PackedQuaternion.h"
+
+namespace greaper::refl
+{
+	namespace Impl
+	{
+		/* JSON and strings keep the compact encodings as their raw integer */
+		INLINE uint64 PackedQuaternion48ToBits(const math::PackedQuaternion48& data)noexcept
+		{
+			const auto& raw = data.GetRaw();
+			return static_cast<uint64>(raw[0]) | (static_cast<uint64>(raw[1]) << 16) | (static_cast<uint64>(raw[2]) << 32);
+		}
+		INLINE std::array<uint16, 3> PackedQuaternion48FromBits(uint64 bits)noexcept
+		{
+			return { static_cast<uint16>(bits), static_cast<uint16>(bits >> 16), static_cast<uint16>(bits >> 32) };
+		}
+	}
+
+	template<>
+	struct PlainType<math::PackedQuaternion32> : public BaseType<math::PackedQuaternion32>
+	{
+		static inline constexpr TypeCategory_t Category = TypeCategory_t::Plain;
+		static TResult<ssizet> ToStream(const math::PackedQuaternion32& data, IStream& stream)
+		{ 
+			ssizet size = stream.Write(&data, sizeof(data));
+			if(size == sizeof(data))
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::PlainType<PackedQuaternion32>]::ToStream Failure while writing to stream, not all data was written, expected:%" PRIuPTR " obtained:%" PRIiPTR ".", sizeof(data), size));
+		}
+		static TResult<ssizet> FromStream(math::PackedQuaternion32& data, IStream& stream)
+		{ 
+			ssizet size = stream.Read(&data, sizeof(data));
+			if(size == sizeof(data))
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::PlainType<PackedQuaternion32>]::FromStream Failure while reading from stream, not all data was read, expected:%" PRIuPTR " obtained:%" PRIiPTR ".", sizeof(data), size));
+		}
+		static TResult<std::pair<math::PackedQuaternion32, ssizet>> CreateFromStream(IStream& stream)
+		{
+			math::PackedQuaternion32 elem;
+			TResult<ssizet> res = FromStream(elem, stream);
+			if (res.HasFailed())
+				return Result::CopyFailure<std::pair<math::PackedQuaternion32, ssizet>, ssizet>(res);
+			return Result::CreateSuccess(std::make_pair(elem, res.GetValue()));
+		}
+		static SPtr<cJSON> CreateJSON(const math::PackedQuaternion32& data, StringView name)
+		{
+			cJSON* obj = cJSON_CreateObject();
+			ToJSON(data, obj, name);
+			return SPtr<cJSON>(obj, cJSON_Delete);
+		}
+		static cJSON* ToJSON(const math::PackedQuaternion32& data, cJSON* obj, StringView name)
+		{
+			return PlainType<uint32>::ToJSON(data.GetRaw(), obj, name);
+		}
+		static EmptyResult FromJSON(math::PackedQuaternion32& data, cJSON* json, StringView name)
+		{
+			uint32 temp;
+			EmptyResult res = PlainType<uint32>::FromJSON(temp, json, name);
+			if(res.HasFailed())
+				return res;
+			data.SetRaw(temp);
+			return Result::CreateSuccess();
+		}
+		static TResult<math::PackedQuaternion32> CreateFromJSON(cJSON* json, StringView name)
+		{
+			math::PackedQuaternion32 elem;
+			EmptyResult res = FromJSON(elem, json, name);
+			if (res.HasFailed())
+				return Result::CopyFailure<math::PackedQuaternion32>(res);
+			return Result::CreateSuccess(elem);
+		}
+		NODISCARD static String ToString(const math::PackedQuaternion32& data)
+		{
+			return PlainType<uint32>::ToString(data.GetRaw());
+		}
+		static EmptyResult FromString(const String& str, math::PackedQuaternion32& data)
+		{
+			uint32 temp;
+			EmptyResult res = PlainType<uint32>::FromString(str, temp);
+			if(res.HasFailed())
+				return res;
+			data.SetRaw(temp);
+			return Result::CreateSuccess();
+		}
+		static TResult<math::PackedQuaternion32> CreateFromString(const String& str)
+		{
+			math::PackedQuaternion32 elem;
+			EmptyResult res = FromString(str, elem);
+			if (res.HasFailed())
+				return Result::CopyFailure<math::PackedQuaternion32>(res);
+			return Result::CreateSuccess(elem);
+		}
+		NODISCARD static int64 GetDynamicSize(UNUSED const math::PackedQuaternion32& data)
+		{
+			return 0ll; 
+		}
+
+		NODISCARD static sizet GetArraySize(UNUSED const math::PackedQuaternion32& data)
+		{
+			Break("[refl::PlainType<PackedQuaternion32>]::GetArraySize Trying to use a PlainType for array operations!");
+			return 0ll;
+		}
+
+		static void SetArraySize(UNUSED math::PackedQuaternion32& data, UNUSED sizet size)
+		{
+			Break("[refl::PlainType<PackedQuaternion32>]::SetArraySize Trying to use a PlainType for array operations!");
+		}
+
+		NODISCARD static const int32& GetArrayValue(UNUSED const math::PackedQuaternion32& data, UNUSED sizet index)
+		{
+			static constexpr int32 dummy = 0;
+			Break("[refl::PlainType<PackedQuaternion32>]::GetArrayValue Trying to use a PlainType for array operations!");
+			return dummy;
+		}
+
+		static void SetArrayValue(UNUSED math::PackedQuaternion32& data, UNUSED const int32& value, UNUSED sizet index)
+		{
+			Break("[refl::PlainType<PackedQuaternion32>]::SetArrayValue Trying to use a PlainType for array operations!");
+		}
+	};
+
+	template<>
+	struct PlainType<math::PackedQuaternion48> : public BaseType<math::PackedQuaternion48>
+	{
+		static inline constexpr TypeCategory_t Category = TypeCategory_t::Plain;
+		static TResult<ssizet> ToStream(const math::PackedQuaternion48& data, IStream& stream)
+		{ 
+			ssizet size = stream.Write(&data, sizeof(data));
+			if(size == sizeof(data))
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::PlainType<PackedQuaternion48>]::ToStream Failure while writing to stream, not all data was written, expected:%" PRIuPTR " obtained:%" PRIiPTR ".", sizeof(data), size));
+		}
+		static TResult<ssizet> FromStream(math::PackedQuaternion48& data, IStream& stream)
+		{ 
+			ssizet size = stream.Read(&data, sizeof(data));
+			if(size == sizeof(data))
+				return Result::CreateSuccess(size);
+			return Result::CreateFailure<ssizet>(Format("[refl::PlainType<PackedQuaternion48>]::FromStream Failure while reading from stream, not all data was read, expected:%" PRIuPTR " obtained:%" PRIiPTR ".", sizeof(data), size));
+		}
+		static TResult<std::pair<math::PackedQuaternion48, ssizet>> CreateFromStream(IStream& stream)
+		{
+			math::PackedQuaternion48 elem;
+			TResult<ssizet> res = FromStream(elem, stream);
+			if (res.HasFailed())
+				return Result::CopyFailure<std::pair<math::PackedQuaternion48, ssizet>, ssizet>(res);
+			return Result::CreateSuccess(std::make_pair(elem, res.GetValue()));
+		}
+		static SPtr<cJSON> CreateJSON(const math::PackedQuaternion48& data, StringView name)
+		{
+			cJSON* obj = cJSON_CreateObject();
+			ToJSON(data, obj, name);
+			return SPtr<cJSON>(obj, cJSON_Delete);
+		}
+		static cJSON* ToJSON(const math::PackedQuaternion48& data, cJSON* obj, StringView name)
+		{
+			return PlainType<uint64>::ToJSON(Impl::PackedQuaternion48ToBits(data), obj, name);
+		}
+		static EmptyResult FromJSON(math::PackedQuaternion48& data, cJSON* json, StringView name)
+		{
+			uint64 temp;
+			EmptyResult res = PlainType<uint64>::FromJSON(temp, json, name);
+			if(res.HasFailed())
+				return res;
+			data.SetRaw(Impl::PackedQuaternion48FromBits(temp));
+			return Result::CreateSuccess();
+		}
+		static TResult<math::PackedQuaternion48> CreateFromJSON(cJSON* json, StringView name)
+		{
+			math::PackedQuaternion48 elem;
+			EmptyResult res = FromJSON(elem, json, name);
+			if (res.HasFailed())
+				return Result::CopyFailure<math::PackedQuaternion48>(res);
+			return Result::CreateSuccess(elem);
+		}
+		NODISCARD static String ToString(const math::PackedQuaternion48& data)
+		{
+			return PlainType<uint64>::ToString(Impl::PackedQuaternion48ToBits(data));
+		}
+		static EmptyResult FromString(const String& str, math::PackedQuaternion48& data)
+		{
+			uint64 temp;
+			EmptyResult res = PlainType<uint64>::FromString(str, temp);
+			if(res.HasFailed())
+				return res;
+			data.SetRaw(Impl::PackedQuaternion48FromBits(temp));
+			return Result::CreateSuccess();
+		}
+		static TResult<math::PackedQuaternion48> CreateFromString(const String& str)
+		{
+			math::PackedQuaternion48 elem;
+			EmptyResult res = FromString(str, elem);
+			if (res.HasFailed())
+				return Result::CopyFailure<math::PackedQuaternion48>(res);
+			return Result::CreateSuccess(elem);
+		}
+		NODISCARD static int64 GetDynamicSize(UNUSED const math::PackedQuaternion48& data)
+		{
+			return 0ll; 
+		}
+
+		NODISCARD static sizet GetArraySize(UNUSED const math::PackedQuaternion48& data)
+		{
+			Break("[refl::PlainType<PackedQuaternion48>]::GetArraySize Trying to use a PlainType for array operations!");
+			return 0ll;
+		}
+
+		static void SetArraySize(UNUSED math::PackedQuaternion48& data, UNUSED sizet size)
+		{
+			Break("[refl::PlainType<PackedQuaternion48>]::SetArraySize Trying to use a PlainType for array operations!");
+		}
+
+		NODISCARD static const int32& GetArrayValue(UNUSED const math::PackedQuaternion48& data, UNUSED sizet index)
+		{
+			static constexpr int32 dummy = 0;
+			Break("[refl::PlainType<PackedQuaternion48>]::GetArrayValue Trying to use a PlainType for array operations!");
+			return dummy;
+		}
+
+		static void SetArrayValue(UNUSED math::PackedQuaternion48& data, UNUSED const int32& value, UNUSED sizet index)
+		{
+			Break("[refl::PlainType<PackedQuaternion48>]::SetArrayValue Trying to use a PlainType for array operations!");
+		}
+	};
+}
+
+#endif /* MATH_REFL_PACKEDQUATERNION_H */
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include "../../../GreaperCore/Public/Reflection/ComplexType.h"
 #include "../Vector2.h"
+#include "Half.h"
 
 #define CreateVec2Refl(vectype)\
 namespace greaper::refl{\
@@ -35,6 +36,7 @@ CreateVec2Refl(greaper::math::Vector2u8);
 CreateVec2Refl(greaper::math::Vector2u16);
 CreateVec2Refl(greaper::math::Vector2u64);
 CreateVec2Refl(greaper::math::Vector2b);
+CreateVec2Refl(greaper::math::Vector2h);
 
 #undef CreateVec2Refl
 
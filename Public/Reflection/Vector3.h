@@ -10,6 +10,7 @@
 
 #include "../../../GreaperCore/Public/Reflection/ComplexType.h"
 #include "../Vector3.h"
+#include "Half.h"
 
 #define CreateVec3Refl(vectype)\
 namespace greaper::refl{\
@@ -38,6 +39,7 @@ CreateVec3Refl(greaper::math::Vector3u8);
 CreateVec3Refl(greaper::math::Vector3u16);
 CreateVec3Refl(greaper::math::Vector3u64);
 CreateVec3Refl(greaper::math::Vector3b);
+CreateVec3Refl(greaper::math::Vector3h);
 
 #undef CreateVec3Refl
 
@@ -10,6 +10,7 @@
 
 #include "../../../GreaperCore/Public/Reflection/ComplexType.h"
 #include "../Vector4.h"
+#include "Half.h"
 
 #define CreateVec4Refl(vectype)\
 namespace greaper::refl{\
@@ -41,6 +42,7 @@ CreateVec4Refl(greaper::math::Vector4u8);
 CreateVec4Refl(greaper::math::Vector4u16);
 CreateVec4Refl(greaper::math::Vector4u64);
 CreateVec4Refl(greaper::math::Vector4b);
+CreateVec4Refl(greaper::math::Vector4h);
 
 #undef CreateVec4Refl
 
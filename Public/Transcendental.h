@@ -0,0 +1,556 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_TRANSCENDENTAL_H
+#define MATH_TRANSCENDENTAL_H 1
+
+#include "MathPrerequisites.h"
+#include "Batch.h"
+#include <bit>
+#include <cmath>
+#include <limits>
+
+MATH_STRICT_FP_BEGIN
+
+/* Sin, Cos, SinCos, Exp, LogN and ATan2 over SIMD lanes, written once in Base/TranscendentalKernels.inl against
+ * the LaneOps primitives below. Every instruction set runs the same operations in the same order, so a lane
+ * gives the same bits whatever the width, the scalar LaneOps included.
+ *
+ * Maximum error in ulps of the exact result, floats measured over every input in range (ATan2 over 2^22 random
+ * pairs) and doubles over 8 million random inputs per function:
+ *	float:	Sin/Cos/SinCos 0.85 for |x| <= 8192, Exp 0.99, LogN 0.83, ATan2 2.23
+ *	double:	Sin/Cos/SinCos 0.95 for |x| <= 262144, Exp 0.88, LogN 0.78, ATan2 2.08
+ * Sin and Cos lanes outside the accurate range are handed to std::sin/std::cos. Exp underflows to 0 and
+ * overflows to infinity, LogN returns -inf for zeros and NaN for negatives. */
+
+namespace greaper::math::SSE::LaneOps
+{
+	using Floats = __m128;
+	using FloatBits = __m128i;
+	using FloatMask = __m128;
+	using Doubles = __m128d;
+	using DoubleBits = __m128i;
+	using DoubleMask = __m128d;
+	inline constexpr sizet FloatCount = 4;
+	inline constexpr sizet DoubleCount = 2;
+
+	INLINE Floats Splat(float value)noexcept { return _mm_set1_ps(value); }
+	INLINE Doubles Splat(double value)noexcept { return _mm_set1_pd(value); }
+	INLINE FloatBits SplatBits32(uint32 value)noexcept { return _mm_set1_epi32(static_cast<int32>(value)); }
+	INLINE DoubleBits SplatBits64(uint64 value)noexcept { return _mm_set1_epi64x(static_cast<int64>(value)); }
+	INLINE Floats Load(const float* src)noexcept { return _mm_loadu_ps(src); }
+	INLINE Doubles Load(const double* src)noexcept { return _mm_loadu_pd(src); }
+	INLINE void Store(float* dst, Floats value)noexcept { _mm_storeu_ps(dst, value); }
+	INLINE void Store(double* dst, Doubles value)noexcept { _mm_storeu_pd(dst, value); }
+
+	INLINE Floats Add(Floats a, Floats b)noexcept { return _mm_add_ps(a, b); }
+	INLINE Floats Sub(Floats a, Floats b)noexcept { return _mm_sub_ps(a, b); }
+	INLINE Floats Mul(Floats a, Floats b)noexcept { return _mm_mul_ps(a, b); }
+	INLINE Floats Div(Floats a, Floats b)noexcept { return _mm_div_ps(a, b); }
+	INLINE Floats Min(Floats a, Floats b)noexcept { return _mm_min_ps(a, b); }
+	INLINE Floats Max(Floats a, Floats b)noexcept { return _mm_max_ps(a, b); }
+	INLINE Floats And(Floats a, Floats b)noexcept { return _mm_and_ps(a, b); }
+	INLINE Floats Or(Floats a, Floats b)noexcept { return _mm_or_ps(a, b); }
+	INLINE Floats Xor(Floats a, Floats b)noexcept { return _mm_xor_ps(a, b); }
+	INLINE Floats AndNot(Floats a, Floats b)noexcept { return _mm_andnot_ps(a, b); }
+	INLINE Doubles Add(Doubles a, Doubles b)noexcept { return _mm_add_pd(a, b); }
+	INLINE Doubles Sub(Doubles a, Doubles b)noexcept { return _mm_sub_pd(a, b); }
+	INLINE Doubles Mul(Doubles a, Doubles b)noexcept { return _mm_mul_pd(a, b); }
+	INLINE Doubles Div(Doubles a, Doubles b)noexcept { return _mm_div_pd(a, b); }
+	INLINE Doubles Min(Doubles a, Doubles b)noexcept { return _mm_min_pd(a, b); }
+	INLINE Doubles Max(Doubles a, Doubles b)noexcept { return _mm_max_pd(a, b); }
+	INLINE Doubles And(Doubles a, Doubles b)noexcept { return _mm_and_pd(a, b); }
+	INLINE Doubles Or(Doubles a, Doubles b)noexcept { return _mm_or_pd(a, b); }
+	INLINE Doubles Xor(Doubles a, Doubles b)noexcept { return _mm_xor_pd(a, b); }
+	INLINE Doubles AndNot(Doubles a, Doubles b)noexcept { return _mm_andnot_pd(a, b); }
+
+	INLINE FloatMask CmpLt(Floats a, Floats b)noexcept { return _mm_cmplt_ps(a, b); }
+	INLINE FloatMask CmpGt(Floats a, Floats b)noexcept { return _mm_cmpgt_ps(a, b); }
+	INLINE FloatMask CmpEq(Floats a, Floats b)noexcept { return _mm_cmpeq_ps(a, b); }
+	INLINE FloatMask CmpUnord(Floats a, Floats b)noexcept { return _mm_cmpunord_ps(a, b); }
+	INLINE DoubleMask CmpLt(Doubles a, Doubles b)noexcept { return _mm_cmplt_pd(a, b); }
+	INLINE DoubleMask CmpGt(Doubles a, Doubles b)noexcept { return _mm_cmpgt_pd(a, b); }
+	INLINE DoubleMask CmpEq(Doubles a, Doubles b)noexcept { return _mm_cmpeq_pd(a, b); }
+	INLINE DoubleMask CmpUnord(Doubles a, Doubles b)noexcept { return _mm_cmpunord_pd(a, b); }
+	INLINE FloatMask MaskOr(FloatMask a, FloatMask b)noexcept { return _mm_or_ps(a, b); }
+	INLINE DoubleMask MaskOr(DoubleMask a, DoubleMask b)noexcept { return _mm_or_pd(a, b); }
+	INLINE bool Any(FloatMask mask)noexcept { return _mm_movemask_ps(mask) != 0; }
+	INLINE bool Any(DoubleMask mask)noexcept { return _mm_movemask_pd(mask) != 0; }
+	INLINE Floats Select(FloatMask mask, Floats ifTrue, Floats ifFalse)noexcept { return _mm_or_ps(_mm_and_ps(mask, ifTrue), _mm_andnot_ps(mask, ifFalse)); }
+	INLINE Doubles Select(DoubleMask mask, Doubles ifTrue, Doubles ifFalse)noexcept { return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse)); }
+	/* Lanes holding 1 become true, lanes holding 0 false */
+	INLINE FloatMask MaskFromOne32(FloatBits bits)noexcept { return _mm_castsi128_ps(_mm_sub_epi32(_mm_setzero_si128(), bits)); }
+	INLINE DoubleMask MaskFromOne64(DoubleBits bits)noexcept { return _mm_castsi128_pd(_mm_sub_epi64(_mm_setzero_si128(), bits)); }
+
+	INLINE FloatBits AsBits(Floats value)noexcept { return _mm_castps_si128(value); }
+	INLINE DoubleBits AsBits(Doubles value)noexcept { return _mm_castpd_si128(value); }
+	INLINE Floats AsFloats(FloatBits bits)noexcept { return _mm_castsi128_ps(bits); }
+	INLINE Doubles AsDoubles(DoubleBits bits)noexcept { return _mm_castsi128_pd(bits); }
+	INLINE __m128i AndBits(__m128i a, __m128i b)noexcept { return _mm_and_si128(a, b); }
+	INLINE __m128i OrBits(__m128i a, __m128i b)noexcept { return _mm_or_si128(a, b); }
+	INLINE FloatBits AddBits32(FloatBits a, FloatBits b)noexcept { return _mm_add_epi32(a, b); }
+	INLINE DoubleBits AddBits64(DoubleBits a, DoubleBits b)noexcept { return _mm_add_epi64(a, b); }
+	template<int Count> INLINE FloatBits ShiftLeft32(FloatBits bits)noexcept { return _mm_slli_epi32(bits, Count); }
+	template<int Count> INLINE FloatBits ShiftRight32(FloatBits bits)noexcept { return _mm_srli_epi32(bits, Count); }
+	template<int Count> INLINE DoubleBits ShiftLeft64(DoubleBits bits)noexcept { return _mm_slli_epi64(bits, Count); }
+	template<int Count> INLINE DoubleBits ShiftRight64(DoubleBits bits)noexcept { return _mm_srli_epi64(bits, Count); }
+}
+
+namespace greaper::math::AVX::LaneOps
+{
+	using Floats = __m256;
+	using FloatBits = __m256i;
+	using FloatMask = __m256;
+	using Doubles = __m256d;
+	using DoubleBits = __m256i;
+	using DoubleMask = __m256d;
+	inline constexpr sizet FloatCount = 8;
+	inline constexpr sizet DoubleCount = 4;
+
+	MATH_TARGET_AVX2 INLINE Floats Splat(float value)noexcept { return _mm256_set1_ps(value); }
+	MATH_TARGET_AVX2 INLINE Doubles Splat(double value)noexcept { return _mm256_set1_pd(value); }
+	MATH_TARGET_AVX2 INLINE FloatBits SplatBits32(uint32 value)noexcept { return _mm256_set1_epi32(static_cast<int32>(value)); }
+	MATH_TARGET_AVX2 INLINE DoubleBits SplatBits64(uint64 value)noexcept { return _mm256_set1_epi64x(static_cast<int64>(value)); }
+	MATH_TARGET_AVX2 INLINE Floats Load(const float* src)noexcept { return _mm256_loadu_ps(src); }
+	MATH_TARGET_AVX2 INLINE Doubles Load(const double* src)noexcept { return _mm256_loadu_pd(src); }
+	MATH_TARGET_AVX2 INLINE void Store(float* dst, Floats value)noexcept { _mm256_storeu_ps(dst, value); }
+	MATH_TARGET_AVX2 INLINE void Store(double* dst, Doubles value)noexcept { _mm256_storeu_pd(dst, value); }
+
+	MATH_TARGET_AVX2 INLINE Floats Add(Floats a, Floats b)noexcept { return _mm256_add_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE Floats Sub(Floats a, Floats b)noexcept { return _mm256_sub_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE Floats Mul(Floats a, Floats b)noexcept { return _mm256_mul_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE Floats Div(Floats a, Floats b)noexcept { return _mm256_div_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE Floats Min(Floats a, Floats b)noexcept { return _mm256_min_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE Floats Max(Floats a, Floats b)noexcept { return _mm256_max_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE Floats And(Floats a, Floats b)noexcept { return _mm256_and_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE Floats Or(Floats a, Floats b)noexcept { return _mm256_or_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE Floats Xor(Floats a, Floats b)noexcept { return _mm256_xor_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE Floats AndNot(Floats a, Floats b)noexcept { return _mm256_andnot_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE Doubles Add(Doubles a, Doubles b)noexcept { return _mm256_add_pd(a, b); }
+	MATH_TARGET_AVX2 INLINE Doubles Sub(Doubles a, Doubles b)noexcept { return _mm256_sub_pd(a, b); }
+	MATH_TARGET_AVX2 INLINE Doubles Mul(Doubles a, Doubles b)noexcept { return _mm256_mul_pd(a, b); }
+	MATH_TARGET_AVX2 INLINE Doubles Div(Doubles a, Doubles b)noexcept { return _mm256_div_pd(a, b); }
+	MATH_TARGET_AVX2 INLINE Doubles Min(Doubles a, Doubles b)noexcept { return _mm256_min_pd(a, b); }
+	MATH_TARGET_AVX2 INLINE Doubles Max(Doubles a, Doubles b)noexcept { return _mm256_max_pd(a, b); }
+	MATH_TARGET_AVX2 INLINE Doubles And(Doubles a, Doubles b)noexcept { return _mm256_and_pd(a, b); }
+	MATH_TARGET_AVX2 INLINE Doubles Or(Doubles a, Doubles b)noexcept { return _mm256_or_pd(a, b); }
+	MATH_TARGET_AVX2 INLINE Doubles Xor(Doubles a, Doubles b)noexcept { return _mm256_xor_pd(a, b); }
+	MATH_TARGET_AVX2 INLINE Doubles AndNot(Doubles a, Doubles b)noexcept { return _mm256_andnot_pd(a, b); }
+
+	MATH_TARGET_AVX2 INLINE FloatMask CmpLt(Floats a, Floats b)noexcept { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+	MATH_TARGET_AVX2 INLINE FloatMask CmpGt(Floats a, Floats b)noexcept { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+	MATH_TARGET_AVX2 INLINE FloatMask CmpEq(Floats a, Floats b)noexcept { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+	MATH_TARGET_AVX2 INLINE FloatMask CmpUnord(Floats a, Floats b)noexcept { return _mm256_cmp_ps(a, b, _CMP_UNORD_Q); }
+	MATH_TARGET_AVX2 INLINE DoubleMask CmpLt(Doubles a, Doubles b)noexcept { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+	MATH_TARGET_AVX2 INLINE DoubleMask CmpGt(Doubles a, Doubles b)noexcept { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+	MATH_TARGET_AVX2 INLINE DoubleMask CmpEq(Doubles a, Doubles b)noexcept { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+	MATH_TARGET_AVX2 INLINE DoubleMask CmpUnord(Doubles a, Doubles b)noexcept { return _mm256_cmp_pd(a, b, _CMP_UNORD_Q); }
+	MATH_TARGET_AVX2 INLINE FloatMask MaskOr(FloatMask a, FloatMask b)noexcept { return _mm256_or_ps(a, b); }
+	MATH_TARGET_AVX2 INLINE DoubleMask MaskOr(DoubleMask a, DoubleMask b)noexcept { return _mm256_or_pd(a, b); }
+	MATH_TARGET_AVX2 INLINE bool Any(FloatMask mask)noexcept { return _mm256_movemask_ps(mask) != 0; }
+	MATH_TARGET_AVX2 INLINE bool Any(DoubleMask mask)noexcept { return _mm256_movemask_pd(mask) != 0; }
+	MATH_TARGET_AVX2 INLINE Floats Select(FloatMask mask, Floats ifTrue, Floats ifFalse)noexcept { return _mm256_blendv_ps(ifFalse, ifTrue, mask); }
+	MATH_TARGET_AVX2 INLINE Doubles Select(DoubleMask mask, Doubles ifTrue, Doubles ifFalse)noexcept { return _mm256_blendv_pd(ifFalse, ifTrue, mask); }
+	MATH_TARGET_AVX2 INLINE FloatMask MaskFromOne32(FloatBits bits)noexcept { return _mm256_castsi256_ps(_mm256_sub_epi32(_mm256_setzero_si256(), bits)); }
+	MATH_TARGET_AVX2 INLINE DoubleMask MaskFromOne64(DoubleBits bits)noexcept { return _mm256_castsi256_pd(_mm256_sub_epi64(_mm256_setzero_si256(), bits)); }
+
+	MATH_TARGET_AVX2 INLINE FloatBits AsBits(Floats value)noexcept { return _mm256_castps_si256(value); }
+	MATH_TARGET_AVX2 INLINE DoubleBits AsBits(Doubles value)noexcept { return _mm256_castpd_si256(value); }
+	MATH_TARGET_AVX2 INLINE Floats AsFloats(FloatBits bits)noexcept { return _mm256_castsi256_ps(bits); }
+	MATH_TARGET_AVX2 INLINE Doubles AsDoubles(DoubleBits bits)noexcept { return _mm256_castsi256_pd(bits); }
+	MATH_TARGET_AVX2 INLINE __m256i AndBits(__m256i a, __m256i b)noexcept { return _mm256_and_si256(a, b); }
+	MATH_TARGET_AVX2 INLINE __m256i OrBits(__m256i a, __m256i b)noexcept { return _mm256_or_si256(a, b); }
+	MATH_TARGET_AVX2 INLINE FloatBits AddBits32(FloatBits a, FloatBits b)noexcept { return _mm256_add_epi32(a, b); }
+	MATH_TARGET_AVX2 INLINE DoubleBits AddBits64(DoubleBits a, DoubleBits b)noexcept { return _mm256_add_epi64(a, b); }
+	template<int Count> MATH_TARGET_AVX2 INLINE FloatBits ShiftLeft32(FloatBits bits)noexcept { return _mm256_slli_epi32(bits, Count); }
+	template<int Count> MATH_TARGET_AVX2 INLINE FloatBits ShiftRight32(FloatBits bits)noexcept { return _mm256_srli_epi32(bits, Count); }
+	template<int Count> MATH_TARGET_AVX2 INLINE DoubleBits ShiftLeft64(DoubleBits bits)noexcept { return _mm256_slli_epi64(bits, Count); }
+	template<int Count> MATH_TARGET_AVX2 INLINE DoubleBits ShiftRight64(DoubleBits bits)noexcept { return _mm256_srli_epi64(bits, Count); }
+}
+
+namespace greaper::math::AVX512::LaneOps
+{
+	using Floats = __m512;
+	using FloatBits = __m512i;
+	using FloatMask = __mmask16;
+	using Doubles = __m512d;
+	using DoubleBits = __m512i;
+	using DoubleMask = __mmask8;
+	inline constexpr sizet FloatCount = 16;
+	inline constexpr sizet DoubleCount = 8;
+
+	MATH_TARGET_AVX512 INLINE Floats Splat(float value)noexcept { return _mm512_set1_ps(value); }
+	MATH_TARGET_AVX512 INLINE Doubles Splat(double value)noexcept { return _mm512_set1_pd(value); }
+	MATH_TARGET_AVX512 INLINE FloatBits SplatBits32(uint32 value)noexcept { return _mm512_set1_epi32(static_cast<int32>(value)); }
+	MATH_TARGET_AVX512 INLINE DoubleBits SplatBits64(uint64 value)noexcept { return _mm512_set1_epi64(static_cast<int64>(value)); }
+	MATH_TARGET_AVX512 INLINE Floats Load(const float* src)noexcept { return _mm512_loadu_ps(src); }
+	MATH_TARGET_AVX512 INLINE Doubles Load(const double* src)noexcept { return _mm512_loadu_pd(src); }
+	MATH_TARGET_AVX512 INLINE void Store(float* dst, Floats value)noexcept { _mm512_storeu_ps(dst, value); }
+	MATH_TARGET_AVX512 INLINE void Store(double* dst, Doubles value)noexcept { _mm512_storeu_pd(dst, value); }
+	/* Loop remainders, the lanes past count read as zero and are not written */
+	MATH_TARGET_AVX512 INLINE Floats LoadPartial(const float* src, sizet count)noexcept { return _mm512_maskz_loadu_ps(TailMask16(count), src); }
+	MATH_TARGET_AVX512 INLINE Doubles LoadPartial(const double* src, sizet count)noexcept { return _mm512_maskz_loadu_pd(TailMask8(count), src); }
+	MATH_TARGET_AVX512 INLINE void StorePartial(float* dst, Floats value, sizet count)noexcept { _mm512_mask_storeu_ps(dst, TailMask16(count), value); }
+	MATH_TARGET_AVX512 INLINE void StorePartial(double* dst, Doubles value, sizet count)noexcept { _mm512_mask_storeu_pd(dst, TailMask8(count), value); }
+
+	MATH_TARGET_AVX512 INLINE Floats Add(Floats a, Floats b)noexcept { return _mm512_add_ps(a, b); }
+	MATH_TARGET_AVX512 INLINE Floats Sub(Floats a, Floats b)noexcept { return _mm512_sub_ps(a, b); }
+	MATH_TARGET_AVX512 INLINE Floats Mul(Floats a, Floats b)noexcept { return _mm512_mul_ps(a, b); }
+	MATH_TARGET_AVX512 INLINE Floats Div(Floats a, Floats b)noexcept { return _mm512_div_ps(a, b); }
+	MATH_TARGET_AVX512 INLINE Floats Min(Floats a, Floats b)noexcept { return _mm512_min_ps(a, b); }
+	MATH_TARGET_AVX512 INLINE Floats Max(Floats a, Floats b)noexcept { return _mm512_max_ps(a, b); }
+	MATH_TARGET_AVX512 INLINE Floats And(Floats a, Floats b)noexcept { return _mm512_and_ps(a, b); }
+	MATH_TARGET_AVX512 INLINE Floats Or(Floats a, Floats b)noexcept { return _mm512_or_ps(a, b); }
+	MATH_TARGET_AVX512 INLINE Floats Xor(Floats a, Floats b)noexcept { return _mm512_xor_ps(a, b); }
+	MATH_TARGET_AVX512 INLINE Floats AndNot(Floats a, Floats b)noexcept { return _mm512_andnot_ps(a, b); }
+	MATH_TARGET_AVX512 INLINE Doubles Add(Doubles a, Doubles b)noexcept { return _mm512_add_pd(a, b); }
+	MATH_TARGET_AVX512 INLINE Doubles Sub(Doubles a, Doubles b)noexcept { return _mm512_sub_pd(a, b); }
+	MATH_TARGET_AVX512 INLINE Doubles Mul(Doubles a, Doubles b)noexcept { return _mm512_mul_pd(a, b); }
+	MATH_TARGET_AVX512 INLINE Doubles Div(Doubles a, Doubles b)noexcept { return _mm512_div_pd(a, b); }
+	MATH_TARGET_AVX512 INLINE Doubles Min(Doubles a, Doubles b)noexcept { return _mm512_min_pd(a, b); }
+	MATH_TARGET_AVX512 INLINE Doubles Max(Doubles a, Doubles b)noexcept { return _mm512_max_pd(a, b); }
+	MATH_TARGET_AVX512 INLINE Doubles And(Doubles a, Doubles b)noexcept { return _mm512_and_pd(a, b); }
+	MATH_TARGET_AVX512 INLINE Doubles Or(Doubles a, Doubles b)noexcept { return _mm512_or_pd(a, b); }
+	MATH_TARGET_AVX512 INLINE Doubles Xor(Doubles a, Doubles b)noexcept { return _mm512_xor_pd(a, b); }
+	MATH_TARGET_AVX512 INLINE Doubles AndNot(Doubles a, Doubles b)noexcept { return _mm512_andnot_pd(a, b); }
+
+	MATH_TARGET_AVX512 INLINE FloatMask CmpLt(Floats a, Floats b)noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+	MATH_TARGET_AVX512 INLINE FloatMask CmpGt(Floats a, Floats b)noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+	MATH_TARGET_AVX512 INLINE FloatMask CmpEq(Floats a, Floats b)noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+	MATH_TARGET_AVX512 INLINE FloatMask CmpUnord(Floats a, Floats b)noexcept { return _mm512_cmp_ps_mask(a, b, _CMP_UNORD_Q); }
+	MATH_TARGET_AVX512 INLINE DoubleMask CmpLt(Doubles a, Doubles b)noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+	MATH_TARGET_AVX512 INLINE DoubleMask CmpGt(Doubles a, Doubles b)noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); }
+	MATH_TARGET_AVX512 INLINE DoubleMask CmpEq(Doubles a, Doubles b)noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+	MATH_TARGET_AVX512 INLINE DoubleMask CmpUnord(Doubles a, Doubles b)noexcept { return _mm512_cmp_pd_mask(a, b, _CMP_UNORD_Q); }
+	MATH_TARGET_AVX512 INLINE FloatMask MaskOr(FloatMask a, FloatMask b)noexcept { return static_cast<FloatMask>(a | b); }
+	MATH_TARGET_AVX512 INLINE DoubleMask MaskOr(DoubleMask a, DoubleMask b)noexcept { return static_cast<DoubleMask>(a | b); }
+	MATH_TARGET_AVX512 INLINE bool Any(FloatMask mask)noexcept { return mask != 0; }
+	MATH_TARGET_AVX512 INLINE bool Any(DoubleMask mask)noexcept { return mask != 0; }
+	MATH_TARGET_AVX512 INLINE Floats Select(FloatMask mask, Floats ifTrue, Floats ifFalse)noexcept { return _mm512_mask_blend_ps(mask, ifFalse, ifTrue); }
+	MATH_TARGET_AVX512 INLINE Doubles Select(DoubleMask mask, Doubles ifTrue, Doubles ifFalse)noexcept { return _mm512_mask_blend_pd(mask, ifFalse, ifTrue); }
+	MATH_TARGET_AVX512 INLINE FloatMask MaskFromOne32(FloatBits bits)noexcept { return _mm512_test_epi32_mask(bits, bits); }
+	MATH_TARGET_AVX512 INLINE DoubleMask MaskFromOne64(DoubleBits bits)noexcept { return _mm512_test_epi64_mask(bits, bits); }
+
+	MATH_TARGET_AVX512 INLINE FloatBits AsBits(Floats value)noexcept { return _mm512_castps_si512(value); }
+	MATH_TARGET_AVX512 INLINE DoubleBits AsBits(Doubles value)noexcept { return _mm512_castpd_si512(value); }
+	MATH_TARGET_AVX512 INLINE Floats AsFloats(FloatBits bits)noexcept { return _mm512_castsi512_ps(bits); }
+	MATH_TARGET_AVX512 INLINE Doubles AsDoubles(DoubleBits bits)noexcept { return _mm512_castsi512_pd(bits); }
+	MATH_TARGET_AVX512 INLINE __m512i AndBits(__m512i a, __m512i b)noexcept { return _mm512_and_si512(a, b); }
+	MATH_TARGET_AVX512 INLINE __m512i OrBits(__m512i a, __m512i b)noexcept { return _mm512_or_si512(a, b); }
+	MATH_TARGET_AVX512 INLINE FloatBits AddBits32(FloatBits a, FloatBits b)noexcept { return _mm512_add_epi32(a, b); }
+	MATH_TARGET_AVX512 INLINE DoubleBits AddBits64(DoubleBits a, DoubleBits b)noexcept { return _mm512_add_epi64(a, b); }
+	template<int Count> MATH_TARGET_AVX512 INLINE FloatBits ShiftLeft32(FloatBits bits)noexcept { return _mm512_slli_epi32(bits, Count); }
+	template<int Count> MATH_TARGET_AVX512 INLINE FloatBits ShiftRight32(FloatBits bits)noexcept { return _mm512_srli_epi32(bits, Count); }
+	template<int Count> MATH_TARGET_AVX512 INLINE DoubleBits ShiftLeft64(DoubleBits bits)noexcept { return _mm512_slli_epi64(bits, Count); }
+	template<int Count> MATH_TARGET_AVX512 INLINE DoubleBits ShiftRight64(DoubleBits bits)noexcept { return _mm512_srli_epi64(bits, Count); }
+}
+
+/* One lane at a time, the reference the batch kernels fall back to for their remainders */
+namespace greaper::math::Batch::Impl::Scalar::LaneOps
+{
+	using Floats = float;
+	using FloatBits = uint32;
+	using FloatMask = bool;
+	using Doubles = double;
+	using DoubleBits = uint64;
+	using DoubleMask = bool;
+	inline constexpr sizet FloatCount = 1;
+	inline constexpr sizet DoubleCount = 1;
+
+	INLINE Floats Splat(float value)noexcept { return value; }
+	INLINE Doubles Splat(double value)noexcept { return value; }
+	INLINE FloatBits SplatBits32(uint32 value)noexcept { return value; }
+	INLINE DoubleBits SplatBits64(uint64 value)noexcept { return value; }
+	INLINE Floats Load(const float* src)noexcept { return *src; }
+	INLINE Doubles Load(const double* src)noexcept { return *src; }
+	INLINE void Store(float* dst, Floats value)noexcept { *dst = value; }
+	INLINE void Store(double* dst, Doubles value)noexcept { *dst = value; }
+
+	INLINE FloatBits AsBits(Floats value)noexcept { return std::bit_cast<FloatBits>(value); }
+	INLINE DoubleBits AsBits(Doubles value)noexcept { return std::bit_cast<DoubleBits>(value); }
+	INLINE Floats AsFloats(FloatBits bits)noexcept { return std::bit_cast<Floats>(bits); }
+	INLINE Doubles AsDoubles(DoubleBits bits)noexcept { return std::bit_cast<Doubles>(bits); }
+
+	template<class T> INLINE T Add(T a, T b)noexcept { return a + b; }
+	template<class T> INLINE T Sub(T a, T b)noexcept { return a - b; }
+	template<class T> INLINE T Mul(T a, T b)noexcept { return a * b; }
+	template<class T> INLINE T Div(T a, T b)noexcept { return a / b; }
+	// Same NaN handling as minps/maxps, the second operand is returned when unordered
+	template<class T> INLINE T Min(T a, T b)noexcept { return a < b ? a : b; }
+	template<class T> INLINE T Max(T a, T b)noexcept { return a > b ? a : b; }
+	template<class T> INLINE T And(T a, T b)noexcept { return std::bit_cast<T>(AsBits(a) & AsBits(b)); }
+	template<class T> INLINE T Or(T a, T b)noexcept { return std::bit_cast<T>(AsBits(a) | AsBits(b)); }
+	template<class T> INLINE T Xor(T a, T b)noexcept { return std::bit_cast<T>(AsBits(a) ^ AsBits(b)); }
+	template<class T> INLINE T AndNot(T a, T b)noexcept { return std::bit_cast<T>(~AsBits(a) & AsBits(b)); }
+
+	template<class T> INLINE bool CmpLt(T a, T b)noexcept { return a < b; }
+	template<class T> INLINE bool CmpGt(T a, T b)noexcept { return a > b; }
+	template<class T> INLINE bool CmpEq(T a, T b)noexcept { return a == b; }
+	template<class T> INLINE bool CmpUnord(T a, T b)noexcept { return a != a || b != b; }
+	INLINE bool MaskOr(bool a, bool b)noexcept { return a || b; }
+	INLINE bool Any(bool mask)noexcept { return mask; }
+	template<class T> INLINE T Select(bool mask, T ifTrue, T ifFalse)noexcept { return mask ? ifTrue : ifFalse; }
+	INLINE bool MaskFromOne32(FloatBits bits)noexcept { return bits != 0; }
+	INLINE bool MaskFromOne64(DoubleBits bits)noexcept { return bits != 0; }
+
+	template<class T> INLINE T AndBits(T a, T b)noexcept { return a & b; }
+	template<class T> INLINE T OrBits(T a, T b)noexcept { return a | b; }
+	INLINE FloatBits AddBits32(FloatBits a, FloatBits b)noexcept { return a + b; }
+	INLINE DoubleBits AddBits64(DoubleBits a, DoubleBits b)noexcept { return a + b; }
+	template<int Count> INLINE FloatBits ShiftLeft32(FloatBits bits)noexcept { return bits << Count; }
+	template<int Count> INLINE FloatBits ShiftRight32(FloatBits bits)noexcept { return bits >> Count; }
+	template<int Count> INLINE DoubleBits ShiftLeft64(DoubleBits bits)noexcept { return bits << Count; }
+	template<int Count> INLINE DoubleBits ShiftRight64(DoubleBits bits)noexcept { return bits >> Count; }
+}
+
+namespace greaper::math::SSE
+{
+#define MATH_TRANSCENDENTAL_TARGET
+#include "Base/TranscendentalKernels.inl"
+#undef MATH_TRANSCENDENTAL_TARGET
+}
+
+namespace greaper::math::AVX
+{
+#define MATH_TRANSCENDENTAL_TARGET MATH_TARGET_AVX2
+#include "Base/TranscendentalKernels.inl"
+#undef MATH_TRANSCENDENTAL_TARGET
+}
+
+namespace greaper::math::AVX512
+{
+#define MATH_TRANSCENDENTAL_TARGET MATH_TARGET_AVX512
+#include "Base/TranscendentalKernels.inl"
+#undef MATH_TRANSCENDENTAL_TARGET
+}
+
+namespace greaper::math::Batch::Impl::Scalar
+{
+#define MATH_TRANSCENDENTAL_TARGET
+#include "Base/TranscendentalKernels.inl"
+#undef MATH_TRANSCENDENTAL_TARGET
+}
+
+namespace greaper::math::Batch
+{
+	namespace Impl
+	{
+#define MATH_BATCH_TRANSCENDENTAL_KERNELS(name, T)\
+		INLINE void name##Scalar(const T* in, T* out, sizet count)noexcept\
+		{\
+			for (sizet i = 0; i < count; ++i)\
+				out[i] = Scalar::name(in[i]);\
+		}\
+		MATH_TARGET_SSE41 inline void name##SSE41(const T* in, T* out, sizet count)noexcept\
+		{\
+			constexpr sizet width = sizeof(__m128) / sizeof(T);\
+			sizet i = 0;\
+			for (; i + width <= count; i += width)\
+				SSE::LaneOps::Store(out + i, SSE::name(SSE::LaneOps::Load(in + i)));\
+			name##Scalar(in + i, out + i, count - i);\
+		}\
+		MATH_TARGET_AVX2 inline void name##AVX2(const T* in, T* out, sizet count)noexcept\
+		{\
+			constexpr sizet width = sizeof(__m256) / sizeof(T);\
+			sizet i = 0;\
+			for (; i + width <= count; i += width)\
+				AVX::LaneOps::Store(out + i, AVX::name(AVX::LaneOps::Load(in + i)));\
+			name##SSE41(in + i, out + i, count - i);\
+		}\
+		MATH_TARGET_AVX512 inline void name##AVX512(const T* in, T* out, sizet count)noexcept\
+		{\
+			constexpr sizet width = sizeof(__m512) / sizeof(T);\
+			sizet i = 0;\
+			for (; i + width <= count; i += width)\
+				AVX512::LaneOps::Store(out + i, AVX512::name(AVX512::LaneOps::Load(in + i)));\
+			if (i < count)\
+				AVX512::LaneOps::StorePartial(out + i, AVX512::name(AVX512::LaneOps::LoadPartial(in + i, count - i)), count - i);\
+		}
+
+		MATH_BATCH_TRANSCENDENTAL_KERNELS(Sin, float);
+		MATH_BATCH_TRANSCENDENTAL_KERNELS(Sin, double);
+		MATH_BATCH_TRANSCENDENTAL_KERNELS(Cos, float);
+		MATH_BATCH_TRANSCENDENTAL_KERNELS(Cos, double);
+		MATH_BATCH_TRANSCENDENTAL_KERNELS(Exp, float);
+		MATH_BATCH_TRANSCENDENTAL_KERNELS(Exp, double);
+		MATH_BATCH_TRANSCENDENTAL_KERNELS(LogN, float);
+		MATH_BATCH_TRANSCENDENTAL_KERNELS(LogN, double);
+
+#undef MATH_BATCH_TRANSCENDENTAL_KERNELS
+
+		template<class T>
+		INLINE void SinCosScalar(const T* in, T* sinOut, T* cosOut, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				Scalar::SinCos(in[i], sinOut[i], cosOut[i]);
+		}
+		template<class T>
+		MATH_TARGET_SSE41 inline void SinCosSSE41(const T* in, T* sinOut, T* cosOut, sizet count)noexcept
+		{
+			constexpr sizet width = sizeof(__m128) / sizeof(T);
+			sizet i = 0;
+			for (; i + width <= count; i += width)
+			{
+				decltype(SSE::LaneOps::Load(in)) s, c;
+				SSE::SinCos(SSE::LaneOps::Load(in + i), s, c);
+				SSE::LaneOps::Store(sinOut + i, s);
+				SSE::LaneOps::Store(cosOut + i, c);
+			}
+			SinCosScalar(in + i, sinOut + i, cosOut + i, count - i);
+		}
+		template<class T>
+		MATH_TARGET_AVX2 inline void SinCosAVX2(const T* in, T* sinOut, T* cosOut, sizet count)noexcept
+		{
+			constexpr sizet width = sizeof(__m256) / sizeof(T);
+			sizet i = 0;
+			for (; i + width <= count; i += width)
+			{
+				decltype(AVX::LaneOps::Load(in)) s, c;
+				AVX::SinCos(AVX::LaneOps::Load(in + i), s, c);
+				AVX::LaneOps::Store(sinOut + i, s);
+				AVX::LaneOps::Store(cosOut + i, c);
+			}
+			SinCosSSE41(in + i, sinOut + i, cosOut + i, count - i);
+		}
+		template<class T>
+		MATH_TARGET_AVX512 inline void SinCosAVX512(const T* in, T* sinOut, T* cosOut, sizet count)noexcept
+		{
+			constexpr sizet width = sizeof(__m512) / sizeof(T);
+			sizet i = 0;
+			decltype(AVX512::LaneOps::Load(in)) s, c;
+			for (; i + width <= count; i += width)
+			{
+				AVX512::SinCos(AVX512::LaneOps::Load(in + i), s, c);
+				AVX512::LaneOps::Store(sinOut + i, s);
+				AVX512::LaneOps::Store(cosOut + i, c);
+			}
+			if (i < count)
+			{
+				AVX512::SinCos(AVX512::LaneOps::LoadPartial(in + i, count - i), s, c);
+				AVX512::LaneOps::StorePartial(sinOut + i, s, count - i);
+				AVX512::LaneOps::StorePartial(cosOut + i, c, count - i);
+			}
+		}
+
+		template<class T>
+		INLINE void ATan2Scalar(const T* y, const T* x, T* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = Scalar::ATan2(y[i], x[i]);
+		}
+		template<class T>
+		MATH_TARGET_SSE41 inline void ATan2SSE41(const T* y, const T* x, T* out, sizet count)noexcept
+		{
+			constexpr sizet width = sizeof(__m128) / sizeof(T);
+			sizet i = 0;
+			for (; i + width <= count; i += width)
+				SSE::LaneOps::Store(out + i, SSE::ATan2(SSE::LaneOps::Load(y + i), SSE::LaneOps::Load(x + i)));
+			ATan2Scalar(y + i, x + i, out + i, count - i);
+		}
+		template<class T>
+		MATH_TARGET_AVX2 inline void ATan2AVX2(const T* y, const T* x, T* out, sizet count)noexcept
+		{
+			constexpr sizet width = sizeof(__m256) / sizeof(T);
+			sizet i = 0;
+			for (; i + width <= count; i += width)
+				AVX::LaneOps::Store(out + i, AVX::ATan2(AVX::LaneOps::Load(y + i), AVX::LaneOps::Load(x + i)));
+			ATan2SSE41(y + i, x + i, out + i, count - i);
+		}
+		template<class T>
+		MATH_TARGET_AVX512 inline void ATan2AVX512(const T* y, const T* x, T* out, sizet count)noexcept
+		{
+			constexpr sizet width = sizeof(__m512) / sizeof(T);
+			sizet i = 0;
+			for (; i + width <= count; i += width)
+				AVX512::LaneOps::Store(out + i, AVX512::ATan2(AVX512::LaneOps::Load(y + i), AVX512::LaneOps::Load(x + i)));
+			if (i < count)
+			{
+				const sizet rest = count - i;
+				AVX512::LaneOps::StorePartial(out + i, AVX512::ATan2(AVX512::LaneOps::LoadPartial(y + i, rest), AVX512::LaneOps::LoadPartial(x + i, rest)), rest);
+			}
+		}
+	}
+
+	/* out[i] = sin(in[i]), the error bounds are listed at the top of Transcendental.h */
+	INLINE void Sin(std::span<const float> in, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::Sin, but the output is bigger than the input.");
+		Impl::Dispatch<void(*)(const float*, float*, sizet)>(&Impl::SinScalar, &Impl::SinSSE41, &Impl::SinAVX2, &Impl::SinAVX512, in.data(), out.data(), out.size());
+	}
+	INLINE void Sin(std::span<const double> in, std::span<double> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::Sin, but the output is bigger than the input.");
+		Impl::Dispatch<void(*)(const double*, double*, sizet)>(&Impl::SinScalar, &Impl::SinSSE41, &Impl::SinAVX2, &Impl::SinAVX512, in.data(), out.data(), out.size());
+	}
+	/* out[i] = cos(in[i]) */
+	INLINE void Cos(std::span<const float> in, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::Cos, but the output is bigger than the input.");
+		Impl::Dispatch<void(*)(const float*, float*, sizet)>(&Impl::CosScalar, &Impl::CosSSE41, &Impl::CosAVX2, &Impl::CosAVX512, in.data(), out.data(), out.size());
+	}
+	INLINE void Cos(std::span<const double> in, std::span<double> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::Cos, but the output is bigger than the input.");
+		Impl::Dispatch<void(*)(const double*, double*, sizet)>(&Impl::CosScalar, &Impl::CosSSE41, &Impl::CosAVX2, &Impl::CosAVX512, in.data(), out.data(), out.size());
+	}
+	/* sinOut[i] = sin(in[i]), cosOut[i] = cos(in[i]), sharing the range reduction */
+	INLINE void SinCos(std::span<const float> in, std::span<float> sinOut, std::span<float> cosOut)noexcept
+	{
+		VerifyLessEqual(sinOut.size(), in.size(), "Trying to Batch::SinCos, but the output is bigger than the input.");
+		VerifyEqual(sinOut.size(), cosOut.size(), "Trying to Batch::SinCos, but the outputs have different sizes.");
+		Impl::Dispatch<void(*)(const float*, float*, float*, sizet)>(&Impl::SinCosScalar<float>, &Impl::SinCosSSE41<float>, &Impl::SinCosAVX2<float>, &Impl::SinCosAVX512<float>,
+			in.data(), sinOut.data(), cosOut.data(), sinOut.size());
+	}
+	INLINE void SinCos(std::span<const double> in, std::span<double> sinOut, std::span<double> cosOut)noexcept
+	{
+		VerifyLessEqual(sinOut.size(), in.size(), "Trying to Batch::SinCos, but the output is bigger than the input.");
+		VerifyEqual(sinOut.size(), cosOut.size(), "Trying to Batch::SinCos, but the outputs have different sizes.");
+		Impl::Dispatch<void(*)(const double*, double*, double*, sizet)>(&Impl::SinCosScalar<double>, &Impl::SinCosSSE41<double>, &Impl::SinCosAVX2<double>, &Impl::SinCosAVX512<double>,
+			in.data(), sinOut.data(), cosOut.data(), sinOut.size());
+	}
+	/* out[i] = e^in[i] */
+	INLINE void Exp(std::span<const float> in, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::Exp, but the output is bigger than the input.");
+		Impl::Dispatch<void(*)(const float*, float*, sizet)>(&Impl::ExpScalar, &Impl::ExpSSE41, &Impl::ExpAVX2, &Impl::ExpAVX512, in.data(), out.data(), out.size());
+	}
+	INLINE void Exp(std::span<const double> in, std::span<double> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::Exp, but the output is bigger than the input.");
+		Impl::Dispatch<void(*)(const double*, double*, sizet)>(&Impl::ExpScalar, &Impl::ExpSSE41, &Impl::ExpAVX2, &Impl::ExpAVX512, in.data(), out.data(), out.size());
+	}
+	/* out[i] = ln(in[i]) */
+	INLINE void LogN(std::span<const float> in, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::LogN, but the output is bigger than the input.");
+		Impl::Dispatch<void(*)(const float*, float*, sizet)>(&Impl::LogNScalar, &Impl::LogNSSE41, &Impl::LogNAVX2, &Impl::LogNAVX512, in.data(), out.data(), out.size());
+	}
+	INLINE void LogN(std::span<const double> in, std::span<double> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to Batch::LogN, but the output is bigger than the input.");
+		Impl::Dispatch<void(*)(const double*, double*, sizet)>(&Impl::LogNScalar, &Impl::LogNSSE41, &Impl::LogNAVX2, &Impl::LogNAVX512, in.data(), out.data(), out.size());
+	}
+	/* out[i] = atan2(y[i], x[i]) */
+	INLINE void ATan2(std::span<const float> y, std::span<const float> x, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), y.size(), "Trying to Batch::ATan2, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), x.size(), "Trying to Batch::ATan2, but the output is bigger than the inputs.");
+		Impl::Dispatch<void(*)(const float*, const float*, float*, sizet)>(&Impl::ATan2Scalar<float>, &Impl::ATan2SSE41<float>, &Impl::ATan2AVX2<float>, &Impl::ATan2AVX512<float>,
+			y.data(), x.data(), out.data(), out.size());
+	}
+	INLINE void ATan2(std::span<const double> y, std::span<const double> x, std::span<double> out)noexcept
+	{
+		VerifyLessEqual(out.size(), y.size(), "Trying to Batch::ATan2, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), x.size(), "Trying to Batch::ATan2, but the output is bigger than the inputs.");
+		Impl::Dispatch<void(*)(const double*, const double*, double*, sizet)>(&Impl::ATan2Scalar<double>, &Impl::ATan2SSE41<double>, &Impl::ATan2AVX2<double>, &Impl::ATan2AVX512<double>,
+			y.data(), x.data(), out.data(), out.size());
+	}
+}
+
+MATH_STRICT_FP_END
+
+#endif /* MATH_TRANSCENDENTAL_H */
\ No newline at end of file
@@ -0,0 +1,473 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_TRANSFORMBATCH_H
+#define MATH_TRANSFORMBATCH_H 1
+
+#include "Matrix4.h"
+#include "Quaternion.h"
+#include "Batch.h"
+
+MATH_STRICT_FP_BEGIN
+
+/* Transforms spans of vectors by a single matrix or quaternion kept in registers and multiplies arrays of matrices,
+ * the results match the scalar Matrix4f products and QuaternionF::Rotate. Streaming stores bypass the cache, use them when the output is too big to be read back soon. */
+namespace greaper::math::Batch
+{
+	namespace Impl
+	{
+		enum class TransformMode
+		{
+			Point,		// w = 1
+			Vector,		// w = 0
+			Project		// w = 1 followed by the perspective divide
+		};
+
+		template<TransformMode mode>
+		INLINE constexpr Vector3f TransformVector3(const Matrix4f& m, const Vector3f& v)noexcept
+		{
+			if constexpr (mode == TransformMode::Vector)
+			{
+				return {
+					m.R0.X * v.X + m.R0.Y * v.Y + m.R0.Z * v.Z,
+					m.R1.X * v.X + m.R1.Y * v.Y + m.R1.Z * v.Z,
+					m.R2.X * v.X + m.R2.Y * v.Y + m.R2.Z * v.Z
+				};
+			}
+			else
+			{
+				float x = m.R0.X * v.X + m.R0.Y * v.Y + m.R0.Z * v.Z + m.R0.W;
+				float y = m.R1.X * v.X + m.R1.Y * v.Y + m.R1.Z * v.Z + m.R1.W;
+				float z = m.R2.X * v.X + m.R2.Y * v.Y + m.R2.Z * v.Z + m.R2.W;
+				if constexpr (mode == TransformMode::Project)
+				{
+					float w = m.R3.X * v.X + m.R3.Y * v.Y + m.R3.Z * v.Z + m.R3.W;
+					return { x / w, y / w, z / w };
+				}
+				return { x, y, z };
+			}
+		}
+		template<TransformMode mode>
+		INLINE constexpr Vector4f TransformVector4(const Matrix4f& m, const Vector4f& v)noexcept
+		{
+			if constexpr (mode == TransformMode::Vector)
+			{
+				return {
+					m.R0.X * v.X + m.R0.Y * v.Y + m.R0.Z * v.Z,
+					m.R1.X * v.X + m.R1.Y * v.Y + m.R1.Z * v.Z,
+					m.R2.X * v.X + m.R2.Y * v.Y + m.R2.Z * v.Z,
+					m.R3.X * v.X + m.R3.Y * v.Y + m.R3.Z * v.Z
+				};
+			}
+			else
+			{
+				return m * v;
+			}
+		}
+
+		template<TransformMode mode>
+		INLINE void TransformVector3Scalar(const Matrix4f& m, const Vector3f* in, Vector3f* out, sizet count, UNUSED bool streaming)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = TransformVector3<mode>(m, in[i]);
+		}
+		template<TransformMode mode>
+		INLINE void TransformVector4Scalar(const Matrix4f& m, const Vector4f* in, Vector4f* out, sizet count, UNUSED bool streaming)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = TransformVector4<mode>(m, in[i]);
+		}
+
+		/* Vector3 spans are processed four at a time as X/Y/Z vectors, the 12 byte stride makes every group of four 16 byte aligned */
+		template<TransformMode mode>
+		MATH_TARGET_SSE41 inline void TransformVector3SSE41(const Matrix4f& m, const Vector3f* in, Vector3f* out, sizet count, bool streaming)noexcept
+		{
+			auto m00 = _mm_set1_ps(m.R0.X), m01 = _mm_set1_ps(m.R0.Y), m02 = _mm_set1_ps(m.R0.Z), m03 = _mm_set1_ps(m.R0.W);
+			auto m10 = _mm_set1_ps(m.R1.X), m11 = _mm_set1_ps(m.R1.Y), m12 = _mm_set1_ps(m.R1.Z), m13 = _mm_set1_ps(m.R1.W);
+			auto m20 = _mm_set1_ps(m.R2.X), m21 = _mm_set1_ps(m.R2.Y), m22 = _mm_set1_ps(m.R2.Z), m23 = _mm_set1_ps(m.R2.W);
+			auto m30 = _mm_set1_ps(m.R3.X), m31 = _mm_set1_ps(m.R3.Y), m32 = _mm_set1_ps(m.R3.Z), m33 = _mm_set1_ps(m.R3.W);
+
+			sizet i = 0;
+			if (streaming)
+			{
+				for (; i < count && (reinterpret_cast<uintptr_t>(out + i) & 15) != 0; ++i)
+					out[i] = TransformVector3<mode>(m, in[i]);
+			}
+			for (; i + 4 <= count; i += 4)
+			{
+				const float* src = &in[i].X;
+				SSE::Vector4f x, y, z;
+				SSE::Deinterleave3(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+
+				auto ox = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, x), _mm_mul_ps(m01, y)), _mm_mul_ps(m02, z));
+				auto oy = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, x), _mm_mul_ps(m11, y)), _mm_mul_ps(m12, z));
+				auto oz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, x), _mm_mul_ps(m21, y)), _mm_mul_ps(m22, z));
+				if constexpr (mode != TransformMode::Vector)
+				{
+					ox = _mm_add_ps(ox, m03);
+					oy = _mm_add_ps(oy, m13);
+					oz = _mm_add_ps(oz, m23);
+				}
+				if constexpr (mode == TransformMode::Project)
+				{
+					auto ow = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m30, x), _mm_mul_ps(m31, y)), _mm_mul_ps(m32, z)), m33);
+					ox = _mm_div_ps(ox, ow);
+					oy = _mm_div_ps(oy, ow);
+					oz = _mm_div_ps(oz, ow);
+				}
+
+				SSE::Vector4f a, b, c;
+				SSE::Interleave3(ox, oy, oz, a, b, c);
+				float* dst = &out[i].X;
+				if (streaming)
+				{
+					_mm_stream_ps(dst, a);
+					_mm_stream_ps(dst + 4, b);
+					_mm_stream_ps(dst + 8, c);
+				}
+				else
+				{
+					_mm_storeu_ps(dst, a);
+					_mm_storeu_ps(dst + 4, b);
+					_mm_storeu_ps(dst + 8, c);
+				}
+			}
+			if (streaming)
+				_mm_sfence();
+			TransformVector3Scalar<mode>(m, in + i, out + i, count - i, false);
+		}
+		template<TransformMode mode>
+		MATH_TARGET_AVX2 inline void TransformVector3AVX2(const Matrix4f& m, const Vector3f* in, Vector3f* out, sizet count, bool streaming)noexcept
+		{
+			auto m00 = _mm256_set1_ps(m.R0.X), m01 = _mm256_set1_ps(m.R0.Y), m02 = _mm256_set1_ps(m.R0.Z), m03 = _mm256_set1_ps(m.R0.W);
+			auto m10 = _mm256_set1_ps(m.R1.X), m11 = _mm256_set1_ps(m.R1.Y), m12 = _mm256_set1_ps(m.R1.Z), m13 = _mm256_set1_ps(m.R1.W);
+			auto m20 = _mm256_set1_ps(m.R2.X), m21 = _mm256_set1_ps(m.R2.Y), m22 = _mm256_set1_ps(m.R2.Z), m23 = _mm256_set1_ps(m.R2.W);
+			auto m30 = _mm256_set1_ps(m.R3.X), m31 = _mm256_set1_ps(m.R3.Y), m32 = _mm256_set1_ps(m.R3.Z), m33 = _mm256_set1_ps(m.R3.W);
+
+			sizet i = 0;
+			if (streaming)
+			{
+				for (; i < count && (reinterpret_cast<uintptr_t>(out + i) & 15) != 0; ++i)
+					out[i] = TransformVector3<mode>(m, in[i]);
+			}
+			for (; i + 8 <= count; i += 8)
+			{
+				const float* src = &in[i].X;
+				SSE::Vector4f x0, y0, z0, x1, y1, z1;
+				SSE::Deinterleave3(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x0, y0, z0);
+				SSE::Deinterleave3(_mm_loadu_ps(src + 12), _mm_loadu_ps(src + 16), _mm_loadu_ps(src + 20), x1, y1, z1);
+				auto x = _mm256_set_m128(x1, x0), y = _mm256_set_m128(y1, y0), z = _mm256_set_m128(z1, z0);
+
+				auto ox = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m00, x), _mm256_mul_ps(m01, y)), _mm256_mul_ps(m02, z));
+				auto oy = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m10, x), _mm256_mul_ps(m11, y)), _mm256_mul_ps(m12, z));
+				auto oz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m20, x), _mm256_mul_ps(m21, y)), _mm256_mul_ps(m22, z));
+				if constexpr (mode != TransformMode::Vector)
+				{
+					ox = _mm256_add_ps(ox, m03);
+					oy = _mm256_add_ps(oy, m13);
+					oz = _mm256_add_ps(oz, m23);
+				}
+				if constexpr (mode == TransformMode::Project)
+				{
+					auto ow = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(m30, x), _mm256_mul_ps(m31, y)), _mm256_mul_ps(m32, z)), m33);
+					ox = _mm256_div_ps(ox, ow);
+					oy = _mm256_div_ps(oy, ow);
+					oz = _mm256_div_ps(oz, ow);
+				}
+
+				SSE::Vector4f a0, b0, c0, a1, b1, c1;
+				SSE::Interleave3(_mm256_castps256_ps128(ox), _mm256_castps256_ps128(oy), _mm256_castps256_ps128(oz), a0, b0, c0);
+				SSE::Interleave3(_mm256_extractf128_ps(ox, 1), _mm256_extractf128_ps(oy, 1), _mm256_extractf128_ps(oz, 1), a1, b1, c1);
+				float* dst = &out[i].X;
+				if (streaming)
+				{
+					_mm_stream_ps(dst, a0);
+					_mm_stream_ps(dst + 4, b0);
+					_mm_stream_ps(dst + 8, c0);
+					_mm_stream_ps(dst + 12, a1);
+					_mm_stream_ps(dst + 16, b1);
+					_mm_stream_ps(dst + 20, c1);
+				}
+				else
+				{
+					_mm256_storeu_ps(dst, _mm256_set_m128(b0, a0));
+					_mm256_storeu_ps(dst + 8, _mm256_set_m128(a1, c0));
+					_mm256_storeu_ps(dst + 16, _mm256_set_m128(c1, b1));
+				}
+			}
+			if (streaming)
+				_mm_sfence();
+			TransformVector3SSE41<mode>(m, in + i, out + i, count - i, false);
+		}
+
+		/* Vector4 spans keep the matrix columns in registers and broadcast each component */
+		template<TransformMode mode>
+		MATH_TARGET_SSE41 inline void TransformVector4SSE41(const Matrix4f& m, const Vector4f* in, Vector4f* out, sizet count, bool streaming)noexcept
+		{
+			auto c0 = _mm_load_ps(&m.R0.X), c1 = _mm_load_ps(&m.R1.X), c2 = _mm_load_ps(&m.R2.X), c3 = _mm_load_ps(&m.R3.X);
+			SSE::Transpose(c0, c1, c2, c3);
+
+			for (sizet i = 0; i < count; ++i)
+			{
+				auto v = _mm_load_ps(&in[i].X);
+				auto r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(SSE::Swizzle<0, 0, 0, 0>(v), c0), _mm_mul_ps(SSE::Swizzle<1, 1, 1, 1>(v), c1)), _mm_mul_ps(SSE::Swizzle<2, 2, 2, 2>(v), c2));
+				if constexpr (mode != TransformMode::Vector)
+					r = _mm_add_ps(r, _mm_mul_ps(SSE::Swizzle<3, 3, 3, 3>(v), c3));
+				if (streaming)
+					_mm_stream_ps(&out[i].X, r);
+				else
+					_mm_store_ps(&out[i].X, r);
+			}
+			if (streaming)
+				_mm_sfence();
+		}
+		template<TransformMode mode>
+		MATH_TARGET_AVX2 inline void TransformVector4AVX2(const Matrix4f& m, const Vector4f* in, Vector4f* out, sizet count, bool streaming)noexcept
+		{
+			auto r0 = _mm_load_ps(&m.R0.X), r1 = _mm_load_ps(&m.R1.X), r2 = _mm_load_ps(&m.R2.X), r3 = _mm_load_ps(&m.R3.X);
+			SSE::Transpose(r0, r1, r2, r3);
+			auto c0 = _mm256_set_m128(r0, r0), c1 = _mm256_set_m128(r1, r1), c2 = _mm256_set_m128(r2, r2), c3 = _mm256_set_m128(r3, r3);
+
+			// Two vectors per register
+			sizet i = 0;
+			for (; i + 2 <= count; i += 2)
+			{
+				auto v = _mm256_loadu_ps(&in[i].X);
+				auto r = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_permute_ps(v, 0x00), c0), _mm256_mul_ps(_mm256_permute_ps(v, 0x55), c1)), _mm256_mul_ps(_mm256_permute_ps(v, 0xAA), c2));
+				if constexpr (mode != TransformMode::Vector)
+					r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(v, 0xFF), c3));
+				if (streaming)
+				{
+					_mm_stream_ps(&out[i].X, _mm256_castps256_ps128(r));
+					_mm_stream_ps(&out[i + 1].X, _mm256_extractf128_ps(r, 1));
+				}
+				else
+				{
+					_mm256_storeu_ps(&out[i].X, r);
+				}
+			}
+			if (streaming)
+				_mm_sfence();
+			TransformVector4SSE41<mode>(m, in + i, out + i, count - i, false);
+		}
+
+		/* Matrix products, a stride of zero reuses the same matrix for every product */
+		/* row * M spelled out inside the strict region, same order as SSE::Matrix4MulRow */
+		INLINE constexpr Vector4f MultiplyRowScalar(const Vector4f& row, const Matrix4f& m)noexcept
+		{
+			return {
+				row.X * m.R0.X + row.Y * m.R1.X + row.Z * m.R2.X + row.W * m.R3.X,
+				row.X * m.R0.Y + row.Y * m.R1.Y + row.Z * m.R2.Y + row.W * m.R3.Y,
+				row.X * m.R0.Z + row.Y * m.R1.Z + row.Z * m.R2.Z + row.W * m.R3.Z,
+				row.X * m.R0.W + row.Y * m.R1.W + row.Z * m.R2.W + row.W * m.R3.W
+			};
+		}
+		INLINE void MultiplyScalar(const Matrix4f* left, sizet leftStride, const Matrix4f* right, sizet rightStride, Matrix4f* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+			{
+				const Matrix4f& l = left[i * leftStride];
+				const Matrix4f& r = right[i * rightStride];
+				Vector4f o0 = MultiplyRowScalar(l.R0, r), o1 = MultiplyRowScalar(l.R1, r), o2 = MultiplyRowScalar(l.R2, r), o3 = MultiplyRowScalar(l.R3, r);
+				out[i].R0 = o0;
+				out[i].R1 = o1;
+				out[i].R2 = o2;
+				out[i].R3 = o3;
+			}
+		}
+		MATH_TARGET_SSE41 inline void MultiplySSE41(const Matrix4f* left, sizet leftStride, const Matrix4f* right, sizet rightStride, Matrix4f* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+			{
+				const Matrix4f& l = left[i * leftStride];
+				const Matrix4f& r = right[i * rightStride];
+				auto r0 = _mm_load_ps(&r.R0.X), r1 = _mm_load_ps(&r.R1.X), r2 = _mm_load_ps(&r.R2.X), r3 = _mm_load_ps(&r.R3.X);
+				auto o0 = SSE::Matrix4MulRow(_mm_load_ps(&l.R0.X), r0, r1, r2, r3);
+				auto o1 = SSE::Matrix4MulRow(_mm_load_ps(&l.R1.X), r0, r1, r2, r3);
+				auto o2 = SSE::Matrix4MulRow(_mm_load_ps(&l.R2.X), r0, r1, r2, r3);
+				auto o3 = SSE::Matrix4MulRow(_mm_load_ps(&l.R3.X), r0, r1, r2, r3);
+				_mm_store_ps(&out[i].R0.X, o0);
+				_mm_store_ps(&out[i].R1.X, o1);
+				_mm_store_ps(&out[i].R2.X, o2);
+				_mm_store_ps(&out[i].R3.X, o3);
+			}
+		}
+		/* Same row of two matrices, the first one in the low 128 bits */
+		MATH_TARGET_AVX2 INLINE AVX::Vector8f LoadRowPair(const Vector4f& a, const Vector4f& b)noexcept
+		{
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_load_ps(&a.X)), _mm_load_ps(&b.X), 1);
+		}
+		/* Row times matrix for two products at once, same summation order as Matrix4MulRow */
+		MATH_TARGET_AVX2 INLINE AVX::Vector8f Matrix4MulRowPair(AVX::Vector8f row, AVX::Vector8f r0, AVX::Vector8f r1, AVX::Vector8f r2, AVX::Vector8f r3)noexcept
+		{
+			auto o = _mm256_mul_ps(_mm256_permute_ps(row, 0x00), r0);
+			o = _mm256_add_ps(o, _mm256_mul_ps(_mm256_permute_ps(row, 0x55), r1));
+			o = _mm256_add_ps(o, _mm256_mul_ps(_mm256_permute_ps(row, 0xAA), r2));
+			return _mm256_add_ps(o, _mm256_mul_ps(_mm256_permute_ps(row, 0xFF), r3));
+		}
+		MATH_TARGET_AVX2 inline void MultiplyAVX2(const Matrix4f* left, sizet leftStride, const Matrix4f* right, sizet rightStride, Matrix4f* out, sizet count)noexcept
+		{
+			// Two products per pass, each 256 bit register holds the same row of both matrices
+			sizet i = 0;
+			for (; i + 2 <= count; i += 2)
+			{
+				const Matrix4f& la = left[i * leftStride];
+				const Matrix4f& lb = left[(i + 1) * leftStride];
+				const Matrix4f& ra = right[i * rightStride];
+				const Matrix4f& rb = right[(i + 1) * rightStride];
+				auto r0 = LoadRowPair(ra.R0, rb.R0), r1 = LoadRowPair(ra.R1, rb.R1), r2 = LoadRowPair(ra.R2, rb.R2), r3 = LoadRowPair(ra.R3, rb.R3);
+				auto o0 = Matrix4MulRowPair(LoadRowPair(la.R0, lb.R0), r0, r1, r2, r3);
+				auto o1 = Matrix4MulRowPair(LoadRowPair(la.R1, lb.R1), r0, r1, r2, r3);
+				auto o2 = Matrix4MulRowPair(LoadRowPair(la.R2, lb.R2), r0, r1, r2, r3);
+				auto o3 = Matrix4MulRowPair(LoadRowPair(la.R3, lb.R3), r0, r1, r2, r3);
+				_mm_store_ps(&out[i].R0.X, _mm256_castps256_ps128(o0));
+				_mm_store_ps(&out[i].R1.X, _mm256_castps256_ps128(o1));
+				_mm_store_ps(&out[i].R2.X, _mm256_castps256_ps128(o2));
+				_mm_store_ps(&out[i].R3.X, _mm256_castps256_ps128(o3));
+				_mm_store_ps(&out[i + 1].R0.X, _mm256_extractf128_ps(o0, 1));
+				_mm_store_ps(&out[i + 1].R1.X, _mm256_extractf128_ps(o1, 1));
+				_mm_store_ps(&out[i + 1].R2.X, _mm256_extractf128_ps(o2, 1));
+				_mm_store_ps(&out[i + 1].R3.X, _mm256_extractf128_ps(o3, 1));
+			}
+			MultiplySSE41(left + i * leftStride, leftStride, right + i * rightStride, rightStride, out + i, count - i);
+		}
+
+		INLINE void RotateScalar(const QuaternionF& q, const Vector3f* in, Vector3f* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = q.Rotate(in[i]);
+		}
+		/* Same operation order as QuaternionReal::Rotate, four vectors per pass */
+		MATH_TARGET_SSE41 inline void RotateSSE41(const QuaternionF& q, const Vector3f* in, Vector3f* out, sizet count)noexcept
+		{
+			auto qw = _mm_set1_ps(q.W), qx = _mm_set1_ps(q.X), qy = _mm_set1_ps(q.Y), qz = _mm_set1_ps(q.Z);
+			auto two = _mm_set1_ps(2.f);
+
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				const float* src = &in[i].X;
+				SSE::Vector4f x, y, z;
+				SSE::Deinterleave3(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+
+				auto tx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y)));
+				auto ty = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z)));
+				auto tz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x)));
+				auto ox = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(qw, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+				auto oy = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(qw, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+				auto oz = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(qw, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+
+				SSE::Vector4f a, b, c;
+				SSE::Interleave3(ox, oy, oz, a, b, c);
+				float* dst = &out[i].X;
+				_mm_storeu_ps(dst, a);
+				_mm_storeu_ps(dst + 4, b);
+				_mm_storeu_ps(dst + 8, c);
+			}
+			RotateScalar(q, in + i, out + i, count - i);
+		}
+		MATH_TARGET_AVX2 inline void RotateAVX2(const QuaternionF& q, const Vector3f* in, Vector3f* out, sizet count)noexcept
+		{
+			auto qw = _mm256_set1_ps(q.W), qx = _mm256_set1_ps(q.X), qy = _mm256_set1_ps(q.Y), qz = _mm256_set1_ps(q.Z);
+			auto two = _mm256_set1_ps(2.f);
+
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				const float* src = &in[i].X;
+				SSE::Vector4f x0, y0, z0, x1, y1, z1;
+				SSE::Deinterleave3(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x0, y0, z0);
+				SSE::Deinterleave3(_mm_loadu_ps(src + 12), _mm_loadu_ps(src + 16), _mm_loadu_ps(src + 20), x1, y1, z1);
+				auto x = _mm256_set_m128(x1, x0), y = _mm256_set_m128(y1, y0), z = _mm256_set_m128(z1, z0);
+
+				auto tx = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(qy, z), _mm256_mul_ps(qz, y)));
+				auto ty = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(qz, x), _mm256_mul_ps(qx, z)));
+				auto tz = _mm256_mul_ps(two, _mm256_sub_ps(_mm256_mul_ps(qx, y), _mm256_mul_ps(qy, x)));
+				auto ox = _mm256_add_ps(_mm256_add_ps(x, _mm256_mul_ps(qw, tx)), _mm256_sub_ps(_mm256_mul_ps(qy, tz), _mm256_mul_ps(qz, ty)));
+				auto oy = _mm256_add_ps(_mm256_add_ps(y, _mm256_mul_ps(qw, ty)), _mm256_sub_ps(_mm256_mul_ps(qz, tx), _mm256_mul_ps(qx, tz)));
+				auto oz = _mm256_add_ps(_mm256_add_ps(z, _mm256_mul_ps(qw, tz)), _mm256_sub_ps(_mm256_mul_ps(qx, ty), _mm256_mul_ps(qy, tx)));
+
+				SSE::Vector4f a0, b0, c0, a1, b1, c1;
+				SSE::Interleave3(_mm256_castps256_ps128(ox), _mm256_castps256_ps128(oy), _mm256_castps256_ps128(oz), a0, b0, c0);
+				SSE::Interleave3(_mm256_extractf128_ps(ox, 1), _mm256_extractf128_ps(oy, 1), _mm256_extractf128_ps(oz, 1), a1, b1, c1);
+				float* dst = &out[i].X;
+				_mm256_storeu_ps(dst, _mm256_set_m128(b0, a0));
+				_mm256_storeu_ps(dst + 8, _mm256_set_m128(a1, c0));
+				_mm256_storeu_ps(dst + 16, _mm256_set_m128(c1, b1));
+			}
+			RotateSSE41(q, in + i, out + i, count - i);
+		}
+
+		template<TransformMode mode>
+		INLINE void TransformVector3(const Matrix4f& m, std::span<const Vector3f> in, std::span<Vector3f> out, bool streaming)noexcept
+		{
+			VerifyLessEqual(out.size(), in.size(), "Trying to transform a batch of Vector3, but the output is bigger than the input.");
+			Dispatch(&TransformVector3Scalar<mode>, &TransformVector3SSE41<mode>, &TransformVector3AVX2<mode>, &TransformVector3AVX2<mode>, m, in.data(), out.data(), out.size(), streaming);
+		}
+		template<TransformMode mode>
+		INLINE void TransformVector4(const Matrix4f& m, std::span<const Vector4f> in, std::span<Vector4f> out, bool streaming)noexcept
+		{
+			VerifyLessEqual(out.size(), in.size(), "Trying to transform a batch of Vector4, but the output is bigger than the input.");
+			Dispatch(&TransformVector4Scalar<mode>, &TransformVector4SSE41<mode>, &TransformVector4AVX2<mode>, &TransformVector4AVX2<mode>, m, in.data(), out.data(), out.size(), streaming);
+		}
+	}
+
+	/* out[i] = m * (in[i], 1) */
+	INLINE void TransformPoints(const Matrix4f& m, std::span<const Vector3f> in, std::span<Vector3f> out, bool streaming = false)noexcept
+	{
+		Impl::TransformVector3<Impl::TransformMode::Point>(m, in, out, streaming);
+	}
+	/* out[i] = m * in[i] */
+	INLINE void TransformPoints(const Matrix4f& m, std::span<const Vector4f> in, std::span<Vector4f> out, bool streaming = false)noexcept
+	{
+		Impl::TransformVector4<Impl::TransformMode::Point>(m, in, out, streaming);
+	}
+	/* out[i] = m * (in[i], 0) */
+	INLINE void TransformVectors(const Matrix4f& m, std::span<const Vector3f> in, std::span<Vector3f> out, bool streaming = false)noexcept
+	{
+		Impl::TransformVector3<Impl::TransformMode::Vector>(m, in, out, streaming);
+	}
+	/* out[i] = m * (in[i].XYZ, 0), the W of the input is ignored */
+	INLINE void TransformVectors(const Matrix4f& m, std::span<const Vector4f> in, std::span<Vector4f> out, bool streaming = false)noexcept
+	{
+		Impl::TransformVector4<Impl::TransformMode::Vector>(m, in, out, streaming);
+	}
+	/* out[i] = (m * (in[i], 1)).XYZ / W */
+	INLINE void TransformPointsProject(const Matrix4f& m, std::span<const Vector3f> in, std::span<Vector3f> out, bool streaming = false)noexcept
+	{
+		Impl::TransformVector3<Impl::TransformMode::Project>(m, in, out, streaming);
+	}
+	/* out[i] = left[i] * right[i], out may be either input */
+	INLINE void Multiply(std::span<const Matrix4f> left, std::span<const Matrix4f> right, std::span<Matrix4f> out)noexcept
+	{
+		VerifyLessEqual(out.size(), left.size(), "Trying to multiply a batch of Matrix4, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), right.size(), "Trying to multiply a batch of Matrix4, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::MultiplyScalar, &Impl::MultiplySSE41, &Impl::MultiplyAVX2, &Impl::MultiplyAVX2, left.data(), sizet(1), right.data(), sizet(1), out.data(), out.size());
+	}
+	/* out[i] = left * right[i], out may be right */
+	INLINE void Multiply(const Matrix4f& left, std::span<const Matrix4f> right, std::span<Matrix4f> out)noexcept
+	{
+		VerifyLessEqual(out.size(), right.size(), "Trying to multiply a batch of Matrix4, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::MultiplyScalar, &Impl::MultiplySSE41, &Impl::MultiplyAVX2, &Impl::MultiplyAVX2, &left, sizet(0), right.data(), sizet(1), out.data(), out.size());
+	}
+	/* out[i] = left[i] * right, out may be left */
+	INLINE void Multiply(std::span<const Matrix4f> left, const Matrix4f& right, std::span<Matrix4f> out)noexcept
+	{
+		VerifyLessEqual(out.size(), left.size(), "Trying to multiply a batch of Matrix4, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::MultiplyScalar, &Impl::MultiplySSE41, &Impl::MultiplyAVX2, &Impl::MultiplyAVX2, left.data(), sizet(1), &right, sizet(0), out.data(), out.size());
+	}
+	/* out[i] = q.Rotate(in[i]), q must be unit length and out may be in */
+	INLINE void Rotate(const QuaternionF& q, std::span<const Vector3f> in, std::span<Vector3f> out)noexcept
+	{
+		VerifyLessEqual(out.size(), in.size(), "Trying to rotate a batch of Vector3, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::RotateScalar, &Impl::RotateSSE41, &Impl::RotateAVX2, &Impl::RotateAVX2, q, in.data(), out.data(), out.size());
+	}
+}
+
+MATH_STRICT_FP_END
+
+#endif /* MATH_TRANSFORMBATCH_H */
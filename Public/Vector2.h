@@ -12,5 +12,6 @@
 #include "Base/Vector2Signed.inl"
 #include "Base/Vector2Unsigned.inl"
 #include "Base/Vector2b.inl"
+#include "Base/Vector2Half.inl"
 
 #endif /* MATH_VECTOR2_H */
\ No newline at end of file
@@ -12,5 +12,6 @@
 #include "Base/Vector3Signed.inl"
 #include "Base/Vector3Unsigned.inl"
 #include "Base/Vector3b.inl"
+#include "Base/Vector3Half.inl"
 
 #endif /* MATH_VECTOR3_H */
\ No newline at end of file
@@ -0,0 +1,423 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_VECTOR3SOA_H
+#define MATH_VECTOR3SOA_H 1
+
+#include "Vector3.h"
+#include "Batch.h"
+#include "Base/SoAStorage.h"
+
+namespace greaper::math
+{
+	/* Non owning view over three X/Y/Z streams of the same length, T can be const */
+	template<class T>
+	struct Vector3SoAView
+	{
+		using value_type = std::remove_const_t<T>;
+		static_assert(std::is_floating_point_v<value_type>, "Vector3SoAView can only work with float, double or long double types");
+
+		T* X = nullptr;
+		T* Y = nullptr;
+		T* Z = nullptr;
+		sizet Count = 0;
+
+		constexpr Vector3SoAView()noexcept = default;
+		INLINE constexpr Vector3SoAView(T* x, T* y, T* z, sizet count)noexcept :X(x), Y(y), Z(z), Count(count) {  }
+		template<class U, class = std::enable_if_t<std::is_same_v<const U, T>>>
+		INLINE constexpr Vector3SoAView(const Vector3SoAView<U>& other)noexcept :X(other.X), Y(other.Y), Z(other.Z), Count(other.Count) {  }
+
+		NODISCARD INLINE constexpr sizet Size()const noexcept { return Count; }
+		NODISCARD INLINE constexpr bool IsEmpty()const noexcept { return Count == 0; }
+		NODISCARD INLINE constexpr Vector3Real<value_type> Get(sizet index)const noexcept
+		{
+			VerifyLess(index, Count, "Trying to access a Vector3SoAView, but the index %" PRIuPTR " was out of range.", index);
+			return { X[index], Y[index], Z[index] };
+		}
+		INLINE constexpr void Set(sizet index, const Vector3Real<value_type>& v)const noexcept
+		{
+			static_assert(!std::is_const_v<T>, "Trying to write through a const Vector3SoAView.");
+			VerifyLess(index, Count, "Trying to access a Vector3SoAView, but the index %" PRIuPTR " was out of range.", index);
+			X[index] = v.X;
+			Y[index] = v.Y;
+			Z[index] = v.Z;
+		}
+		NODISCARD INLINE constexpr Vector3SoAView Subview(sizet offset, sizet count)const noexcept
+		{
+			VerifyLessEqual(offset + count, Count, "Trying to get a Vector3SoAView subview, but the range was out of bounds.");
+			return { X + offset, Y + offset, Z + offset, count };
+		}
+		/* Copies the AoS vectors into the streams */
+		INLINE constexpr void Gather(std::span<const Vector3Real<value_type>> src)const noexcept
+		{
+			static_assert(!std::is_const_v<T>, "Trying to write through a const Vector3SoAView.");
+			VerifyLessEqual(src.size(), Count, "Trying to gather into a Vector3SoAView, but the source is bigger than the view.");
+			for (sizet i = 0; i < src.size(); ++i)
+			{
+				X[i] = src[i].X;
+				Y[i] = src[i].Y;
+				Z[i] = src[i].Z;
+			}
+		}
+		/* Copies the streams into the AoS vectors */
+		INLINE constexpr void Scatter(std::span<Vector3Real<value_type>> dst)const noexcept
+		{
+			VerifyLessEqual(dst.size(), Count, "Trying to scatter from a Vector3SoAView, but the destination is bigger than the view.");
+			for (sizet i = 0; i < dst.size(); ++i)
+			{
+				dst[i].X = X[i];
+				dst[i].Y = Y[i];
+				dst[i].Z = Z[i];
+			}
+		}
+	};
+
+	/* Owning structure of arrays Vector3 container over three X/Y/Z streams of one SoAStorage */
+	template<class T>
+	class Vector3SoA : public SoAStorage<T, 3>
+	{
+		using Storage = SoAStorage<T, 3>;
+
+	public:
+		using value_type = T;
+
+		constexpr Vector3SoA()noexcept = default;
+		INLINE explicit Vector3SoA(sizet size) :Storage(size) {  }
+		INLINE explicit Vector3SoA(std::span<const Vector3Real<T>> vectors)
+			:Storage(vectors.size())
+		{
+			GetView().Gather(vectors);
+		}
+
+		NODISCARD INLINE std::span<T> GetX()noexcept { return { this->GetStream(0), this->Size() }; }
+		NODISCARD INLINE std::span<T> GetY()noexcept { return { this->GetStream(1), this->Size() }; }
+		NODISCARD INLINE std::span<T> GetZ()noexcept { return { this->GetStream(2), this->Size() }; }
+		NODISCARD INLINE std::span<const T> GetX()const noexcept { return { this->GetStream(0), this->Size() }; }
+		NODISCARD INLINE std::span<const T> GetY()const noexcept { return { this->GetStream(1), this->Size() }; }
+		NODISCARD INLINE std::span<const T> GetZ()const noexcept { return { this->GetStream(2), this->Size() }; }
+
+		NODISCARD INLINE Vector3SoAView<T> GetView()noexcept { return { this->GetStream(0), this->GetStream(1), this->GetStream(2), this->Size() }; }
+		NODISCARD INLINE Vector3SoAView<const T> GetView()const noexcept { return { this->GetStream(0), this->GetStream(1), this->GetStream(2), this->Size() }; }
+		NODISCARD INLINE operator Vector3SoAView<T>()noexcept { return GetView(); }
+		NODISCARD INLINE operator Vector3SoAView<const T>()const noexcept { return GetView(); }
+
+		NODISCARD INLINE Vector3Real<T> Get(sizet index)const noexcept { return GetView().Get(index); }
+		INLINE void Set(sizet index, const Vector3Real<T>& v)noexcept { GetView().Set(index, v); }
+
+		INLINE void PushBack(const Vector3Real<T>& v)
+		{
+			const sizet index = this->Append();
+			Set(index, v);
+		}
+	};
+}
+
+MATH_STRICT_FP_BEGIN
+
+/* Batched kernels, they compute exactly what the Vector3Real function of the same name does per element */
+namespace greaper::math::Batch
+{
+	namespace Impl
+	{
+		template<class T>
+		INLINE void DotProductScalar(Vector3SoAView<const T> a, Vector3SoAView<const T> b, T* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = a.X[i] * b.X[i] + a.Y[i] * b.Y[i] + a.Z[i] * b.Z[i];
+		}
+		MATH_TARGET_SSE41 inline void DotProductSSE41(Vector3SoAView<const float> a, Vector3SoAView<const float> b, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				auto d = _mm_mul_ps(_mm_loadu_ps(a.X + i), _mm_loadu_ps(b.X + i));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(a.Y + i), _mm_loadu_ps(b.Y + i)));
+				d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(a.Z + i), _mm_loadu_ps(b.Z + i)));
+				_mm_storeu_ps(out + i, d);
+			}
+			DotProductScalar<float>(a.Subview(i, count - i), b.Subview(i, count - i), out + i, count - i);
+		}
+		MATH_TARGET_AVX2 inline void DotProductAVX2(Vector3SoAView<const float> a, Vector3SoAView<const float> b, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				auto d = _mm256_mul_ps(_mm256_loadu_ps(a.X + i), _mm256_loadu_ps(b.X + i));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(a.Y + i), _mm256_loadu_ps(b.Y + i)));
+				d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_loadu_ps(a.Z + i), _mm256_loadu_ps(b.Z + i)));
+				_mm256_storeu_ps(out + i, d);
+			}
+			DotProductSSE41(a.Subview(i, count - i), b.Subview(i, count - i), out + i, count - i);
+		}
+
+		template<class T>
+		INLINE void LengthScalar(Vector3SoAView<const T> a, T* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+				out[i] = math::Sqrt(a.X[i] * a.X[i] + a.Y[i] * a.Y[i] + a.Z[i] * a.Z[i]);
+		}
+		MATH_TARGET_SSE41 inline void LengthSSE41(Vector3SoAView<const float> a, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				auto x = _mm_loadu_ps(a.X + i), y = _mm_loadu_ps(a.Y + i), z = _mm_loadu_ps(a.Z + i);
+				auto d = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+				_mm_storeu_ps(out + i, _mm_sqrt_ps(d));
+			}
+			LengthScalar<float>(a.Subview(i, count - i), out + i, count - i);
+		}
+		MATH_TARGET_AVX2 inline void LengthAVX2(Vector3SoAView<const float> a, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				auto x = _mm256_loadu_ps(a.X + i), y = _mm256_loadu_ps(a.Y + i), z = _mm256_loadu_ps(a.Z + i);
+				auto d = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+				_mm256_storeu_ps(out + i, _mm256_sqrt_ps(d));
+			}
+			LengthSSE41(a.Subview(i, count - i), out + i, count - i);
+		}
+
+		template<class T>
+		INLINE void DistSquaredScalar(Vector3SoAView<const T> a, Vector3SoAView<const T> b, T* out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+			{
+				T dx = a.X[i] - b.X[i], dy = a.Y[i] - b.Y[i], dz = a.Z[i] - b.Z[i];
+				out[i] = dx * dx + dy * dy + dz * dz;
+			}
+		}
+		MATH_TARGET_SSE41 inline void DistSquaredSSE41(Vector3SoAView<const float> a, Vector3SoAView<const float> b, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				auto dx = _mm_sub_ps(_mm_loadu_ps(a.X + i), _mm_loadu_ps(b.X + i));
+				auto dy = _mm_sub_ps(_mm_loadu_ps(a.Y + i), _mm_loadu_ps(b.Y + i));
+				auto dz = _mm_sub_ps(_mm_loadu_ps(a.Z + i), _mm_loadu_ps(b.Z + i));
+				_mm_storeu_ps(out + i, _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+			}
+			DistSquaredScalar<float>(a.Subview(i, count - i), b.Subview(i, count - i), out + i, count - i);
+		}
+		MATH_TARGET_AVX2 inline void DistSquaredAVX2(Vector3SoAView<const float> a, Vector3SoAView<const float> b, float* out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				auto dx = _mm256_sub_ps(_mm256_loadu_ps(a.X + i), _mm256_loadu_ps(b.X + i));
+				auto dy = _mm256_sub_ps(_mm256_loadu_ps(a.Y + i), _mm256_loadu_ps(b.Y + i));
+				auto dz = _mm256_sub_ps(_mm256_loadu_ps(a.Z + i), _mm256_loadu_ps(b.Z + i));
+				_mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz)));
+			}
+			DistSquaredSSE41(a.Subview(i, count - i), b.Subview(i, count - i), out + i, count - i);
+		}
+
+		template<class T>
+		INLINE void CrossProductScalar(Vector3SoAView<const T> a, Vector3SoAView<const T> b, Vector3SoAView<T> out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+			{
+				T ax = a.X[i], ay = a.Y[i], az = a.Z[i];
+				T bx = b.X[i], by = b.Y[i], bz = b.Z[i];
+				out.X[i] = ay * bz - az * by;
+				out.Y[i] = az * bx - ax * bz;
+				out.Z[i] = ax * by - ay * bx;
+			}
+		}
+		MATH_TARGET_SSE41 inline void CrossProductSSE41(Vector3SoAView<const float> a, Vector3SoAView<const float> b, Vector3SoAView<float> out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				auto ax = _mm_loadu_ps(a.X + i), ay = _mm_loadu_ps(a.Y + i), az = _mm_loadu_ps(a.Z + i);
+				auto bx = _mm_loadu_ps(b.X + i), by = _mm_loadu_ps(b.Y + i), bz = _mm_loadu_ps(b.Z + i);
+				_mm_storeu_ps(out.X + i, _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by)));
+				_mm_storeu_ps(out.Y + i, _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz)));
+				_mm_storeu_ps(out.Z + i, _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx)));
+			}
+			CrossProductScalar<float>(a.Subview(i, count - i), b.Subview(i, count - i), out.Subview(i, count - i), count - i);
+		}
+		MATH_TARGET_AVX2 inline void CrossProductAVX2(Vector3SoAView<const float> a, Vector3SoAView<const float> b, Vector3SoAView<float> out, sizet count)noexcept
+		{
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				auto ax = _mm256_loadu_ps(a.X + i), ay = _mm256_loadu_ps(a.Y + i), az = _mm256_loadu_ps(a.Z + i);
+				auto bx = _mm256_loadu_ps(b.X + i), by = _mm256_loadu_ps(b.Y + i), bz = _mm256_loadu_ps(b.Z + i);
+				_mm256_storeu_ps(out.X + i, _mm256_sub_ps(_mm256_mul_ps(ay, bz), _mm256_mul_ps(az, by)));
+				_mm256_storeu_ps(out.Y + i, _mm256_sub_ps(_mm256_mul_ps(az, bx), _mm256_mul_ps(ax, bz)));
+				_mm256_storeu_ps(out.Z + i, _mm256_sub_ps(_mm256_mul_ps(ax, by), _mm256_mul_ps(ay, bx)));
+			}
+			CrossProductSSE41(a.Subview(i, count - i), b.Subview(i, count - i), out.Subview(i, count - i), count - i);
+		}
+
+		/* Vectors whose squared length is not above the tolerance are copied unchanged */
+		template<class T>
+		INLINE void GetNormalizedScalar(Vector3SoAView<const T> a, Vector3SoAView<T> out, sizet count, T tolerance)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+			{
+				T x = a.X[i], y = a.Y[i], z = a.Z[i];
+				T len = x * x + y * y + z * z;
+				if (len > tolerance)
+				{
+					T invScale = InvSqrt(len);
+					x *= invScale;
+					y *= invScale;
+					z *= invScale;
+				}
+				out.X[i] = x;
+				out.Y[i] = y;
+				out.Z[i] = z;
+			}
+		}
+		MATH_TARGET_SSE41 inline void GetNormalizedSSE41(Vector3SoAView<const float> a, Vector3SoAView<float> out, sizet count, float tolerance)noexcept
+		{
+			auto one = _mm_set1_ps(1.f);
+			auto tol = _mm_set1_ps(tolerance);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				auto x = _mm_loadu_ps(a.X + i), y = _mm_loadu_ps(a.Y + i), z = _mm_loadu_ps(a.Z + i);
+				auto len = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+				auto invScale = _mm_blendv_ps(one, _mm_div_ps(one, _mm_sqrt_ps(len)), _mm_cmpgt_ps(len, tol));
+				_mm_storeu_ps(out.X + i, _mm_mul_ps(x, invScale));
+				_mm_storeu_ps(out.Y + i, _mm_mul_ps(y, invScale));
+				_mm_storeu_ps(out.Z + i, _mm_mul_ps(z, invScale));
+			}
+			GetNormalizedScalar<float>(a.Subview(i, count - i), out.Subview(i, count - i), count - i, tolerance);
+		}
+		MATH_TARGET_AVX2 inline void GetNormalizedAVX2(Vector3SoAView<const float> a, Vector3SoAView<float> out, sizet count, float tolerance)noexcept
+		{
+			auto one = _mm256_set1_ps(1.f);
+			auto tol = _mm256_set1_ps(tolerance);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				auto x = _mm256_loadu_ps(a.X + i), y = _mm256_loadu_ps(a.Y + i), z = _mm256_loadu_ps(a.Z + i);
+				auto len = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y)), _mm256_mul_ps(z, z));
+				auto invScale = _mm256_blendv_ps(one, _mm256_div_ps(one, _mm256_sqrt_ps(len)), _mm256_cmp_ps(len, tol, _CMP_GT_OQ));
+				_mm256_storeu_ps(out.X + i, _mm256_mul_ps(x, invScale));
+				_mm256_storeu_ps(out.Y + i, _mm256_mul_ps(y, invScale));
+				_mm256_storeu_ps(out.Z + i, _mm256_mul_ps(z, invScale));
+			}
+			GetNormalizedSSE41(a.Subview(i, count - i), out.Subview(i, count - i), count - i, tolerance);
+		}
+
+		template<class T>
+		INLINE void LerpScalar(Vector3SoAView<const T> a, Vector3SoAView<const T> b, T t, Vector3SoAView<T> out, sizet count)noexcept
+		{
+			for (sizet i = 0; i < count; ++i)
+			{
+				out.X[i] = a.X[i] + (b.X[i] - a.X[i]) * t;
+				out.Y[i] = a.Y[i] + (b.Y[i] - a.Y[i]) * t;
+				out.Z[i] = a.Z[i] + (b.Z[i] - a.Z[i]) * t;
+			}
+		}
+		MATH_TARGET_SSE41 inline void LerpSSE41(Vector3SoAView<const float> a, Vector3SoAView<const float> b, float t, Vector3SoAView<float> out, sizet count)noexcept
+		{
+			auto vt = _mm_set1_ps(t);
+			sizet i = 0;
+			for (; i + 4 <= count; i += 4)
+			{
+				auto ax = _mm_loadu_ps(a.X + i), ay = _mm_loadu_ps(a.Y + i), az = _mm_loadu_ps(a.Z + i);
+				_mm_storeu_ps(out.X + i, _mm_add_ps(ax, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b.X + i), ax), vt)));
+				_mm_storeu_ps(out.Y + i, _mm_add_ps(ay, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b.Y + i), ay), vt)));
+				_mm_storeu_ps(out.Z + i, _mm_add_ps(az, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(b.Z + i), az), vt)));
+			}
+			LerpScalar<float>(a.Subview(i, count - i), b.Subview(i, count - i), t, out.Subview(i, count - i), count - i);
+		}
+		MATH_TARGET_AVX2 inline void LerpAVX2(Vector3SoAView<const float> a, Vector3SoAView<const float> b, float t, Vector3SoAView<float> out, sizet count)noexcept
+		{
+			auto vt = _mm256_set1_ps(t);
+			sizet i = 0;
+			for (; i + 8 <= count; i += 8)
+			{
+				auto ax = _mm256_loadu_ps(a.X + i), ay = _mm256_loadu_ps(a.Y + i), az = _mm256_loadu_ps(a.Z + i);
+				_mm256_storeu_ps(out.X + i, _mm256_add_ps(ax, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b.X + i), ax), vt)));
+				_mm256_storeu_ps(out.Y + i, _mm256_add_ps(ay, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b.Y + i), ay), vt)));
+				_mm256_storeu_ps(out.Z + i, _mm256_add_ps(az, _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(b.Z + i), az), vt)));
+			}
+			LerpSSE41(a.Subview(i, count - i), b.Subview(i, count - i), t, out.Subview(i, count - i), count - i);
+		}
+	}
+
+	/* float uses 4 or 8 lanes depending on the CPU, AVX-512 machines take the AVX2 kernels. double loops are left to the compiler. */
+	INLINE void DotProduct(Vector3SoAView<const float> a, Vector3SoAView<const float> b, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.Size(), "Trying to Batch::DotProduct, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.Size(), "Trying to Batch::DotProduct, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::DotProductScalar<float>, &Impl::DotProductSSE41, &Impl::DotProductAVX2, &Impl::DotProductAVX2, a, b, out.data(), out.size());
+	}
+	INLINE void DotProduct(Vector3SoAView<const double> a, Vector3SoAView<const double> b, std::span<double> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.Size(), "Trying to Batch::DotProduct, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.Size(), "Trying to Batch::DotProduct, but the output is bigger than the inputs.");
+		Impl::DotProductScalar<double>(a, b, out.data(), out.size());
+	}
+	INLINE void Length(Vector3SoAView<const float> a, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.Size(), "Trying to Batch::Length, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::LengthScalar<float>, &Impl::LengthSSE41, &Impl::LengthAVX2, &Impl::LengthAVX2, a, out.data(), out.size());
+	}
+	INLINE void Length(Vector3SoAView<const double> a, std::span<double> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.Size(), "Trying to Batch::Length, but the output is bigger than the input.");
+		Impl::LengthScalar<double>(a, out.data(), out.size());
+	}
+	INLINE void DistSquared(Vector3SoAView<const float> a, Vector3SoAView<const float> b, std::span<float> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.Size(), "Trying to Batch::DistSquared, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.Size(), "Trying to Batch::DistSquared, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::DistSquaredScalar<float>, &Impl::DistSquaredSSE41, &Impl::DistSquaredAVX2, &Impl::DistSquaredAVX2, a, b, out.data(), out.size());
+	}
+	INLINE void DistSquared(Vector3SoAView<const double> a, Vector3SoAView<const double> b, std::span<double> out)noexcept
+	{
+		VerifyLessEqual(out.size(), a.Size(), "Trying to Batch::DistSquared, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.size(), b.Size(), "Trying to Batch::DistSquared, but the output is bigger than the inputs.");
+		Impl::DistSquaredScalar<double>(a, b, out.data(), out.size());
+	}
+	INLINE void CrossProduct(Vector3SoAView<const float> a, Vector3SoAView<const float> b, Vector3SoAView<float> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::CrossProduct, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.Size(), b.Size(), "Trying to Batch::CrossProduct, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::CrossProductScalar<float>, &Impl::CrossProductSSE41, &Impl::CrossProductAVX2, &Impl::CrossProductAVX2, a, b, out, out.Size());
+	}
+	INLINE void CrossProduct(Vector3SoAView<const double> a, Vector3SoAView<const double> b, Vector3SoAView<double> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::CrossProduct, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.Size(), b.Size(), "Trying to Batch::CrossProduct, but the output is bigger than the inputs.");
+		Impl::CrossProductScalar<double>(a, b, out, out.Size());
+	}
+	INLINE void GetNormalized(Vector3SoAView<const float> a, Vector3SoAView<float> out, float tolerance = MATH_TOLERANCE<float>)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::GetNormalized, but the output is bigger than the input.");
+		Impl::Dispatch(&Impl::GetNormalizedScalar<float>, &Impl::GetNormalizedSSE41, &Impl::GetNormalizedAVX2, &Impl::GetNormalizedAVX2, a, out, out.Size(), tolerance);
+	}
+	INLINE void GetNormalized(Vector3SoAView<const double> a, Vector3SoAView<double> out, double tolerance = MATH_TOLERANCE<double>)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::GetNormalized, but the output is bigger than the input.");
+		Impl::GetNormalizedScalar<double>(a, out, out.Size(), tolerance);
+	}
+	INLINE void Lerp(Vector3SoAView<const float> a, Vector3SoAView<const float> b, float t, Vector3SoAView<float> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::Lerp, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.Size(), b.Size(), "Trying to Batch::Lerp, but the output is bigger than the inputs.");
+		Impl::Dispatch(&Impl::LerpScalar<float>, &Impl::LerpSSE41, &Impl::LerpAVX2, &Impl::LerpAVX2, a, b, t, out, out.Size());
+	}
+	INLINE void Lerp(Vector3SoAView<const double> a, Vector3SoAView<const double> b, double t, Vector3SoAView<double> out)noexcept
+	{
+		VerifyLessEqual(out.Size(), a.Size(), "Trying to Batch::Lerp, but the output is bigger than the inputs.");
+		VerifyLessEqual(out.Size(), b.Size(), "Trying to Batch::Lerp, but the output is bigger than the inputs.");
+		Impl::LerpScalar<double>(a, b, t, out, out.Size());
+	}
+}
+
+MATH_STRICT_FP_END
+
+#endif /* MATH_VECTOR3SOA_H */
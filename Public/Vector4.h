@@ -12,5 +12,6 @@
 #include "Base/Vector4Signed.inl"
 #include "Base/Vector4Unsigned.inl"
 #include "Base/Vector4b.inl"
+#include "Base/Vector4Half.inl"
 
 #endif /* MATH_VECTOR4_H */
\ No newline at end of file
@@ -0,0 +1,446 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+#pragma once
+
+#ifndef MATH_WIDE_BVH_H
+#define MATH_WIDE_BVH_H 1
+
+#include "BVH.h"
+#include <cmath>
+#include <cstring>
+#include <bit>
+
+namespace greaper::math
+{
+	/* Children bounds are 8 bit offsets from Origin in steps of 2^Exponent per axis. The steps are powers of two and Origin
+	 * is a multiple of them, so dequantizing is exact in float and the boxes always contain the real ones.
+	 * BVH4 nodes fill one cache line and BVH8 nodes two. */
+	template<sizet Width>
+	struct alignas(64) WideBVHNode
+	{
+		static_assert(Width == 4 || Width == 8, "WideBVHNode only supports 4 or 8 children");
+
+		Vector3f Origin;
+		int8 Exponent[3] = {};
+		uint8 ChildCount = 0; // Used slots come first
+		uint8 QuantizedMin[3][Width] = {};
+		uint8 QuantizedMax[3][Width] = {};
+		uint8 PrimitiveCount[Width] = {}; // 0 for inner children
+		uint32 Child[Width] = {}; // Inner: node index, leaf: first entry in the primitive indices
+
+		NODISCARD INLINE bool IsLeaf(sizet child)const noexcept { return PrimitiveCount[child] != 0; }
+		NODISCARD INLINE AABB3f GetChildBounds(sizet child)const noexcept;
+	};
+	static_assert(sizeof(WideBVHNode<4>) == 64, "WideBVHNode<4> must fill one cache line");
+	static_assert(sizeof(WideBVHNode<8>) == 128, "WideBVHNode<8> must fill two cache lines");
+
+	namespace Impl
+	{
+		NODISCARD INLINE float ExponentToScale(int8 exponent)noexcept
+		{
+			return std::bit_cast<float>(static_cast<uint32>(exponent + 127) << 23);
+		}
+		struct WideBVHRay
+		{
+			float Origin[3];
+			float InvDirection[3];
+			float TMin;
+		};
+
+		INLINE SSE::Vector4f LoadQuantizedSSE(const uint8* src)noexcept
+		{
+			int32 packed;
+			std::memcpy(&packed, src, sizeof(packed));
+			const __m128i zero = _mm_setzero_si128();
+			const __m128i bytes = _mm_cvtsi32_si128(packed);
+			return _mm_cvtepi32_ps(_mm_unpacklo_epi16(_mm_unpacklo_epi8(bytes, zero), zero));
+		}
+		/* Slab test of the children [first, first + 4), same order of operations as AABB3f::RayIntersects */
+		template<sizet Width>
+		INLINE uint32 IntersectWideBVHChildrenSSE(const WideBVHNode<Width>& node, sizet first, const WideBVHRay& ray, float tMax, float* distances)noexcept
+		{
+			SSE::Vector4f enter = _mm_set1_ps(ray.TMin), exit = _mm_set1_ps(tMax);
+			for (sizet axis = 0; axis < 3; ++axis)
+			{
+				const SSE::Vector4f origin = _mm_set1_ps(node.Origin[axis]);
+				const SSE::Vector4f scale = _mm_set1_ps(ExponentToScale(node.Exponent[axis]));
+				const SSE::Vector4f lo = _mm_add_ps(origin, _mm_mul_ps(LoadQuantizedSSE(node.QuantizedMin[axis] + first), scale));
+				const SSE::Vector4f hi = _mm_add_ps(origin, _mm_mul_ps(LoadQuantizedSSE(node.QuantizedMax[axis] + first), scale));
+				const SSE::Vector4f rayOrigin = _mm_set1_ps(ray.Origin[axis]);
+				const SSE::Vector4f invDirection = _mm_set1_ps(ray.InvDirection[axis]);
+				const SSE::Vector4f t0 = _mm_mul_ps(_mm_sub_ps(lo, rayOrigin), invDirection);
+				const SSE::Vector4f t1 = _mm_mul_ps(_mm_sub_ps(hi, rayOrigin), invDirection);
+				enter = _mm_max_ps(_mm_min_ps(t0, t1), enter);
+				exit = _mm_min_ps(_mm_max_ps(t0, t1), exit);
+			}
+			_mm_storeu_ps(distances, enter);
+			return static_cast<uint32>(_mm_movemask_ps(_mm_cmple_ps(enter, exit)));
+		}
+		MATH_TARGET_AVX2 inline uint32 IntersectWideBVHChildrenAVX2(const WideBVHNode<8>& node, const WideBVHRay& ray, float tMax, float* distances)noexcept
+		{
+			__m256 enter = _mm256_set1_ps(ray.TMin), exit = _mm256_set1_ps(tMax);
+			for (sizet axis = 0; axis < 3; ++axis)
+			{
+				const __m256 origin = _mm256_set1_ps(node.Origin[axis]);
+				const __m256 scale = _mm256_set1_ps(ExponentToScale(node.Exponent[axis]));
+				const __m256 qMin = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(node.QuantizedMin[axis]))));
+				const __m256 qMax = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(node.QuantizedMax[axis]))));
+				const __m256 lo = _mm256_add_ps(origin, _mm256_mul_ps(qMin, scale));
+				const __m256 hi = _mm256_add_ps(origin, _mm256_mul_ps(qMax, scale));
+				const __m256 rayOrigin = _mm256_set1_ps(ray.Origin[axis]);
+				const __m256 invDirection = _mm256_set1_ps(ray.InvDirection[axis]);
+				const __m256 t0 = _mm256_mul_ps(_mm256_sub_ps(lo, rayOrigin), invDirection);
+				const __m256 t1 = _mm256_mul_ps(_mm256_sub_ps(hi, rayOrigin), invDirection);
+				enter = _mm256_max_ps(_mm256_min_ps(t0, t1), enter);
+				exit = _mm256_min_ps(_mm256_max_ps(t0, t1), exit);
+			}
+			_mm256_storeu_ps(distances, enter);
+			return static_cast<uint32>(_mm256_movemask_ps(_mm256_cmp_ps(enter, exit, _CMP_LE_OQ)));
+		}
+		/* Bit i is set when child i is hit, distances gets the entry distance of every slot */
+		template<bool UseAVX2, sizet Width>
+		INLINE uint32 IntersectWideBVHChildren(const WideBVHNode<Width>& node, const WideBVHRay& ray, float tMax, float* distances)noexcept
+		{
+			uint32 mask;
+			if constexpr (Width == 4)
+				mask = IntersectWideBVHChildrenSSE(node, 0, ray, tMax, distances);
+			else if constexpr (UseAVX2)
+				mask = IntersectWideBVHChildrenAVX2(node, ray, tMax, distances);
+			else
+				mask = IntersectWideBVHChildrenSSE(node, 0, ray, tMax, distances) | (IntersectWideBVHChildrenSSE(node, 4, ray, tMax, distances + 4) << 4);
+			return mask & ((1u << node.ChildCount) - 1);
+		}
+	}
+
+	template<sizet Width>
+	INLINE AABB3f WideBVHNode<Width>::GetChildBounds(sizet child)const noexcept
+	{
+		Vector3f min, max;
+		for (sizet axis = 0; axis < 3; ++axis)
+		{
+			const float scale = Impl::ExponentToScale(Exponent[axis]);
+			min[axis] = Origin[axis] + static_cast<float>(QuantizedMin[axis][child]) * scale;
+			max[axis] = Origin[axis] + static_cast<float>(QuantizedMax[axis][child]) * scale;
+		}
+		return { min, max };
+	}
+
+	/* Collapsed BVH with Width children per node, every child box of a node is tested with one SIMD slab test.
+	 * Queries behave like the BVH ones and give the same hits. */
+	template<sizet Width>
+	class WideBVH
+	{
+	public:
+		using Node = WideBVHNode<Width>;
+		static constexpr uint32 MAX_LEAF_SIZE = 255;
+
+		WideBVH()noexcept = default;
+
+		/* Pulls up the grandchildren with the biggest surface area until every node is full */
+		INLINE void Build(const BVH& bvh);
+		INLINE void Build(std::span<const AABB3f> primitiveBounds, const BVHBuildSettings& settings = {})
+		{
+			BVH bvh;
+			bvh.Build(primitiveBounds, settings);
+			Build(bvh);
+		}
+		INLINE void Build(std::span<const Vector3f> vertices, std::span<const uint32> indices, const BVHBuildSettings& settings = {})
+		{
+			BVH bvh;
+			bvh.Build(vertices, indices, settings);
+			Build(bvh);
+		}
+
+		INLINE void Clear()noexcept
+		{
+			m_Nodes.clear();
+			m_PrimitiveIndices.clear();
+		}
+		NODISCARD INLINE bool IsEmpty()const noexcept { return m_Nodes.empty(); }
+		NODISCARD INLINE std::span<const Node> GetNodes()const noexcept { return m_Nodes; }
+		NODISCARD INLINE std::span<const uint32> GetPrimitiveIndices()const noexcept { return m_PrimitiveIndices; }
+
+		/* Same callbacks as BVH::ClosestHit and BVH::AnyHit */
+		template<class Fn>
+		NODISCARD INLINE BVHHit ClosestHit(const Vector3f& origin, const Vector3f& direction, float tMin, float tMax, Fn&& intersect)const
+		{
+			if (Width == 8 && GetSIMDLevel() >= SIMDLevel_t::AVX2)
+				return ClosestHitImpl<true>(origin, direction, tMin, tMax, intersect);
+			return ClosestHitImpl<false>(origin, direction, tMin, tMax, intersect);
+		}
+		template<class Fn>
+		NODISCARD INLINE bool AnyHit(const Vector3f& origin, const Vector3f& direction, float tMin, float tMax, Fn&& intersect)const
+		{
+			if (Width == 8 && GetSIMDLevel() >= SIMDLevel_t::AVX2)
+				return AnyHitImpl<true>(origin, direction, tMin, tMax, intersect);
+			return AnyHitImpl<false>(origin, direction, tMin, tMax, intersect);
+		}
+
+	private:
+		// Split leaves can add a few levels below the deepest BVH node
+		static constexpr uint32 STACK_SIZE = (BVH::MAX_DEPTH + 8) * (Width - 1) + 1;
+		struct StackEntry
+		{
+			uint32 Node;
+			float Distance;
+		};
+
+		INLINE uint32 CollapseNode(const BVH& bvh, uint32 binaryIndex);
+		INLINE uint32 SplitLeaf(const AABB3f& bounds, uint32 offset, uint32 count);
+		INLINE static void Quantize(Node& node, const AABB3f& bounds, const AABB3f* children, sizet childCount)noexcept;
+		NODISCARD INLINE static Impl::WideBVHRay MakeRay(const Vector3f& origin, const Vector3f& direction, float tMin)noexcept
+		{
+			return { { origin.X, origin.Y, origin.Z }, { 1.f / direction.X, 1.f / direction.Y, 1.f / direction.Z }, tMin };
+		}
+
+		template<bool UseAVX2, class Fn>
+		NODISCARD INLINE BVHHit ClosestHitImpl(const Vector3f& origin, const Vector3f& direction, float tMin, float tMax, Fn& intersect)const;
+		template<bool UseAVX2, class Fn>
+		NODISCARD INLINE bool AnyHitImpl(const Vector3f& origin, const Vector3f& direction, float tMin, float tMax, Fn& intersect)const;
+
+		std::vector<Node> m_Nodes;
+		std::vector<uint32> m_PrimitiveIndices;
+	};
+	using BVH4 = WideBVH<4>;
+	using BVH8 = WideBVH<8>;
+
+	template<sizet Width>
+	INLINE void WideBVH<Width>::Build(const BVH& bvh)
+	{
+		Clear();
+		if (bvh.IsEmpty())
+			return;
+		const std::span<const uint32> indices = bvh.GetPrimitiveIndices();
+		m_PrimitiveIndices.assign(indices.begin(), indices.end());
+		m_Nodes.reserve(bvh.GetNodes().size() / (Width - 1) + 1);
+
+		const BVHNode& root = bvh.GetNodes()[0];
+		if (root.IsLeaf())
+			SplitLeaf(root.GetBounds(), root.Offset, root.Count);
+		else
+			CollapseNode(bvh, 0);
+	}
+
+	template<sizet Width>
+	INLINE uint32 WideBVH<Width>::CollapseNode(const BVH& bvh, uint32 binaryIndex)
+	{
+		const std::span<const BVHNode> nodes = bvh.GetNodes();
+		uint32 children[Width] = { binaryIndex + 1, nodes[binaryIndex].Offset };
+		sizet childCount = 2;
+		while (childCount < Width)
+		{
+			sizet best = Width;
+			float bestArea = -1.f;
+			for (sizet i = 0; i < childCount; ++i)
+			{
+				const BVHNode& child = nodes[children[i]];
+				if (child.IsLeaf())
+					continue;
+				const float area = child.GetBounds().GetSurfaceArea();
+				if (area > bestArea)
+				{
+					best = i;
+					bestArea = area;
+				}
+			}
+			if (best == Width)
+				break;
+			const uint32 opened = children[best];
+			children[best] = opened + 1;
+			children[childCount++] = nodes[opened].Offset;
+		}
+
+		const auto nodeIndex = static_cast<uint32>(m_Nodes.size());
+		m_Nodes.emplace_back();
+		AABB3f childBounds[Width];
+		for (sizet i = 0; i < childCount; ++i)
+			childBounds[i] = nodes[children[i]].GetBounds();
+		Quantize(m_Nodes[nodeIndex], nodes[binaryIndex].GetBounds(), childBounds, childCount);
+
+		for (sizet i = 0; i < childCount; ++i)
+		{
+			const BVHNode& child = nodes[children[i]];
+			if (child.IsLeaf() && child.Count <= MAX_LEAF_SIZE)
+			{
+				m_Nodes[nodeIndex].PrimitiveCount[i] = static_cast<uint8>(child.Count);
+				m_Nodes[nodeIndex].Child[i] = child.Offset;
+				continue;
+			}
+			const uint32 childIndex = child.IsLeaf() ? SplitLeaf(child.GetBounds(), child.Offset, child.Count) : CollapseNode(bvh, children[i]);
+			m_Nodes[nodeIndex].Child[i] = childIndex;
+		}
+		return nodeIndex;
+	}
+
+	template<sizet Width>
+	INLINE uint32 WideBVH<Width>::SplitLeaf(const AABB3f& bounds, uint32 offset, uint32 count)
+	{
+		// Leaves with too many primitives for a byte become nodes whose children share their bounds
+		const auto nodeIndex = static_cast<uint32>(m_Nodes.size());
+		m_Nodes.emplace_back();
+		const uint32 chunk = (count + Width - 1) / Width;
+		AABB3f childBounds[Width];
+		sizet childCount = 0;
+		for (uint32 first = 0; first < count; first += chunk)
+			childBounds[childCount++] = bounds;
+		Quantize(m_Nodes[nodeIndex], bounds, childBounds, childCount);
+
+		for (sizet i = 0; i < childCount; ++i)
+		{
+			const uint32 first = static_cast<uint32>(i) * chunk;
+			const uint32 size = std::min(chunk, count - first);
+			if (size <= MAX_LEAF_SIZE)
+			{
+				m_Nodes[nodeIndex].PrimitiveCount[i] = static_cast<uint8>(size);
+				m_Nodes[nodeIndex].Child[i] = offset + first;
+				continue;
+			}
+			const uint32 childIndex = SplitLeaf(bounds, offset + first, size);
+			m_Nodes[nodeIndex].Child[i] = childIndex;
+		}
+		return nodeIndex;
+	}
+
+	template<sizet Width>
+	INLINE void WideBVH<Width>::Quantize(Node& node, const AABB3f& bounds, const AABB3f* children, sizet childCount)noexcept
+	{
+		node.ChildCount = static_cast<uint8>(childCount);
+		for (sizet axis = 0; axis < 3; ++axis)
+		{
+			// Work in double, where every difference of two floats is exact
+			const double lo = bounds.Min[axis], hi = bounds.Max[axis];
+			const double maxAbs = std::max(std::abs(lo), std::abs(hi));
+			int32 exponent = -126;
+			int32 e;
+			if (hi > lo)
+			{
+				// 254 steps cover the extent, one more absorbs the origin rounding down
+				std::frexp((hi - lo) / 254.0, &e);
+				exponent = std::max(exponent, e);
+			}
+			if (maxAbs > 0.0)
+			{
+				// Any multiple of the step up to 2^24 steps is a float, which keeps Origin + q * step exact
+				std::frexp(maxAbs, &e);
+				exponent = std::max(exponent, e - 23);
+			}
+			exponent = std::min(exponent, 127);
+			const double step = std::ldexp(1.0, exponent);
+			const double origin = std::floor(lo / step) * step;
+
+			node.Origin[axis] = static_cast<float>(origin);
+			node.Exponent[axis] = static_cast<int8>(exponent);
+			for (sizet i = 0; i < childCount; ++i)
+			{
+				const double qMin = std::floor((static_cast<double>(children[i].Min[axis]) - origin) / step);
+				const double qMax = std::ceil((static_cast<double>(children[i].Max[axis]) - origin) / step);
+				node.QuantizedMin[axis][i] = static_cast<uint8>(std::clamp(qMin, 0.0, 255.0));
+				node.QuantizedMax[axis][i] = static_cast<uint8>(std::clamp(qMax, 0.0, 255.0));
+			}
+		}
+	}
+
+	template<sizet Width>
+	template<bool UseAVX2, class Fn>
+	INLINE BVHHit WideBVH<Width>::ClosestHitImpl(const Vector3f& origin, const Vector3f& direction, float tMin, float tMax, Fn& intersect)const
+	{
+		BVHHit hit;
+		hit.Distance = tMax;
+		if (m_Nodes.empty())
+			return hit;
+
+		const Impl::WideBVHRay ray = MakeRay(origin, direction, tMin);
+		StackEntry stack[STACK_SIZE];
+		uint32 stackSize = 0;
+		uint32 nodeIndex = 0;
+		for (;;)
+		{
+			const Node& node = m_Nodes[nodeIndex];
+			float distances[Width];
+			uint32 mask = Impl::IntersectWideBVHChildren<UseAVX2>(node, ray, hit.Distance, distances);
+
+			// Leaves first, their hits make the inner children cheaper to reject
+			StackEntry inner[Width];
+			sizet innerCount = 0;
+			while (mask != 0)
+			{
+				const auto i = static_cast<sizet>(std::countr_zero(mask));
+				mask &= mask - 1;
+				if (!node.IsLeaf(i))
+				{
+					inner[innerCount++] = { node.Child[i], distances[i] };
+					continue;
+				}
+				for (uint32 j = 0; j < node.PrimitiveCount[i]; ++j)
+				{
+					const uint32 prim = m_PrimitiveIndices[node.Child[i] + j];
+					if (intersect(prim, hit.Distance))
+						hit.Primitive = prim;
+				}
+			}
+
+			// Furthest first so the nearest child ends on top of the stack
+			for (sizet i = 1; i < innerCount; ++i)
+			{
+				const StackEntry entry = inner[i];
+				sizet j = i;
+				for (; j > 0 && inner[j - 1].Distance < entry.Distance; --j)
+					inner[j] = inner[j - 1];
+				inner[j] = entry;
+			}
+			for (sizet i = 0; i < innerCount; ++i)
+			{
+				if (inner[i].Distance <= hit.Distance)
+					stack[stackSize++] = inner[i];
+			}
+
+			do
+			{
+				if (stackSize == 0)
+					return hit;
+				--stackSize;
+			} while (stack[stackSize].Distance > hit.Distance);
+			nodeIndex = stack[stackSize].Node;
+		}
+	}
+
+	template<sizet Width>
+	template<bool UseAVX2, class Fn>
+	INLINE bool WideBVH<Width>::AnyHitImpl(const Vector3f& origin, const Vector3f& direction, float tMin, float tMax, Fn& intersect)const
+	{
+		if (m_Nodes.empty())
+			return false;
+
+		const Impl::WideBVHRay ray = MakeRay(origin, direction, tMin);
+		uint32 stack[STACK_SIZE];
+		uint32 stackSize = 0;
+		stack[stackSize++] = 0;
+		while (stackSize > 0)
+		{
+			const Node& node = m_Nodes[stack[--stackSize]];
+			float distances[Width];
+			uint32 mask = Impl::IntersectWideBVHChildren<UseAVX2>(node, ray, tMax, distances);
+			while (mask != 0)
+			{
+				const auto i = static_cast<sizet>(std::countr_zero(mask));
+				mask &= mask - 1;
+				if (!node.IsLeaf(i))
+				{
+					stack[stackSize++] = node.Child[i];
+					continue;
+				}
+				for (uint32 j = 0; j < node.PrimitiveCount[i]; ++j)
+				{
+					if (intersect(m_PrimitiveIndices[node.Child[i] + j], tMax))
+						return true;
+				}
+			}
+		}
+		return false;
+	}
+}
+
+#endif /* MATH_WIDE_BVH_H */
\ No newline at end of file
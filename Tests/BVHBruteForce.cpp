@@ -0,0 +1,224 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+/* Checks every BVH query against a linear scan over the same primitives: ClosestHit, AnyHit, both QueryOverlaps and
+ * ClosestPoint. The soup has a tenth of its triangles stacked on one point so the binning has to fall back, some rays
+ * are axis parallel and some start on the X = 0 plane. The serial and parallel builds must give the same tree, and
+ * after moving part of the triangles both Refit forms must answer like a fresh scan again.
+ * Build it standalone, with the same include paths as the library:
+ *	g++ -std=c++20 -O2 -msse4.1 BVHBruteForce.cpp -o BVHBruteForce */
+
+#include "../Public/BVH.h"
+#include "../Public/RayTriangle.h"
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace greaper::math;
+
+namespace
+{
+	struct Scene
+	{
+		std::vector<Vector3f> Vertices;
+		std::vector<uint32> Indices;
+
+		NODISCARD uint32 GetTriangleCount()const { return static_cast<uint32>(Indices.size() / 3); }
+		NODISCARD const Vector3f& GetVertex(uint32 triangle, uint32 corner)const { return Vertices[Indices[triangle * 3 + corner]]; }
+		NODISCARD AABB3f GetTriangleBounds(uint32 triangle)const
+		{
+			AABB3f bounds = AABB3f::EMPTY;
+			for (uint32 corner = 0; corner < 3; ++corner)
+				bounds.Merge(GetVertex(triangle, corner));
+			return bounds;
+		}
+		/* Lowers distance and returns true when the triangle is hit closer */
+		NODISCARD bool Intersect(uint32 triangle, const Vector3f& origin, const Vector3f& direction, float tMin, float& distance)const
+		{
+			RayTriangleHit<float> hit;
+			if (!RayIntersectsTriangle(origin, direction, GetVertex(triangle, 0), GetVertex(triangle, 1), GetVertex(triangle, 2), tMin, distance, hit))
+				return false;
+			distance = hit.Distance;
+			return true;
+		}
+	};
+
+	Scene MakeScene(std::mt19937& generator, uint32 triangleCount)
+	{
+		std::uniform_real_distribution<float> position(-10.f, 10.f), offset(-0.3f, 0.3f);
+		Scene scene;
+		for (uint32 i = 0; i < triangleCount; ++i)
+		{
+			const Vector3f center = i % 10 == 0 ? Vector3f(1.f, 1.f, 1.f) : Vector3f(position(generator), position(generator), position(generator));
+			for (uint32 corner = 0; corner < 3; ++corner)
+			{
+				scene.Indices.push_back(static_cast<uint32>(scene.Vertices.size()));
+				scene.Vertices.push_back(center + Vector3f(offset(generator), offset(generator), offset(generator)));
+			}
+		}
+		return scene;
+	}
+
+	/* Every primitive must be in exactly one leaf and every node must contain its children */
+	uint64 CheckStructure(const BVH& bvh, const Scene& scene)
+	{
+		uint64 errors = 0;
+		std::vector<uint32> seen(scene.GetTriangleCount(), 0);
+		const std::span<const BVHNode> nodes = bvh.GetNodes();
+		for (uint32 n = 0; n < nodes.size(); ++n)
+		{
+			const BVHNode& node = nodes[n];
+			if (node.IsLeaf())
+			{
+				for (uint32 i = 0; i < node.Count; ++i)
+				{
+					const uint32 primitive = bvh.GetPrimitiveIndices()[node.Offset + i];
+					++seen[primitive];
+					const AABB3f bounds = scene.GetTriangleBounds(primitive);
+					errors += node.GetBounds().GetMerged(bounds).Min != node.Min || node.GetBounds().GetMerged(bounds).Max != node.Max;
+				}
+				continue;
+			}
+			for (const uint32 child : { n + 1, node.Offset })
+			{
+				const AABB3f merged = node.GetBounds().GetMerged(nodes[child].GetBounds());
+				errors += merged.Min != node.Min || merged.Max != node.Max;
+			}
+		}
+		for (const uint32 count : seen)
+			errors += count != 1;
+		return errors;
+	}
+
+	uint64 CheckRays(const BVH& bvh, const Scene& scene, std::mt19937& generator, uint32 rayCount)
+	{
+		std::uniform_real_distribution<float> position(-12.f, 12.f);
+		uint64 errors = 0, hits = 0;
+		for (uint32 r = 0; r < rayCount; ++r)
+		{
+			Vector3f origin(position(generator), position(generator), position(generator));
+			Vector3f direction(position(generator), position(generator), position(generator));
+			if (r % 5 == 0)
+				direction.Y = 0.f;
+			if (r % 7 == 0)
+				origin.X = 0.f;
+			const float tMin = r % 3 == 0 ? 0.5f : 0.f;
+			const float tMax = r % 4 == 0 ? 1.f : std::numeric_limits<float>::infinity();
+
+			float expectedDistance = tMax;
+			bool expectedHit = false;
+			for (uint32 triangle = 0; triangle < scene.GetTriangleCount(); ++triangle)
+				expectedHit |= scene.Intersect(triangle, origin, direction, tMin, expectedDistance);
+
+			const BVHHit hit = bvh.ClosestHit(origin, direction, tMin, tMax, [&](uint32 triangle, float& distance) { return scene.Intersect(triangle, origin, direction, tMin, distance); });
+			const bool any = bvh.AnyHit(origin, direction, tMin, tMax, [&](uint32 triangle, float distance) { return scene.Intersect(triangle, origin, direction, tMin, distance); });
+			bool closestOk = hit.IsHit() == expectedHit;
+			if (closestOk && expectedHit)
+			{
+				// Triangles can tie, the reported one only has to be hit at that distance
+				float distance = tMax;
+				closestOk = hit.Distance == expectedDistance && scene.Intersect(hit.Primitive, origin, direction, tMin, distance) && distance == expectedDistance;
+			}
+			if (!closestOk && errors < 5)
+				printf("\tClosestHit ray %u: hit %d at %a, scan %d at %a\n", r, hit.IsHit(), hit.Distance, expectedHit, expectedDistance);
+			if (any != expectedHit && errors < 5)
+				printf("\tAnyHit ray %u: %d, scan %d\n", r, any, expectedHit);
+			errors += !closestOk + (any != expectedHit);
+			hits += expectedHit;
+		}
+		printf("\t%u rays, %llu hit\n", rayCount, static_cast<unsigned long long>(hits));
+		return errors;
+	}
+
+	uint64 CheckVolumes(const BVH& bvh, const Scene& scene, std::mt19937& generator, uint32 queryCount)
+	{
+		std::uniform_real_distribution<float> position(-11.f, 11.f), size(0.f, 2.f);
+		uint64 errors = 0;
+		std::vector<uint32> visits(scene.GetTriangleCount());
+		for (uint32 q = 0; q < queryCount; ++q)
+		{
+			const Vector3f center(position(generator), position(generator), position(generator));
+			const AABB3f box(center, center + Vector3f(size(generator), size(generator), size(generator)));
+			const float radius = size(generator);
+
+			// Every overlapping primitive must be visited once, others may be visited since the test is on the leaf
+			std::fill(visits.begin(), visits.end(), 0);
+			bvh.QueryOverlaps(box, [&](uint32 triangle) { ++visits[triangle]; });
+			for (uint32 triangle = 0; triangle < scene.GetTriangleCount(); ++triangle)
+				errors += visits[triangle] > 1 || (scene.GetTriangleBounds(triangle).Overlaps(box) && visits[triangle] != 1);
+
+			std::fill(visits.begin(), visits.end(), 0);
+			bvh.QueryOverlaps(center, radius, [&](uint32 triangle) { ++visits[triangle]; });
+			for (uint32 triangle = 0; triangle < scene.GetTriangleCount(); ++triangle)
+				errors += visits[triangle] > 1 || (scene.GetTriangleBounds(triangle).OverlapsSphere(center, radius) && visits[triangle] != 1);
+
+			// The closest point on the triangle bounds keeps the scan exact
+			float expected = std::numeric_limits<float>::infinity();
+			for (uint32 triangle = 0; triangle < scene.GetTriangleCount(); ++triangle)
+				expected = std::min(expected, scene.GetTriangleBounds(triangle).DistanceSquared(center));
+			const BVHClosestPoint closest = bvh.ClosestPoint(center, [&](uint32 triangle, const Vector3f& point) { return scene.GetTriangleBounds(triangle).ClosestPoint(point); });
+			const bool closestOk = closest.IsFound() && closest.DistanceSquared == expected
+				&& scene.GetTriangleBounds(closest.Primitive).DistanceSquared(center) == expected;
+			if (!closestOk && errors < 5)
+				printf("\tClosestPoint query %u: %a, scan %a\n", q, closest.DistanceSquared, expected);
+			errors += !closestOk;
+		}
+		return errors;
+	}
+
+	uint64 CheckAll(const char* name, const BVH& bvh, const Scene& scene, std::mt19937& generator)
+	{
+		uint64 errors = CheckStructure(bvh, scene);
+		errors += CheckRays(bvh, scene, generator, 3000);
+		errors += CheckVolumes(bvh, scene, generator, 300);
+		printf("%-28s %llu errors\n", name, static_cast<unsigned long long>(errors));
+		return errors;
+	}
+}
+
+int main()
+{
+	std::mt19937 generator(17);
+	Scene scene = MakeScene(generator, 20000);
+	uint64 errors = 0;
+
+	BVH serial;
+	serial.Build(scene.Vertices, scene.Indices);
+	errors += CheckAll("serial build", serial, scene, generator);
+
+	BVHBuildSettings parallelSettings;
+	parallelSettings.ThreadCount = 4;
+	parallelSettings.MinTaskSize = 256;
+	BVH parallel;
+	parallel.Build(scene.Vertices, scene.Indices, parallelSettings);
+	const bool sameTree = parallel.GetNodes().size() == serial.GetNodes().size()
+		&& std::memcmp(parallel.GetNodes().data(), serial.GetNodes().data(), serial.GetNodes().size_bytes()) == 0
+		&& std::equal(parallel.GetPrimitiveIndices().begin(), parallel.GetPrimitiveIndices().end(), serial.GetPrimitiveIndices().begin());
+	printf("parallel build %s the serial tree\n", sameTree ? "matches" : "DIFFERS FROM");
+	errors += !sameTree;
+	errors += CheckAll("parallel build", parallel, scene, generator);
+
+	// Moves one triangle out of eight, some of them far outside the old root bounds
+	std::uniform_real_distribution<float> motion(-3.f, 3.f);
+	std::vector<uint32> changed;
+	for (uint32 triangle = 0; triangle < scene.GetTriangleCount(); triangle += 8)
+	{
+		const Vector3f delta = triangle % 64 == 0 ? Vector3f(25.f, motion(generator), 0.f) : Vector3f(motion(generator), motion(generator), motion(generator));
+		for (uint32 corner = 0; corner < 3; ++corner)
+			scene.Vertices[scene.Indices[triangle * 3 + corner]] += delta;
+		changed.push_back(triangle);
+	}
+	BVH refitAll = serial, refitChanged = serial;
+	refitAll.Refit(scene.Vertices, scene.Indices);
+	refitChanged.Refit(scene.Vertices, scene.Indices, changed);
+	errors += CheckAll("Refit every primitive", refitAll, scene, generator);
+	errors += CheckAll("Refit changed primitives", refitChanged, scene, generator);
+	const bool sameRefit = std::memcmp(refitAll.GetNodes().data(), refitChanged.GetNodes().data(), refitAll.GetNodes().size_bytes()) == 0;
+	printf("both Refit forms %s\n", sameRefit ? "give the same nodes" : "DIFFER");
+	errors += !sameRefit;
+
+	return errors == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+/* Exhaustive sweep behind the error table of FastMath.h. For every function it measures the maximum error against
+ * the double precision libm over every float of the documented range, and checks that the float and the 4 lane
+ * versions give the same bits for all 2^32 inputs, NaNs included. ATan2 is swept over every y with x = +-1 and
+ * 2^26 random pairs.
+ * Build it standalone, with the same include paths as the library:
+ *	g++ -std=c++20 -O2 -msse4.1 -pthread FastMathSweep.cpp -o FastMathSweep
+ * Pass a function name (invsqrt, rcp, sin, cos, atan2, exp2, log2, acos) to run only that one. */
+
+#include "../Public/FastMath.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace greaper::math;
+
+namespace
+{
+	using VectorFn = SSE::Vector4f(*)(SSE::Vector4f);
+	using ScalarFn = float(*)(float);
+	using ReferenceFn = double(*)(double);
+
+	struct SweepResult
+	{
+		double MaxError = 0.0;
+		float WorstInput = 0.f;
+	};
+
+	/* Runs fn over every bit pattern in [first, last] split across the hardware threads */
+	template<class Fn>
+	void ForEachBits(uint32 first, uint32 last, Fn fn)
+	{
+		const uint32 threadCount = std::max(1u, std::thread::hardware_concurrency());
+		const uint64 count = uint64(last) - first + 1;
+		std::vector<std::thread> threads;
+		for (uint32 t = 0; t < threadCount; ++t)
+		{
+			const uint64 begin = first + count * t / threadCount;
+			const uint64 end = first + count * (t + 1) / threadCount;
+			threads.emplace_back([=, &fn] { fn(t, begin, end); });
+		}
+		for (auto& thread : threads)
+			thread.join();
+	}
+
+	/* Maximum error of the 4 lane version, relative or absolute, over every float in [first, last] */
+	SweepResult MeasureError(VectorFn fn, ReferenceFn reference, uint32 first, uint32 last, bool relative)
+	{
+		const uint32 threadCount = std::max(1u, std::thread::hardware_concurrency());
+		std::vector<SweepResult> results(threadCount);
+		ForEachBits(first, last, [&](uint32 t, uint64 begin, uint64 end)
+			{
+				SweepResult& result = results[t];
+				alignas(16) float in[4], out[4];
+				for (uint64 i = begin; i < end; i += 4)
+				{
+					for (uint32 k = 0; k < 4; ++k)
+						in[k] = std::bit_cast<float>(static_cast<uint32>(std::min(i + k, end - 1)));
+					_mm_store_ps(out, fn(_mm_load_ps(in)));
+					for (uint32 k = 0; k < 4; ++k)
+					{
+						const double expected = reference(in[k]);
+						double error = std::fabs(out[k] - expected);
+						if (relative)
+							error /= std::fabs(expected);
+						if (!(error <= result.MaxError))
+						{
+							result.MaxError = std::isnan(error) ? std::numeric_limits<double>::infinity() : error;
+							result.WorstInput = in[k];
+						}
+					}
+				}
+			});
+		SweepResult total;
+		for (const auto& result : results)
+		{
+			if (result.MaxError > total.MaxError)
+				total = result;
+		}
+		return total;
+	}
+
+	/* Counts the inputs where the float and the 4 lane versions disagree on any bit */
+	uint64 CountMismatches(VectorFn fn, ScalarFn scalar)
+	{
+		std::atomic<uint64> mismatches = 0;
+		ForEachBits(0, 0xFFFFFFFF, [&](uint32, uint64 begin, uint64 end)
+			{
+				uint64 local = 0;
+				alignas(16) uint32 in[4], out[4];
+				for (uint64 i = begin; i < end; i += 4)
+				{
+					for (uint32 k = 0; k < 4; ++k)
+						in[k] = static_cast<uint32>(std::min(i + k, end - 1));
+					_mm_store_ps(reinterpret_cast<float*>(out), fn(_mm_load_ps(reinterpret_cast<const float*>(in))));
+					for (uint32 k = 0; k < 4; ++k)
+					{
+						if (std::bit_cast<uint32>(scalar(std::bit_cast<float>(in[k]))) != out[k] && local++ < 3)
+							printf("\tmismatch at %a\n", std::bit_cast<float>(in[k]));
+					}
+				}
+				mismatches += local;
+			});
+		return mismatches;
+	}
+
+	/* Sweeps [first, last] and, when negativeLast is not zero, [-first, negativeLast] */
+	bool Report(const char* name, VectorFn fn, ScalarFn scalar, ReferenceFn reference, uint32 first, uint32 last, uint32 negativeLast, bool relative)
+	{
+		SweepResult result = MeasureError(fn, reference, first, last, relative);
+		if (negativeLast != 0)
+		{
+			const SweepResult negative = MeasureError(fn, reference, first | 0x80000000, negativeLast, relative);
+			if (negative.MaxError > result.MaxError)
+				result = negative;
+		}
+		const uint64 mismatches = CountMismatches(fn, scalar);
+		printf("%-8s %.2e %s at %a, %llu float/4 lane mismatches\n", name, result.MaxError, relative ? "relative" : "absolute",
+			result.WorstInput, static_cast<unsigned long long>(mismatches));
+		return mismatches == 0;
+	}
+
+	bool ReportATan2()
+	{
+		const VectorFn positiveX = [](SSE::Vector4f y) { return fast::ATan2(y, _mm_set1_ps(1.f)); };
+		const VectorFn negativeX = [](SSE::Vector4f y) { return fast::ATan2(y, _mm_set1_ps(-1.f)); };
+		double maxError = 0.0;
+		uint64 mismatches = 0;
+		for (uint32 first : { 0u, 0x80000000u })
+		{
+			maxError = std::max(maxError, MeasureError(positiveX, [](double y) { return std::atan2(y, 1.0); }, first, first | 0x7F800000, false).MaxError);
+			maxError = std::max(maxError, MeasureError(negativeX, [](double y) { return std::atan2(y, -1.0); }, first, first | 0x7F800000, false).MaxError);
+		}
+
+		std::mt19937 generator(1);
+		std::uniform_real_distribution<float> distribution(-100.f, 100.f);
+		const float specials[] = { 0.f, -0.f, 1.f, -1.f, std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+			std::numeric_limits<float>::quiet_NaN(), -std::numeric_limits<float>::quiet_NaN(), std::numeric_limits<float>::denorm_min() };
+		for (float y : specials)
+		{
+			for (float x : specials)
+			{
+				const float lane = _mm_cvtss_f32(fast::ATan2(_mm_set_ss(y), _mm_set_ss(x)));
+				mismatches += std::bit_cast<uint32>(lane) != std::bit_cast<uint32>(fast::ATan2(y, x));
+			}
+		}
+		for (uint32 i = 0; i < (1u << 26); ++i)
+		{
+			float y = distribution(generator);
+			const float x = distribution(generator);
+			if ((i & 1) != 0)
+				y *= 1e-3f;
+			const float value = fast::ATan2(y, x);
+			maxError = std::max(maxError, std::fabs(value - std::atan2(double(y), double(x))));
+			mismatches += std::bit_cast<uint32>(_mm_cvtss_f32(fast::ATan2(_mm_set_ss(y), _mm_set_ss(x)))) != std::bit_cast<uint32>(value);
+		}
+		printf("%-8s %.2e absolute, %llu float/4 lane mismatches\n", "ATan2", maxError, static_cast<unsigned long long>(mismatches));
+		return mismatches == 0;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const char* only = argc > 1 ? argv[1] : nullptr;
+	const auto selected = [only](const char* name) { return only == nullptr || std::strcmp(only, name) == 0; };
+	constexpr uint32 minNormal = 0x00800000, maxFinite = 0x7F7FFFFF, bits8192 = 0x46000000;
+	bool ok = true;
+
+	if (selected("invsqrt"))
+	{
+		ok &= Report("InvSqrt", fast::InvSqrt, fast::InvSqrt, [](double x) { return 1.0 / std::sqrt(x); },
+			minNormal, maxFinite, 0, true);
+	}
+	if (selected("rcp"))
+	{
+		ok &= Report("Rcp", fast::Rcp, fast::Rcp, [](double x) { return 1.0 / x; },
+			minNormal, 0x7E7FFFFF, 0xFE7FFFFF, true);
+	}
+	if (selected("sin"))
+	{
+		ok &= Report("Sin", fast::Sin, fast::Sin, [](double x) { return std::sin(x); },
+			0, bits8192, 0x80000000 | bits8192, false);
+	}
+	if (selected("cos"))
+	{
+		ok &= Report("Cos", fast::Cos, fast::Cos, [](double x) { return std::cos(x); },
+			0, bits8192, 0x80000000 | bits8192, false);
+	}
+	if (selected("atan2"))
+		ok &= ReportATan2();
+	if (selected("exp2"))
+	{
+		ok &= Report("Exp2", fast::Exp2, fast::Exp2, [](double x) { return std::exp2(x); },
+			0, 0x42FFFFFF, 0xC2FC0000, true);
+	}
+	if (selected("log2"))
+	{
+		ok &= Report("Log2", fast::Log2, fast::Log2, [](double x) { return std::log2(x); },
+			minNormal, maxFinite, 0, false);
+	}
+	if (selected("acos"))
+	{
+		ok &= Report("ACos", fast::ACos, fast::ACos, [](double x) { return std::acos(x); },
+			0, 0x3F800000, 0xBF800000, false);
+	}
+	return ok ? 0 : 1;
+}
\ No newline at end of file
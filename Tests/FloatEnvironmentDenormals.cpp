@@ -0,0 +1,124 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+/* Shows the denormal slowdown going away under ScopedFloatEnvironment and checks that Batch::SetFlushDenormals
+ * only changes FTZ / DAZ. A Vector3f damping filter decays into denormals and is timed with the default control
+ * register and inside a scope, the times are printed since how much denormals cost depends on the CPU.
+ * Build it standalone, with the same include paths as the library:
+ *	g++ -std=c++20 -O2 -msse4.1 FloatEnvironmentDenormals.cpp -o FloatEnvironmentDenormals */
+
+#include "../Public/Batch.h"
+#include "../Public/Vector3.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#if defined(_MSC_VER)
+#define TEST_NOINLINE __declspec(noinline)
+#else
+#define TEST_NOINLINE __attribute__((noinline))
+#endif
+
+using namespace greaper::math;
+
+namespace
+{
+	constexpr uint32 ExceptionFlags = ScopedFloatEnvironment::ExceptionFlagsMask;
+	// Volatile so the divisions are not folded at compile time with the default rounding
+	volatile float One = 1.f, Three = 3.f, Zero = 0.f;
+
+	/* Out of line so the compiler can not move the arithmetic across the scopes */
+	TEST_NOINLINE float Damp(std::vector<Vector3f>& values, uint32 steps)
+	{
+		for (uint32 step = 0; step < steps; ++step)
+		{
+			for (Vector3f& v : values)
+				v = v * 0.5f + v * 0.45f;
+		}
+		return values[0].X;
+	}
+	TEST_NOINLINE float Divide(float a, float b)
+	{
+		return a / b;
+	}
+
+	double TimeDamping(bool flushDenormals, float& result)
+	{
+		std::vector<Vector3f> values(4096, Vector3f(1e-36f, 2e-36f, 3e-36f));
+		const auto start = std::chrono::steady_clock::now();
+		if (flushDenormals)
+		{
+			const ScopedFloatEnvironment environment;
+			result = Damp(values, 400);
+		}
+		else
+		{
+			result = Damp(values, 400);
+		}
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	bool Check(bool condition, const char* what)
+	{
+		printf("%s %s\n", condition ? "ok    " : "FAILED", what);
+		return condition;
+	}
+}
+
+int main()
+{
+	bool ok = true;
+	const uint32 initialCSR = _mm_getcsr() & ~ExceptionFlags;
+
+	float defaultResult = 0.f, flushedResult = 0.f;
+	const double defaultTime = TimeDamping(false, defaultResult);
+	const double flushedTime = TimeDamping(true, flushedResult);
+	printf("damping into denormals: default %.2f ms, ScopedFloatEnvironment %.2f ms (%.1fx)\n", defaultTime, flushedTime, defaultTime / flushedTime);
+	ok &= Check(defaultResult != 0.f && flushedResult == 0.f, "the scope flushes the denormal results to zero");
+	ok &= Check((_mm_getcsr() & ~ExceptionFlags) == initialCSR, "the control register is restored");
+
+	{
+		const ScopedFloatEnvironment up(false, false, FloatRounding_t::Up);
+		const float upThird = Divide(One, Three);
+		{
+			const ScopedFloatEnvironment down(false, false, FloatRounding_t::Down);
+			ok &= Check(Divide(One, Three) < upThird, "nested scopes change the rounding mode");
+		}
+		ok &= Check(Divide(One, Three) == upThird, "the outer rounding mode comes back");
+	}
+	{
+		{
+			const ScopedFloatEnvironment environment;
+			volatile float quotient = Divide(One, Zero);
+			(void)quotient;
+		}
+		ok &= Check((_mm_getcsr() & 0x4) != 0, "exception flags raised in the scope are kept");
+	}
+
+	std::vector<float> denormals(1000, 1e-39f), out(1000);
+	Batch::Scale(denormals, 0.5f, out);
+	ok &= Check(out[999] != 0.f, "Batch keeps denormals by default");
+	Batch::SetFlushDenormals(true);
+	for (uint32 level = 0; level <= static_cast<uint32>(GetDetectedSIMDLevel()); ++level)
+	{
+		SetMaxSIMDLevel(static_cast<SIMDLevel_t>(level));
+		Batch::Scale(denormals, 0.5f, out);
+		ok &= Check(out[0] == 0.f && out[999] == 0.f, "Batch::SetFlushDenormals flushes at every level");
+	}
+	SetMaxSIMDLevel(SIMDLevel_t::AVX512);
+	{
+		// 1 / 3 rounds down differently than to nearest
+		const ScopedFloatEnvironment down(false, false, FloatRounding_t::Down);
+		const float numerator = One, denominator = Three;
+		float third = 0.f;
+		Batch::Div(std::span<const float>(&numerator, 1), std::span<const float>(&denominator, 1), std::span<float>(&third, 1));
+		ok &= Check(third == Divide(One, Three), "Batch::SetFlushDenormals keeps the rounding mode of the caller");
+		ok &= Check((_mm_getcsr() & ScopedFloatEnvironment::RoundingMask) == (static_cast<uint32>(FloatRounding_t::Down) << ScopedFloatEnvironment::RoundingShift),
+			"the rounding mode is still set after the batch call");
+	}
+	Batch::SetFlushDenormals(false);
+	ok &= Check((_mm_getcsr() & ~ExceptionFlags) == initialCSR, "the control register is restored after the batch calls");
+	return ok ? 0 : 1;
+}
\ No newline at end of file
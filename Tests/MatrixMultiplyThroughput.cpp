@@ -0,0 +1,92 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+/* Throughput of Batch::Multiply for the pairwise, one times N and N times one forms at every SIMD level, printed
+ * in matrices per second. It also checks that every level gives the same bits as the scalar one.
+ * Build it standalone, with the same include paths as the library:
+ *	g++ -std=c++20 -O2 -msse4.1 MatrixMultiplyThroughput.cpp -o MatrixMultiplyThroughput
+ * An optional argument sets the number of matrices, 4096 by default so they stay in cache. */
+
+#include "../Public/TransformBatch.h"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+using namespace greaper::math;
+
+namespace
+{
+	const char* const LevelNames[] = { "Scalar", "SSE41", "AVX2", "AVX512" };
+
+	/* Repeats fn until at least 200 ms went by and returns the matrices per second */
+	template<class Fn>
+	double MeasureThroughput(sizet count, Fn fn)
+	{
+		using Clock = std::chrono::steady_clock;
+		fn();
+		uint64 repetitions = 0;
+		const auto start = Clock::now();
+		double seconds = 0.0;
+		do
+		{
+			fn();
+			++repetitions;
+			seconds = std::chrono::duration<double>(Clock::now() - start).count();
+		} while (seconds < 0.2);
+		return static_cast<double>(count) * static_cast<double>(repetitions) / seconds;
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const sizet count = argc > 1 ? static_cast<sizet>(std::strtoull(argv[1], nullptr, 10)) : 4096;
+	std::mt19937 generator(7);
+	std::uniform_real_distribution<float> distribution(-10.f, 10.f);
+	std::vector<Matrix4f> left(count), right(count), out(count), reference(count);
+	for (auto* matrices : { &left, &right })
+	{
+		for (Matrix4f& m : *matrices)
+		{
+			std::array<float, 16> components;
+			for (float& c : components)
+				c = distribution(generator);
+			m = Matrix4f(components);
+		}
+	}
+
+	struct Form
+	{
+		const char* Name;
+		void(*Run)(const std::vector<Matrix4f>&, const std::vector<Matrix4f>&, std::vector<Matrix4f>&);
+	};
+	const Form forms[] = {
+		{ "left[i] * right[i]", [](const std::vector<Matrix4f>& l, const std::vector<Matrix4f>& r, std::vector<Matrix4f>& o) { Batch::Multiply(l, r, o); } },
+		{ "left[0] * right[i]", [](const std::vector<Matrix4f>& l, const std::vector<Matrix4f>& r, std::vector<Matrix4f>& o) { Batch::Multiply(l[0], r, o); } },
+		{ "left[i] * right[0]", [](const std::vector<Matrix4f>& l, const std::vector<Matrix4f>& r, std::vector<Matrix4f>& o) { Batch::Multiply(l, r[0], o); } },
+	};
+
+	bool ok = true;
+	const uint32 maxLevel = static_cast<uint32>(GetDetectedSIMDLevel());
+	printf("%zu matrices\n", count);
+	for (const Form& form : forms)
+	{
+		SetMaxSIMDLevel(SIMDLevel_t::Scalar);
+		form.Run(left, right, reference);
+		for (uint32 level = 0; level <= maxLevel; ++level)
+		{
+			SetMaxSIMDLevel(static_cast<SIMDLevel_t>(level));
+			const double throughput = MeasureThroughput(count, [&]() { form.Run(left, right, out); });
+			const bool same = std::memcmp(out.data(), reference.data(), count * sizeof(Matrix4f)) == 0;
+			printf("%-20s %-7s %8.1f M matrices/s%s\n", form.Name, LevelNames[level], throughput * 1e-6, same ? "" : "  DIFFERS FROM SCALAR");
+			ok &= same;
+		}
+	}
+	SetMaxSIMDLevel(SIMDLevel_t::AVX512);
+	return ok ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+/* Checks that SSE::RayIntersectsAABB4, AVX::RayIntersectsAABB8 and the RayPacket forms give, lane by lane, the same
+ * mask and the same entry distance bits as the scalar slab test. The reference is the plain Impl::SlabStep loop and
+ * AABB3f::RayIntersects is checked against it too. Coordinates come from a coarse grid so rays often start on a slab
+ * plane, directions have zero and negative zero components so the slabs give infinities and 0 * inf NaNs, and some
+ * boxes are EMPTY or have NaN bounds.
+ * Build it standalone, with the same include paths as the library:
+ *	g++ -std=c++20 -O2 -msse4.1 RayBoxPacketSweep.cpp -o RayBoxPacketSweep */
+
+#include "../Public/AABB.h"
+#include <cstdio>
+#include <random>
+
+using namespace greaper::math;
+
+namespace
+{
+	struct Ray
+	{
+		Vector3f Origin;
+		Vector3f Direction;
+		Vector3f InvDirection;
+		float TMin;
+		float TMax;
+	};
+
+	struct Expected
+	{
+		bool Hit;
+		float Distance;
+	};
+
+	/* The scalar path of AABB3f::RayIntersects, without the SSE shortcut */
+	Expected ScalarSlabTest(const AABB3f& box, const Ray& ray)
+	{
+		float enter = ray.TMin, exit = ray.TMax;
+		Impl::SlabStep(box.Min.X, box.Max.X, ray.Origin.X, ray.InvDirection.X, enter, exit);
+		Impl::SlabStep(box.Min.Y, box.Max.Y, ray.Origin.Y, ray.InvDirection.Y, enter, exit);
+		Impl::SlabStep(box.Min.Z, box.Max.Z, ray.Origin.Z, ray.InvDirection.Z, enter, exit);
+		return { enter <= exit, enter };
+	}
+
+	class Generator
+	{
+	public:
+		float Coordinate()
+		{
+			// Mostly grid values so origins land on box faces
+			if (m_Engine() % 4 == 0)
+				return m_Uniform(m_Engine);
+			return static_cast<float>(static_cast<int32>(m_Engine() % 9) - 4);
+		}
+		float DirectionComponent()
+		{
+			constexpr float choices[] = { 0.f, -0.f, 1.f, -1.f, 0.5f, -2.f, 1e-30f };
+			const uint32 pick = m_Engine() % 10;
+			return pick < 7 ? choices[pick] : m_Uniform(m_Engine);
+		}
+		AABB3f Box()
+		{
+			const uint32 pick = m_Engine() % 20;
+			if (pick == 0)
+				return AABB3f::EMPTY;
+			Vector3f a(Coordinate(), Coordinate(), Coordinate()), b(Coordinate(), Coordinate(), Coordinate());
+			AABB3f box(a, a);
+			box.Merge(b);
+			if (pick == 1)
+				box.Min.Y = std::numeric_limits<float>::quiet_NaN();
+			else if (pick == 2)
+				box.Max.Z = std::numeric_limits<float>::quiet_NaN();
+			return box;
+		}
+		Ray MakeRay()
+		{
+			Ray ray;
+			ray.Origin = Vector3f(Coordinate(), Coordinate(), Coordinate());
+			ray.Direction = Vector3f(DirectionComponent(), DirectionComponent(), DirectionComponent());
+			ray.InvDirection = Vector3f(1.f / ray.Direction.X, 1.f / ray.Direction.Y, 1.f / ray.Direction.Z);
+			const uint32 pick = m_Engine() % 6;
+			ray.TMin = pick == 0 ? 1.f : 0.f;
+			ray.TMax = pick == 1 ? 2.f : pick == 2 ? -1.f : std::numeric_limits<float>::infinity();
+			return ray;
+		}
+
+	private:
+		std::mt19937 m_Engine{ 16 };
+		std::uniform_real_distribution<float> m_Uniform{ -5.f, 5.f };
+	};
+
+	struct Counters
+	{
+		uint64 Tests = 0;
+		uint64 Hits = 0;
+		uint64 Errors = 0;
+	};
+
+	void Compare(const char* name, uint32 mask, const float* distances, const Expected* expected, sizet count, Counters& counters)
+	{
+		for (sizet i = 0; i < count; ++i)
+		{
+			const bool hit = (mask >> i) & 1;
+			// Distances of missed lanes are not specified
+			const bool ok = hit == expected[i].Hit && (!hit || std::bit_cast<uint32>(distances[i]) == std::bit_cast<uint32>(expected[i].Distance));
+			if (!ok && counters.Errors < 10)
+				printf("\t%s lane %zu: hit %d at %a, scalar %d at %a\n", name, i, hit, distances[i], expected[i].Hit, expected[i].Distance);
+			counters.Errors += !ok;
+			counters.Tests++;
+			counters.Hits += expected[i].Hit;
+		}
+	}
+}
+
+int main()
+{
+	Generator generator;
+	Counters counters;
+	const bool hasAVX2 = GetDetectedSIMDLevel() >= SIMDLevel_t::AVX2;
+	for (uint32 iteration = 0; iteration < 200000; ++iteration)
+	{
+		// One ray against eight boxes
+		const Ray ray = generator.MakeRay();
+		AABB3x8f boxes;
+		Expected expected[8];
+		for (sizet i = 0; i < 8; ++i)
+		{
+			boxes.Set(i, generator.Box());
+			expected[i] = ScalarSlabTest(boxes.Get(i), ray);
+		}
+		float distances[8];
+		for (sizet i = 0; i < 8; ++i)
+		{
+			float distance = 0.f;
+			const bool hit = boxes.Get(i).RayIntersects(ray.Origin, ray.InvDirection, ray.TMin, ray.TMax, &distance);
+			Compare("AABB3f::RayIntersects", hit ? 1u : 0u, &distance, &expected[i], 1, counters);
+		}
+		const int mask4 = SSE::RayIntersectsAABB4(boxes.MinX, boxes.MinY, boxes.MinZ, boxes.MaxX, boxes.MaxY, boxes.MaxZ, ray.Origin, ray.InvDirection, ray.TMin, ray.TMax, distances);
+		Compare("SSE::RayIntersectsAABB4", static_cast<uint32>(mask4), distances, expected, 4, counters);
+		if (hasAVX2)
+		{
+			const int mask8 = AVX::RayIntersectsAABB8(boxes, ray.Origin, ray.InvDirection, ray.TMin, ray.TMax, distances);
+			Compare("AVX::RayIntersectsAABB8", static_cast<uint32>(mask8), distances, expected, 8, counters);
+		}
+		SetMaxSIMDLevel(SIMDLevel_t::SSE41);
+		Compare("RayIntersects(AABB3x8f) SSE41", RayIntersects(boxes, ray.Origin, ray.InvDirection, ray.TMin, ray.TMax, distances), distances, expected, 8, counters);
+		SetMaxSIMDLevel(SIMDLevel_t::AVX512);
+
+		// Eight rays against one box
+		const AABB3f box = generator.Box();
+		RayPacket8 rays;
+		for (sizet i = 0; i < 8; ++i)
+		{
+			const Ray packetRay = generator.MakeRay();
+			rays.Set(i, packetRay.Origin, packetRay.Direction, packetRay.TMin, packetRay.TMax);
+			expected[i] = ScalarSlabTest(box, packetRay);
+		}
+		const int packetMask4 = SSE::RayPacketIntersectsAABB4(box, rays, 0, distances);
+		Compare("SSE::RayPacketIntersectsAABB4", static_cast<uint32>(packetMask4), distances, expected, 4, counters);
+		if (hasAVX2)
+		{
+			const int packetMask8 = AVX::RayPacketIntersectsAABB8(box, rays, distances);
+			Compare("AVX::RayPacketIntersectsAABB8", static_cast<uint32>(packetMask8), distances, expected, 8, counters);
+		}
+		SetMaxSIMDLevel(SIMDLevel_t::SSE41);
+		Compare("RayIntersects(RayPacket8) SSE41", RayIntersects(box, rays, distances), distances, expected, 8, counters);
+		SetMaxSIMDLevel(SIMDLevel_t::AVX512);
+	}
+	printf("%llu lane tests, %llu hits, %llu mismatches%s\n", static_cast<unsigned long long>(counters.Tests), static_cast<unsigned long long>(counters.Hits),
+		static_cast<unsigned long long>(counters.Errors), hasAVX2 ? "" : " (no AVX2, the 8 wide kernels were skipped)");
+	return counters.Errors == 0 ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+/* Exhaustive check of Batch::FloorInt, CeilInt, RoundInt and TruncInt. Every float bit pattern goes through each
+ * SIMD level, with tail lengths that change from block to block, and must give the same int32 as the scalar math::
+ * function. A few spot checks pin down the saturation: out of range values clamp to INT32_MIN / INT32_MAX and NaN
+ * gives 0.
+ * Build it standalone, with the same include paths as the library:
+ *	g++ -std=c++20 -O2 -msse4.1 RoundingKernelsSweep.cpp -o RoundingKernelsSweep */
+
+#include "../Public/Batch.h"
+#include <cstdio>
+#include <vector>
+
+using namespace greaper::math;
+
+namespace
+{
+	using BatchFn = void(*)(std::span<const float>, std::span<int32>);
+	using ScalarFn = int32(*)(float);
+
+	struct Conversion
+	{
+		const char* Name;
+		BatchFn Batch;
+		ScalarFn Scalar;
+	};
+
+	bool Sweep(const Conversion& conversion)
+	{
+		constexpr uint64 blockSize = 1 << 16;
+		std::vector<float> in(blockSize);
+		std::vector<int32> out(blockSize), expected(blockSize);
+		const uint32 maxLevel = static_cast<uint32>(GetDetectedSIMDLevel());
+		uint64 mismatches = 0;
+		for (uint64 base = 0; base < (uint64(1) << 32); base += blockSize)
+		{
+			for (uint64 i = 0; i < blockSize; ++i)
+			{
+				in[i] = std::bit_cast<float>(static_cast<uint32>(base + i));
+				expected[i] = conversion.Scalar(in[i]);
+			}
+			// Drops up to 16 elements so every tail length of every level is exercised
+			const sizet count = blockSize - (base / blockSize) % 17;
+			for (uint32 level = 0; level <= maxLevel; ++level)
+			{
+				SetMaxSIMDLevel(static_cast<SIMDLevel_t>(level));
+				conversion.Batch(std::span<const float>(in.data(), count), std::span<int32>(out.data(), count));
+				for (sizet i = 0; i < count; ++i)
+				{
+					if (out[i] != expected[i] && mismatches++ < 5)
+						printf("\t%s level %u at %a: %d, scalar %d\n", conversion.Name, level, in[i], out[i], expected[i]);
+				}
+			}
+		}
+		SetMaxSIMDLevel(SIMDLevel_t::AVX512);
+		printf("%-8s %llu mismatches over every float and SIMD level\n", conversion.Name, static_cast<unsigned long long>(mismatches));
+		return mismatches == 0;
+	}
+
+	bool CheckSaturation()
+	{
+		struct Case { float Value; int32 Floor, Ceil, Round, Trunc; };
+		constexpr int32 maxInt = std::numeric_limits<int32>::max(), minInt = std::numeric_limits<int32>::min();
+		const Case cases[] = {
+			{ 3e9f, maxInt, maxInt, maxInt, maxInt },
+			{ -3e9f, minInt, minInt, minInt, minInt },
+			{ 2147483648.f, maxInt, maxInt, maxInt, maxInt },
+			{ -2147483648.f, minInt, minInt, minInt, minInt },
+			{ 2147483520.f, 2147483520, 2147483520, 2147483520, 2147483520 },
+			{ std::numeric_limits<float>::infinity(), maxInt, maxInt, maxInt, maxInt },
+			{ -std::numeric_limits<float>::infinity(), minInt, minInt, minInt, minInt },
+			{ std::numeric_limits<float>::quiet_NaN(), 0, 0, 0, 0 },
+			{ -1.5f, -2, -1, -1, -1 },
+			{ 2.5f, 2, 3, 3, 2 },
+		};
+		bool ok = true;
+		for (const Case& c : cases)
+		{
+			const bool match = FloorInt(c.Value) == c.Floor && CeilInt(c.Value) == c.Ceil && RoundInt(c.Value) == c.Round && TruncInt(c.Value) == c.Trunc;
+			if (!match)
+				printf("\tsaturation mismatch at %a\n", c.Value);
+			ok &= match;
+		}
+		printf("saturation spot checks %s\n", ok ? "ok" : "FAILED");
+		return ok;
+	}
+}
+
+int main()
+{
+	const Conversion conversions[] = {
+		{ "FloorInt", &Batch::FloorInt, [](float x) { return FloorInt(x); } },
+		{ "CeilInt", &Batch::CeilInt, [](float x) { return CeilInt(x); } },
+		{ "RoundInt", &Batch::RoundInt, [](float x) { return RoundInt(x); } },
+		{ "TruncInt", &Batch::TruncInt, [](float x) { return TruncInt(x); } },
+	};
+	bool ok = CheckSaturation();
+	for (const Conversion& conversion : conversions)
+		ok &= Sweep(conversion);
+	return ok ? 0 : 1;
+}
\ No newline at end of file
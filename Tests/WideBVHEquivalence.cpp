@@ -0,0 +1,188 @@
+/***********************************************************************************
+*   Copyright 2022 Marcos Sánchez Torrent.                                         *
+*   All Rights Reserved.                                                           *
+***********************************************************************************/
+
+/* Checks that BVH4 and BVH8 answer ClosestHit and AnyHit like the binary BVH they are collapsed from, at every SIMD
+ * level since BVH8 switches to AVX2. The trees are also walked to check that every primitive sits in exactly one leaf
+ * and that the quantized child boxes contain their primitives. Besides the default leaves, the BVH is built with
+ * leaves far past the 255 primitives a wide leaf can hold, and once as a single leaf, so the leaf splitting is covered.
+ * Build it standalone, with the same include paths as the library:
+ *	g++ -std=c++20 -O2 -msse4.1 WideBVHEquivalence.cpp -o WideBVHEquivalence */
+
+#include "../Public/WideBVH.h"
+#include "../Public/RayTriangle.h"
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace greaper::math;
+
+namespace
+{
+	const char* const LevelNames[] = { "Scalar", "SSE41", "AVX2", "AVX512" };
+
+	struct Scene
+	{
+		std::vector<Vector3f> Vertices;
+		std::vector<uint32> Indices;
+
+		NODISCARD uint32 GetTriangleCount()const { return static_cast<uint32>(Indices.size() / 3); }
+		NODISCARD const Vector3f& GetVertex(uint32 triangle, uint32 corner)const { return Vertices[Indices[triangle * 3 + corner]]; }
+		NODISCARD AABB3f GetTriangleBounds(uint32 triangle)const
+		{
+			AABB3f bounds = AABB3f::EMPTY;
+			for (uint32 corner = 0; corner < 3; ++corner)
+				bounds.Merge(GetVertex(triangle, corner));
+			return bounds;
+		}
+		/* Lowers distance and returns true when the triangle is hit closer */
+		NODISCARD bool Intersect(uint32 triangle, const Vector3f& origin, const Vector3f& direction, float tMin, float& distance)const
+		{
+			RayTriangleHit<float> hit;
+			if (!RayIntersectsTriangle(origin, direction, GetVertex(triangle, 0), GetVertex(triangle, 1), GetVertex(triangle, 2), tMin, distance, hit))
+				return false;
+			distance = hit.Distance;
+			return true;
+		}
+	};
+
+	Scene MakeScene(std::mt19937& generator, uint32 triangleCount)
+	{
+		std::uniform_real_distribution<float> position(-10.f, 10.f), offset(-0.3f, 0.3f);
+		Scene scene;
+		for (uint32 i = 0; i < triangleCount; ++i)
+		{
+			const Vector3f center = i % 10 == 0 ? Vector3f(1.f, 1.f, 1.f) : Vector3f(position(generator), position(generator), position(generator));
+			for (uint32 corner = 0; corner < 3; ++corner)
+			{
+				scene.Indices.push_back(static_cast<uint32>(scene.Vertices.size()));
+				scene.Vertices.push_back(center + Vector3f(offset(generator), offset(generator), offset(generator)));
+			}
+		}
+		return scene;
+	}
+
+	template<sizet Width>
+	uint64 CheckStructure(const WideBVH<Width>& wide, const Scene& scene)
+	{
+		uint64 errors = 0;
+		std::vector<uint32> seen(scene.GetTriangleCount(), 0);
+		for (const WideBVHNode<Width>& node : wide.GetNodes())
+		{
+			for (sizet child = 0; child < node.ChildCount; ++child)
+			{
+				if (!node.IsLeaf(child))
+					continue;
+				const AABB3f childBounds = node.GetChildBounds(child);
+				for (uint32 i = 0; i < node.PrimitiveCount[child]; ++i)
+				{
+					const uint32 primitive = wide.GetPrimitiveIndices()[node.Child[child] + i];
+					++seen[primitive];
+					const AABB3f merged = childBounds.GetMerged(scene.GetTriangleBounds(primitive));
+					errors += merged.Min != childBounds.Min || merged.Max != childBounds.Max;
+				}
+			}
+		}
+		for (const uint32 count : seen)
+			errors += count != 1;
+		return errors;
+	}
+
+	uint32 GetLargestLeaf(const BVH& bvh)
+	{
+		uint32 largest = 0;
+		for (const BVHNode& node : bvh.GetNodes())
+			largest = std::max(largest, node.Count);
+		return largest;
+	}
+
+	/* The hit primitive may differ on ties, it only has to be hit at the same distance */
+	bool SameHit(const BVHHit& hit, const BVHHit& expected, const Scene& scene, const Vector3f& origin, const Vector3f& direction, float tMin, float tMax)
+	{
+		if (hit.IsHit() != expected.IsHit())
+			return false;
+		if (!hit.IsHit())
+			return true;
+		float distance = tMax;
+		return hit.Distance == expected.Distance && scene.Intersect(hit.Primitive, origin, direction, tMin, distance) && distance == expected.Distance;
+	}
+
+	template<sizet Width>
+	uint64 CheckRays(const WideBVH<Width>& wide, const BVH& bvh, const Scene& scene, uint32 rayCount)
+	{
+		std::mt19937 generator(5);
+		std::uniform_real_distribution<float> position(-12.f, 12.f);
+		uint64 errors = 0;
+		for (uint32 r = 0; r < rayCount; ++r)
+		{
+			Vector3f origin(position(generator), position(generator), position(generator));
+			Vector3f direction(position(generator), position(generator), position(generator));
+			if (r % 5 == 0)
+				direction.Y = 0.f;
+			if (r % 7 == 0)
+				origin.X = 0.f;
+			if (r % 11 == 0)
+				direction = Vector3f(1.f, 1.f, 1.f) - origin;
+			const float tMin = r % 3 == 0 ? 0.5f : 0.f;
+			const float tMax = r % 4 == 0 ? 1.f : std::numeric_limits<float>::infinity();
+			const auto closest = [&](uint32 triangle, float& distance) { return scene.Intersect(triangle, origin, direction, tMin, distance); };
+			const auto any = [&](uint32 triangle, float distance) { return scene.Intersect(triangle, origin, direction, tMin, distance); };
+
+			const BVHHit expected = bvh.ClosestHit(origin, direction, tMin, tMax, closest);
+			const BVHHit hit = wide.ClosestHit(origin, direction, tMin, tMax, closest);
+			const bool closestOk = SameHit(hit, expected, scene, origin, direction, tMin, tMax);
+			const bool anyOk = wide.AnyHit(origin, direction, tMin, tMax, any) == expected.IsHit();
+			if ((!closestOk || !anyOk) && errors < 5)
+				printf("\tray %u: hit %d at %a, BVH %d at %a, AnyHit %s\n", r, hit.IsHit(), hit.Distance, expected.IsHit(), expected.Distance, anyOk ? "ok" : "differs");
+			errors += !closestOk + !anyOk;
+		}
+		return errors;
+	}
+
+	template<sizet Width>
+	uint64 CheckWidth(const BVH& bvh, const Scene& scene)
+	{
+		WideBVH<Width> wide;
+		wide.Build(bvh);
+		uint64 errors = CheckStructure(wide, scene);
+		for (uint32 level = 0; level <= static_cast<uint32>(GetDetectedSIMDLevel()); ++level)
+		{
+			SetMaxSIMDLevel(static_cast<SIMDLevel_t>(level));
+			const uint64 rayErrors = CheckRays(wide, bvh, scene, 4000);
+			printf("\tBVH%zu %-7s %zu nodes, %llu errors\n", Width, LevelNames[level], wide.GetNodes().size(), static_cast<unsigned long long>(rayErrors));
+			errors += rayErrors;
+		}
+		SetMaxSIMDLevel(SIMDLevel_t::AVX512);
+		return errors;
+	}
+
+	uint64 CheckScene(const char* name, const Scene& scene, const BVHBuildSettings& settings)
+	{
+		BVH bvh;
+		bvh.Build(scene.Vertices, scene.Indices, settings);
+		printf("%s: %u triangles, largest BVH leaf %u\n", name, scene.GetTriangleCount(), GetLargestLeaf(bvh));
+		return CheckWidth<4>(bvh, scene) + CheckWidth<8>(bvh, scene);
+	}
+}
+
+int main()
+{
+	std::mt19937 generator(19);
+	const Scene soup = MakeScene(generator, 20000);
+	const Scene small = MakeScene(generator, 3000);
+	uint64 errors = 0;
+
+	errors += CheckScene("default leaves", soup, {});
+	BVHBuildSettings largeLeaves;
+	largeLeaves.MaxLeafSize = 1500;
+	largeLeaves.IntersectionCost = 0.01f;
+	errors += CheckScene("leaves past 255", soup, largeLeaves);
+	BVHBuildSettings singleLeaf;
+	singleLeaf.MaxLeafSize = 4096;
+	singleLeaf.IntersectionCost = 0.f;
+	errors += CheckScene("single leaf", small, singleLeaf);
+
+	printf("%llu errors\n", static_cast<unsigned long long>(errors));
+	return errors == 0 ? 0 : 1;
+}
\ No newline at end of file